@@ -1,9 +1,73 @@
 // Debug pipeline (renderMode=1 or production fallback): point->quad via GS,
 // flat circle splat with degree-0 SH color and sigmoid opacity.
+// GS_COMPACT: the node holds compact storage (unorm16 positions in chunk
+// boxes, fp16 SH), see SplatCompact.h.
 
-StructuredBuffer<float3> gPositionWS : register(t0);
-StructuredBuffer<float>  gOpacity    : register(t1);
-StructuredBuffer<float3> gSHCoeffs   : register(t2);
+// Inputs are paged (see PageLayout.h): element i of a column lives in page
+// i >> kPageShift at i & kPageMask. Position and opacity take 4 pages, SH 48.
+static const uint kPageShift = 26;                  // PageLayout::kPageShift
+static const uint kPageMask  = (1u << kPageShift) - 1;
+
+#ifdef GS_COMPACT
+StructuredBuffer<uint2>  gPositionQ[4]  : register(t0);
+StructuredBuffer<float>  gOpacity[4]    : register(t4);
+StructuredBuffer<uint>   gSHHalf[48]    : register(t8);
+struct CompactChunk { float3 origin; float3 step; };
+StructuredBuffer<CompactChunk> gChunks  : register(t56);
+#else
+StructuredBuffer<float3> gPositionWS[4] : register(t0);
+StructuredBuffer<float>  gOpacity[4]    : register(t4);
+StructuredBuffer<float3> gSHCoeffs[48]  : register(t8);
+#endif
+
+// Resource arrays take literal indices in SM 5.0, hence the switches
+#define PAGED_LOAD4(T, name, col)                                              \
+    T name(uint i) {                                                           \
+        uint l = i & kPageMask;                                                \
+        switch (i >> kPageShift) {                                             \
+        case 0: return col[0][l]; case 1: return col[1][l];                    \
+        case 2: return col[2][l]; default: return col[3][l];                   \
+        }                                                                      \
+    }
+#define PAGED_LOAD48(T, name, col)                                             \
+    T name(uint i) {                                                           \
+        uint l = i & kPageMask;                                                \
+        switch (i >> kPageShift) {                                             \
+        case 0:  return col[0][l];   case 1:  return col[1][l];                \
+        case 2:  return col[2][l];   case 3:  return col[3][l];                \
+        case 4:  return col[4][l];   case 5:  return col[5][l];                \
+        case 6:  return col[6][l];   case 7:  return col[7][l];                \
+        case 8:  return col[8][l];   case 9:  return col[9][l];                \
+        case 10: return col[10][l];  case 11: return col[11][l];               \
+        case 12: return col[12][l];  case 13: return col[13][l];               \
+        case 14: return col[14][l];  case 15: return col[15][l];               \
+        case 16: return col[16][l];  case 17: return col[17][l];               \
+        case 18: return col[18][l];  case 19: return col[19][l];               \
+        case 20: return col[20][l];  case 21: return col[21][l];               \
+        case 22: return col[22][l];  case 23: return col[23][l];               \
+        case 24: return col[24][l];  case 25: return col[25][l];               \
+        case 26: return col[26][l];  case 27: return col[27][l];               \
+        case 28: return col[28][l];  case 29: return col[29][l];               \
+        case 30: return col[30][l];  case 31: return col[31][l];               \
+        case 32: return col[32][l];  case 33: return col[33][l];               \
+        case 34: return col[34][l];  case 35: return col[35][l];               \
+        case 36: return col[36][l];  case 37: return col[37][l];               \
+        case 38: return col[38][l];  case 39: return col[39][l];               \
+        case 40: return col[40][l];  case 41: return col[41][l];               \
+        case 42: return col[42][l];  case 43: return col[43][l];               \
+        case 44: return col[44][l];  case 45: return col[45][l];               \
+        case 46: return col[46][l];  default: return col[47][l];               \
+        }                                                                      \
+    }
+
+PAGED_LOAD4(float, LoadOpacity, gOpacity)
+#ifdef GS_COMPACT
+PAGED_LOAD4(uint2, LoadPositionQ, gPositionQ)
+PAGED_LOAD48(uint, LoadSHHalf, gSHHalf)
+#else
+PAGED_LOAD4(float3, LoadPositionWS, gPositionWS)
+PAGED_LOAD48(float3, LoadSHCoeff, gSHCoeffs)
+#endif
 
 cbuffer CBDebug : register(b0)
 {
@@ -11,20 +75,41 @@ cbuffer CBDebug : register(b0)
     float  gPointSize;
     float  gVPWidth;
     float  gVPHeight;
-    uint   gSHStride;    // = 16 (groups per splat), for indexing into gSHCoeffs
+    uint   gSHStride;    // SH groups per splat (1/4/9/16 by shDegree), for indexing into gSHCoeffs
 };
 
+#ifdef GS_COMPACT
+static const uint kChunkSplats = 256;   // kCompactChunkSplats
+
+float3 LoadPosition(uint i)
+{
+    uint2 q = LoadPositionQ(i);
+    CompactChunk c = gChunks[i / kChunkSplats];
+    return c.origin + float3(q.x & 0xFFFF, q.x >> 16, q.y & 0xFFFF) * c.step;
+}
+
+float3 LoadSHDC(uint i)
+{
+    uint base = i * ((gSHStride * 3 + 1) / 2);   // uints per splat
+    uint w0 = LoadSHHalf(base), w1 = LoadSHHalf(base + 1);
+    return float3(f16tof32(w0), f16tof32(w0 >> 16), f16tof32(w1));
+}
+#else
+float3 LoadPosition(uint i) { return LoadPositionWS(i); }
+float3 LoadSHDC(uint i)     { return LoadSHCoeff(i * gSHStride); }
+#endif
+
 struct VS_OUT { float4 clip : SV_Position; float4 col : COLOR; };
 struct GS_OUT { float4 clip : SV_Position; float4 col : COLOR; float2 uv : TEXCOORD0; };
 
 VS_OUT VS(uint vid : SV_VertexID)
 {
-    float3 pos = gPositionWS[vid];
+    float3 pos = LoadPosition(vid);
     // degree-0 SH color
-    float3 col = gSHCoeffs[vid * gSHStride] * 0.282095f + 0.5f;
+    float3 col = LoadSHDC(vid) * 0.282095f + 0.5f;
     col = max(col, 0.0f);
     // sigmoid opacity
-    float alpha = 1.0f / (1.0f + exp(-gOpacity[vid]));
+    float alpha = 1.0f / (1.0f + exp(-LoadOpacity(vid)));
 
     VS_OUT o;
     o.clip = mul(float4(pos, 1.0f), gWVP);
@@ -1,6 +1,8 @@
 // Depth pass for GS -> Maya occlusion. Two kernels (compiled separately):
 //   CLEAR_DEPTH_KERNEL -> ClearDepthKernel
 //   DEPTH_PASS_KERNEL  -> DepthPassKernel  (atomic-min depth write per splat footprint)
+// The depth pass runs per 2^23 slots from gSlotBase, with the output page
+// holding them bound (see PageLayout.h).
 
 cbuffer DepthCB : register(b0)
 {
@@ -9,7 +11,8 @@ cbuffer DepthCB : register(b0)
     uint  gSplatCount;
     uint  gRadiusCap;
     float gAlphaThreshold;
-    float gDpadA, gDpadB, gDpadC;
+    uint  gSlotBase;        // first slot of this dispatch
+    float gDpadB, gDpadC;
 };
 
 RWTexture2D<uint> gDepthUAV : register(u0);
@@ -24,6 +27,8 @@ void ClearDepthKernel(uint3 id : SV_DispatchThreadID)
 #endif
 
 #ifdef DEPTH_PASS_KERNEL
+static const uint kPageMask = (1u << 26) - 1;       // PageLayout::kPageShift
+
 StructuredBuffer<float2> gPositionSS   : register(t0);
 StructuredBuffer<float>  gRadius       : register(t1);
 StructuredBuffer<float>  gDepth        : register(t2);
@@ -34,8 +39,8 @@ float sigmoid_approx(float x) { return 1.0f / (1.0f + exp(-x)); }
 [numthreads(256, 1, 1)]
 void DepthPassKernel(uint3 id : SV_DispatchThreadID)
 {
-    uint sidx = id.x;
-    if (sidx >= gSplatCount) return;
+    if (gSlotBase + id.x >= gSplatCount) return;
+    uint sidx = (gSlotBase + id.x) & kPageMask;
 
     float r = gRadius[sidx];
     if (r <= 0.0f) return;
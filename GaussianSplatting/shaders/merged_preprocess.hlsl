@@ -1,19 +1,120 @@
 // Merged preprocessing CS.
-//   - worldMat is per-splat via gInstanceID -> gWorldMats[]
+//   - One thread per instance slot; the slot's instance is found by binary
+//     search over gInstanceSlots, which gives its matrices and the pool
+//     row it reads. Instances of one dataset read the same pool rows.
+//   - Camera-independent work is done before the frame: the float pool holds
+//     each splat's object-space cov3D (computed when its rows are uploaded),
+//     and gInstanceMats holds world * view per instance, so a splat goes to
+//     view space, and its cov3D to screen space, with one matrix each
+//   - Outputs (and the selection mask) are indexed by slot
+//   - Only the slots of gDispatchRanges run: the chunks of each visible
+//     instance its SplatBVH keeps. The host clears the radius of the
+//     others first, so they read as culled.
 //   - Outputs: positionSS, depth, radius, color, cov2D+opacity
 //   - Skips deleted splats (mask bit 1) by emitting radius=0
+//   - Skips slots of splats still being streamed in (past the loaded rows)
+//   - SH is packed per dataset block at that dataset's degree (gInstanceSH)
+//   - GS_COMPACT: the pool holds compact storage (see SplatCompact.h):
+//     unorm16 positions in per-chunk boxes, fp16 log-scale and SH, snorm8
+//     quaternions
+//   - Pool columns, outputs and the mask are paged (see PageLayout.h):
+//     element i lives in page i >> kPageShift at i & kPageMask. The pool
+//     pages are all bound; each dispatch's ranges lie in gSlotBase +
+//     [0, 2^23), which lies in one output page, and it gets that page's
+//     outputs and mask.
+
+static const uint kPageShift = 26;                  // PageLayout::kPageShift
+static const uint kPageMask  = (1u << kPageShift) - 1;
+
+// Per-instance slots: x = first merged slot, y = rows loaded. Sorted by x.
+StructuredBuffer<uint2>  gInstanceSlots : register(t0);
+// Per-instance matrices (PreprocessInstance), 4 x float4 rows each
+// (row-major, matching Maya convention): world, and world * view
+struct InstanceMats { float4 w0, w1, w2, w3; float4 wv0, wv1, wv2, wv3; };
+StructuredBuffer<InstanceMats> gInstanceMats : register(t1);
+// Selection mask page of this dispatch: bit 0 = selected, bit 1 = deleted
+StructuredBuffer<uint>   gMask        : register(t2);
+// Per-instance pool layout: x = first pool row, y = first SH group (first SH
+// uint when compact), z = SH groups per splat (1, 4, 9 or 16), w = first
+// position chunk (compact only)
+StructuredBuffer<uint4>  gInstanceSH  : register(t3);
+#ifdef GS_COMPACT
+struct CompactChunk { float3 origin; float3 step; };
+StructuredBuffer<CompactChunk> gChunks : register(t4);
+#endif
+// Slot ranges to run: x = first slot, y = threads before it in its dispatch.
+// Each dispatch reads gRangeCount of them from gRangeBase.
+StructuredBuffer<uint2>  gDispatchRanges : register(t5);
+
+// Pool columns: 4 pages per row column, 48 for SH. The float pool stores
+// the object-space cov3D (diagonal, off-diagonal) where the compact pool
+// has the scale and quaternion.
+#ifdef GS_COMPACT
+StructuredBuffer<uint2>  gPositionQ[4]  : register(t8);
+StructuredBuffer<uint2>  gScaleH[4]     : register(t12);
+StructuredBuffer<uint>   gRotationQ[4]  : register(t16);
+StructuredBuffer<float>  gOpacity[4]    : register(t20);
+StructuredBuffer<uint>   gSHHalf[48]    : register(t24);
+#else
+StructuredBuffer<float3> gPositionWS[4] : register(t8);
+StructuredBuffer<float3> gCovDiag[4]    : register(t12);   // xx, yy, zz
+StructuredBuffer<float3> gCovOffDiag[4] : register(t16);   // xy, xz, yz
+StructuredBuffer<float>  gOpacity[4]    : register(t20);
+StructuredBuffer<float3> gSHsCoeff[48]  : register(t24);
+#endif
+
+// Resource arrays take literal indices in SM 5.0, hence the switches
+#define PAGED_LOAD4(T, name, col)                                              \
+    T name(uint i) {                                                           \
+        uint l = i & kPageMask;                                                \
+        switch (i >> kPageShift) {                                             \
+        case 0: return col[0][l]; case 1: return col[1][l];                    \
+        case 2: return col[2][l]; default: return col[3][l];                   \
+        }                                                                      \
+    }
+#define PAGED_LOAD48(T, name, col)                                             \
+    T name(uint i) {                                                           \
+        uint l = i & kPageMask;                                                \
+        switch (i >> kPageShift) {                                             \
+        case 0:  return col[0][l];   case 1:  return col[1][l];                \
+        case 2:  return col[2][l];   case 3:  return col[3][l];                \
+        case 4:  return col[4][l];   case 5:  return col[5][l];                \
+        case 6:  return col[6][l];   case 7:  return col[7][l];                \
+        case 8:  return col[8][l];   case 9:  return col[9][l];                \
+        case 10: return col[10][l];  case 11: return col[11][l];               \
+        case 12: return col[12][l];  case 13: return col[13][l];               \
+        case 14: return col[14][l];  case 15: return col[15][l];               \
+        case 16: return col[16][l];  case 17: return col[17][l];               \
+        case 18: return col[18][l];  case 19: return col[19][l];               \
+        case 20: return col[20][l];  case 21: return col[21][l];               \
+        case 22: return col[22][l];  case 23: return col[23][l];               \
+        case 24: return col[24][l];  case 25: return col[25][l];               \
+        case 26: return col[26][l];  case 27: return col[27][l];               \
+        case 28: return col[28][l];  case 29: return col[29][l];               \
+        case 30: return col[30][l];  case 31: return col[31][l];               \
+        case 32: return col[32][l];  case 33: return col[33][l];               \
+        case 34: return col[34][l];  case 35: return col[35][l];               \
+        case 36: return col[36][l];  case 37: return col[37][l];               \
+        case 38: return col[38][l];  case 39: return col[39][l];               \
+        case 40: return col[40][l];  case 41: return col[41][l];               \
+        case 42: return col[42][l];  case 43: return col[43][l];               \
+        case 44: return col[44][l];  case 45: return col[45][l];               \
+        case 46: return col[46][l];  default: return col[47][l];               \
+        }                                                                      \
+    }
 
-StructuredBuffer<float3> gPositionWS  : register(t0);
-StructuredBuffer<float3> gScale       : register(t1);
-StructuredBuffer<float4> gRotation    : register(t2);
-StructuredBuffer<float>  gOpacity     : register(t3);
-StructuredBuffer<float3> gSHsCoeff    : register(t4);
-StructuredBuffer<uint>   gInstanceID  : register(t5);
-// World matrices stored as 4 x float4 rows (row-major, matching Maya convention)
-struct Float4x4 { float4 r0, r1, r2, r3; };
-StructuredBuffer<Float4x4> gWorldMats : register(t6);
-// Per-splat selection mask: bit 0 = selected, bit 1 = deleted
-StructuredBuffer<uint>   gMask        : register(t7);
+PAGED_LOAD4(float, LoadOpacity, gOpacity)
+#ifdef GS_COMPACT
+PAGED_LOAD4(uint2, LoadPositionQ, gPositionQ)
+PAGED_LOAD4(uint2, LoadScaleH,    gScaleH)
+PAGED_LOAD4(uint,  LoadRotationQ, gRotationQ)
+PAGED_LOAD48(uint, LoadSHWord,    gSHHalf)
+#else
+PAGED_LOAD4(float3, LoadPositionWS, gPositionWS)
+PAGED_LOAD4(float3, LoadCovDiag,    gCovDiag)
+PAGED_LOAD4(float3, LoadCovOffDiag, gCovOffDiag)
+PAGED_LOAD48(float3, LoadSHGroup,   gSHsCoeff)
+#endif
 
 RWStructuredBuffer<float2> gPositionSS    : register(u0);
 RWStructuredBuffer<float>  gDepth         : register(u1);
@@ -32,9 +133,57 @@ cbuffer PreprocessParams : register(b0)
     int      filmHeight;
     uint     gGaussCounts;
     uint     debugFixedRadius;
-    float    pad2; float pad3;
+    uint     gInstanceCount;
+    uint     gSlotBase;      // first slot of this dispatch's 2^23 batch
+    uint     gRangeBase;
+    uint     gRangeCount;
+    uint     gThreadCount;   // slots in this dispatch's ranges
+    uint     padding1;
 };
 
+#ifdef GS_COMPACT
+static const uint kChunkSplats = 256;   // kCompactChunkSplats
+
+float3 LoadPosition(uint idx, uint4 info)
+{
+    uint2 q = LoadPositionQ(idx);
+    CompactChunk c = gChunks[info.w + (idx - info.x) / kChunkSplats];
+    return c.origin + float3(q.x & 0xFFFF, q.x >> 16, q.y & 0xFFFF) * c.step;
+}
+
+float3 LoadScale(uint idx)
+{
+    uint2 h = LoadScaleH(idx);
+    return exp(float3(f16tof32(h.x), f16tof32(h.x >> 16), f16tof32(h.y)));
+}
+
+float4 LoadRotation(uint idx)
+{
+    // snorm8 w | x << 8 | y << 16 | z << 24, sign-extended per byte
+    int  q = (int)LoadRotationQ(idx);
+    int4 v = int4(q << 24, q << 16, q << 8, q) >> 24;
+    return normalize((float4)v / 127.0f);
+}
+
+// SH value k of a splat's fp16 block starting at uint `base`
+float LoadSHHalf(uint base, uint k)
+{
+    return f16tof32(LoadSHWord(base + (k >> 1)) >> ((k & 1) * 16));
+}
+
+// float3 group i of the splat whose SH block starts at `base`
+float3 SH(uint base, uint i)
+{
+    return float3(LoadSHHalf(base, 3 * i), LoadSHHalf(base, 3 * i + 1), LoadSHHalf(base, 3 * i + 2));
+}
+
+uint SHBase(uint idx, uint4 info) { return info.y + (idx - info.x) * ((info.z * 3 + 1) / 2); }
+#else
+float3 LoadPosition(uint idx, uint4 info) { return LoadPositionWS(idx); }
+float3 SH(uint base, uint i)              { return LoadSHGroup(base + i); }
+uint   SHBase(uint idx, uint4 info)       { return info.y + (idx - info.x) * info.z; }
+#endif
+
 float3x3 Get3DCovariance(float3 scale, float4 rotation)
 {
     float r = rotation.x;
@@ -55,7 +204,23 @@ float3x3 Get3DCovariance(float3 scale, float4 rotation)
     return mul(R, mul(S, transpose(R)));
 }
 
-float3 Get2DCovariance(float3x3 cov3D, float3 meanVS)
+// Object-space cov3D of pool row idx
+float3x3 LoadCov3D(uint idx)
+{
+#ifdef GS_COMPACT
+    return Get3DCovariance(LoadScale(idx), LoadRotation(idx));
+#else
+    float3 d = LoadCovDiag(idx);
+    float3 o = LoadCovOffDiag(idx);
+    return float3x3(d.x, o.x, o.y,
+                    o.x, d.y, o.z,
+                    o.y, o.z, d.z);
+#endif
+}
+
+// cov3D in object space; worldView3 = upper 3x3 of world * view, so
+// T = J * transpose(worldView3) covers the world and view rotations at once
+float3 Get2DCovariance(float3x3 cov3D, float3x3 worldView3, float3 meanVS)
 {
     float focalX = 0.5f * (float)filmWidth  / tanHalfFov.x;
     float focalY = 0.5f * (float)filmHeight / tanHalfFov.y;
@@ -72,37 +237,40 @@ float3 Get2DCovariance(float3x3 cov3D, float3 meanVS)
         0.0f,          0.0f,           0.0f
     );
 
-    float3x3 W   = transpose((float3x3)viewMat);
-    float3x3 T   = mul(J, W);
+    float3x3 T   = mul(J, transpose(worldView3));
     float3x3 cov = mul(T, mul(cov3D, transpose(T)));
 
     return float3(cov[0][0] + 0.3f, cov[0][1], cov[1][1] + 0.3f);
 }
 
-float3 ComputeSphericalHarmonics(uint idx, float3 position, float3 camPos)
+float3 ComputeSphericalHarmonics(uint idx, uint4 shInfo, float3 position, float3 camPos)
 {
-    uint shBaseIdx = idx * 16;
+    uint shStride  = shInfo.z;
+    uint shBaseIdx = SHBase(idx, shInfo);
     float3 dir = normalize(position - camPos);
 
-    float3 shColor = gSHsCoeff[shBaseIdx + 0] * 0.282095f;
-
-    shColor += gSHsCoeff[shBaseIdx + 1] * -0.488603f * dir.y;
-    shColor += gSHsCoeff[shBaseIdx + 2] *  0.488603f * dir.z;
-    shColor += gSHsCoeff[shBaseIdx + 3] * -0.488603f * dir.x;
-
-    shColor += gSHsCoeff[shBaseIdx + 4] *  1.092548f * dir.x * dir.y;
-    shColor += gSHsCoeff[shBaseIdx + 5] * -1.092548f * dir.y * dir.z;
-    shColor += gSHsCoeff[shBaseIdx + 6] *  0.315392f * (3.0f * dir.z * dir.z - 1.0f);
-    shColor += gSHsCoeff[shBaseIdx + 7] * -1.092548f * dir.x * dir.z;
-    shColor += gSHsCoeff[shBaseIdx + 8] *  0.546274f * (dir.x * dir.x - dir.y * dir.y);
-
-    shColor += gSHsCoeff[shBaseIdx + 9]  * -0.590044f * dir.y * (3.0f * dir.x * dir.x - dir.y * dir.y);
-    shColor += gSHsCoeff[shBaseIdx + 10] *  2.890611f * dir.x * dir.y * dir.z;
-    shColor += gSHsCoeff[shBaseIdx + 11] * -0.457046f * dir.y * (5.0f * dir.z * dir.z - 1.0f);
-    shColor += gSHsCoeff[shBaseIdx + 12] *  0.373176f * (5.0f * dir.z * dir.z * dir.z - 3.0f * dir.z);
-    shColor += gSHsCoeff[shBaseIdx + 13] * -0.457046f * dir.x * (5.0f * dir.z * dir.z - 1.0f);
-    shColor += gSHsCoeff[shBaseIdx + 14] *  1.445305f * dir.z * (dir.x * dir.x - dir.y * dir.y);
-    shColor += gSHsCoeff[shBaseIdx + 15] * -0.590044f * dir.x * (dir.x * dir.x - 3.0f * dir.y * dir.y);
+    float3 shColor = SH(shBaseIdx, 0) * 0.282095f;
+    if (shStride < 4) return max(shColor + 0.5f, 0.0f);
+
+    shColor += SH(shBaseIdx, 1) * -0.488603f * dir.y;
+    shColor += SH(shBaseIdx, 2) *  0.488603f * dir.z;
+    shColor += SH(shBaseIdx, 3) * -0.488603f * dir.x;
+    if (shStride < 9) return max(shColor + 0.5f, 0.0f);
+
+    shColor += SH(shBaseIdx, 4) *  1.092548f * dir.x * dir.y;
+    shColor += SH(shBaseIdx, 5) * -1.092548f * dir.y * dir.z;
+    shColor += SH(shBaseIdx, 6) *  0.315392f * (3.0f * dir.z * dir.z - 1.0f);
+    shColor += SH(shBaseIdx, 7) * -1.092548f * dir.x * dir.z;
+    shColor += SH(shBaseIdx, 8) *  0.546274f * (dir.x * dir.x - dir.y * dir.y);
+    if (shStride < 16) return max(shColor + 0.5f, 0.0f);
+
+    shColor += SH(shBaseIdx, 9)  * -0.590044f * dir.y * (3.0f * dir.x * dir.x - dir.y * dir.y);
+    shColor += SH(shBaseIdx, 10) *  2.890611f * dir.x * dir.y * dir.z;
+    shColor += SH(shBaseIdx, 11) * -0.457046f * dir.y * (5.0f * dir.z * dir.z - 1.0f);
+    shColor += SH(shBaseIdx, 12) *  0.373176f * (5.0f * dir.z * dir.z * dir.z - 3.0f * dir.z);
+    shColor += SH(shBaseIdx, 13) * -0.457046f * dir.x * (5.0f * dir.z * dir.z - 1.0f);
+    shColor += SH(shBaseIdx, 14) *  1.445305f * dir.z * (dir.x * dir.x - dir.y * dir.y);
+    shColor += SH(shBaseIdx, 15) * -0.590044f * dir.x * (dir.x * dir.x - 3.0f * dir.y * dir.y);
 
     shColor += 0.5f;
     return max(shColor, 0.0f);
@@ -111,24 +279,43 @@ float3 ComputeSphericalHarmonics(uint idx, float3 position, float3 camPos)
 [numthreads(256, 1, 1)]
 void PreprocessKernel(uint3 id : SV_DispatchThreadID)
 {
-    if (id.x >= gGaussCounts) return;
+    if (id.x >= gThreadCount) return;
 
-    // Deleted splats: emit zero-radius so they are skipped downstream.
-    uint mask = gMask[id.x];
-    if (mask & 2u) { gRadius[id.x] = 0.0f; return; }
+    // Range holding this thread: the last one starting at or before it
+    uint rlo = gRangeBase, rhi = gRangeBase + gRangeCount;
+    while (rhi - rlo > 1) {
+        uint mid = (rlo + rhi) >> 1;
+        if (gDispatchRanges[mid].y <= id.x) rlo = mid; else rhi = mid;
+    }
+    uint2 range = gDispatchRanges[rlo];
+    uint  slot  = range.x + (id.x - range.y);
+    if (slot >= gGaussCounts) return;
+    uint o = slot & kPageMask;     // in this dispatch's output and mask pages
 
-    // Look up per-splat world matrix via instance ID
-    uint inst = gInstanceID[id.x];
-    Float4x4 wm = gWorldMats[inst];
-    float4x4 worldMat = float4x4(wm.r0, wm.r1, wm.r2, wm.r3);
+    // Deleted splats: emit zero-radius so they are skipped downstream.
+    uint mask = gMask[o];
+    if (mask & 2u) { gRadius[o] = 0.0f; return; }
+
+    // Instance owning this slot: the last one starting at or before it
+    uint lo = 0, hi = gInstanceCount;
+    while (hi - lo > 1) {
+        uint mid = (lo + hi) >> 1;
+        if (gInstanceSlots[mid].x <= slot) lo = mid; else hi = mid;
+    }
+    uint2 slots = gInstanceSlots[lo];
+    uint  local = slot - slots.x;
+    if (local >= slots.y) { gRadius[o] = 0.0f; return; }
 
-    float3 posOS = gPositionWS[id.x];
-    float3 posWS = mul(float4(posOS, 1.0f), worldMat).xyz;
+    InstanceMats im        = gInstanceMats[lo];
+    float4x4     worldView = float4x4(im.wv0, im.wv1, im.wv2, im.wv3);
+    uint4        info      = gInstanceSH[lo];
+    uint         row       = info.x + local;    // pool row shared by the dataset's instances
 
-    float4 posVS = mul(float4(posWS, 1.0f), viewMat);
+    float3 posOS = LoadPosition(row, info);
+    float4 posVS = mul(float4(posOS, 1.0f), worldView);
 
     if (posVS.z >= -0.2f) {
-        gRadius[id.x] = 0.0f;
+        gRadius[o] = 0.0f;
         return;
     }
 
@@ -136,44 +323,43 @@ void PreprocessKernel(uint3 id : SV_DispatchThreadID)
     float2 posNDC = posCS.xy / posCS.w;
     float2 posSS  = (posNDC * 0.5f + 0.5f) * float2((float)filmWidth, (float)filmHeight);
 
-    float3x3 cov3D_obj = Get3DCovariance(gScale[id.x], gRotation[id.x]);
-    float3x3 W3x3      = (float3x3)worldMat;
-    float3x3 cov3D     = mul(transpose(W3x3), mul(cov3D_obj, W3x3));
-
-    float3   cov2D = Get2DCovariance(cov3D, posVS.xyz);
+    float3 cov2D = Get2DCovariance(LoadCov3D(row), (float3x3)worldView, posVS.xyz);
 
     float det    = cov2D.x * cov2D.z - cov2D.y * cov2D.y;
-    if (det <= 0.0f) { gRadius[id.x] = 0.0f; return; }
+    if (det <= 0.0f) { gRadius[o] = 0.0f; return; }
 
     float mid    = 0.5f * (cov2D.x + cov2D.z);
     float lambda = mid + sqrt(max(0.01f, mid*mid - det));
     float radius = ceil(3.0f * sqrt(lambda));
 
-    if (radius > 1024.0f) { gRadius[id.x] = 0.0f; return; }
+    if (radius > 1024.0f) { gRadius[o] = 0.0f; return; }
 
     if (posSS.x + radius < 0.0f || posSS.x - radius > (float)filmWidth ||
         posSS.y + radius < 0.0f || posSS.y - radius > (float)filmHeight)
     {
-        gRadius[id.x] = 0.0f;
+        gRadius[o] = 0.0f;
         return;
     }
 
     float3 invCov = float3(cov2D.z, -cov2D.y, cov2D.x) / det;
 
-    float3 color = ComputeSphericalHarmonics(id.x, posWS, cameraPos);
+    // World position only for the SH view direction
+    float4x4 worldMat = float4x4(im.w0, im.w1, im.w2, im.w3);
+    float3   posWS    = mul(float4(posOS, 1.0f), worldMat).xyz;
+    float3   color    = ComputeSphericalHarmonics(row, info, posWS, cameraPos);
 
-    gPositionSS[id.x]    = posSS;
-    gDepth[id.x]         = posCS.z / posCS.w;
+    gPositionSS[o]    = posSS;
+    gDepth[o]         = posCS.z / posCS.w;
 
     if (debugFixedRadius > 0) {
         float fr = (float)debugFixedRadius;
-        gRadius[id.x]        = fr;
-        gColor[id.x]         = color;
+        gRadius[o]        = fr;
+        gColor[o]         = color;
         float invR2 = 1.0f / (fr * fr * 0.1111f);
-        gCov2D_opacity[id.x] = float4(invR2, 0.0f, invR2, gOpacity[id.x]);
+        gCov2D_opacity[o] = float4(invR2, 0.0f, invR2, LoadOpacity(row));
     } else {
-        gRadius[id.x]        = radius;
-        gColor[id.x]         = color;
-        gCov2D_opacity[id.x] = float4(invCov, gOpacity[id.x]);
+        gRadius[o]        = radius;
+        gColor[o]         = color;
+        gCov2D_opacity[o] = float4(invCov, LoadOpacity(row));
     }
 }
@@ -1,14 +1,35 @@
 // Production render: instanced ellipse splat (4 vertices per splat).
 // VS reads sorted indices and per-splat preprocess outputs;
 // PS evaluates Gaussian alpha and tints selected splats.
+// The draw is indirect, one instance per entry of the sorted list, which
+// holds the drawn slots only (KeyGenKernel in radix_sort.hlsl): culled and
+// deleted splats never reach the VS.
 
-StructuredBuffer<float2> gPositionSS    : register(t0);
-StructuredBuffer<float>  gRadius        : register(t1);
-StructuredBuffer<float3> gColor         : register(t2);
-StructuredBuffer<float4> gCov2D_Opacity : register(t3);
-StructuredBuffer<float>  gDepth         : register(t4);
-StructuredBuffer<uint>   gSortedIndices : register(t5);
-StructuredBuffer<uint>   gMask          : register(t6);
+// Per-slot outputs and mask are paged (see PageLayout.h): slot i lives in
+// page i >> kPageShift at i & kPageMask; the merged slot space has 2 pages.
+static const uint kPageShift = 26;                  // PageLayout::kPageShift
+static const uint kPageMask  = (1u << kPageShift) - 1;
+
+StructuredBuffer<float2> gPositionSS[2]    : register(t0);
+StructuredBuffer<float>  gRadius[2]        : register(t2);
+StructuredBuffer<float3> gColor[2]         : register(t4);
+StructuredBuffer<float4> gCov2D_Opacity[2] : register(t6);
+StructuredBuffer<float>  gDepth[2]         : register(t8);
+StructuredBuffer<uint>   gMask[2]          : register(t10);
+StructuredBuffer<uint>   gSortedIndices    : register(t12);
+
+// Resource arrays take literal indices in SM 5.0
+#define SLOT_LOAD(T, name, col)                                                \
+    T name(uint i) {                                                           \
+        [branch] if ((i >> kPageShift) == 0) return col[0][i & kPageMask];     \
+        return col[1][i & kPageMask];                                          \
+    }
+SLOT_LOAD(float2, LoadPositionSS, gPositionSS)
+SLOT_LOAD(float,  LoadRadius,     gRadius)
+SLOT_LOAD(float3, LoadColor,      gColor)
+SLOT_LOAD(float4, LoadCov2D,      gCov2D_Opacity)
+SLOT_LOAD(float,  LoadDepth,      gDepth)
+SLOT_LOAD(uint,   LoadMask,       gMask)
 
 cbuffer CBRender : register(b0)
 {
@@ -31,18 +52,13 @@ PS_IN VS(uint cornerID : SV_VertexID, uint iid : SV_InstanceID)
 {
     PS_IN o = (PS_IN)0;
 
-    uint idx = gSortedIndices[iid];
-    float r  = gRadius[idx];
-
-    if (r <= 0.0f) { o.clipPos = float4(0, 0, -2, 1); return o; }
-
-    uint  m    = gMask[idx];
-    if (m & 2u) { o.clipPos = float4(0, 0, -2, 1); return o; }  // deleted
-
-    float2 spos  = gPositionSS[idx];
-    float3 col   = gColor[idx];
-    float4 cov4  = gCov2D_Opacity[idx];
-    float  depth = gDepth[idx];
+    uint   idx   = gSortedIndices[iid];
+    float  r     = LoadRadius(idx);
+    uint   m     = LoadMask(idx);
+    float2 spos  = LoadPositionSS(idx);
+    float3 col   = LoadColor(idx);
+    float4 cov4  = LoadCov2D(idx);
+    float  depth = LoadDepth(idx);
 
     float2 ndc = spos / gViewportSize * 2.0f - 1.0f;
 
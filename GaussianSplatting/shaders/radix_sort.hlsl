@@ -1,19 +1,112 @@
-// 4-pass 8-bit radix sort. Each pass compiled with a different define:
-//   KEYGEN_KERNEL  -> KeyGenKernel
-//   COUNT_KERNEL   -> CountKernel
-//   SCAN_KERNEL    -> ScanKernel
-//   SCATTER_KERNEL -> ScatterKernel
+// Onesweep radix sort of the drawn slots: up to 4 passes of 8 bits, each
+// one dispatch. Each stage compiled with a different define:
+//   KEYGEN_KERNEL      -> KeyGenKernel
+//   SORT_ARGS_KERNEL   -> SortArgsKernel
+//   GLOBAL_HIST_KERNEL -> GlobalHistKernel
+//   GLOBAL_SCAN_KERNEL -> GlobalScanKernel
+//   ONESWEEP_KERNEL    -> OnesweepKernel
+// and, for frames seeded with the last frame's order (SplatCoherence.h):
+//   COHERENCE_MARK_KERNEL     -> CoherenceMarkKernel
+//   COHERENCE_SEED_KERNEL     -> CoherenceSeedKernel
+//   COHERENCE_ENTRANTS_KERNEL -> CoherenceEntrantsKernel
+//   COHERENCE_ARGS_KERNEL     -> CoherenceArgsKernel
+//   COHERENCE_FIXUP_KERNEL    -> CoherenceFixupKernel
+//   COHERENCE_CHECK_KERNEL    -> CoherenceCheckKernel
+//   COHERENCE_MERGE_KERNEL    -> CoherenceMergeKernel
+//
+// KeyGen compacts: only slots with radius > 0 get a key, written to a dense
+// list in slot order (see SplatSort.h for the CPU reference). SortArgs
+// turns the kept count into the indirect arguments of the per-tile
+// dispatches and of the draw. GlobalHist counts the digits of all four
+// passes in one read of the keys and GlobalScan turns them into each
+// digit's first output entry per pass. Each Onesweep pass then sorts its
+// tile by the pass digit in groupshared memory with stable 1-bit splits,
+// finds the entries earlier tiles take per digit by decoupled lookback,
+// and scatters; the sort is stable, so splats of equal depth keep their
+// slot order from frame to frame.
+//
+// Key precision (gKeyBits, SplatSort::keyBits): at 32 the keys are the
+// inverted float depths and all four passes run. Below, KeyGen also takes
+// the depth range of the kept splats and GlobalHist replaces every key by
+// gKeyBits of view depth normalised over that range (SplatSort::
+// quantizeKeys), so the host runs only ceil(gKeyBits / 8) passes.
+//
+// Incremental sort (SortCoherence::incrementalSort is the CPU reference),
+// after KeyGen and GlobalHist as usual. Mark notes each kept slot's entry
+// in A (in keys B, by slot). Seed walks the last frame's sorted list and
+// compacts the slots still kept, in that order and with their new keys,
+// into C (survivors), noting their old rank (in vals B, by slot); Entrants
+// appends the kept slots that are not survivors behind them. Fixup sorts
+// the survivors' windows of TILE_SIZE entries, then the windows shifted by
+// half a tile, then the entrants as one window; Check flags any survivor
+// still out of order, as do more than kMaxEntrants entrants. Merge then
+// interleaves survivors and entrants back into A by binary search. If the
+// fix-up did not hold, CoherenceArgs gives Merge no groups and the
+// Onesweep passes run over A instead (an even count, so either way the
+// list ends in A).
+//
+// Decoupled lookback: a group takes the next tile from an atomic counter,
+// so every earlier tile belongs to a group that has started. It publishes
+// its own count (aggregate) in gTileState, then walks back over earlier
+// tiles, adding aggregates until it meets an inclusive prefix, and
+// publishes its own inclusive prefix. It waits only on groups that run.
+//
+// gSortArgs (raw, byte offsets):
+//   0   kept count
+//   4   DispatchIndirect: tiles, 1, 1
+//   16  DrawInstancedIndirect: 4 vertices, kept count instances, 0, 0
+//   32  DispatchIndirect: tiles of the last frame's list (Seed)
+//   44  DispatchIndirect: tiles of the survivors (Fixup, Check)
+//   56  DispatchIndirect: tiles of the kept count if the fix-up held (Merge)
+//   68  DispatchIndirect: tiles of the kept count if not (Onesweep)
+// gSortState (uint):
+//   [0, 1024)  digit counts, then first entries, of pass p at p * 256
+//   1024 + p   next tile of Onesweep pass p
+//   1028       next tile of KeyGen
+//   1029       largest FloatToSortKey(depth) kept (farthest), gKeyBits < 32
+//   1030       largest ~FloatToSortKey(depth) kept (nearest)
+//   1031       kept count of the last frame (CoherenceArgs, before the
+//              arguments are cleared)
+//   1032       next tile of Seed
+//   1033       survivors
+//   1034       entrants
+//   1035       nonzero if the fix-up did not hold
 
 #define SORT_GROUP_SIZE 256
-#define ITEMS_PER_THREAD 16
+#define ITEMS_PER_THREAD 8
 #define TILE_SIZE (SORT_GROUP_SIZE * ITEMS_PER_THREAD)
 #define RADIX_SIZE 256
 
+static const uint kTileCounters  = 4 * RADIX_SIZE;
+static const uint kKeyGenCounter = kTileCounters + 4;
+static const uint kDepthFar      = kKeyGenCounter + 1;
+static const uint kDepthNearInv  = kKeyGenCounter + 2;
+static const uint kPrevCount     = kKeyGenCounter + 3;
+static const uint kSeedCounter   = kKeyGenCounter + 4;
+static const uint kSurvivors     = kKeyGenCounter + 5;
+static const uint kEntrants      = kKeyGenCounter + 6;
+static const uint kUnsorted      = kKeyGenCounter + 7;
+static const uint kMaxEntrants   = TILE_SIZE;          // SortCoherence::kMaxEntrants
+
+// gTileState entries: flag in the top 2 bits, count below
+static const uint kFlagAggregate = 1u << 30;
+static const uint kFlagInclusive = 2u << 30;
+static const uint kFlagMask      = 3u << 30;
+static const uint kValueMask     = (1u << 30) - 1;
+
 cbuffer SortCB : register(b0) {
-    uint gNumElements;
-    uint gNumBlocks;
-    uint gShift;
-    uint gPadSort;
+    uint gNumElements;  // KeyGen: merged slot count
+    uint gTileBase;     // KeyGen: tiles taken by the earlier dispatches
+    uint gShift;        // Onesweep: 8 * gPass
+    uint gSlotBase;     // KeyGen: first slot of this dispatch's 2^23 batch
+    uint gRangeBase;    // KeyGen: this dispatch's ranges in gDispatchRanges
+    uint gRangeCount;
+    uint gThreadCount;
+    uint gPass;         // Onesweep: pass index; CoherenceArgs: stage;
+                        // CoherenceFixup: 0, 1 survivor rounds, 2 entrants
+    uint gKeyBits;      // KeyGen, GlobalHist: key precision, 32 = full float
+    uint3 padding;
+    float4 gDepthProj;  // GlobalHist: projection _33, _34, _43, _44
 };
 
 uint FloatToSortKey(float f) {
@@ -22,109 +115,571 @@ uint FloatToSortKey(float f) {
     return bits ^ mask;
 }
 
+float SortKeyToFloat(uint key) {
+    return asfloat((key & 0x80000000u) ? (key ^ 0x80000000u) : ~key);
+}
+
+#if defined(KEYGEN_KERNEL) || defined(GLOBAL_SCAN_KERNEL) || defined(ONESWEEP_KERNEL) || \
+    defined(COHERENCE_SEED_KERNEL)
+groupshared uint sScan[2][SORT_GROUP_SIZE];
+
+// Exclusive prefix sum of one value per thread over the group; `total` is
+// the sum of all. Every thread of the group must call it.
+uint GroupExclusiveScan(uint v, uint tid, out uint total) {
+    uint src = 0;
+    sScan[0][tid] = v;
+    GroupMemoryBarrierWithGroupSync();
+    [unroll]
+    for (uint off = 1; off < SORT_GROUP_SIZE; off <<= 1) {
+        uint x = sScan[src][tid];
+        if (tid >= off) x += sScan[src][tid - off];
+        sScan[src ^ 1][tid] = x;
+        src ^= 1;
+        GroupMemoryBarrierWithGroupSync();
+    }
+    uint inclusive = sScan[src][tid];
+    total = sScan[src][SORT_GROUP_SIZE - 1];
+    GroupMemoryBarrierWithGroupSync();   // sScan is free again
+    return inclusive - v;
+}
+#endif
+
+#if defined(KEYGEN_KERNEL) || defined(ONESWEEP_KERNEL) || defined(COHERENCE_SEED_KERNEL)
+globallycoherent RWStructuredBuffer<uint> gSortState : register(u2);
+globallycoherent RWStructuredBuffer<uint> gTileState : register(u3);
+
+// Publishes `count` for lane `lane` of `tile` and returns the sum of that
+// lane over the earlier tiles, by decoupled lookback (see the top)
+uint DecoupledLookback(uint tile, uint lane, uint lanes, uint count) {
+    uint unused;
+    uint idx = tile * lanes + lane;
+    if (tile == 0) {
+        InterlockedExchange(gTileState[idx], kFlagInclusive | count, unused);
+        return 0;
+    }
+    InterlockedExchange(gTileState[idx], kFlagAggregate | count, unused);
+
+    uint prefix = 0;
+    uint t = tile - 1;
+    [allow_uav_condition]
+    for (;;) {
+        uint s    = gTileState[t * lanes + lane];
+        uint flag = s & kFlagMask;
+        if (flag == 0) continue;              // not published yet
+        prefix += s & kValueMask;
+        if (flag == kFlagInclusive) break;
+        t--;
+    }
+    InterlockedExchange(gTileState[idx], kFlagInclusive | (prefix + count), unused);
+    return prefix;
+}
+#endif
+
 #ifdef KEYGEN_KERNEL
-StructuredBuffer<float>    gDepthIn   : register(t0);
-RWStructuredBuffer<uint>   gKeysOut   : register(u0);
-RWStructuredBuffer<uint>   gValsOut   : register(u1);
+// Runs over the slots preprocess ran over (gDispatchRanges, as in
+// merged_preprocess.hlsl), per 2^23 slots from gSlotBase; gDepthIn and
+// gRadiusIn are the output pages holding them (see PageLayout.h). Groups
+// take their tile of 256 threads in order, so the kept entries of the
+// earlier tiles come from the lookback and the list is in slot order.
+static const uint kPageMask = (1u << 26) - 1;       // PageLayout::kPageShift
+
+StructuredBuffer<float>    gDepthIn        : register(t0);
+StructuredBuffer<float>    gRadiusIn       : register(t1);
+StructuredBuffer<uint2>    gDispatchRanges : register(t2);
+RWStructuredBuffer<uint>   gKeysOut        : register(u0);
+RWStructuredBuffer<uint>   gValsOut        : register(u1);
+RWByteAddressBuffer        gSortArgs       : register(u4);
+
+groupshared uint sTile;
+groupshared uint sFirst;
+groupshared uint sDepthFar;
+groupshared uint sDepthNearInv;
+
+[numthreads(SORT_GROUP_SIZE, 1, 1)]
+void KeyGenKernel(uint3 tid : SV_GroupThreadID) {
+    if (tid.x == 0) {
+        uint t;
+        InterlockedAdd(gSortState[kKeyGenCounter], 1u, t);
+        sTile = t;
+        sDepthFar = 0;
+        sDepthNearInv = 0;
+    }
+    GroupMemoryBarrierWithGroupSync();
+    uint tile   = sTile;
+    uint thread = (tile - gTileBase) * SORT_GROUP_SIZE + tid.x;
+
+    // Slot of this thread, as the preprocess kernel found it
+    uint slot = 0xFFFFFFFFu;
+    if (thread < gThreadCount) {
+        uint lo = gRangeBase, hi = gRangeBase + gRangeCount;
+        while (hi - lo > 1) {
+            uint mid = (lo + hi) >> 1;
+            if (gDispatchRanges[mid].y <= thread) lo = mid; else hi = mid;
+        }
+        uint2 range = gDispatchRanges[lo];
+        slot = range.x + (thread - range.y);
+    }
+    bool keep = slot < gNumElements && gRadiusIn[slot & kPageMask] > 0.0f;
+    uint depthKey = keep ? FloatToSortKey(gDepthIn[slot & kPageMask]) : 0u;
+    if (keep && gKeyBits < 32) {
+        InterlockedMax(sDepthFar, depthKey);
+        InterlockedMax(sDepthNearInv, ~depthKey);
+    }
+
+    uint kept;
+    uint rank = GroupExclusiveScan(keep ? 1u : 0u, tid.x, kept);
+    if (tid.x == 0) {
+        sFirst = DecoupledLookback(tile, 0, 1, kept);
+        if (kept > 0) gSortArgs.InterlockedAdd(0, kept);
+        if (kept > 0 && gKeyBits < 32) {
+            InterlockedMax(gSortState[kDepthFar], sDepthFar);
+            InterlockedMax(gSortState[kDepthNearInv], sDepthNearInv);
+        }
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    if (keep) {
+        gKeysOut[sFirst + rank] = ~depthKey;
+        gValsOut[sFirst + rank] = slot;
+    }
+}
+#endif
+
+#ifdef SORT_ARGS_KERNEL
+RWByteAddressBuffer gSortArgs : register(u0);
+
+[numthreads(1, 1, 1)]
+void SortArgsKernel() {
+    uint n = gSortArgs.Load(0);
+    gSortArgs.Store3(4,  uint3((n + TILE_SIZE - 1) / TILE_SIZE, 1, 1));
+    gSortArgs.Store4(16, uint4(4, n, 0, 0));
+}
+#endif
+
+#ifdef GLOBAL_HIST_KERNEL
+ByteAddressBuffer          gSortArgs  : register(t1);
+RWStructuredBuffer<uint>   gSortState : register(u0);
+RWStructuredBuffer<uint>   gKeys      : register(u1);
+
+groupshared uint sHist[4 * RADIX_SIZE];
+
+// View z of an NDC depth, inverting the projection's z / w
+float ViewZ(float ndc) {
+    return (gDepthProj.z - ndc * gDepthProj.w) / (ndc * gDepthProj.y - gDepthProj.x);
+}
 
 [numthreads(SORT_GROUP_SIZE, 1, 1)]
-void KeyGenKernel(uint3 id : SV_DispatchThreadID) {
-    if (id.x >= gNumElements) return;
-    gKeysOut[id.x] = ~FloatToSortKey(gDepthIn[id.x]);
-    gValsOut[id.x] = id.x;
+void GlobalHistKernel(uint3 gid : SV_GroupID, uint3 tid : SV_GroupThreadID) {
+    for (uint d = tid.x; d < 4 * RADIX_SIZE; d += SORT_GROUP_SIZE) sHist[d] = 0;
+    GroupMemoryBarrierWithGroupSync();
+
+    // Quantisation over the kept depth range (SplatSort::quantizeKeys)
+    float zNear = ViewZ(SortKeyToFloat(~gSortState[kDepthNearInv]));
+    float zFar  = ViewZ(SortKeyToFloat(gSortState[kDepthFar]));
+    float scale = zFar != zNear ? 1.0f / (zFar - zNear) : 0.0f;
+    float steps = (float)(1u << gKeyBits);
+
+    uint n    = gSortArgs.Load(0);
+    uint base = gid.x * TILE_SIZE;
+    for (uint i = 0; i < ITEMS_PER_THREAD; i++) {
+        uint idx = base + tid.x + i * SORT_GROUP_SIZE;
+        if (idx < n) {
+            uint key = gKeys[idx];
+            if (gKeyBits < 32) {
+                float t = saturate((ViewZ(SortKeyToFloat(~key)) - zNear) * scale);
+                key = min((uint)((1.0f - t) * steps), (1u << gKeyBits) - 1);
+                gKeys[idx] = key;
+            }
+            [unroll]
+            for (uint p = 0; p < 4; p++)
+                InterlockedAdd(sHist[p * RADIX_SIZE + ((key >> (p * 8)) & 0xFFu)], 1u);
+        }
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    for (uint d2 = tid.x; d2 < 4 * RADIX_SIZE; d2 += SORT_GROUP_SIZE)
+        if (sHist[d2] > 0) InterlockedAdd(gSortState[d2], sHist[d2]);
+}
+#endif
+
+#ifdef GLOBAL_SCAN_KERNEL
+RWStructuredBuffer<uint> gSortState : register(u0);
+
+[numthreads(RADIX_SIZE, 1, 1)]
+void GlobalScanKernel(uint3 tid : SV_GroupThreadID) {
+    [unroll]
+    for (uint p = 0; p < 4; p++) {
+        uint total;
+        uint first = GroupExclusiveScan(gSortState[p * RADIX_SIZE + tid.x], tid.x, total);
+        gSortState[p * RADIX_SIZE + tid.x] = first;
+    }
 }
 #endif
 
-#ifdef COUNT_KERNEL
+#ifdef ONESWEEP_KERNEL
 StructuredBuffer<uint>     gKeysIn    : register(t0);
-RWStructuredBuffer<uint>   gBlockHist : register(u0);
+StructuredBuffer<uint>     gValsIn    : register(t1);
+ByteAddressBuffer          gSortArgs  : register(t2);
+RWStructuredBuffer<uint>   gKeysOut   : register(u0);
+RWStructuredBuffer<uint>   gValsOut   : register(u1);
 
+groupshared uint sKeys[TILE_SIZE];
+groupshared uint sVals[TILE_SIZE];
 groupshared uint sHist[RADIX_SIZE];
+groupshared uint sBase[RADIX_SIZE];
+groupshared uint sTile;
 
 [numthreads(SORT_GROUP_SIZE, 1, 1)]
-void CountKernel(uint3 gid : SV_GroupID, uint3 tid : SV_GroupThreadID) {
+void OnesweepKernel(uint3 tid : SV_GroupThreadID) {
+    if (tid.x == 0) {
+        uint t;
+        InterlockedAdd(gSortState[kTileCounters + gPass], 1u, t);
+        sTile = t;
+    }
     sHist[tid.x] = 0;
     GroupMemoryBarrierWithGroupSync();
 
+    uint tile  = sTile;
+    uint n     = gSortArgs.Load(0);
+    uint base  = tile * TILE_SIZE;
+    uint valid = min(TILE_SIZE, n - base);
+
+    // Coalesced loads; the slack of the last tile sorts last (all ones)
+    for (uint i = 0; i < ITEMS_PER_THREAD; i++) {
+        uint p = tid.x + i * SORT_GROUP_SIZE;
+        sKeys[p] = p < valid ? gKeysIn[base + p] : 0xFFFFFFFFu;
+        sVals[p] = p < valid ? gValsIn[base + p] : 0u;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // Stable sort of the tile by the pass digit: one split per bit, zeros
+    // first, each thread holding ITEMS_PER_THREAD consecutive entries
+    uint k[ITEMS_PER_THREAD], v[ITEMS_PER_THREAD];
+    [unroll]
+    for (uint j = 0; j < ITEMS_PER_THREAD; j++) {
+        k[j] = sKeys[tid.x * ITEMS_PER_THREAD + j];
+        v[j] = sVals[tid.x * ITEMS_PER_THREAD + j];
+    }
+    for (uint bit = gShift; bit < gShift + 8; bit++) {
+        uint zeros = 0;
+        [unroll]
+        for (uint j2 = 0; j2 < ITEMS_PER_THREAD; j2++) zeros += ((k[j2] >> bit) & 1u) ^ 1u;
+        uint totalZeros;
+        uint z = GroupExclusiveScan(zeros, tid.x, totalZeros);
+        uint o = totalZeros + tid.x * ITEMS_PER_THREAD - z;
+        [unroll]
+        for (uint j3 = 0; j3 < ITEMS_PER_THREAD; j3++) {
+            uint pos = ((k[j3] >> bit) & 1u) ? o++ : z++;
+            sKeys[pos] = k[j3];
+            sVals[pos] = v[j3];
+        }
+        GroupMemoryBarrierWithGroupSync();
+        [unroll]
+        for (uint j4 = 0; j4 < ITEMS_PER_THREAD; j4++) {
+            k[j4] = sKeys[tid.x * ITEMS_PER_THREAD + j4];
+            v[j4] = sVals[tid.x * ITEMS_PER_THREAD + j4];
+        }
+    }
+
+    // The tile's digit counts and each digit's first entry in the tile
+    for (uint i2 = 0; i2 < ITEMS_PER_THREAD; i2++) {
+        uint p = tid.x + i2 * SORT_GROUP_SIZE;
+        if (p < valid) InterlockedAdd(sHist[(sKeys[p] >> gShift) & 0xFFu], 1u);
+    }
+    GroupMemoryBarrierWithGroupSync();
+    uint count = sHist[tid.x];
+    uint tileTotal;
+    uint start = GroupExclusiveScan(count, tid.x, tileTotal);
+
+    // One thread per digit: entries of this digit in the earlier tiles
+    uint prefix = DecoupledLookback(tile, tid.x, RADIX_SIZE, count);
+    sBase[tid.x] = gSortState[gPass * RADIX_SIZE + tid.x] + prefix - start;
+    GroupMemoryBarrierWithGroupSync();
+
+    for (uint i3 = 0; i3 < ITEMS_PER_THREAD; i3++) {
+        uint p = tid.x + i3 * SORT_GROUP_SIZE;
+        if (p < valid) {
+            uint key = sKeys[p];
+            uint dst = sBase[(key >> gShift) & 0xFFu] + p;
+            gKeysOut[dst] = key;
+            gValsOut[dst] = sVals[p];
+        }
+    }
+}
+#endif
+
+#ifdef COHERENCE_MARK_KERNEL
+ByteAddressBuffer          gSortArgs : register(t0);
+StructuredBuffer<uint>     gValsIn   : register(t1);   // A
+RWStructuredBuffer<uint>   gEntryOut : register(u0);   // keys B, by slot
+
+[numthreads(SORT_GROUP_SIZE, 1, 1)]
+void CoherenceMarkKernel(uint3 gid : SV_GroupID, uint3 tid : SV_GroupThreadID) {
+    uint n    = gSortArgs.Load(0);
     uint base = gid.x * TILE_SIZE;
     for (uint i = 0; i < ITEMS_PER_THREAD; i++) {
         uint idx = base + tid.x + i * SORT_GROUP_SIZE;
-        if (idx < gNumElements) {
-            uint digit = (gKeysIn[idx] >> gShift) & 0xFFu;
-            InterlockedAdd(sHist[digit], 1u);
+        if (idx < n) gEntryOut[gValsIn[idx]] = idx;
+    }
+}
+#endif
+
+#ifdef COHERENCE_SEED_KERNEL
+// One tile of the last frame's list per group, taken in order so the
+// survivors of earlier tiles come from the lookback. An entry of keys B is
+// only trusted if A holds its slot there: the buffer is never cleared.
+StructuredBuffer<uint>     gKeysIn    : register(t0);  // A
+StructuredBuffer<uint>     gValsIn    : register(t1);  // A
+StructuredBuffer<uint>     gEntry     : register(t2);  // keys B, from Mark
+StructuredBuffer<uint>     gPrevOrder : register(t3);
+ByteAddressBuffer          gSortArgs  : register(t4);
+RWStructuredBuffer<uint>   gKeysOut   : register(u0);  // C
+RWStructuredBuffer<uint>   gValsOut   : register(u1);  // C
+RWStructuredBuffer<uint>   gRankOut   : register(u4);  // vals B, by slot
+
+groupshared uint sTile;
+groupshared uint sFirst;
+
+[numthreads(SORT_GROUP_SIZE, 1, 1)]
+void CoherenceSeedKernel(uint3 tid : SV_GroupThreadID) {
+    if (tid.x == 0) {
+        uint t;
+        InterlockedAdd(gSortState[kSeedCounter], 1u, t);
+        sTile = t;
+    }
+    GroupMemoryBarrierWithGroupSync();
+    uint tile      = sTile;
+    uint n         = gSortArgs.Load(0);
+    uint prevCount = gSortState[kPrevCount];
+
+    // ITEMS_PER_THREAD consecutive ranks per thread, so the scan keeps order
+    uint first = tile * TILE_SIZE + tid.x * ITEMS_PER_THREAD;
+    uint entry[ITEMS_PER_THREAD];
+    uint kept = 0;
+    [unroll]
+    for (uint j = 0; j < ITEMS_PER_THREAD; j++) {
+        entry[j] = 0xFFFFFFFFu;
+        uint r = first + j;
+        if (r < prevCount) {
+            uint slot = gPrevOrder[r];
+            uint e    = gEntry[slot];
+            if (e < n && gValsIn[e] == slot) {
+                entry[j] = e;
+                kept++;
+            }
         }
     }
+
+    uint total;
+    uint dst = GroupExclusiveScan(kept, tid.x, total);
+    if (tid.x == 0) {
+        sFirst = DecoupledLookback(tile, 0, 1, total);
+        if (total > 0) InterlockedAdd(gSortState[kSurvivors], total);
+    }
     GroupMemoryBarrierWithGroupSync();
 
-    gBlockHist[gid.x * RADIX_SIZE + tid.x] = sHist[tid.x];
+    dst += sFirst;
+    [unroll]
+    for (uint j2 = 0; j2 < ITEMS_PER_THREAD; j2++) {
+        if (entry[j2] != 0xFFFFFFFFu) {
+            uint slot = gValsIn[entry[j2]];
+            gKeysOut[dst] = gKeysIn[entry[j2]];
+            gValsOut[dst] = slot;
+            gRankOut[slot] = first + j2;
+            dst++;
+        }
+    }
 }
 #endif
 
-#ifdef SCAN_KERNEL
-RWStructuredBuffer<uint> gBlockHist : register(u0);
+#ifdef COHERENCE_ENTRANTS_KERNEL
+// A slot is a survivor iff Seed noted a rank for it that still names it
+StructuredBuffer<uint>     gKeysIn    : register(t0);  // A
+StructuredBuffer<uint>     gValsIn    : register(t1);  // A
+StructuredBuffer<uint>     gRank      : register(t2);  // vals B, from Seed
+StructuredBuffer<uint>     gPrevOrder : register(t3);
+ByteAddressBuffer          gSortArgs  : register(t4);
+RWStructuredBuffer<uint>   gKeysOut   : register(u0);  // C
+RWStructuredBuffer<uint>   gValsOut   : register(u1);  // C
+RWStructuredBuffer<uint>   gSortState : register(u2);
 
-groupshared uint sDigitTotal[RADIX_SIZE];
+[numthreads(SORT_GROUP_SIZE, 1, 1)]
+void CoherenceEntrantsKernel(uint3 gid : SV_GroupID, uint3 tid : SV_GroupThreadID) {
+    uint n         = gSortArgs.Load(0);
+    uint prevCount = gSortState[kPrevCount];
+    uint survivors = gSortState[kSurvivors];
+    uint base      = gid.x * TILE_SIZE;
+    for (uint i = 0; i < ITEMS_PER_THREAD; i++) {
+        uint idx = base + tid.x + i * SORT_GROUP_SIZE;
+        if (idx >= n) continue;
+        uint slot = gValsIn[idx];
+        uint r    = gRank[slot];
+        if (r < prevCount && gPrevOrder[r] == slot) continue;
 
-[numthreads(RADIX_SIZE, 1, 1)]
-void ScanKernel(uint3 tid : SV_GroupThreadID) {
-    uint digit = tid.x;
+        uint e;
+        InterlockedAdd(gSortState[kEntrants], 1u, e);
+        if (e < kMaxEntrants) {
+            gKeysOut[survivors + e] = gKeysIn[idx];
+            gValsOut[survivors + e] = slot;
+        }
+    }
+}
+#endif
 
-    uint total = 0;
-    for (uint b = 0; b < gNumBlocks; b++) {
-        uint count = gBlockHist[b * RADIX_SIZE + digit];
-        gBlockHist[b * RADIX_SIZE + digit] = total;
-        total += count;
+#ifdef COHERENCE_ARGS_KERNEL
+RWByteAddressBuffer        gSortArgs  : register(u0);
+RWStructuredBuffer<uint>   gSortState : register(u1);
+
+uint Tiles(uint n) { return (n + TILE_SIZE - 1) / TILE_SIZE; }
+
+// gPass 0: the last kept count, before gSortArgs is cleared; 1: before
+// Seed; 2: before Fixup; 3: after Check
+[numthreads(1, 1, 1)]
+void CoherenceArgsKernel() {
+    if (gPass == 0) {
+        gSortState[kPrevCount] = gSortArgs.Load(0);
+    } else if (gPass == 1) {
+        gSortArgs.Store3(32, uint3(Tiles(gSortState[kPrevCount]), 1, 1));
+    } else if (gPass == 2) {
+        gSortArgs.Store3(44, uint3(Tiles(gSortState[kSurvivors]), 1, 1));
+        if (gSortState[kEntrants] > kMaxEntrants) gSortState[kUnsorted] = 1;
+    } else {
+        uint tiles = Tiles(gSortArgs.Load(0));
+        bool held  = gSortState[kUnsorted] == 0;
+        gSortArgs.Store3(56, uint3(held ? tiles : 0, 1, 1));
+        gSortArgs.Store3(68, uint3(held ? 0 : tiles, 1, 1));
     }
+}
+#endif
 
-    sDigitTotal[digit] = total;
-    GroupMemoryBarrierWithGroupSync();
+#ifdef COHERENCE_FIXUP_KERNEL
+StructuredBuffer<uint>     gSortState : register(t0);
+RWStructuredBuffer<uint>   gKeys      : register(u0);  // C
+RWStructuredBuffer<uint>   gVals      : register(u1);  // C
+
+groupshared uint sKeys[TILE_SIZE];
+groupshared uint sTie[TILE_SIZE];
+groupshared uint sVals[TILE_SIZE];
 
-    if (digit == 0) {
-        uint sum = 0;
-        for (uint d = 0; d < RADIX_SIZE; d++) {
-            uint t = sDigitTotal[d];
-            sDigitTotal[d] = sum;
-            sum += t;
+// Bitonic sort of the tile in groupshared memory: keys ascending, equal
+// keys by sTie, sVals moved along
+void GroupBitonicSort(uint tid) {
+    for (uint k = 2; k <= TILE_SIZE; k <<= 1) {
+        for (uint j = k >> 1; j > 0; j >>= 1) {
+            [unroll]
+            for (uint q = 0; q < TILE_SIZE / 2 / SORT_GROUP_SIZE; q++) {
+                uint p = tid + q * SORT_GROUP_SIZE;
+                uint a = 2 * p - (p & (j - 1));
+                uint b = a + j;
+                uint ka = sKeys[a], kb = sKeys[b];
+                uint ta = sTie[a],  tb = sTie[b];
+                bool after = ka > kb || (ka == kb && ta > tb);
+                if (after == ((a & k) == 0)) {
+                    uint va = sVals[a];
+                    sKeys[a] = kb; sKeys[b] = ka;
+                    sTie[a]  = tb; sTie[b]  = ta;
+                    sVals[a] = sVals[b]; sVals[b] = va;
+                }
+            }
+            GroupMemoryBarrierWithGroupSync();
         }
     }
+}
+
+// Survivor windows keep equal keys in the order they came (the last
+// frame's); entrants, in slot order before, sort equal keys by slot
+[numthreads(SORT_GROUP_SIZE, 1, 1)]
+void CoherenceFixupKernel(uint3 gid : SV_GroupID, uint3 tid : SV_GroupThreadID) {
+    uint survivors = gSortState[kSurvivors];
+    uint base, valid;
+    if (gPass == 2) {
+        base  = survivors;
+        valid = min(gSortState[kEntrants], kMaxEntrants);
+    } else {
+        base  = gid.x * TILE_SIZE + gPass * (TILE_SIZE / 2);
+        valid = base < survivors ? min(TILE_SIZE, survivors - base) : 0;
+    }
+
+    for (uint i = 0; i < ITEMS_PER_THREAD; i++) {
+        uint p = tid.x + i * SORT_GROUP_SIZE;
+        uint v = p < valid ? gVals[base + p] : 0u;
+        sKeys[p] = p < valid ? gKeys[base + p] : 0xFFFFFFFFu;
+        sTie[p]  = p < valid ? (gPass == 2 ? v : p) : 0xFFFFFFFFu;
+        sVals[p] = v;
+    }
     GroupMemoryBarrierWithGroupSync();
 
-    uint digitOff = sDigitTotal[digit];
-    for (uint b2 = 0; b2 < gNumBlocks; b2++) {
-        gBlockHist[b2 * RADIX_SIZE + digit] += digitOff;
+    GroupBitonicSort(tid.x);
+
+    for (uint i2 = 0; i2 < ITEMS_PER_THREAD; i2++) {
+        uint p = tid.x + i2 * SORT_GROUP_SIZE;
+        if (p < valid) {
+            gKeys[base + p] = sKeys[p];
+            gVals[base + p] = sVals[p];
+        }
     }
 }
 #endif
 
-#ifdef SCATTER_KERNEL
-StructuredBuffer<uint>     gKeysIn     : register(t0);
-StructuredBuffer<uint>     gValsIn     : register(t1);
-StructuredBuffer<uint>     gBlockOff   : register(t2);
-RWStructuredBuffer<uint>   gKeysOut    : register(u0);
-RWStructuredBuffer<uint>   gValsOut    : register(u1);
+#ifdef COHERENCE_CHECK_KERNEL
+StructuredBuffer<uint>     gKeys      : register(t0);  // C
+RWStructuredBuffer<uint>   gSortState : register(u0);
 
-groupshared uint sLocalRank[RADIX_SIZE];
+groupshared uint sUnsorted;
 
 [numthreads(SORT_GROUP_SIZE, 1, 1)]
-void ScatterKernel(uint3 gid : SV_GroupID, uint3 tid : SV_GroupThreadID) {
-    sLocalRank[tid.x] = 0;
+void CoherenceCheckKernel(uint3 gid : SV_GroupID, uint3 tid : SV_GroupThreadID) {
+    if (tid.x == 0) sUnsorted = 0;
     GroupMemoryBarrierWithGroupSync();
 
-    uint base = gid.x * TILE_SIZE;
+    uint survivors = gSortState[kSurvivors];
+    uint base      = gid.x * TILE_SIZE;
     for (uint i = 0; i < ITEMS_PER_THREAD; i++) {
         uint idx = base + tid.x + i * SORT_GROUP_SIZE;
-        if (idx < gNumElements) {
-            uint key   = gKeysIn[idx];
-            uint val   = gValsIn[idx];
-            uint digit = (key >> gShift) & 0xFFu;
+        if (idx + 1 < survivors && gKeys[idx] > gKeys[idx + 1]) sUnsorted = 1;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    if (tid.x == 0 && sUnsorted) InterlockedOr(gSortState[kUnsorted], 1u);
+}
+#endif
 
-            uint rank;
-            InterlockedAdd(sLocalRank[digit], 1u, rank);
+#ifdef COHERENCE_MERGE_KERNEL
+// Each entry's place is its index in its own run plus the entries of the
+// other run before it: survivors go first among equal keys
+StructuredBuffer<uint>     gKeysIn    : register(t0);  // C
+StructuredBuffer<uint>     gValsIn    : register(t1);  // C
+StructuredBuffer<uint>     gSortState : register(t2);
+RWStructuredBuffer<uint>   gKeysOut   : register(u0);  // A
+RWStructuredBuffer<uint>   gValsOut   : register(u1);  // A
 
-            uint pos = gBlockOff[gid.x * RADIX_SIZE + digit] + rank;
-            gKeysOut[pos] = key;
-            gValsOut[pos] = val;
+[numthreads(SORT_GROUP_SIZE, 1, 1)]
+void CoherenceMergeKernel(uint3 gid : SV_GroupID, uint3 tid : SV_GroupThreadID) {
+    uint survivors = gSortState[kSurvivors];
+    uint entrants  = min(gSortState[kEntrants], kMaxEntrants);
+    uint base      = gid.x * TILE_SIZE;
+    for (uint i = 0; i < ITEMS_PER_THREAD; i++) {
+        uint idx = base + tid.x + i * SORT_GROUP_SIZE;
+        if (idx >= survivors + entrants) continue;
+        uint key = gKeysIn[idx];
+        uint lo = 0, hi, dst;
+        if (idx < survivors) {
+            hi = entrants;
+            while (lo < hi) {
+                uint mid = (lo + hi) >> 1;
+                if (gKeysIn[survivors + mid] < key) lo = mid + 1; else hi = mid;
+            }
+            dst = idx + lo;
+        } else {
+            hi = survivors;
+            while (lo < hi) {
+                uint mid = (lo + hi) >> 1;
+                if (gKeysIn[mid] <= key) lo = mid + 1; else hi = mid;
+            }
+            dst = (idx - survivors) + lo;
         }
+        gKeysOut[dst] = key;
+        gValsOut[dst] = gValsIn[idx];
     }
 }
 #endif
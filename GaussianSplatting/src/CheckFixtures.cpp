@@ -0,0 +1,1348 @@
+#include "CheckFixtures.h"
+#include "CopyPlan.h"
+#include "MappedFile.h"
+#include "PLYReader.h"
+#include "PageLayout.h"
+#include "ParallelFor.h"
+#include "RangeAllocator.h"
+#include "SplatBVH.h"
+#include "SplatCoherence.h"
+#include "SplatSort.h"
+#include "SplatCompact.h"
+#include "SplatKernels.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <sstream>
+
+const float CheckFixtures::kIdentity[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+
+// ===========================================================================
+// Synthetic files
+// ===========================================================================
+bool CheckFixtures::writeSyntheticPLY(const std::string& path, unsigned count, std::string& err,
+                                      const PLYEncoding& encoding) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) { err = "Cannot write: " + path; return false; }
+
+    const char* eol = encoding.ascii && encoding.crlf ? "\r\n" : "\n";
+    out << "ply" << eol << "format " << (encoding.ascii ? "ascii" : "binary_little_endian")
+        << " 1.0" << eol << "element vertex " << count << eol;
+    for (const char* n : { "x", "y", "z", "nx", "ny", "nz", "f_dc_0", "f_dc_1", "f_dc_2" })
+        out << "property float " << n << eol;
+    for (int j = 0; j < 45; j++) out << "property float f_rest_" << j << eol;
+    for (const char* n : { "opacity", "scale_0", "scale_1", "scale_2", "rot_0", "rot_1", "rot_2", "rot_3" })
+        out << "property float " << n << eol;
+    out << "end_header" << eol;
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> unit(-1.f, 1.f);
+    float row[62];                                  // kFloatsPerSplat + normals
+    char  text[62 * 16 + 2];
+    for (unsigned i = 0; i < count; i++) {
+        for (int k = 0; k < 3; k++)  row[k]      = unit(rng) * 10.f;        // position
+        for (int k = 3; k < 6; k++)  row[k]      = 0.f;                     // normal
+        for (int k = 6; k < 54; k++) row[k]      = unit(rng);               // SH
+        row[54] = unit(rng) * 8.f;                                          // opacity
+        for (int k = 55; k < 58; k++) row[k]     = unit(rng) * 3.f - 3.f;   // log scale
+        for (int k = 58; k < 62; k++) row[k]     = unit(rng);               // rotation
+        if (!encoding.ascii) {
+            out.write(reinterpret_cast<const char*>(row), sizeof(row));
+            continue;
+        }
+        // Shortest round-trip form, so both readers must reproduce `row`
+        char* p = text;
+        for (int k = 0; k < 62; k++) {
+            if (k) *p++ = ' ';
+            p = std::to_chars(p, text + sizeof(text), row[k]).ptr;
+        }
+        out.write(text, p - text);
+        if (i + 1 < count || encoding.finalNewline) out << eol;
+    }
+    if (!out) { err = "Write failed: " + path; return false; }
+    return true;
+}
+
+CheckFixtures::TempPLY::~TempPLY() {
+    if (m_path.empty()) return;
+    std::error_code ec;
+    std::filesystem::remove(m_path, ec);
+}
+
+bool CheckFixtures::TempPLY::write(const std::string& tag, unsigned count, std::string& err,
+                                   const PLYEncoding& encoding) {
+    std::error_code ec;
+    std::filesystem::path dir = std::filesystem::temp_directory_path(ec);
+    if (ec) { err = ec.message(); return false; }
+    m_path = (dir / (tag + "_synthetic.ply")).string();
+    return writeSyntheticPLY(m_path, count, err, encoding);
+}
+
+bool CheckFixtures::readInput(const std::string& file, unsigned synthetic, const std::string& tag,
+                              GaussianData& data, std::string& err, PLYReadControl* control) {
+    TempPLY     temp;
+    std::string path = file;
+    if (path.empty()) {
+        if (!temp.write(tag, synthetic, err)) return false;
+        path = temp.path();
+    }
+    if (!PLYReader::read(path, data, err, control)) {
+        err = "read failed (" + path + "): " + err;
+        return false;
+    }
+    if (data.empty()) {
+        err = "read failed (" + path + "): no splats";
+        return false;
+    }
+    return true;
+}
+
+// ===========================================================================
+// PLY readers
+// ===========================================================================
+// Whether two reads hold the same rows, bit for bit
+static bool sameColumns(const GaussianData& a, const GaussianData& b) {
+    auto same = [](const std::vector<float>& x, const std::vector<float>& y) {
+        return x.size() == y.size() && std::memcmp(x.data(), y.data(), x.size() * sizeof(float)) == 0;
+    };
+    return a.shDegree == b.shDegree && same(a.positions, b.positions) && same(a.scaleWS, b.scaleWS) &&
+           same(a.rotationWS, b.rotationWS) && same(a.opacityRaw, b.opacityRaw) &&
+           same(a.shCoeffs, b.shCoeffs);
+}
+
+static double bestOf(int iterations, const std::function<bool()>& fn) {
+    double best = -1.0;
+    for (int i = 0; i < iterations; i++) {
+        auto t0 = std::chrono::steady_clock::now();
+        if (!fn()) return -1.0;
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        if (best < 0.0 || ms < best) best = ms;
+    }
+    return best;
+}
+
+// Largest |a - b| over the float columns; infinite when the shapes differ
+static float maxColumnDiff(const GaussianData& a, const GaussianData& b) {
+    auto diff = [](const std::vector<float>& x, const std::vector<float>& y) {
+        if (x.size() != y.size()) return INFINITY;
+        float m = 0.f;
+        for (size_t i = 0; i < x.size(); i++) m = std::max(m, std::fabs(x[i] - y[i]));
+        return m;
+    };
+    if (a.shDegree != b.shDegree) return INFINITY;
+    return std::max({ diff(a.positions, b.positions), diff(a.scaleWS, b.scaleWS),
+                      diff(a.rotationWS, b.rotationWS), diff(a.opacityRaw, b.opacityRaw),
+                      diff(a.shCoeffs, b.shCoeffs) });
+}
+
+const float CheckFixtures::kStreamReadTolerance = 1e-5f;
+
+CheckFixtures::CheckReport CheckFixtures::benchPLY(const std::string& path, int iterations) {
+    CheckReport report;
+    iterations = std::max(1, iterations);
+
+    GaussianData streamData, genericData, mappedData;
+    PLYReadControl generic;
+    generic.genericDecode = true;
+
+    std::string err;
+    double streamMs  = bestOf(iterations, [&] { return PLYReader::readStream(path, streamData, err); });
+    double genericMs = streamMs < 0.0 ? -1.0
+                     : bestOf(iterations, [&] { return PLYReader::read(path, genericData, err, &generic); });
+    double mappedMs  = genericMs < 0.0 ? -1.0
+                     : bestOf(iterations, [&] { return PLYReader::read(path, mappedData, err); });
+    if (mappedMs < 0.0) {
+        report.error = "read failed: " + err;
+        return report;
+    }
+
+    // Best time to copy the whole file out of a warm mapping: the bandwidth
+    // ceiling for any binary decoder. The first pass only faults the pages in.
+    MappedFile file;
+    if (!file.open(path, err)) {
+        report.error = err;
+        return report;
+    }
+    std::vector<char> dst(file.size());
+    std::memcpy(dst.data(), file.data(), file.size());
+    double memcpyMs = bestOf(iterations, [&] { std::memcpy(dst.data(), file.data(), file.size()); return true; });
+    file.close();
+
+    if (streamData.count() != mappedData.count() || genericData.count() != mappedData.count()) {
+        report.error = "splat count mismatch (stream=" + std::to_string(streamData.count()) +
+                       ", generic=" + std::to_string(genericData.count()) +
+                       ", mapped=" + std::to_string(mappedData.count()) + ")";
+        return report;
+    }
+
+    // The generic and fixed-layout decoders run the same conversions, so
+    // must agree bit for bit; the stream reader only up to rounding
+    const float streamDiff  = maxColumnDiff(streamData, mappedData);
+    const bool  genericSame = sameColumns(genericData, mappedData);
+
+    double speedup  = mappedMs > 0.0 ? streamMs / mappedMs : 0.0;
+    double ofMemcpy = mappedMs > 0.0 ? 100.0 * memcpyMs / mappedMs : 0.0;
+    std::ostringstream line;
+    line << mappedData.count() << " splats, best of " << iterations << ": stream " << streamMs
+         << " ms, mapped generic " << genericMs << " ms, mapped " << mappedMs << " ms (x" << speedup
+         << "), memcpy " << memcpyMs << " ms (mapped at " << ofMemcpy << "% of memcpy)";
+    report.lines.push_back(line.str());
+    line.str("");
+    line << "generic and fixed-layout decoders " << (genericSame ? "identical" : "DIFFER")
+         << ", stream against mapped max |diff| " << streamDiff << " (tolerance " << kStreamReadTolerance << ")";
+    report.lines.push_back(line.str());
+
+    if (!genericSame)
+        report.error = "the fixed-layout decoder differs from the generic decoder.";
+    else if (!(streamDiff <= kStreamReadTolerance))
+        report.error = "the stream reader differs from the mapped reader beyond the tolerance.";
+    report.value = speedup;
+    return report;
+}
+
+CheckFixtures::CheckReport CheckFixtures::asciiCheck(unsigned count, int iterations) {
+    CheckReport report;
+    iterations = std::max(1, iterations);
+
+    // The same rows in binary: what both ASCII readers must reproduce
+    TempPLY     binary;
+    GaussianData reference;
+    std::string err;
+    if (!binary.write("gsAsciiCheck_binary", count, err) || !PLYReader::read(binary.path(), reference, err)) {
+        report.error = "binary reference: " + err;
+        return report;
+    }
+
+    struct Variant { const char* name; PLYEncoding encoding; };
+    const Variant variants[] = {
+        { "LF",                      { true, false, true  } },
+        { "CRLF",                    { true, true,  true  } },
+        { "LF, no final newline",    { true, false, false } },
+        { "CRLF, no final newline",  { true, true,  false } },
+    };
+    double streamMs = -1.0, mappedMs = -1.0;
+    for (const Variant& v : variants) {
+        TempPLY ascii;
+        if (!ascii.write(std::string("gsAsciiCheck_") + (v.encoding.crlf ? "crlf" : "lf") +
+                             (v.encoding.finalNewline ? "" : "_open"), count, err, v.encoding)) {
+            report.error = err;
+            return report;
+        }
+
+        // Segments the mapped reader cuts the body into, and how many of
+        // the nominal cuts land inside a row rather than on a line end
+        std::ifstream in(ascii.path(), std::ios::binary);
+        std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        size_t body = text.find("end_header");
+        body = body == std::string::npos ? text.size() : text.find('\n', body) + 1;
+        const size_t bytes    = text.size() - body;
+        const size_t segments = std::max<size_t>(1, (bytes + PLYReader::kAsciiSegmentBytes - 1) /
+                                                        PLYReader::kAsciiSegmentBytes);
+        size_t split = 0;
+        for (size_t s = 1; s < segments; s++)
+            split += text[body + s * PLYReader::kAsciiSegmentBytes - 1] != '\n';
+        if (segments < 2 || split == 0) {
+            report.error = std::string(v.name) + ": " + std::to_string(count) +
+                           " rows do not reach past a segment boundary; use more rows.";
+            return report;
+        }
+
+        GaussianData mapped, stream;
+        double m = bestOf(iterations, [&] { return PLYReader::read(ascii.path(), mapped, err); });
+        double t = m < 0.0 ? -1.0 : bestOf(iterations, [&] { return PLYReader::readStream(ascii.path(), stream, err); });
+        if (t < 0.0) {
+            report.error = std::string(v.name) + ": read failed: " + err;
+            return report;
+        }
+        if (!sameColumns(mapped, stream) || !sameColumns(mapped, reference)) {
+            report.error = std::string(v.name) + ": the mapped ASCII read differs from " +
+                           (sameColumns(mapped, stream) ? "the binary file" : "the stream reader") + ".";
+            return report;
+        }
+        if (streamMs < 0.0) { streamMs = t; mappedMs = m; }
+
+        std::ostringstream line;
+        line << v.name << ": " << count << " rows in " << segments << " segments (" << split
+             << " cut inside a row); mapped, stream and binary reads identical";
+        report.lines.push_back(line.str());
+    }
+
+    // Seconds per 10M rows at these rates
+    double speedup = mappedMs > 0.0 ? streamMs / mappedMs : 0.0;
+    double per10M  = 1e4 / std::max(1u, count);
+    std::ostringstream line;
+    line << "LF, best of " << iterations << ": stream " << streamMs << " ms, mapped " << mappedMs << " ms (x"
+         << speedup << ", " << gs::WorkerCount() << " threads); 10M rows: stream ~" << streamMs * per10M
+         << " s, mapped ~" << mappedMs * per10M << " s";
+    report.lines.push_back(line.str());
+    report.value = speedup;
+    return report;
+}
+
+// ===========================================================================
+// Compact storage
+// ===========================================================================
+CheckFixtures::CheckReport CheckFixtures::compactCheck(const GaussianData& reference, int iterations) {
+    CheckReport report;
+    iterations = std::max(1, iterations);
+
+    // Best of `iterations` for the encode and for a full decode
+    GaussianData packed;
+    std::vector<float> pos(reference.positions.size()), scale(reference.scaleWS.size());
+    std::vector<float> rot(reference.rotationWS.size()), sh(reference.shCoeffs.size());
+    double encodeMs = -1.0, decodeMs = -1.0;
+    for (int i = 0; i < iterations; i++) {
+        auto t0 = std::chrono::steady_clock::now();
+        packed = SplatCompact::encode(reference);
+        auto t1 = std::chrono::steady_clock::now();
+        SplatCompact::decodeRows(packed, 0, packed.count(), pos.data(), scale.data(), rot.data(), sh.data());
+        auto t2 = std::chrono::steady_clock::now();
+        double enc = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        double dec = std::chrono::duration<double, std::milli>(t2 - t1).count();
+        if (encodeMs < 0.0 || enc < encodeMs) encodeMs = enc;
+        if (decodeMs < 0.0 || dec < decodeMs) decodeMs = dec;
+    }
+
+    SplatCompact::ErrorReport r = SplatCompact::measureError(reference, packed);
+    float worst = std::max({ r.positionRatio, r.logScaleRatio, r.rotationRatio, r.shRatio });
+
+    const double mb = 1.0 / (1024.0 * 1024.0);
+    const double n  = (double)reference.count();
+    std::ostringstream line;
+    line << reference.count() << " splats, SH degree " << reference.shDegree << ": "
+         << reference.memoryBytes() * mb << " MB -> " << packed.memoryBytes() * mb << " MB ("
+         << reference.memoryBytes() / n << " -> " << packed.memoryBytes() / n << " B/splat), best of "
+         << iterations << ": encode " << encodeMs << " ms, decode " << decodeMs << " ms";
+    report.lines.push_back(line.str());
+    line.str("");
+    line << "max error (/bound): position " << r.position << " (" << r.positionRatio << "), log-scale "
+         << r.logScale << " (" << r.logScaleRatio << "), rotation " << r.rotation << " (" << r.rotationRatio
+         << "), SH " << r.sh << " (" << r.shRatio << ")";
+    report.lines.push_back(line.str());
+    if (r.violations) {
+        report.error = std::to_string(r.violations) + " elements outside their error bound.";
+        return report;
+    }
+
+    // The last chunk's splats all on its first splat: a zero-extent box,
+    // whose positions must come back exactly
+    const size_t first = (reference.count() - 1) / kCompactChunkSplats * kCompactChunkSplats;
+    GaussianData point = reference;
+    for (size_t i = first + 1; i < point.count(); i++)
+        std::memcpy(&point.positions[i * 3], &point.positions[first * 3], 3 * sizeof(float));
+    GaussianData pointPacked = SplatCompact::encode(point);
+    SplatCompact::ErrorReport p = SplatCompact::measureError(point, pointPacked);
+    const CompactChunk& chunk = pointPacked.packed.chunks.back();
+    float chunkError = 0.f;
+    for (size_t i = first; i < point.count(); i++) {
+        float q[3];
+        pointPacked.position(i, q);
+        for (int k = 0; k < 3; k++) chunkError = std::max(chunkError, std::fabs(q[k] - point.positions[i * 3 + k]));
+    }
+    line.str("");
+    line << "single-point chunk (rows " << first << "-" << point.count() - 1 << ", step " << chunk.step[0]
+         << " " << chunk.step[1] << " " << chunk.step[2] << "): max position error " << chunkError;
+    report.lines.push_back(line.str());
+    if (p.violations || chunkError != 0.f) {
+        report.error = "single-point chunk: " + std::to_string(p.violations) +
+                       " elements outside their error bound, position error " + std::to_string(chunkError) + ".";
+        return report;
+    }
+    report.value = std::max({ worst, p.positionRatio, p.logScaleRatio, p.rotationRatio, p.shRatio });
+    return report;
+}
+
+// ===========================================================================
+// Kernel benchmark
+// ===========================================================================
+CheckFixtures::CheckReport CheckFixtures::benchKernels(size_t count, int iterations) {
+    CheckReport report;
+    iterations = std::max(1, iterations);
+    const size_t N   = std::max<size_t>(1, count);
+    const size_t shF = (size_t)kSHCoeffsPerSplat * 3;
+
+    // Same value ranges as writeSyntheticPLY
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> unit(-1.f, 1.f);
+    std::vector<float> pos(N * 3), logScale(N * 3), rot(N * 4), opacity(N), sh(N * shF);
+    for (float& v : pos)      v = unit(rng) * 10.f;
+    for (float& v : logScale) v = unit(rng) * 3.f - 3.f;
+    for (float& v : rot)      v = unit(rng);
+    for (float& v : opacity)  v = unit(rng) * 8.f;
+    for (float& v : sh)       v = unit(rng);
+
+    struct Result {
+        std::vector<float> scale, rot, rgba;
+        float bmin[3], bmax[3];
+        double finalizeMs = -1.0, colorMs = -1.0;
+    };
+    auto run = [&](gs::SimdLevel level, Result& r) {
+        r.rgba.resize(N * 4);
+        for (int i = 0; i < iterations; i++) {
+            r.scale = logScale;          // finalize works in place
+            r.rot   = rot;
+            for (int k = 0; k < 3; k++) { r.bmin[k] = 1e30f; r.bmax[k] = -1e30f; }
+            auto t0 = std::chrono::steady_clock::now();
+            gs::FinalizeRows(pos.data(), r.scale.data(), r.rot.data(), N, r.bmin, r.bmax, level);
+            auto t1 = std::chrono::steady_clock::now();
+            gs::DisplayColors(sh.data(), shF, opacity.data(), N, r.rgba.data(), level);
+            auto t2 = std::chrono::steady_clock::now();
+            double f = std::chrono::duration<double, std::milli>(t1 - t0).count();
+            double c = std::chrono::duration<double, std::milli>(t2 - t1).count();
+            if (r.finalizeMs < 0.0 || f < r.finalizeMs) r.finalizeMs = f;
+            if (r.colorMs    < 0.0 || c < r.colorMs)    r.colorMs    = c;
+        }
+    };
+
+    gs::SimdLevel simd = gs::DetectedSimd();
+    Result scalar, vec;
+    run(gs::SimdLevel::Scalar, scalar);
+    run(simd, vec);
+
+    bool identical =
+        std::memcmp(scalar.scale.data(), vec.scale.data(), scalar.scale.size() * sizeof(float)) == 0 &&
+        std::memcmp(scalar.rot.data(),   vec.rot.data(),   scalar.rot.size()   * sizeof(float)) == 0 &&
+        std::memcmp(scalar.rgba.data(),  vec.rgba.data(),  scalar.rgba.size()  * sizeof(float)) == 0 &&
+        std::memcmp(scalar.bmin, vec.bmin, sizeof(vec.bmin)) == 0 &&
+        std::memcmp(scalar.bmax, vec.bmax, sizeof(vec.bmax)) == 0;
+
+    // Relative error against double precision
+    double expErr = 0.0, sigErr = 0.0;
+    for (size_t i = 0; i < N * 3; i++) {
+        double ref = std::exp((double)logScale[i]);
+        expErr = std::max(expErr, std::fabs(vec.scale[i] - ref) / ref);
+    }
+    for (size_t i = 0; i < N; i++) {
+        double ref = 1.0 / (1.0 + std::exp(-(double)opacity[i]));
+        sigErr = std::max(sigErr, std::fabs(vec.rgba[i * 4 + 3] - ref) / ref);
+    }
+
+    double msplat  = 1e-3 * (double)N;     // splats per ms -> Msplats/s
+    double speedup = vec.finalizeMs > 0.0 ? scalar.finalizeMs / vec.finalizeMs : 0.0;
+    std::ostringstream line;
+    line << N << " splats, best of " << iterations << ", 1 thread, " << gs::SimdName(simd)
+         << " vs scalar (active: " << gs::SimdName(gs::ActiveSimd()) << ")";
+    report.lines.push_back(line.str());
+    line.str("");
+    line << "finalize: scalar " << scalar.finalizeMs << " ms, " << gs::SimdName(simd) << " "
+         << vec.finalizeMs << " ms (x" << speedup << ", " << msplat / vec.finalizeMs << " Msplats/s)";
+    report.lines.push_back(line.str());
+    line.str("");
+    line << "colours:  scalar " << scalar.colorMs << " ms, " << gs::SimdName(simd) << " " << vec.colorMs
+         << " ms (x" << (vec.colorMs > 0.0 ? scalar.colorMs / vec.colorMs : 0.0) << ")";
+    report.lines.push_back(line.str());
+    line.str("");
+    line << "max rel. error: exp " << expErr << " (bound " << gs::kExpMaxRelError << "), sigmoid " << sigErr
+         << " (bound " << gs::kSigmoidMaxRelError << ")" << (identical ? ", scalar and SIMD identical" : "");
+    report.lines.push_back(line.str());
+
+    if (!identical)
+        report.error = "scalar and SIMD kernels disagree.";
+    else if (expErr > gs::kExpMaxRelError || sigErr > gs::kSigmoidMaxRelError)
+        report.error = "exp/sigmoid error above the documented bound.";
+    report.value = speedup;
+    return report;
+}
+
+// ===========================================================================
+// Cameras
+// ===========================================================================
+float CheckFixtures::boxRadius(const float bmin[3], const float bmax[3]) {
+    float r = 0.f;
+    for (int k = 0; k < 3; k++) r += 0.25f * (bmax[k] - bmin[k]) * (bmax[k] - bmin[k]);
+    return std::max(std::sqrt(r), 1e-3f);
+}
+
+// 1920x1080, 45 degree vertical FOV, and the D3D right-handed projection
+static void setLens(PreprocessCamera& cam, float farDist) {
+    cam.filmWidth     = 1920;
+    cam.filmHeight    = 1080;
+    cam.tanHalfFov[1] = std::tan(0.5f * 0.785398f);
+    cam.tanHalfFov[0] = cam.tanHalfFov[1] * cam.filmWidth / cam.filmHeight;
+
+    float zn = 0.1f, zf = farDist;
+    cam.projMat[0]  = 1.f / cam.tanHalfFov[0];
+    cam.projMat[5]  = 1.f / cam.tanHalfFov[1];
+    cam.projMat[10] = zf / (zn - zf);
+    cam.projMat[11] = -1.f;
+    cam.projMat[14] = zn * zf / (zn - zf);
+}
+
+PreprocessCamera CheckFixtures::frameBox(const float bmin[3], const float bmax[3]) {
+    PreprocessCamera cam;
+    const float r    = boxRadius(bmin, bmax);
+    const float dist = r / std::tan(0.5f * 0.785398f) + r;
+    setLens(cam, dist + 2.f * r);
+    for (int k = 0; k < 3; k++) cam.cameraPos[k] = 0.5f * (bmin[k] + bmax[k]);
+    cam.cameraPos[2] += dist;
+
+    // Row vectors: view translates by -cameraPos
+    for (int k = 0; k < 4; k++) cam.viewMat[k * 5] = 1.f;
+    for (int k = 0; k < 3; k++) cam.viewMat[12 + k] = -cam.cameraPos[k];
+    return cam;
+}
+
+PreprocessCamera CheckFixtures::lookFrom(const float eye[3], const float dir[3], float farDist) {
+    PreprocessCamera cam;
+    setLens(cam, std::max(farDist, 1.f));
+    std::memcpy(cam.cameraPos, eye, sizeof(cam.cameraPos));
+
+    // View axes: right, up, back (the view looks down -z)
+    float back[3] = { -dir[0], -dir[1], -dir[2] };
+    float up[3]   = { 0.f, 1.f, 0.f };
+    if (std::fabs(back[1]) > 0.99f) { up[1] = 0.f; up[2] = 1.f; }
+    float right[3] = { up[1] * back[2] - up[2] * back[1], up[2] * back[0] - up[0] * back[2],
+                       up[0] * back[1] - up[1] * back[0] };
+    float len = std::sqrt(right[0] * right[0] + right[1] * right[1] + right[2] * right[2]);
+    for (float& v : right) v /= len;
+    up[0] = back[1] * right[2] - back[2] * right[1];
+    up[1] = back[2] * right[0] - back[0] * right[2];
+    up[2] = back[0] * right[1] - back[1] * right[0];
+    const float* axes[3] = { right, up, back };
+    for (int j = 0; j < 3; j++) {
+        for (int k = 0; k < 3; k++) cam.viewMat[k * 4 + j] = axes[j][k];
+        cam.viewMat[12 + j] = -(eye[0] * axes[j][0] + eye[1] * axes[j][1] + eye[2] * axes[j][2]);
+    }
+    cam.viewMat[15] = 1.f;
+    return cam;
+}
+
+CheckFixtures::RandomCameras::RandomCameras(const float bmin[3], const float bmax[3], unsigned seed)
+    : m_rng(seed)
+{
+    for (int k = 0; k < 3; k++) {
+        m_centre[k] = 0.5f * (bmin[k] + bmax[k]);
+        m_ext[k]    = std::max(bmax[k] - bmin[k], 1e-3f);
+        m_diag     += m_ext[k] * m_ext[k];
+    }
+    m_diag = std::sqrt(m_diag);
+}
+
+PreprocessCamera CheckFixtures::RandomCameras::next() {
+    float eye[3], dir[3], len = 0.f;
+    for (int k = 0; k < 3; k++) {
+        eye[k] = m_centre[k] + 0.75f * m_ext[k] * m_uni(m_rng);
+        dir[k] = m_gauss(m_rng);
+        len   += dir[k] * dir[k];
+    }
+    len = std::max(std::sqrt(len), 1e-6f);
+    for (float& v : dir) v /= len;
+    return lookFrom(eye, dir, 2.f * m_diag);
+}
+
+// ===========================================================================
+// Preprocess check
+// ===========================================================================
+void CheckFixtures::preprocessCheck(const GaussianData& data, int iterations,
+                                    PreprocessLayoutResult results[2]) {
+    const float a = 0.523599f, sc = 1.5f;
+    const float worldMat[16] = {
+        sc * std::cos(a), 0.f, -sc * std::sin(a), 0.f,
+        0.f,              sc,  0.f,               0.f,
+        sc * std::sin(a), 0.f, sc * std::cos(a),  0.f,
+        1.f,              2.f, 3.f,               1.f,
+    };
+    float bmin[3], bmax[3];
+    for (int k = 0; k < 3; k++) {
+        float c = 0.5f * (data.bboxMin[k] + data.bboxMax[k]);
+        float h = 0.5f * (data.bboxMax[k] - data.bboxMin[k]);
+        float w = worldMat[12 + k];
+        for (int j = 0; j < 3; j++) w += c * worldMat[j * 4 + k];
+        bmin[k] = w - sc * h;
+        bmax[k] = w + sc * h;
+    }
+    const PreprocessCamera cam = frameBox(bmin, bmax);
+
+    const size_t n = data.count();
+    std::vector<uint32_t> mask(n, 0u);
+    for (size_t i = 0; i < n; i += 97) mask[i] = 2u;
+
+    const GaussianData  packed    = SplatCompact::encode(data);
+    const GaussianData* layouts[] = { &data, &packed };
+    for (int l = 0; l < 2; l++) {
+        const GaussianData& gd = *layouts[l];
+        PreprocessOutputs single, reference;
+        double bestMs = -1.0;
+        for (int i = 0; i < std::max(1, iterations); i++) {
+            auto t0 = std::chrono::steady_clock::now();
+            SplatPreprocess::run(gd, n, worldMat, cam, mask.data(), single);
+            double ms = std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - t0).count();
+            if (bestMs < 0.0 || ms < bestMs) bestMs = ms;
+        }
+        SplatPreprocess::run(gd, n, worldMat, cam, mask.data(), reference,
+                             SplatPreprocess::Precision::Double);
+
+        results[l].compact    = gd.compact();
+        results[l].bestMs     = bestMs;
+        results[l].comparison = SplatPreprocess::compare(reference, single, n);
+    }
+}
+
+std::string CheckFixtures::describe(const PreprocessComparison& c) {
+    std::ostringstream s;
+    s << c.compared << " drawn by both, " << c.culledBoth << " culled by both, " << c.cullMismatch
+      << " by one only; max diff position " << c.positionPx << " px, depth " << c.depth
+      << ", radius " << c.radius << " px, colour " << c.color << ", cov2D " << c.cov2D
+      << " (worst " << c.worstRatio << " of the tolerance)";
+    return s.str();
+}
+
+// ===========================================================================
+// Pool check
+// ===========================================================================
+CheckFixtures::CheckReport CheckFixtures::poolCheck(int operations, unsigned seed) {
+    CheckReport report;
+    operations = std::max(1, operations);
+
+    // Model: owner of every unit (-1 = free) and the live ranges
+    RangeAllocator alloc(4096);
+    std::vector<int> owner(alloc.capacity(), -1);
+    std::vector<std::pair<uint32_t, uint32_t>> live;   // offset, size
+    std::mt19937 rng(seed);
+    size_t failures = 0;
+    int    id = 0;
+
+    auto largestModelRun = [&]() {
+        uint32_t run = 0, best = 0;
+        for (int o : owner) { run = o < 0 ? run + 1 : 0; best = std::max(best, run); }
+        return best;
+    };
+
+    auto t0 = std::chrono::steady_clock::now();
+    int step = 0;
+    for (; step < operations && failures == 0; step++) {
+        // Allocations and frees are equally likely, so the live set drifts
+        // up and down and the pool both fragments and grows; sizes are fixed
+        // rather than a share of the capacity, which would grow it without
+        // bound
+        if (rng() % 2 == 0 || live.empty()) {
+            uint32_t size = 1 + rng() % 256;
+            uint32_t offset = alloc.allocate(size);
+            if (offset == RangeAllocator::kInvalid) {
+                if (largestModelRun() >= size) failures++;     // missed fit
+                uint32_t cap = RangeAllocator::grownCapacity(alloc.capacity(), alloc.capacityToFit(size));
+                alloc.grow(cap);
+                owner.resize(alloc.capacity(), -1);
+                offset = alloc.allocate(size);
+                if (offset == RangeAllocator::kInvalid) { failures++; break; }
+            }
+            for (uint32_t u = offset; u < offset + size; u++) {
+                if (owner[u] >= 0) failures++;                 // overlap
+                owner[u] = id;
+            }
+            live.emplace_back(offset, size);
+            id++;
+        } else {
+            size_t k = rng() % live.size();
+            auto [offset, size] = live[k];
+            if (alloc.free(offset) != size) failures++;
+            std::fill(owner.begin() + offset, owner.begin() + offset + size, -1);
+            live[k] = live.back();
+            live.pop_back();
+        }
+        if (!alloc.validate()) failures++;
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+    uint32_t modelUsed = (uint32_t)std::count_if(owner.begin(), owner.end(), [](int o) { return o >= 0; });
+    if (modelUsed != alloc.used()) failures++;
+
+    // Copy plans: fill every live range from a source of its own, in rows of
+    // 1-4 elements as the SH column is laid out, split across two frames as
+    // a streaming load would be (the halves must merge into one copy). Run
+    // the plan with memcpy and compare the destination with the sources.
+    const uint32_t kStride = 4;
+    CopyPlan plan;
+    std::vector<std::vector<uint8_t>> sources;
+    std::vector<uint64_t> sourceBytes, copiedBytes;
+    size_t expectedCopies = 0;
+    for (const auto& [offset, size] : live) {
+        uint32_t perRow = 1 + rng() % 4;
+        uint32_t rows   = size / perRow;
+        uint32_t split  = (uint32_t)(rng() % (rows + 1));
+        uint32_t src    = (uint32_t)sources.size();
+        std::vector<uint8_t> bytes((size_t)size * kStride);
+        for (size_t b = 0; b < bytes.size(); b++) bytes[b] = (uint8_t)(src * 131 + b * 7 + 1);
+        sourceBytes.push_back(bytes.size());
+        copiedBytes.push_back((uint64_t)rows * perRow * kStride);
+        sources.push_back(std::move(bytes));
+        plan.addRows(src, 0, kStride, perRow, offset, 0, split);
+        plan.addRows(src, 0, kStride, perRow, offset, split, rows);
+        expectedCopies += rows > 0;
+    }
+    std::vector<uint8_t> dest((size_t)alloc.capacity() * kStride, 0);
+    std::string error;
+    if (plan.copies().size() != expectedCopies) failures++;
+    if (!plan.validate(sourceBytes, { dest.size() }, &error)) {
+        report.error = "valid copy plan rejected: " + error + "; ";
+        failures++;
+    } else {
+        for (const BufferCopy& c : plan.copies())
+            std::memcpy(&dest[c.dstOffset], &sources[c.source][c.srcOffset], c.bytes);
+        for (size_t r = 0; r < live.size(); r++)
+            if (copiedBytes[r] &&
+                std::memcmp(&dest[(size_t)live[r].first * kStride], sources[r].data(), copiedBytes[r]) != 0)
+                failures++;
+    }
+
+    // Plans that must be rejected: reading past a source, writing past the
+    // destination, two copies onto the same bytes, an unknown buffer
+    {
+        CopyPlan bad;
+        bad.add(0, 0, 8, 0, 16);
+        if (bad.validate({ 16 }, { 64 })) failures++;
+        bad.clear();
+        bad.add(0, 0, 0, 56, 16);
+        if (bad.validate({ 16 }, { 64 })) failures++;
+        bad.clear();
+        bad.add(0, 0, 0, 0, 16);
+        bad.add(1, 0, 0, 12, 16);
+        if (bad.validate({ 16, 16 }, { 64 })) failures++;
+        bad.clear();
+        bad.add(0, 1, 0, 0, 16);
+        if (bad.validate({ 16 }, { 64 })) failures++;
+    }
+
+    std::ostringstream line;
+    line << step << " steps in " << ms << " ms: capacity " << alloc.capacity() << ", " << alloc.used()
+         << " used in " << alloc.rangeCount() << " ranges, " << alloc.freeCount()
+         << " free ranges (largest " << alloc.largestFree() << ")";
+    report.lines.push_back(line.str());
+    line.str("");
+    line << "copy plan: " << plan.copies().size() << " copies, " << (plan.totalBytes() >> 10) << " KB";
+    report.lines.push_back(line.str());
+
+    if (failures)
+        report.error += std::to_string(failures) + " failures (seed " + std::to_string(seed) + ").";
+    report.value = step;
+    return report;
+}
+
+// ===========================================================================
+// Page check
+// ===========================================================================
+CheckFixtures::CheckReport CheckFixtures::pageCheck(int iterations, unsigned seed) {
+    CheckReport report;
+    iterations = std::max(1, iterations);
+
+    std::mt19937_64 rng(seed);
+    auto below = [&](uint64_t n) { return n ? rng() % n : 0; };
+    size_t failures = 0, checks = 0;
+
+    // Byte size of every page of a column of `elements`
+    auto pageBytes = [](const PageLayout& l, uint64_t elements) {
+        std::vector<uint64_t> bytes(l.pageCount(elements));
+        for (uint32_t p = 0; p < bytes.size(); p++)
+            bytes[p] = (uint64_t)l.elementsInPage(elements, p) * l.stride();
+        return bytes;
+    };
+
+    // Simulated columns at full size: the strides of the pool, dataset and
+    // output columns, in row-sized and SH-sized layouts
+    auto t0 = std::chrono::steady_clock::now();
+    const uint32_t strides[] = { 4, 8, 12, 16, 24 };
+    for (uint32_t stride : strides) {
+        for (uint32_t maxPages : { PageLayout::kMaxRowPages, PageLayout::kMaxSHPages }) {
+            PageLayout l(stride, maxPages);
+            if (l.pageBytes() > PageLayout::kMaxPageBytes || l.pageElements() > PageLayout::kMaxPageElements)
+                failures++;
+
+            uint64_t total = 0;
+            uint64_t elements = l.maxElements() - below(l.pageElements());
+            for (uint32_t p = 0; p < l.pageCount(elements); p++) total += l.elementsInPage(elements, p);
+            if (total != elements || !l.fits(elements) || l.fits(l.maxElements() + 1)) failures++;
+
+            for (int it = 0; it < iterations && failures == 0; it++, checks++) {
+                uint64_t count = 1 + below(std::min<uint64_t>(elements, 3 * l.pageElements()));
+                uint64_t first = below(elements - count + 1);
+
+                uint64_t next = first;
+                for (const PageLayout::Piece& piece : l.split(first, count)) {
+                    if (first + piece.offset != next || l.pageOf(next) != piece.page ||
+                        l.localOf(next) != piece.local || piece.count == 0 ||
+                        piece.local + (uint64_t)piece.count > l.pageElements())
+                        failures++;
+                    next += piece.count;
+                }
+                if (next != first + count) failures++;
+
+                // Into a second column at another offset, as a dataset's
+                // rows go into its pool block
+                uint64_t dstElements = elements;
+                uint64_t dstFirst    = below(dstElements - count + 1);
+                CopyPlan plan;
+                plan.addPaged(l, 0, first, l, 0, dstFirst, count);
+                std::string error;
+                if (plan.totalBytes() != count * stride ||
+                    !plan.validate(pageBytes(l, elements), pageBytes(l, dstElements), &error)) {
+                    report.error += "stride " + std::to_string(stride) + ", " + std::to_string(first) +
+                                    " + " + std::to_string(count) + ": " + error + "; ";
+                    failures++;
+                }
+            }
+        }
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+    // 100M splats at SH degree 3 fit in either storage: one element per
+    // splat in the row columns, 16 float3 groups or 24 uints of fp16 pairs
+    // per splat in the SH column, at element indices a shader uint holds
+    struct Column { const char* name; uint32_t stride, maxPages, perSplat; };
+    const uint64_t kSplats = 100000000;
+    const Column columns[] = {
+        { "float rows",   12, PageLayout::kMaxRowPages, 1 },
+        { "compact rows",  8, PageLayout::kMaxRowPages, 1 },
+        { "float SH",     12, PageLayout::kMaxSHPages,  (uint32_t)shCoeffsForDegree(3) },
+        { "compact SH",    4, PageLayout::kMaxSHPages,  (uint32_t)compactSHHalfs(3) / 2 },
+    };
+    std::ostringstream line;
+    line << kSplats / 1000000 << "M splats at SH degree 3:";
+    for (const Column& c : columns) {
+        PageLayout l(c.stride, c.maxPages);
+        uint64_t elements = kSplats * c.perSplat;
+        if (!l.fits(elements) || l.maxElements() > (1ull << 32)) {
+            report.error += std::string(c.name) + ": " + std::to_string(elements) + " elements do not fit " +
+                            std::to_string(l.maxElements()) + "; ";
+            failures++;
+        }
+        line << (&c == columns ? " " : ", ") << c.name << " " << l.pageCount(elements) << "/" << c.maxPages
+             << " pages";
+    }
+    report.lines.push_back(line.str());
+
+    // Real copies on small pages, with different page sizes on each side
+    size_t copies = 0;
+    for (int it = 0; it < std::max(1, iterations / 20) && failures == 0; it++) {
+        uint32_t   stride = strides[below(std::size(strides))];
+        PageLayout src(stride, 64, 2 + (uint32_t)below(4));
+        PageLayout dst(stride, 64, 2 + (uint32_t)below(4));
+        uint64_t   srcElements = 1 + below(src.maxElements());
+        uint64_t   dstElements = 1 + below(dst.maxElements());
+        uint64_t   count       = 1 + below(std::min(srcElements, dstElements));
+        uint64_t   srcFirst    = below(srcElements - count + 1);
+        uint64_t   dstFirst    = below(dstElements - count + 1);
+
+        std::vector<std::vector<uint8_t>> srcPages, dstPages;
+        for (uint64_t b : pageBytes(src, srcElements)) srcPages.emplace_back(b);
+        for (uint64_t b : pageBytes(dst, dstElements)) dstPages.emplace_back(b, 0);
+        auto srcByte = [&](uint64_t e, uint32_t k) { return (uint8_t)(e * 31 + k * 7 + 1); };
+        for (uint64_t e = 0; e < srcElements; e++)
+            for (uint32_t k = 0; k < stride; k++)
+                srcPages[src.pageOf(e)][(uint64_t)src.localOf(e) * stride + k] = srcByte(e, k);
+
+        CopyPlan plan;
+        plan.addPaged(src, 0, srcFirst, dst, 0, dstFirst, count);
+        std::vector<uint64_t> srcBytes = pageBytes(src, srcElements), dstBytes = pageBytes(dst, dstElements);
+        std::string error;
+        if (!plan.validate(srcBytes, dstBytes, &error)) {
+            report.error += "valid paged plan rejected: " + error + "; ";
+            failures++;
+            break;
+        }
+        for (const BufferCopy& c : plan.copies())
+            std::memcpy(&dstPages[c.dest][c.dstOffset], &srcPages[c.source][c.srcOffset], c.bytes);
+        copies += plan.copies().size();
+
+        for (uint64_t e = 0; e < dstElements; e++) {
+            bool     inRange = e >= dstFirst && e < dstFirst + count;
+            uint64_t from    = srcFirst + (e - dstFirst);
+            for (uint32_t k = 0; k < stride; k++) {
+                uint8_t want = inRange ? srcByte(from, k) : 0;
+                if (dstPages[dst.pageOf(e)][(uint64_t)dst.localOf(e) * stride + k] != want) failures++;
+            }
+        }
+    }
+
+    line.str("");
+    line << checks << " ranges in " << ms << " ms; small-page copies: " << copies << " page copies checked";
+    report.lines.push_back(line.str());
+    if (failures)
+        report.error += std::to_string(failures) + " failures (seed " + std::to_string(seed) + ").";
+    report.value = (double)checks;
+    return report;
+}
+
+// ===========================================================================
+// Sort check
+// ===========================================================================
+CheckFixtures::CheckReport CheckFixtures::sortCheck(const GaussianData& data, int iterations) {
+    CheckReport report;
+    iterations = std::max(1, iterations);
+    const size_t N = data.count();
+
+    // Framed, then moved sideways until the left screen edge runs through
+    // the bbox at 70% of its width, so only part of it is on screen
+    PreprocessCamera cam = frameBox(data.bboxMin, data.bboxMax);
+    const float dist  = cam.cameraPos[2] - 0.5f * (data.bboxMin[2] + data.bboxMax[2]);
+    const float shift = dist * cam.tanHalfFov[0] + 0.2f * (data.bboxMax[0] - data.bboxMin[0]);
+    cam.cameraPos[0] += shift;
+    cam.viewMat[12]  -= shift;
+    PreprocessOutputs out;
+    SplatPreprocess::run(data, N, kIdentity, cam, nullptr, out);
+
+    // Compaction against a plain filter, both sorts against a stable sort
+    std::vector<uint32_t> keys, slots, refKeys, refSlots;
+    SplatSort::compact(out.radius.data(), out.depth.data(), N, keys, slots);
+    for (size_t i = 0; i < N; i++) {
+        if (!(out.radius[i] > 0.f)) continue;
+        refKeys.push_back(SplatSort::depthKey(out.depth[i]));
+        refSlots.push_back((uint32_t)i);
+    }
+    if (keys != refKeys || slots != refSlots) {
+        report.error = "compaction differs from a plain filter of the drawn splats.";
+        return report;
+    }
+    std::vector<uint32_t> order(refSlots.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = (uint32_t)i;
+    std::stable_sort(order.begin(), order.end(),
+                     [&](uint32_t a, uint32_t b) { return refKeys[a] < refKeys[b]; });
+    std::vector<uint32_t> radixKeys = keys, radixSlots = slots;
+    SplatSort::onesweep(keys, slots);
+    SplatSort::radixSort(radixKeys, radixSlots);
+    for (size_t i = 0; i < order.size(); i++) {
+        if (keys[i] != refKeys[order[i]] || slots[i] != refSlots[order[i]] ||
+            radixKeys[i] != keys[i] || radixSlots[i] != slots[i]) {
+            report.error = "radix sort differs from a stable sort of the keys.";
+            return report;
+        }
+    }
+    const size_t kept = slots.size();
+
+    // Best of `iterations`: every slot keyed and sorted (culled ones too, as
+    // before compaction) against the drawn ones compacted and sorted
+    double fullMs = -1.0, compactMs = -1.0;
+    for (int i = 0; i < iterations; i++) {
+        auto t0 = std::chrono::steady_clock::now();
+        keys.resize(N);
+        slots.resize(N);
+        for (size_t r = 0; r < N; r++) {
+            keys[r]  = SplatSort::depthKey(out.depth[r]);
+            slots[r] = (uint32_t)r;
+        }
+        SplatSort::onesweep(keys, slots);
+        auto t1 = std::chrono::steady_clock::now();
+        SplatSort::compact(out.radius.data(), out.depth.data(), N, keys, slots);
+        SplatSort::onesweep(keys, slots);
+        auto t2 = std::chrono::steady_clock::now();
+        double f = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        double c = std::chrono::duration<double, std::milli>(t2 - t1).count();
+        if (fullMs    < 0.0 || f < fullMs)    fullMs    = f;
+        if (compactMs < 0.0 || c < compactMs) compactMs = c;
+    }
+    double speedup = compactMs > 0.0 ? fullMs / compactMs : 0.0;
+
+    std::ostringstream line;
+    line << N << " splats, " << kept << " drawn (" << 100.0 * kept / N
+         << "%); compaction and radix sort match the reference";
+    report.lines.push_back(line.str());
+    line.str("");
+    line << "best of " << iterations << ": key and sort all " << fullMs << " ms, compact and sort the drawn "
+         << compactMs << " ms (x" << speedup << ")";
+    report.lines.push_back(line.str());
+    report.value = speedup;
+    return report;
+}
+
+// ===========================================================================
+// Cull check
+// ===========================================================================
+CheckFixtures::CheckReport CheckFixtures::cullCheck(const GaussianData& data, SplatOrder order, int iterations) {
+    CheckReport report;
+    iterations = std::max(1, iterations);
+    const size_t N = data.count();
+    GaussianData sorted = SplatReorder::reorder(data, order);
+
+    struct Layout {
+        const char*         name;
+        const GaussianData* data;
+        SplatBVH            bvh;
+        double              buildMs = 0.0, cullMs = 0.0;
+        size_t              kept = 0, tested = 0, ranges = 0;
+        float               maxScreenPx = 0.f;
+    };
+    Layout layouts[2] = { { "file", &data }, { SplatReorder::name(order), &sorted } };
+    for (Layout& l : layouts) {
+        auto t0 = std::chrono::steady_clock::now();
+        l.bvh.build(*l.data, N);
+        l.buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    }
+
+    // Cameras anywhere in the bbox grown by half, looking any way
+    RandomCameras randomCameras(data.bboxMin, data.bboxMax);
+
+    size_t drawn = 0;
+    PreprocessOutputs out;
+    std::vector<SplatBVH::Range> ranges;
+    std::vector<uint8_t> covered(N);
+    for (int it = 0; it < iterations; it++) {
+        PreprocessCamera cam = randomCameras.next();
+        PreprocessInstance mats(kIdentity, cam.viewMat);
+        CullFrustum frustum(mats.worldView, cam.projMat, cam.tanHalfFov,
+                            (float)cam.filmWidth, (float)cam.filmHeight);
+
+        for (Layout& l : layouts) {
+            ranges.clear();
+            auto t0 = std::chrono::steady_clock::now();
+            l.tested += l.bvh.cull(frustum, (uint32_t)N, ranges);
+            l.cullMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            l.ranges += ranges.size();
+
+            std::fill(covered.begin(), covered.end(), (uint8_t)0);
+            for (const SplatBVH::Range& r : ranges) {
+                std::fill(covered.begin() + r.first, covered.begin() + r.first + r.count, (uint8_t)1);
+                l.kept       += r.count;
+                l.maxScreenPx = std::max(l.maxScreenPx, r.screenPx);
+            }
+            SplatPreprocess::run(*l.data, N, kIdentity, cam, nullptr, out);
+            size_t missed = 0, frameDrawn = 0;
+            for (size_t i = 0; i < N; i++) {
+                if (out.radius[i] <= 0.f) continue;
+                frameDrawn++;
+                if (!covered[i]) missed++;
+            }
+            if (missed) {
+                report.error = "camera " + std::to_string(it) + ", " + l.name + " order: " +
+                               std::to_string(missed) + " drawn splats outside the kept ranges.";
+                return report;
+            }
+            if (l.data == &sorted) drawn += frameDrawn;
+        }
+    }
+
+    const double total = (double)N * iterations;
+    for (const Layout& l : layouts) {
+        std::ostringstream line;
+        line << l.name << " order: " << l.bvh.nodeCount() << " nodes (" << l.bvh.memoryBytes() / 1024
+             << " KB) built in " << l.buildMs << " ms; per camera " << l.cullMs / iterations << " ms, "
+             << (double)l.tested / iterations << " nodes tested, " << (double)l.ranges / iterations
+             << " ranges, " << 100.0 * l.kept / total << "% of the splats kept (largest range ~"
+             << l.maxScreenPx << " px)";
+        report.lines.push_back(line.str());
+    }
+    const size_t kept = layouts[1].kept;
+    std::ostringstream line;
+    line << N << " splats, " << iterations << " cameras: " << 100.0 * drawn / total << "% drawn, "
+         << 100.0 * kept / total << "% preprocessed in " << SplatReorder::name(order)
+         << " order, no drawn splat culled";
+    report.lines.push_back(line.str());
+    report.value = kept > 0 ? total / (double)kept : 0.0;
+    return report;
+}
+
+// ===========================================================================
+// Sort benchmark
+// ===========================================================================
+CheckFixtures::CheckReport CheckFixtures::benchSort(size_t count, int iterations) {
+    CheckReport report;
+    iterations = std::max(1, iterations);
+    const size_t N = std::max<size_t>(1, count);
+
+    // Key distributions: random bits, depth keys of a perspective depth
+    // range, few distinct keys, one key, and presorted either way
+    static const char* kNames[] = { "uniform", "depth", "few", "equal", "sorted", "reversed" };
+    const int numDists = (int)(sizeof(kNames) / sizeof(kNames[0]));
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> viewZ(1.f, 100.f);
+
+    double logSum = 0.0;
+    for (int dist = 0; dist < numDists; dist++) {
+        std::vector<uint32_t> keys(N), values(N);
+        for (size_t i = 0; i < N; i++) {
+            switch (dist) {
+            case 0: keys[i] = (uint32_t)rng(); break;
+            case 1: keys[i] = SplatSort::depthKey(1.01f - 1.01f / viewZ(rng)); break;
+            case 2: keys[i] = (uint32_t)(rng() % 16) * 0x10001u; break;
+            case 3: keys[i] = 0x3F800000u; break;
+            case 4: keys[i] = (uint32_t)i; break;
+            default: keys[i] = (uint32_t)(N - i); break;
+            }
+            values[i] = (uint32_t)i;
+        }
+
+        // Order and stability: both sorts against std::stable_sort
+        std::vector<uint32_t> order(N);
+        for (size_t i = 0; i < N; i++) order[i] = (uint32_t)i;
+        std::stable_sort(order.begin(), order.end(),
+                         [&](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+        std::vector<uint32_t> osKeys = keys, osVals = values, rsKeys = keys, rsVals = values;
+        SplatSort::onesweep(osKeys, osVals);
+        SplatSort::radixSort(rsKeys, rsVals);
+        for (size_t i = 0; i < N; i++) {
+            if (osVals[i] != order[i] || rsVals[i] != order[i] ||
+                osKeys[i] != keys[order[i]] || rsKeys[i] != keys[order[i]]) {
+                report.error = std::string(kNames[dist]) +
+                               " keys sort differently from std::stable_sort at entry " + std::to_string(i) + ".";
+                return report;
+            }
+        }
+
+        // Best of `iterations` for each sort, from the same input
+        double onesweepMs = -1.0, radixMs = -1.0, stdMs = -1.0;
+        for (int it = 0; it < iterations; it++) {
+            osKeys = keys; osVals = values;
+            auto t0 = std::chrono::steady_clock::now();
+            SplatSort::onesweep(osKeys, osVals);
+            auto t1 = std::chrono::steady_clock::now();
+            rsKeys = keys; rsVals = values;
+            auto t2 = std::chrono::steady_clock::now();
+            SplatSort::radixSort(rsKeys, rsVals);
+            auto t3 = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < N; i++) order[i] = (uint32_t)i;
+            auto t4 = std::chrono::steady_clock::now();
+            std::stable_sort(order.begin(), order.end(),
+                             [&](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+            auto t5 = std::chrono::steady_clock::now();
+            double o = std::chrono::duration<double, std::milli>(t1 - t0).count();
+            double r = std::chrono::duration<double, std::milli>(t3 - t2).count();
+            double s = std::chrono::duration<double, std::milli>(t5 - t4).count();
+            if (onesweepMs < 0.0 || o < onesweepMs) onesweepMs = o;
+            if (radixMs    < 0.0 || r < radixMs)    radixMs    = r;
+            if (stdMs      < 0.0 || s < stdMs)      stdMs      = s;
+        }
+        double speedup = onesweepMs > 0.0 ? radixMs / onesweepMs : 1.0;
+        logSum += std::log(std::max(speedup, 1e-9));
+
+        std::ostringstream line;
+        line << kNames[dist] << ": onesweep " << onesweepMs << " ms, radix " << radixMs
+             << " ms, std::stable_sort " << stdMs << " ms (x" << speedup << " over radix)";
+        report.lines.push_back(line.str());
+    }
+    double mean = std::exp(logSum / numDists);
+    std::ostringstream line;
+    line << N << " keys, best of " << iterations << ": all distributions sort stably; onesweep x" << mean
+         << " over radix (geometric mean)";
+    report.lines.push_back(line.str());
+    report.value = mean;
+    return report;
+}
+
+// ===========================================================================
+// Sort precision
+// ===========================================================================
+CheckFixtures::SortPrecision::SortPrecision(int views)
+    : m_views(std::max(1, views)), m_inversions(kNumBits, 0), m_sortMs(kNumBits, 0.0) {}
+
+// Pairs drawn out of depth order whose footprints overlap, in a draw list
+// sorted by quantised keys: only splats sharing a key can be inverted, so
+// each run of equal keys is swept along x for overlapping circles.
+// `fullKey` is the depthKey of every slot.
+static size_t countInversions(const std::vector<uint32_t>& keys, const std::vector<uint32_t>& slots,
+                              const std::vector<uint32_t>& fullKey, const PreprocessOutputs& out) {
+    struct Entry { float minX, x, y, r; uint32_t order, key; };
+    std::vector<Entry> run;
+    size_t inversions = 0;
+    for (size_t begin = 0, end = 0; begin < keys.size(); begin = end) {
+        for (end = begin + 1; end < keys.size() && keys[end] == keys[begin]; end++) {}
+        if (end - begin < 2) continue;
+
+        run.clear();
+        for (size_t i = begin; i < end; i++) {
+            uint32_t s = slots[i];
+            float x = out.positionSS[s * 2], y = out.positionSS[s * 2 + 1], r = out.radius[s];
+            run.push_back({ x - r, x, y, r, (uint32_t)i, fullKey[s] });
+        }
+        std::sort(run.begin(), run.end(), [](const Entry& a, const Entry& b) { return a.minX < b.minX; });
+        for (size_t a = 0; a < run.size(); a++) {
+            const Entry& ea = run[a];
+            for (size_t b = a + 1; b < run.size() && run[b].minX < ea.x + ea.r; b++) {
+                const Entry& eb = run[b];
+                float dx = eb.x - ea.x, dy = eb.y - ea.y, rr = ea.r + eb.r;
+                if (dx * dx + dy * dy >= rr * rr) continue;
+                // Ascending full keys is far to near; the earlier one drawn
+                // must not be the nearer
+                const Entry& first  = ea.order < eb.order ? ea : eb;
+                const Entry& second = ea.order < eb.order ? eb : ea;
+                inversions += first.key > second.key;
+            }
+        }
+    }
+    return inversions;
+}
+
+void CheckFixtures::SortPrecision::addScene(const std::string& name, const GaussianData& data) {
+    const size_t N = data.count();
+
+    // The framing view, then cameras anywhere in the bbox grown by half
+    // looking any way, as cullCheck
+    RandomCameras randomCameras(data.bboxMin, data.bboxMax);
+
+    size_t sceneDrawn = 0;
+    std::vector<size_t> sceneInversions(kNumBits, 0);
+    PreprocessOutputs out;
+    std::vector<uint32_t> fullKeys, slots, fullKey(N), keys, sorted;
+    for (int v = 0; v < m_views; v++) {
+        PreprocessCamera cam = v == 0 ? frameBox(data.bboxMin, data.bboxMax) : randomCameras.next();
+        SplatPreprocess::run(data, N, kIdentity, cam, nullptr, out);
+        SplatSort::compact(out.radius.data(), out.depth.data(), N, fullKeys, slots);
+        for (size_t i = 0; i < slots.size(); i++) fullKey[slots[i]] = fullKeys[i];
+        sceneDrawn += slots.size();
+
+        for (int b = 0; b < kNumBits; b++) {
+            keys   = fullKeys;
+            sorted = slots;
+            auto t0 = std::chrono::steady_clock::now();
+            SplatSort::quantizeKeys(keys, kBits[b], cam.projMat);
+            SplatSort::onesweep(keys, sorted, SplatSort::passCount(kBits[b]));
+            m_sortMs[b] += std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - t0).count();
+            size_t inv = countInversions(keys, sorted, fullKey, out);
+            sceneInversions[b] += inv;
+            m_inversions[b]    += inv;
+        }
+    }
+    m_drawn += sceneDrawn;
+
+    std::ostringstream line;
+    line << name << ": " << N << " splats, " << sceneDrawn << " drawn over " << m_views << " views; inversions";
+    for (int b = 0; b < kNumBits - 1; b++) line << " " << kBits[b] << "-bit " << sceneInversions[b];
+    m_report.lines.push_back(line.str());
+}
+
+CheckFixtures::CheckReport CheckFixtures::SortPrecision::finish() {
+    // Per precision over every scene and view: overlapping pairs drawn out
+    // of order, per 1000 drawn splats, and the quantise + sort time
+    CheckReport report = m_report;
+    for (int b = 0; b < kNumBits; b++) {
+        double perK    = m_drawn > 0 ? 1000.0 * m_inversions[b] / m_drawn : 0.0;
+        double speedup = m_sortMs[b] > 0.0 ? m_sortMs[kNumBits - 1] / m_sortMs[b] : 0.0;
+        std::ostringstream line;
+        line << kBits[b] << "-bit keys, " << SplatSort::passCount(kBits[b]) << " passes: " << m_inversions[b]
+             << " inversions (" << perK << " per 1000 drawn), sort " << m_sortMs[b] << " ms (x" << speedup
+             << " over 32-bit)";
+        report.lines.push_back(line.str());
+        if (kBits[b] == 16) report.value = perK;
+    }
+    // Full keys sort by exact depth, so only a broken sort inverts them
+    if (m_inversions[kNumBits - 1] != 0)
+        report.error = std::to_string(m_inversions[kNumBits - 1]) + " inversions with full 32-bit keys.";
+    return report;
+}
+
+// ===========================================================================
+// Coherence check
+// ===========================================================================
+CheckFixtures::CheckReport CheckFixtures::coherenceCheck(const GaussianData& data, int frames, int keyBits) {
+    CheckReport report;
+    frames  = std::max(1, frames);
+    keyBits = SplatSort::keyBits(keyBits);
+    const int passes = SplatSort::passCount(keyBits);
+    const size_t N = data.count();
+
+    // The framing view, looking down -z; the projection stays as it is so
+    // only the camera tells frames apart
+    const PreprocessCamera framing = frameBox(data.bboxMin, data.bboxMax);
+    const float radius = boxRadius(data.bboxMin, data.bboxMax);
+    const float farDist = framing.cameraPos[2] - 0.5f * (data.bboxMin[2] + data.bboxMax[2]) + 2.f * radius;
+
+    // Per frame: a move along x (pan) or the view (dolly), in scene radii,
+    // and a turn about y, in radians
+    struct Motion { const char* name; float pan, dolly, turn; };
+    const Motion motions[] = {
+        { "still", 0.f,    0.f,    0.f     },
+        { "pan",   0.001f, 0.f,    0.f     },
+        { "dolly", 0.f,    0.001f, 0.f     },
+        { "turn",  0.f,    0.f,    0.0005f },
+        { "orbit", 0.f,    0.f,    0.01f   },
+    };
+
+    PreprocessOutputs out;
+    std::vector<uint32_t> keys, slots, refKeys, refSlots, lastKeys, lastSlots, a, b;
+    size_t incrementalTotal = 0, heldTotal = 0;
+    for (const Motion& m : motions) {
+        SortFrame last;
+        int counts[3] = {};
+        size_t held = 0;
+        double fullMs = 0.0, incrementalMs = 0.0;
+        for (int f = 0; f <= frames; f++) {
+            float eye[3], dir[3];
+            std::memcpy(eye, framing.cameraPos, sizeof(eye));
+            eye[0] += f * m.pan * radius;
+            eye[2] -= f * m.dolly * radius;
+            dir[0] = -std::sin(f * m.turn);
+            dir[1] = 0.f;
+            dir[2] = -std::cos(f * m.turn);
+            PreprocessCamera cam = lookFrom(eye, dir, farDist);
+
+            SortFrame frame;
+            frame.sceneHash   = SortCoherence::hash(cam.projMat,
+                                SortCoherence::hash(keyBits, SortCoherence::hash(N, SortCoherence::kHashSeed)));
+            std::memcpy(frame.viewMat, cam.viewMat, sizeof(frame.viewMat));
+            frame.sceneRadius = radius;
+            frame.valid       = true;
+
+            SplatPreprocess::run(data, N, kIdentity, cam, nullptr, out);
+            SplatSort::compact(out.radius.data(), out.depth.data(), N, keys, slots);
+            if (keyBits < SplatSort::kFullKeyBits) SplatSort::quantizeKeys(keys, keyBits, cam.projMat);
+
+            refKeys  = keys;
+            refSlots = slots;
+            auto t0 = std::chrono::steady_clock::now();
+            SplatSort::onesweep(refKeys, refSlots, passes);
+            double sortMs = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - t0).count();
+
+            SortCoherence::Mode mode = SortCoherence::classify(last, frame);
+            counts[mode]++;
+            if (mode == SortCoherence::kReuse) {
+                // The last list as it is: its keys must be this frame's too
+                if (lastSlots != refSlots || lastKeys != refKeys) {
+                    report.error = std::string(m.name) + " frame " + std::to_string(f) +
+                                   ": the reused draw list differs from a fresh sort.";
+                    return report;
+                }
+            } else if (mode == SortCoherence::kIncremental) {
+                t0 = std::chrono::steady_clock::now();
+                held += SortCoherence::incrementalSort(lastSlots, (uint32_t)N, keys, slots, passes);
+                incrementalMs += std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - t0).count();
+                fullMs += sortMs;
+                a = slots;
+                b = refSlots;
+                std::sort(a.begin(), a.end());
+                std::sort(b.begin(), b.end());
+                if (keys != refKeys || a != b) {
+                    report.error = std::string(m.name) + " frame " + std::to_string(f) +
+                                   ": the incremental sort differs from a full one.";
+                    return report;
+                }
+                lastKeys  = keys;
+                lastSlots = slots;
+            } else {
+                lastKeys  = refKeys;
+                lastSlots = refSlots;
+            }
+            last = frame;
+        }
+        if (std::strcmp(m.name, "still") == 0 && counts[SortCoherence::kReuse] != frames) {
+            report.error = "an unmoved camera did not reuse its draw list.";
+            return report;
+        }
+        incrementalTotal += counts[SortCoherence::kIncremental];
+        heldTotal        += held;
+
+        std::ostringstream line;
+        line << m.name << ": " << counts[SortCoherence::kFullSort] << " full, "
+             << counts[SortCoherence::kIncremental] << " incremental, " << counts[SortCoherence::kReuse]
+             << " reused";
+        if (counts[SortCoherence::kIncremental] > 0)
+            line << "; fix-up held " << held << "/" << counts[SortCoherence::kIncremental] << ", incremental "
+                 << incrementalMs << " ms against " << fullMs << " ms in full";
+        report.lines.push_back(line.str());
+    }
+
+    double heldFraction = incrementalTotal > 0 ? (double)heldTotal / incrementalTotal : 0.0;
+    std::ostringstream line;
+    line << N << " splats, " << keyBits << "-bit keys, " << frames
+         << " frames per motion: every draw list matches a full sort";
+    report.lines.push_back(line.str());
+    report.value = heldFraction;
+    return report;
+}
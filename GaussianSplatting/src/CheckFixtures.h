@@ -0,0 +1,215 @@
+#pragma once
+#include "SplatOrder.h"
+#include "SplatPreprocess.h"
+#include "SplatSort.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+struct PLYReadControl;
+
+// ===========================================================================
+// CheckFixtures  --  the inputs the check and benchmark commands
+// (GaussianCheckCommands) share: synthetic PLY files, and the cameras the
+// checks look through. No Maya types, so they can be used outside the plugin.
+//
+// frameBox() is the framing view: 1920x1080, 45 degree vertical FOV,
+// looking down -z at the centre of a box from far enough back to see all of
+// it. lookFrom() places the same camera anywhere, and RandomCameras draws
+// eyes anywhere in a box grown by half, looking any way, from a fixed seed,
+// so runs are repeatable.
+//
+// preprocessCheck() is the float-against-double check of gsPreprocessCheck
+// and of the headless gsPreprocessCheck tool (GaussianSplatting/tools).
+// The other *Check() functions are the bodies of the Maya-free gs* checks;
+// the command and its tool both run them and print the CheckReport.
+// ===========================================================================
+// How CheckFixtures::writeSyntheticPLY encodes the vertex block. The ASCII
+// options exercise the line splitting of PLYReader's text parser.
+struct PLYEncoding {
+    bool ascii        = false;
+    bool crlf         = false;    // ASCII: "\r\n" line ends, header included
+    bool finalNewline = true;     // ASCII: end the last row with a line end
+};
+
+class CheckFixtures {
+public:
+    static const float kIdentity[16];
+
+    // Writes `count` random splats in the canonical 3DGS layout (the one
+    // writeBinaryPLY emits), so the fixed-layout decoder is exercised. ASCII
+    // values are written with enough digits to read back bit for bit.
+    static bool writeSyntheticPLY(const std::string& path, unsigned count, std::string& err,
+                                  const PLYEncoding& encoding = PLYEncoding());
+
+    // A synthetic PLY in the temp directory, named after `tag`; removed
+    // again when this goes out of scope
+    class TempPLY {
+    public:
+        TempPLY() = default;
+        TempPLY(const TempPLY&)            = delete;
+        TempPLY& operator=(const TempPLY&) = delete;
+        ~TempPLY();
+
+        bool write(const std::string& tag, unsigned count, std::string& err,
+                   const PLYEncoding& encoding = PLYEncoding());
+        const std::string& path() const { return m_path; }
+
+    private:
+        std::string m_path;
+    };
+
+    // The -file / -synthetic input of a headless tool: `file`, or else
+    // `synthetic` random splats in a TempPLY named after `tag`, read with
+    // `control` (e.g. its shDegree). An input without splats fails too;
+    // `err` then says why.
+    static bool readInput(const std::string& file, unsigned synthetic, const std::string& tag,
+                          GaussianData& data, std::string& err, PLYReadControl* control = nullptr);
+
+    // Half the diagonal of the box, at least 1e-3
+    static float boxRadius(const float bmin[3], const float bmax[3]);
+
+    static PreprocessCamera frameBox(const float bmin[3], const float bmax[3]);
+    // Camera at `eye` looking along the unit vector `dir`, framed like
+    // frameBox, with its far plane `farDist` away
+    static PreprocessCamera lookFrom(const float eye[3], const float dir[3], float farDist);
+
+    class RandomCameras {
+    public:
+        RandomCameras(const float bmin[3], const float bmax[3], unsigned seed = 1234);
+        // Far plane at twice the box diagonal
+        PreprocessCamera next();
+
+    private:
+        float        m_centre[3], m_ext[3], m_diag = 0.f;
+        std::mt19937 m_rng;
+        std::uniform_real_distribution<float> m_uni   { -1.f, 1.f };
+        std::normal_distribution<float>       m_gauss { 0.f, 1.f };
+    };
+
+    // One layout of preprocessCheck: the best float run and its comparison
+    // against the double run
+    struct PreprocessLayoutResult {
+        bool                 compact = false;
+        double               bestMs  = 0.0;
+        PreprocessComparison comparison;
+    };
+
+    // Float against double on `data` and on its compact encoding (in that
+    // order), under a 30 degree, 1.5x instance transform so the world cov3D
+    // path is exercised, framing the transformed bbox, with every 97th
+    // splat soft-deleted. The float run is timed best of `iterations`.
+    static void preprocessCheck(const GaussianData& data, int iterations,
+                                PreprocessLayoutResult results[2]);
+
+    // One line: the counts and the largest difference per output
+    static std::string describe(const PreprocessComparison& c);
+
+    // What a check found: its info lines (without the "[gsX] " prefix), the
+    // failure ("" when it passed) and the value the command returns
+    struct CheckReport {
+        std::vector<std::string> lines;
+        std::string              error;
+        double                   value = 0.0;
+        bool passed() const { return error.empty(); }
+    };
+
+    // Largest |difference| benchPLY accepts between the stream and mapped
+    // readers in any column
+    static const float kStreamReadTolerance;
+
+    // gsBenchPLY on the file at `path`: PLYReader::readStream, PLYReader::read
+    // through the generic per-column decoder and through the fixed-layout
+    // decoders, and a memcpy of the mapped file, best of `iterations`.
+    // Fails unless the generic and fixed-layout reads are identical and the
+    // stream read is within kStreamReadTolerance of them. value: the stream
+    // reader's time over the mapped reader's.
+    static CheckReport benchPLY(const std::string& path, int iterations);
+
+    // gsAsciiCheck: `count` random splats written as ASCII with LF and
+    // CRLF line ends, each with and without a final newline, read by
+    // PLYReader::read (mapped, split into segments) and readStream, both
+    // compared value by value with the same rows in binary. Fails when the
+    // body does not reach past a segment boundary. value: the stream
+    // reader's best of `iterations` over the mapped reader's (LF).
+    static CheckReport asciiCheck(unsigned count, int iterations);
+
+    // gsCompactCheck: `reference` encoded into compact storage and decoded
+    // again, best of `iterations`, with every element checked against the
+    // SplatCompact error bounds; then the same with one chunk's splats
+    // moved onto a single point, so its quantisation box is degenerate.
+    // value: the largest error / bound ratio.
+    static CheckReport compactCheck(const GaussianData& reference, int iterations);
+
+    // gsBenchKernels: the SplatKernels load transforms (FinalizeRows,
+    // DisplayColors) on `count` random splats, scalar against the SIMD level
+    // this CPU supports, best of `iterations` on one thread. Fails unless
+    // both give identical bits and exp/sigmoid stay within kExpMaxRelError
+    // and kSigmoidMaxRelError. value: the finalize speedup.
+    static CheckReport benchKernels(size_t count, int iterations);
+
+    // gsPoolCheck: `operations` random allocate / free / grow steps on a
+    // RangeAllocator against a model of every unit's owner, then CopyPlan
+    // fills of the surviving ranges and plans that must be rejected.
+    // value: the steps run.
+    static CheckReport poolCheck(int operations, unsigned seed);
+
+    // gsPageCheck: `iterations` random ranges per column stride split at
+    // the page boundaries of full-size PageLayouts and planned through
+    // CopyPlan::addPaged, a 100M-splat dataset at SH degree 3 in the float
+    // and compact columns, then real copies on small pages.
+    // value: the ranges checked.
+    static CheckReport pageCheck(int iterations, unsigned seed);
+
+    // gsSortCheck on a file: the float preprocess reference from a camera
+    // that sees part of `data`, SplatSort::compact against a plain filter,
+    // onesweep and radixSort against std::stable_sort, then the best of
+    // `iterations` sorts of every splat against the drawn ones compacted.
+    // value: that speedup.
+    static CheckReport sortCheck(const GaussianData& data, int iterations);
+
+    // gsCullCheck: SplatBVH built over `data` in file order and in `order`
+    // (Morton or Hilbert), culled from `iterations` RandomCameras; fails
+    // when a splat the float preprocess draws lies outside the kept
+    // ranges. value: the splats over those kept in curve order.
+    static CheckReport cullCheck(const GaussianData& data, SplatOrder order, int iterations);
+
+    // gsBenchSort: `count` keys of each distribution sorted by onesweep,
+    // radixSort and std::stable_sort, best of `iterations`; fails when a
+    // radix sort's order or stability differs. value: the geometric mean
+    // of onesweep's speedup over radixSort.
+    static CheckReport benchSort(size_t count, int iterations);
+
+    // gsSortPrecision: for every scene added, the float preprocess from the
+    // framing view and `views` - 1 RandomCameras, the drawn splats
+    // quantised and sorted at each of kBits as the GPU does, and the
+    // inversions counted: pairs whose footprints overlap on screen drawn
+    // nearer first. finish() reports them per precision over all scenes and
+    // fails when full 32-bit keys have any. value: inversions per 1000
+    // drawn splats at 16 bits.
+    class SortPrecision {
+    public:
+        static constexpr int kBits[]  = { 12, 16, 20, 24, SplatSort::kFullKeyBits };
+        static constexpr int kNumBits = (int)(sizeof(kBits) / sizeof(kBits[0]));
+
+        explicit SortPrecision(int views);
+        void addScene(const std::string& name, const GaussianData& data);
+        CheckReport finish();
+        // Per precision, in kBits order
+        const std::vector<size_t>& inversions() const { return m_inversions; }
+
+    private:
+        int                 m_views;
+        size_t              m_drawn = 0;
+        std::vector<size_t> m_inversions;
+        std::vector<double> m_sortMs;
+        CheckReport         m_report;     // the per-scene lines
+    };
+
+    // gsCoherenceCheck: `frames` frames of each camera motion (still, pan,
+    // dolly, turn, orbit) through SortCoherence, every reused or
+    // incrementally sorted draw list against a full sort, with `keyBits`
+    // keys. value: the share of incremental frames whose fix-up held.
+    static CheckReport coherenceCheck(const GaussianData& data, int frames, int keyBits);
+};
@@ -0,0 +1,72 @@
+#include "CopyPlan.h"
+
+#include <algorithm>
+
+void CopyPlan::add(uint32_t source, uint32_t dest, uint64_t srcOffset, uint64_t dstOffset, uint64_t bytes) {
+    if (bytes == 0) return;
+    m_bytes += bytes;
+    if (!m_copies.empty()) {
+        BufferCopy& last = m_copies.back();
+        if (last.source == source && last.dest == dest &&
+            last.srcOffset + last.bytes == srcOffset && last.dstOffset + last.bytes == dstOffset) {
+            last.bytes += bytes;
+            return;
+        }
+    }
+    m_copies.push_back({ source, dest, srcOffset, dstOffset, bytes });
+}
+
+void CopyPlan::addRows(uint32_t source, uint32_t dest, uint32_t stride, uint32_t perRow,
+                       uint32_t dstBase, uint32_t first, uint32_t last) {
+    if (last <= first) return;
+    uint64_t rowBytes = (uint64_t)stride * perRow;
+    add(source, dest, first * rowBytes, (uint64_t)dstBase * stride + first * rowBytes,
+        (last - first) * rowBytes);
+}
+
+void CopyPlan::addPaged(const PageLayout& src, uint32_t srcBase, uint64_t srcFirst,
+                        const PageLayout& dst, uint32_t dstBase, uint64_t dstFirst, uint64_t count) {
+    const uint64_t stride = dst.stride();
+    for (uint64_t done = 0; done < count;) {
+        uint64_t s = srcFirst + done, d = dstFirst + done;
+        uint64_t n = std::min({ count - done, src.pageElements() - src.localOf(s),
+                                dst.pageElements() - dst.localOf(d) });
+        add(srcBase + src.pageOf(s), dstBase + dst.pageOf(d),
+            src.localOf(s) * stride, dst.localOf(d) * stride, n * stride);
+        done += n;
+    }
+}
+
+bool CopyPlan::validate(const std::vector<uint64_t>& sourceBytes,
+                        const std::vector<uint64_t>& destBytes,
+                        std::string* error) const {
+    auto fail = [&](size_t i, const char* what) {
+        if (error) *error = "copy " + std::to_string(i) + ": " + what;
+        return false;
+    };
+
+    std::vector<size_t> order(m_copies.size());
+    for (size_t i = 0; i < m_copies.size(); i++) {
+        const BufferCopy& c = m_copies[i];
+        if (c.source >= sourceBytes.size()) return fail(i, "unknown source");
+        if (c.dest >= destBytes.size())     return fail(i, "unknown destination");
+        if (c.bytes == 0)                   return fail(i, "empty");
+        if (c.srcOffset + c.bytes > sourceBytes[c.source]) return fail(i, "reads past the end of its source");
+        if (c.dstOffset + c.bytes > destBytes[c.dest])     return fail(i, "writes past the end of its destination");
+        order[i] = i;
+    }
+
+    // Sorted by destination, each write must end before the next one starts
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        const BufferCopy& x = m_copies[a];
+        const BufferCopy& y = m_copies[b];
+        return x.dest != y.dest ? x.dest < y.dest : x.dstOffset < y.dstOffset;
+    });
+    for (size_t k = 1; k < order.size(); k++) {
+        const BufferCopy& prev = m_copies[order[k - 1]];
+        const BufferCopy& cur  = m_copies[order[k]];
+        if (prev.dest == cur.dest && prev.dstOffset + prev.bytes > cur.dstOffset)
+            return fail(order[k], "overlaps another copy's destination");
+    }
+    return true;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "PageLayout.h"
+
+// ===========================================================================
+// CopyPlan  --  list of buffer-to-buffer byte copies, built and checked on
+// the CPU before any of it is issued to the GPU.
+//
+// Sources and destinations are plain indices into the caller's own buffer
+// tables, so building a plan needs no device: the render manager maps them
+// to ID3D11Buffers and issues one CopySubresourceRegion per copy, and
+// gsPoolCheck maps them to byte arrays and runs the plan with memcpy.
+// Copies that continue the previous one in both buffers are merged.
+// ===========================================================================
+struct BufferCopy {
+    uint32_t source    = 0;     // caller's source buffer index
+    uint32_t dest      = 0;     // caller's destination buffer index
+    uint64_t srcOffset = 0;     // bytes
+    uint64_t dstOffset = 0;     // bytes
+    uint64_t bytes     = 0;
+};
+
+class CopyPlan {
+public:
+    void add(uint32_t source, uint32_t dest, uint64_t srcOffset, uint64_t dstOffset, uint64_t bytes);
+
+    // Rows [first, last) of a column with `perRow` elements of `stride` bytes
+    // per row: row r starts at element r * perRow in the source and at
+    // element dstBase + r * perRow in the destination.
+    void addRows(uint32_t source, uint32_t dest, uint32_t stride, uint32_t perRow,
+                 uint32_t dstBase, uint32_t first, uint32_t last);
+
+    // Elements [srcFirst, srcFirst + count) of a paged column into a paged
+    // column of the same stride starting at dstFirst. Page p of the source
+    // is source srcBase + p, page q of the destination is dest dstBase + q;
+    // the run is cut wherever either side crosses a page.
+    void addPaged(const PageLayout& src, uint32_t srcBase, uint64_t srcFirst,
+                  const PageLayout& dst, uint32_t dstBase, uint64_t dstFirst, uint64_t count);
+
+    void clear() { m_copies.clear(); m_bytes = 0; }
+
+    const std::vector<BufferCopy>& copies() const { return m_copies; }
+    bool     empty()      const { return m_copies.empty(); }
+    uint64_t totalBytes() const { return m_bytes; }
+
+    // Every copy stays inside its source and destination (sizes in bytes,
+    // indexed like the plan's indices), and no two copies write the same
+    // destination byte. On failure `error` names the first bad copy.
+    bool validate(const std::vector<uint64_t>& sourceBytes,
+                  const std::vector<uint64_t>& destBytes,
+                  std::string* error = nullptr) const;
+
+private:
+    std::vector<BufferCopy> m_copies;
+    uint64_t                m_bytes = 0;
+};
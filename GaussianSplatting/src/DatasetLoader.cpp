@@ -0,0 +1,133 @@
+#include "DatasetLoader.h"
+
+#include <maya/MGlobal.h>
+#include <maya/MPlug.h>
+#include <maya/MTimerMessage.h>
+#include <maya/MViewport2Renderer.h>
+#include <maya/M3dView.h>
+
+#include <algorithm>
+
+// How often the main thread polls a running load (seconds)
+static constexpr float kLoadPollSeconds = 0.1f;
+
+DatasetLoader::DatasetLoader(MPxNode* owner, const MObject& tickAttr, bool refreshViews)
+    : m_owner(owner), m_tickAttr(tickAttr), m_refreshViews(refreshViews) {}
+
+DatasetLoader::~DatasetLoader() {
+    release();
+}
+
+SplatDataset::Settings DatasetLoader::readSettings(MDataBlock& dataBlock, const MObject& shDegree,
+                                                   const MObject& compactStorage, const MObject& splatOrder) {
+    SplatDataset::Settings settings;
+    settings.shDegree = std::clamp(dataBlock.inputValue(shDegree).asInt(), 0, kMaxSHDegree);
+    settings.compact  = dataBlock.inputValue(compactStorage).asBool();
+    settings.order    = (SplatOrder)std::clamp(dataBlock.inputValue(splatOrder).asInt(),
+                                               (int)SplatOrder::File, (int)SplatOrder::Hilbert);
+    return settings;
+}
+
+bool DatasetLoader::changed(const MString& path, const SplatDataset::Settings& settings) const {
+    return path != m_loadedPath || settings.shDegree != m_loadedSettings.shDegree ||
+           settings.compact != m_loadedSettings.compact || settings.order != m_loadedSettings.order;
+}
+
+// The old dataset is released; if this was its last node, its worker stops
+// at the next checkpoint and the data is discarded. (Reloading from a valid
+// sidecar cache is cheap.)
+void DatasetLoader::begin(const MString& path, const SplatDataset::Settings& settings) {
+    release();
+    m_loadedPath     = path;
+    m_loadedSettings = settings;
+    if (path.length() > 0) adopt(SplatDataset::acquire(path.asChar(), settings));
+}
+
+// A dataset still loading is polled by this loader's own timer as well, so
+// the owner re-evaluates however it got the dataset.
+void DatasetLoader::adopt(const std::shared_ptr<SplatDataset>& dataset) {
+    m_dataset  = dataset;
+    m_seenRows = 0;
+    if (m_dataset && m_dataset->isLoading()) startTimer();
+}
+
+// The dataset picks up new rows and finishes the load once, whichever of
+// its nodes polls first.
+bool DatasetLoader::poll() {
+    if (!m_dataset) return true;
+    m_dataset->poll();
+    if (m_dataset->failed()) {
+        // Reported by the dataset; every node sharing it ends up empty
+        release();
+        return false;
+    }
+    m_seenRows = m_dataset->readyCount();
+    if (!m_dataset->isLoading()) stopTimer();
+    return true;
+}
+
+void DatasetLoader::release() {
+    stopTimer();
+    m_dataset.reset();
+    m_seenRows = 0;
+}
+
+void DatasetLoader::forget() {
+    release();
+    m_loadedPath = MString();
+}
+
+void DatasetLoader::cancel() {
+    if (!m_dataset || !m_dataset->isLoading()) return;
+    MGlobal::displayInfo(MString("[GaussianSplatData] Load cancelled: ") + m_dataset->path().c_str());
+    m_dataset->cancel();
+    release();
+    bumpTick();
+}
+
+void DatasetLoader::bumpTick() {
+    MPlug(m_owner->thisMObject(), m_tickAttr).setInt(++m_loadTick);
+}
+
+void DatasetLoader::startTimer() {
+    m_lastLoadProgress = 0.f;
+    if (!m_loadTimer) {
+        MStatus st;
+        m_loadTimer = MTimerMessage::addTimerCallback(kLoadPollSeconds, timerCallback, this, &st);
+        if (!st) m_loadTimer = 0;
+    }
+}
+
+void DatasetLoader::stopTimer() {
+    if (m_loadTimer) {
+        MMessage::removeCallback(m_loadTimer);
+        m_loadTimer = 0;
+    }
+}
+
+// Runs on the main thread while a load is in flight. Only dirties the
+// owner's outputs when there is something new to show; its compute does
+// the rest.
+void DatasetLoader::timerCallback(float, float, void* clientData) {
+    DatasetLoader* loader = static_cast<DatasetLoader*>(clientData);
+    if (!loader->m_dataset) return;
+
+    // Another node sharing the dataset may have polled it already
+    const SplatDataset& ds = *loader->m_dataset;
+    bool  done     = ds.loadFinished();
+    bool  newRows  = ds.publishedCount() > loader->m_seenRows;
+    float progress = ds.progress();
+    if (!done && !newRows && progress - loader->m_lastLoadProgress < 0.01f) return;
+    loader->m_lastLoadProgress = progress;
+
+    loader->bumpTick();
+
+    if (done) {
+        // Nothing left to poll; the load is finished on the next evaluation.
+        loader->stopTimer();
+    }
+    if (loader->m_refreshViews && (done || newRows)) {
+        MHWRender::MRenderer::setGeometryDrawDirty(loader->m_owner->thisMObject());
+        M3dView::scheduleRefreshAllViews();
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <maya/MDataBlock.h>
+#include <maya/MMessage.h>
+#include <maya/MObject.h>
+#include <maya/MPxNode.h>
+#include <maya/MString.h>
+#include <cstdint>
+#include <memory>
+#include "SplatDataset.h"
+
+// ---------------------------------------------------------------------------
+// DatasetLoader  --  the loading half of a node that shows a splat file:
+// which path and load settings it last asked for, the SplatDataset it holds
+// and the Maya timer that polls that dataset while it loads.
+//
+// gaussianSplat and gaussianSplatData both own one. On every compute the
+// node reads its settings (readSettings), calls begin() when changed()
+// reports a new path or setting, then poll(). While a load runs, the timer
+// bumps the owner's hidden tick attribute (which affects the node's
+// outputs) whenever there are new rows or progress to show, so compute runs
+// again and picks them up.
+//
+// Main thread only.
+// ---------------------------------------------------------------------------
+class DatasetLoader {
+public:
+    // `tickAttr` is the owner's hidden int attribute that the timer bumps.
+    // With refreshViews, new rows also dirty the owner's geometry and
+    // refresh the viewports (for a shape; a data node's shapes run their
+    // own loaders).
+    DatasetLoader(MPxNode* owner, const MObject& tickAttr, bool refreshViews);
+    ~DatasetLoader();
+
+    DatasetLoader(const DatasetLoader&)            = delete;
+    DatasetLoader& operator=(const DatasetLoader&) = delete;
+
+    // shDegree, compactStorage and splatOrder from the data block, clamped
+    // to their valid ranges
+    static SplatDataset::Settings readSettings(MDataBlock& dataBlock, const MObject& shDegree,
+                                               const MObject& compactStorage, const MObject& splatOrder);
+
+    // Whether `path` or `settings` differ from the last begin()
+    bool changed(const MString& path, const SplatDataset::Settings& settings) const;
+    // Releases the current dataset and, for a non-empty path, acquires the
+    // (possibly shared) dataset for `path` and `settings`
+    void begin(const MString& path, const SplatDataset::Settings& settings);
+    // Holds a dataset acquired elsewhere (a connected data node's)
+    void adopt(const std::shared_ptr<SplatDataset>& dataset);
+    // Picks up the rows finished so far. Returns false when the load failed;
+    // the dataset (which reported the error) has then been released.
+    bool poll();
+
+    // Drops the dataset and stops the timer; the path and settings are kept,
+    // so the same file is not loaded again until one of them changes
+    void release();
+    // release(), and forgets the path so the next begin() always loads
+    void forget();
+    // Cancels the load for every node sharing it, releases it and bumps the
+    // tick so the owner re-evaluates
+    void cancel();
+
+    const std::shared_ptr<SplatDataset>& dataset() const { return m_dataset; }
+    const MString&                 loadedPath()     const { return m_loadedPath; }
+    const SplatDataset::Settings&  loadedSettings() const { return m_loadedSettings; }
+
+private:
+    MPxNode*       m_owner;
+    const MObject& m_tickAttr;
+    bool           m_refreshViews;
+
+    std::shared_ptr<SplatDataset> m_dataset;
+    MString                m_loadedPath;
+    SplatDataset::Settings m_loadedSettings;
+
+    MCallbackId  m_loadTimer        = 0;
+    int          m_loadTick         = 0;
+    float        m_lastLoadProgress = 0.f;
+    uint32_t     m_seenRows         = 0;    // dataset rows as of the last poll
+
+    void bumpTick();
+    void startTimer();
+    void stopTimer();
+    static void timerCallback(float elapsedTime, float lastTime, void* clientData);
+};
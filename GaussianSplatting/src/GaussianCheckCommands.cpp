@@ -0,0 +1,811 @@
+#define NOMINMAX
+#include "GaussianCheckCommands.h"
+#include "CheckFixtures.h"
+#include "GaussianData.h"
+#include "GaussianNode.h"
+#include "GaussianRenderManager.h"
+#include "PLYReader.h"
+#include "SplatCoherence.h"
+#include "SplatCompact.h"
+#include "SplatKernels.h"
+#include "SplatOrder.h"
+#include "SplatPreprocess.h"
+#include "SplatSort.h"
+
+#include <maya/MGlobal.h>
+#include <maya/MArgDatabase.h>
+#include <maya/MSelectionList.h>
+#include <maya/MFnDependencyNode.h>
+#include <maya/MIntArray.h>
+#include <maya/MViewport2Renderer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// ===========================================================================
+// Helpers
+// ===========================================================================
+namespace {
+
+GaussianNode* gaussianNodeFromObject(const MObject& obj) {
+    MFnDependencyNode fn(obj);
+    if (fn.typeName() != GaussianNode::typeName) return nullptr;
+    return static_cast<GaussianNode*>(fn.userNode());
+}
+
+// The -file / -synthetic input of command `cmd`: exactly one must be set.
+// -synthetic writes its splats into `temp`; `fileUse` picks one use of a
+// multi-use -file. Shows "<cmd>: ..." and returns false on failure.
+bool openCheckInput(const MArgDatabase& db, const char* cmd, CheckFixtures::TempPLY& temp,
+                    std::string& path, unsigned fileUse = 0)
+{
+    if (db.isFlagSet("-f") == db.isFlagSet("-s")) {
+        MGlobal::displayError(MString(cmd) + ": give exactly one of -file or -synthetic.");
+        return false;
+    }
+    if (db.isFlagSet("-f")) {
+        MArgList fileArgs;
+        db.getFlagArgumentList("-f", fileUse, fileArgs);
+        path = fileArgs.asString(0).asChar();
+        return true;
+    }
+    int count = 0;
+    db.getFlagArgument("-s", 0, count);
+    if (count <= 0) {
+        MGlobal::displayError(MString(cmd) + ": -synthetic needs a positive splat count.");
+        return false;
+    }
+    std::string err;
+    if (!temp.write(cmd, (unsigned)count, err)) {
+        MGlobal::displayError(MString(cmd) + ": " + err.c_str());
+        return false;
+    }
+    path = temp.path();
+    return true;
+}
+
+// Reads the input of command `cmd` (see openCheckInput) into `data`; an
+// input without splats fails too
+bool loadCheckInput(const MArgDatabase& db, const char* cmd, GaussianData& data,
+                    PLYReadControl* control = nullptr, unsigned fileUse = 0)
+{
+    CheckFixtures::TempPLY temp;
+    std::string path, err;
+    if (!openCheckInput(db, cmd, temp, path, fileUse)) return false;
+    bool ok = PLYReader::read(path, data, err, control);
+    if (!ok || data.empty()) {
+        MGlobal::displayError(MString(cmd) + ": read failed (" + path.c_str() + "): " +
+                              (ok ? "no splats" : err.c_str()));
+        return false;
+    }
+    return true;
+}
+
+// The info lines of a CheckFixtures check, as "[<cmd>] <line>"
+void showReport(const char* cmd, const CheckFixtures::CheckReport& report) {
+    for (const std::string& line : report.lines)
+        MGlobal::displayInfo(MString("[") + cmd + "] " + line.c_str());
+}
+
+} // namespace
+
+// ===========================================================================
+// gsBenchPLY
+// ===========================================================================
+const MString GSBenchPLYCmd::commandName("gsBenchPLY");
+
+MSyntax GSBenchPLYCmd::newSyntax() {
+    MSyntax s;
+    s.addFlag("-f",  "-file",       MSyntax::kString);
+    s.addFlag("-s",  "-synthetic",  MSyntax::kLong);
+    s.addFlag("-it", "-iterations", MSyntax::kLong);
+    return s;
+}
+
+MStatus GSBenchPLYCmd::doIt(const MArgList& args) {
+    MStatus st;
+    MArgDatabase db(syntax(), args, &st);
+    if (!st) return st;
+
+    int iterations = 3;
+    if (db.isFlagSet("-it")) db.getFlagArgument("-it", 0, iterations);
+    iterations = std::max(1, iterations);
+
+    CheckFixtures::TempPLY temp;
+    std::string path;
+    if (!openCheckInput(db, "gsBenchPLY", temp, path)) return MS::kFailure;
+
+    CheckFixtures::CheckReport report = CheckFixtures::benchPLY(path, iterations);
+    showReport("gsBenchPLY", report);
+    if (!report.passed()) {
+        displayError(MString("gsBenchPLY: ") + report.error.c_str());
+        return MS::kFailure;
+    }
+    setResult(report.value);
+    return MS::kSuccess;
+}
+
+// ===========================================================================
+// gsCompactCheck
+// ===========================================================================
+const MString GSCompactCheckCmd::commandName("gsCompactCheck");
+
+MSyntax GSCompactCheckCmd::newSyntax() {
+    MSyntax s;
+    s.addFlag("-f",  "-file",       MSyntax::kString);
+    s.addFlag("-s",  "-synthetic",  MSyntax::kLong);
+    s.addFlag("-sh", "-shDegree",   MSyntax::kLong);
+    s.addFlag("-it", "-iterations", MSyntax::kLong);
+    return s;
+}
+
+MStatus GSCompactCheckCmd::doIt(const MArgList& args) {
+    MStatus st;
+    MArgDatabase db(syntax(), args, &st);
+    if (!st) return st;
+
+    int iterations = 3;
+    if (db.isFlagSet("-it")) db.getFlagArgument("-it", 0, iterations);
+    iterations = std::max(1, iterations);
+
+    PLYReadControl control;
+    if (db.isFlagSet("-sh")) {
+        int degree = kMaxSHDegree;
+        db.getFlagArgument("-sh", 0, degree);
+        control.shDegree = std::clamp(degree, 0, kMaxSHDegree);
+    }
+
+    GaussianData reference;
+    if (!loadCheckInput(db, "gsCompactCheck", reference, &control)) return MS::kFailure;
+
+    CheckFixtures::CheckReport report = CheckFixtures::compactCheck(reference, iterations);
+    showReport("gsCompactCheck", report);
+    if (!report.passed()) {
+        displayError(MString("gsCompactCheck: ") + report.error.c_str());
+        return MS::kFailure;
+    }
+    setResult(report.value);
+    return MS::kSuccess;
+}
+
+// ===========================================================================
+// gsBenchKernels
+// ===========================================================================
+const MString GSBenchKernelsCmd::commandName("gsBenchKernels");
+
+MSyntax GSBenchKernelsCmd::newSyntax() {
+    MSyntax s;
+    s.addFlag("-c",  "-count",      MSyntax::kLong);
+    s.addFlag("-it", "-iterations", MSyntax::kLong);
+    s.addFlag("-sd", "-simd",       MSyntax::kBoolean);
+    return s;
+}
+
+MStatus GSBenchKernelsCmd::doIt(const MArgList& args) {
+    MStatus st;
+    MArgDatabase db(syntax(), args, &st);
+    if (!st) return st;
+
+    if (db.isFlagSet("-sd")) {
+        bool on = true;
+        db.getFlagArgument("-sd", 0, on);
+        gs::SetActiveSimd(on ? gs::DetectedSimd() : gs::SimdLevel::Scalar);
+    }
+    int count = 1000000, iterations = 3;
+    if (db.isFlagSet("-c"))  db.getFlagArgument("-c", 0, count);
+    if (db.isFlagSet("-it")) db.getFlagArgument("-it", 0, iterations);
+    if (count <= 0) {
+        displayError("gsBenchKernels: -count must be positive.");
+        return MS::kFailure;
+    }
+
+    CheckFixtures::CheckReport report = CheckFixtures::benchKernels((size_t)count, iterations);
+    showReport("gsBenchKernels", report);
+    if (!report.passed()) {
+        displayError(MString("gsBenchKernels: ") + report.error.c_str());
+        return MS::kFailure;
+    }
+    setResult(report.value);
+    return MS::kSuccess;
+}
+
+// ===========================================================================
+// gsBenchOrder
+// ===========================================================================
+const MString GSBenchOrderCmd::commandName("gsBenchOrder");
+
+MSyntax GSBenchOrderCmd::newSyntax() {
+    MSyntax s;
+    s.addFlag("-f",  "-file",       MSyntax::kString);
+    s.addFlag("-s",  "-synthetic",  MSyntax::kLong);
+    s.addFlag("-o",  "-order",      MSyntax::kLong);
+    s.addFlag("-it", "-iterations", MSyntax::kLong);
+    return s;
+}
+
+// Mean distance between the positions of consecutive rows
+static double meanNeighbourDistance(const GaussianData& d) {
+    const size_t N = d.count();
+    if (N < 2) return 0.0;
+    double sum = 0.0;
+    for (size_t i = 1; i < N; i++) {
+        const float* a = &d.positions[(i - 1) * 3];
+        const float* b = &d.positions[i * 3];
+        double dx = b[0] - a[0], dy = b[1] - a[1], dz = b[2] - a[2];
+        sum += std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+    return sum / (double)(N - 1);
+}
+
+// Mean per-axis quantisation step of the compact chunks
+static double meanChunkStep(const GaussianData& packed) {
+    const auto& chunks = packed.packed.chunks;
+    if (chunks.empty()) return 0.0;
+    double sum = 0.0;
+    for (const CompactChunk& c : chunks) sum += c.step[0] + c.step[1] + c.step[2];
+    return sum / (double)(chunks.size() * 3);
+}
+
+MStatus GSBenchOrderCmd::doIt(const MArgList& args) {
+    MStatus st;
+    MArgDatabase db(syntax(), args, &st);
+    if (!st) return st;
+
+    int iterations = 3, orderArg = (int)SplatOrder::Hilbert;
+    if (db.isFlagSet("-it")) db.getFlagArgument("-it", 0, iterations);
+    if (db.isFlagSet("-o"))  db.getFlagArgument("-o", 0, orderArg);
+    iterations = std::max(1, iterations);
+    if (orderArg != (int)SplatOrder::Morton && orderArg != (int)SplatOrder::Hilbert) {
+        displayError("gsBenchOrder: -order must be 1 (Morton) or 2 (Hilbert).");
+        return MS::kFailure;
+    }
+    const SplatOrder order = (SplatOrder)orderArg;
+
+    GaussianData data;
+    if (!loadCheckInput(db, "gsBenchOrder", data)) return MS::kFailure;
+    if (data.count() < 2) {
+        displayError("gsBenchOrder: needs at least 2 splats.");
+        return MS::kFailure;
+    }
+    const size_t N = data.count();
+
+    // Best of `iterations` for each reorder stage
+    GaussianData sorted;
+    std::vector<uint32_t> keys, perm;
+    double keyMs = -1.0, sortMs = -1.0, gatherMs = -1.0;
+    for (int i = 0; i < iterations; i++) {
+        auto t0 = std::chrono::steady_clock::now();
+        SplatReorder::computeKeys(data, order, keys);
+        auto t1 = std::chrono::steady_clock::now();
+        perm = SplatReorder::sortPermutation(keys);
+        auto t2 = std::chrono::steady_clock::now();
+        sorted = SplatReorder::permute(data, perm);
+        auto t3 = std::chrono::steady_clock::now();
+        double k = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        double s = std::chrono::duration<double, std::milli>(t2 - t1).count();
+        double g = std::chrono::duration<double, std::milli>(t3 - t2).count();
+        if (keyMs    < 0.0 || k < keyMs)    keyMs    = k;
+        if (sortMs   < 0.0 || s < sortMs)   sortMs   = s;
+        if (gatherMs < 0.0 || g < gatherMs) gatherMs = g;
+    }
+
+    // Keys ascending, every file row exactly once, columns follow the rows
+    std::vector<uint8_t> seen(N, 0);
+    bool valid = true;
+    for (size_t i = 0; i < N && valid; i++) {
+        size_t s = sorted.fileRow(i);
+        valid = s < N && !seen[s] && (i == 0 || keys[perm[i - 1]] <= keys[perm[i]]) &&
+                std::memcmp(&sorted.positions[i * 3], &data.positions[s * 3], 3 * sizeof(float)) == 0 &&
+                sorted.opacityRaw[i] == data.opacityRaw[s];
+        if (valid) seen[s] = 1;
+    }
+    if (!valid) {
+        displayError("gsBenchOrder: reordered rows are not a permutation of the file rows.");
+        return MS::kFailure;
+    }
+
+    // Orthographic view down z mapping the bbox onto clip [-1, 1]; the rect
+    // covers the middle half of it on both axes.
+    float wvp[16] = {};
+    for (int k = 0; k < 2; k++) {
+        float ext = std::max(data.bboxMax[k] - data.bboxMin[k], 1e-6f);
+        wvp[k * 5]  = 2.f / ext;
+        wvp[12 + k] = -(data.bboxMin[k] + data.bboxMax[k]) / ext;
+    }
+    wvp[15] = 1.f;
+    auto select = [&](const GaussianData& d, uint32_t& selected) {
+        std::vector<uint32_t> mask(N, 0u);
+        double best = -1.0;
+        for (int i = 0; i < iterations; i++) {
+            auto t0 = std::chrono::steady_clock::now();
+            selected = GaussianRenderManager::selectInRect(d, (uint32_t)N, wvp,
+                                                           -0.5f, -0.5f, 0.5f, 0.5f, 0, mask.data());
+            double ms = std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - t0).count();
+            if (best < 0.0 || ms < best) best = ms;
+        }
+        return best;
+    };
+    uint32_t fileSelected = 0, curveSelected = 0;
+    double fileSelectMs  = select(data, fileSelected);
+    double curveSelectMs = select(sorted, curveSelected);
+    if (fileSelected != curveSelected) {
+        displayError("gsBenchOrder: selection differs between file and curve order.");
+        return MS::kFailure;
+    }
+
+    double fileStep  = meanChunkStep(SplatCompact::encode(data));
+    double curveStep = meanChunkStep(SplatCompact::encode(sorted));
+    double speedup   = curveSelectMs > 0.0 ? fileSelectMs / curveSelectMs : 0.0;
+
+    displayInfo(MString("[gsBenchOrder] ") + (unsigned)N + " splats, " + SplatReorder::name(order) +
+                " order, best of " + iterations + ": keys " + keyMs + " ms, sort " + sortMs +
+                " ms, gather " + gatherMs + " ms");
+    displayInfo(MString("[gsBenchOrder] mean neighbour distance ") + meanNeighbourDistance(data) +
+                " -> " + meanNeighbourDistance(sorted) + ", mean compact chunk step " + fileStep +
+                " -> " + curveStep);
+    displayInfo(MString("[gsBenchOrder] rect selection (") + curveSelected + " selected): file order " +
+                fileSelectMs + " ms, " + SplatReorder::name(order) + " " + curveSelectMs + " ms (x" +
+                speedup + ")");
+    setResult(speedup);
+    return MS::kSuccess;
+}
+
+// ===========================================================================
+// gsPoolCheck
+// ===========================================================================
+const MString GSPoolCheckCmd::commandName("gsPoolCheck");
+
+MSyntax GSPoolCheckCmd::newSyntax() {
+    MSyntax s;
+    s.addFlag("-op", "-operations", MSyntax::kLong);
+    s.addFlag("-sd", "-seed",       MSyntax::kLong);
+    return s;
+}
+
+MStatus GSPoolCheckCmd::doIt(const MArgList& args) {
+    MStatus st;
+    MArgDatabase db(syntax(), args, &st);
+    if (!st) return st;
+
+    int operations = 200000, seed = 1;
+    if (db.isFlagSet("-op")) db.getFlagArgument("-op", 0, operations);
+    if (db.isFlagSet("-sd")) db.getFlagArgument("-sd", 0, seed);
+
+    CheckFixtures::CheckReport report = CheckFixtures::poolCheck(operations, (unsigned)seed);
+    showReport("gsPoolCheck", report);
+
+    const GaussianRenderManager& mgr = GaussianRenderManager::instance();
+    displayInfo(MString("[gsPoolCheck] render pool: ") + mgr.poolRowCount() + "/" +
+                mgr.poolRowCapacity() + " rows in use, " + mgr.totalSplatCount() + " instance slots (" +
+                mgr.visibleSplatCount() + " in view in " + mgr.visibleInstanceCount() + " instances)");
+
+    if (!report.passed()) {
+        displayError(MString("gsPoolCheck: ") + report.error.c_str());
+        return MS::kFailure;
+    }
+    setResult((int)report.value);
+    return MS::kSuccess;
+}
+
+// ===========================================================================
+// gsPageCheck
+// ===========================================================================
+const MString GSPageCheckCmd::commandName("gsPageCheck");
+
+MSyntax GSPageCheckCmd::newSyntax() {
+    MSyntax s;
+    s.addFlag("-it", "-iterations", MSyntax::kLong);
+    s.addFlag("-sd", "-seed",       MSyntax::kLong);
+    return s;
+}
+
+MStatus GSPageCheckCmd::doIt(const MArgList& args) {
+    MStatus st;
+    MArgDatabase db(syntax(), args, &st);
+    if (!st) return st;
+
+    int iterations = 20000, seed = 1;
+    if (db.isFlagSet("-it")) db.getFlagArgument("-it", 0, iterations);
+    if (db.isFlagSet("-sd")) db.getFlagArgument("-sd", 0, seed);
+
+    CheckFixtures::CheckReport report = CheckFixtures::pageCheck(iterations, (unsigned)seed);
+    showReport("gsPageCheck", report);
+    if (!report.passed()) {
+        displayError(MString("gsPageCheck: ") + report.error.c_str());
+        return MS::kFailure;
+    }
+    setResult((int)report.value);
+    return MS::kSuccess;
+}
+
+// ===========================================================================
+// gsPreprocessCheck
+// ===========================================================================
+const MString GSPreprocessCheckCmd::commandName("gsPreprocessCheck");
+
+MSyntax GSPreprocessCheckCmd::newSyntax() {
+    MSyntax s;
+    s.addFlag("-n",  "-node",       MSyntax::kString);
+    s.addFlag("-f",  "-file",       MSyntax::kString);
+    s.addFlag("-s",  "-synthetic",  MSyntax::kLong);
+    s.addFlag("-it", "-iterations", MSyntax::kLong);
+    return s;
+}
+
+MStatus GSPreprocessCheckCmd::doIt(const MArgList& args) {
+    MStatus st;
+    MArgDatabase db(syntax(), args, &st);
+    if (!st) return st;
+
+    if ((int)db.isFlagSet("-n") + (int)db.isFlagSet("-f") + (int)db.isFlagSet("-s") != 1) {
+        displayError("gsPreprocessCheck: give exactly one of -node, -file or -synthetic.");
+        return MS::kFailure;
+    }
+    int iterations = 3;
+    if (db.isFlagSet("-it")) db.getFlagArgument("-it", 0, iterations);
+    iterations = std::max(1, iterations);
+
+    // --- GPU outputs of a drawn node against the float reference ---
+    if (db.isFlagSet("-n")) {
+        MString name; db.getFlagArgument("-n", 0, name);
+        MSelectionList sel;
+        MObject obj;
+        GaussianNode* node = nullptr;
+        if (sel.add(name) == MS::kSuccess && sel.getDependNode(0, obj) == MS::kSuccess)
+            node = gaussianNodeFromObject(obj);
+        if (!node) {
+            displayError(MString("gsPreprocessCheck: no gaussianSplat named ") + name);
+            return MS::kFailure;
+        }
+
+        MHWRender::MRenderer* renderer = MHWRender::MRenderer::theRenderer();
+        ID3D11Device* device = renderer ? (ID3D11Device*)renderer->GPUDeviceHandle() : nullptr;
+        ID3D11DeviceContext* ctx = nullptr;
+        if (device) device->GetImmediateContext(&ctx);
+        if (!ctx) {
+            displayError("gsPreprocessCheck: no DX11 device (is Viewport 2.0 using DirectX 11?)");
+            return MS::kFailure;
+        }
+
+        auto& mgr = GaussianRenderManager::instance();
+        PreprocessOutputs gpu;
+        uint32_t rows = 0;
+        float worldMat[16];
+        bool ok = mgr.readInstanceOutputs(device, ctx, node, gpu, rows, worldMat);
+        ctx->Release();
+        if (!ok) {
+            displayError(MString("gsPreprocessCheck: ") + name +
+                         " was not drawn in the last viewport frame (or was outside the view).");
+            return MS::kFailure;
+        }
+
+        PreprocessCamera cam;
+        std::memcpy(cam.viewMat, mgr.viewMatrix(), sizeof(cam.viewMat));
+        std::memcpy(cam.projMat, mgr.projMatrix(), sizeof(cam.projMat));
+        std::memcpy(cam.cameraPos, mgr.cameraPosition(), sizeof(cam.cameraPos));
+        std::memcpy(cam.tanHalfFov, mgr.tanHalfFov(), sizeof(cam.tanHalfFov));
+        cam.filmWidth        = (int)mgr.viewportWidth();
+        cam.filmHeight       = (int)mgr.viewportHeight();
+        cam.debugFixedRadius = mgr.debugFixedRadius();
+
+        const std::vector<uint32_t>& mask = node->maskShadow();
+        PreprocessOutputs cpu;
+        auto t0 = std::chrono::steady_clock::now();
+        SplatPreprocess::run(node->gaussianData(), rows, worldMat, cam,
+                             mask.size() >= rows ? mask.data() : nullptr, cpu);
+        double ms = std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - t0).count();
+
+        PreprocessComparison c = SplatPreprocess::compare(cpu, gpu, rows);
+        displayInfo(MString("[gsPreprocessCheck] ") + name + ": " + (unsigned)rows +
+                    " splats, CPU float run " + ms + " ms; GPU against CPU: " + CheckFixtures::describe(c).c_str());
+        if (!c.passed) {
+            displayError(MString("gsPreprocessCheck: ") + (unsigned)c.violations +
+                         " values outside the tolerance, " + (unsigned)c.cullMismatch +
+                         " splats culled by one side only.");
+            return MS::kFailure;
+        }
+        setResult(c.worstRatio);
+        return MS::kSuccess;
+    }
+
+    // --- Float against double on a file ---
+    GaussianData data;
+    if (!loadCheckInput(db, "gsPreprocessCheck", data)) return MS::kFailure;
+
+    CheckFixtures::PreprocessLayoutResult results[2];
+    CheckFixtures::preprocessCheck(data, iterations, results);
+
+    const size_t n = data.count();
+    float worst  = 0.f;
+    bool  passed = true;
+    for (const CheckFixtures::PreprocessLayoutResult& r : results) {
+        const PreprocessComparison& c = r.comparison;
+        displayInfo(MString("[gsPreprocessCheck] ") + (r.compact ? "compact" : "float") +
+                    " layout, " + (unsigned)n + " splats: float run best of " + iterations + " " +
+                    r.bestMs + " ms (" + (n / 1000.0) / std::max(r.bestMs, 1e-3) +
+                    " M splats/s); float against double: " + CheckFixtures::describe(c).c_str());
+        if (!c.passed) {
+            displayError(MString("gsPreprocessCheck: ") + (r.compact ? "compact" : "float") +
+                         " layout: " + (unsigned)c.violations + " values outside the tolerance, " +
+                         (unsigned)c.cullMismatch + " splats culled by one run only.");
+            passed = false;
+        }
+        worst = std::max(worst, c.worstRatio);
+    }
+    if (!passed) return MS::kFailure;
+    setResult(worst);
+    return MS::kSuccess;
+}
+
+// ===========================================================================
+// gsCullCheck
+// ===========================================================================
+const MString GSCullCheckCmd::commandName("gsCullCheck");
+
+MSyntax GSCullCheckCmd::newSyntax() {
+    MSyntax s;
+    s.addFlag("-f",  "-file",       MSyntax::kString);
+    s.addFlag("-s",  "-synthetic",  MSyntax::kLong);
+    s.addFlag("-o",  "-order",      MSyntax::kLong);
+    s.addFlag("-it", "-iterations", MSyntax::kLong);
+    return s;
+}
+
+MStatus GSCullCheckCmd::doIt(const MArgList& args) {
+    MStatus st;
+    MArgDatabase db(syntax(), args, &st);
+    if (!st) return st;
+
+    int iterations = 20, orderArg = (int)SplatOrder::Hilbert;
+    if (db.isFlagSet("-it")) db.getFlagArgument("-it", 0, iterations);
+    if (db.isFlagSet("-o"))  db.getFlagArgument("-o", 0, orderArg);
+    iterations = std::max(1, iterations);
+    if (orderArg != (int)SplatOrder::Morton && orderArg != (int)SplatOrder::Hilbert) {
+        displayError("gsCullCheck: -order must be 1 (Morton) or 2 (Hilbert).");
+        return MS::kFailure;
+    }
+    const SplatOrder order = (SplatOrder)orderArg;
+
+    GaussianData data;
+    if (!loadCheckInput(db, "gsCullCheck", data)) return MS::kFailure;
+
+    CheckFixtures::CheckReport report = CheckFixtures::cullCheck(data, order, iterations);
+    showReport("gsCullCheck", report);
+    if (!report.passed()) {
+        displayError(MString("gsCullCheck: ") + report.error.c_str());
+        return MS::kFailure;
+    }
+    setResult(report.value);
+    return MS::kSuccess;
+}
+
+// ===========================================================================
+// gsSortCheck
+// ===========================================================================
+const MString GSSortCheckCmd::commandName("gsSortCheck");
+
+MSyntax GSSortCheckCmd::newSyntax() {
+    MSyntax s;
+    s.addFlag("-v",  "-viewport",   MSyntax::kNoArg);
+    s.addFlag("-f",  "-file",       MSyntax::kString);
+    s.addFlag("-s",  "-synthetic",  MSyntax::kLong);
+    s.addFlag("-it", "-iterations", MSyntax::kLong);
+    return s;
+}
+
+MStatus GSSortCheckCmd::doIt(const MArgList& args) {
+    MStatus st;
+    MArgDatabase db(syntax(), args, &st);
+    if (!st) return st;
+
+    if ((int)db.isFlagSet("-v") + (int)db.isFlagSet("-f") + (int)db.isFlagSet("-s") != 1) {
+        displayError("gsSortCheck: give exactly one of -viewport, -file or -synthetic.");
+        return MS::kFailure;
+    }
+    int iterations = 3;
+    if (db.isFlagSet("-it")) db.getFlagArgument("-it", 0, iterations);
+    iterations = std::max(1, iterations);
+
+    // --- Draw list of the last viewport frame ---
+    if (db.isFlagSet("-v")) {
+        MHWRender::MRenderer* renderer = MHWRender::MRenderer::theRenderer();
+        ID3D11Device* device = renderer ? (ID3D11Device*)renderer->GPUDeviceHandle() : nullptr;
+        ID3D11DeviceContext* ctx = nullptr;
+        if (device) device->GetImmediateContext(&ctx);
+        if (!ctx) {
+            displayError("gsSortCheck: no DX11 device (is Viewport 2.0 using DirectX 11?)");
+            return MS::kFailure;
+        }
+        GaussianRenderManager& mgr = GaussianRenderManager::instance();
+        std::vector<uint32_t> slots;
+        std::vector<float> depth, radius;
+        bool ok = mgr.readDrawList(device, ctx, slots, depth, radius);
+        ctx->Release();
+        if (!ok) {
+            displayError("gsSortCheck: nothing was drawn in the last viewport frame.");
+            return MS::kFailure;
+        }
+
+        const size_t N = radius.size();
+        size_t drawn = 0;
+        for (float r : radius) drawn += r > 0.f;
+        std::vector<uint8_t> seen(N, 0);
+        size_t bad = 0;
+        for (uint32_t s : slots) {
+            if (s >= N || seen[s] || !(radius[s] > 0.f)) { bad++; continue; }
+            seen[s] = 1;
+        }
+
+        // Far to near and equal keys in slot order (the sort is stable).
+        // Quantised keys are recomputed on the CPU, whose rounding may put
+        // a splat one step off the GPU's, so they only check the order
+        // within one step.
+        const int bits = (int)mgr.sortKeyBits();
+        std::vector<uint32_t> keys(slots.size());
+        for (size_t i = 0; i < slots.size(); i++)
+            keys[i] = slots[i] < N ? SplatSort::depthKey(depth[slots[i]]) : 0u;
+        SplatSort::quantizeKeys(keys, bits, mgr.projMatrix());
+        size_t unordered = 0;
+        for (size_t i = 1; i < slots.size(); i++) {
+            if (bits < SplatSort::kFullKeyBits)
+                unordered += keys[i - 1] > keys[i] + 1;
+            else
+                unordered += keys[i - 1] > keys[i] || (keys[i - 1] == keys[i] && slots[i - 1] > slots[i]);
+        }
+        displayInfo(MString("[gsSortCheck] viewport: ") + (unsigned)slots.size() + " slots in the draw list, " +
+                    (unsigned)drawn + " of " + (unsigned)N + " visible slots drawn by preprocess, " +
+                    bits + "-bit keys");
+        if (bad || unordered || slots.size() != drawn) {
+            displayError(MString("gsSortCheck: ") + (unsigned)bad + " entries not a drawn slot or repeated, " +
+                         (unsigned)unordered + " out of order, " + (unsigned)slots.size() +
+                         " entries for " + (unsigned)drawn + " drawn slots.");
+            return MS::kFailure;
+        }
+        setResult((int)slots.size());
+        return MS::kSuccess;
+    }
+
+    // --- CPU reference against plain filtering and sorting ---
+    GaussianData data;
+    if (!loadCheckInput(db, "gsSortCheck", data)) return MS::kFailure;
+
+    CheckFixtures::CheckReport report = CheckFixtures::sortCheck(data, iterations);
+    showReport("gsSortCheck", report);
+    if (!report.passed()) {
+        displayError(MString("gsSortCheck: ") + report.error.c_str());
+        return MS::kFailure;
+    }
+    setResult(report.value);
+    return MS::kSuccess;
+}
+
+// ===========================================================================
+// gsBenchSort
+// ===========================================================================
+const MString GSBenchSortCmd::commandName("gsBenchSort");
+
+MSyntax GSBenchSortCmd::newSyntax() {
+    MSyntax s;
+    s.addFlag("-c",  "-count",      MSyntax::kLong);
+    s.addFlag("-it", "-iterations", MSyntax::kLong);
+    return s;
+}
+
+MStatus GSBenchSortCmd::doIt(const MArgList& args) {
+    MStatus st;
+    MArgDatabase db(syntax(), args, &st);
+    if (!st) return st;
+
+    int count = 1 << 22, iterations = 3;
+    if (db.isFlagSet("-c"))  db.getFlagArgument("-c", 0, count);
+    if (db.isFlagSet("-it")) db.getFlagArgument("-it", 0, iterations);
+    if (count <= 0) {
+        displayError("gsBenchSort: -count must be positive.");
+        return MS::kFailure;
+    }
+
+    CheckFixtures::CheckReport report = CheckFixtures::benchSort((size_t)count, iterations);
+    showReport("gsBenchSort", report);
+    if (!report.passed()) {
+        displayError(MString("gsBenchSort: ") + report.error.c_str());
+        return MS::kFailure;
+    }
+    setResult(report.value);
+    return MS::kSuccess;
+}
+
+// ===========================================================================
+// gsSortPrecision
+// ===========================================================================
+const MString GSSortPrecisionCmd::commandName("gsSortPrecision");
+
+MSyntax GSSortPrecisionCmd::newSyntax() {
+    MSyntax s;
+    s.addFlag("-f",  "-file",       MSyntax::kString);
+    s.addFlag("-s",  "-synthetic",  MSyntax::kLong);
+    s.addFlag("-vw", "-views",      MSyntax::kLong);
+    s.makeFlagMultiUse("-f");
+    return s;
+}
+
+MStatus GSSortPrecisionCmd::doIt(const MArgList& args) {
+    MStatus st;
+    MArgDatabase db(syntax(), args, &st);
+    if (!st) return st;
+
+    const unsigned numFiles = db.numberOfFlagUses("-f");
+    if ((numFiles > 0) == db.isFlagSet("-s")) {
+        displayError("gsSortPrecision: give -file (one or more) or -synthetic.");
+        return MS::kFailure;
+    }
+    int views = 8;
+    if (db.isFlagSet("-vw")) db.getFlagArgument("-vw", 0, views);
+
+    CheckFixtures::SortPrecision precision(views);
+    const unsigned numInputs = numFiles > 0 ? numFiles : 1;
+    for (unsigned input = 0; input < numInputs; input++) {
+        GaussianData data;
+        if (!loadCheckInput(db, "gsSortPrecision", data, nullptr, input)) return MS::kFailure;
+        MString name = "synthetic";
+        if (numFiles > 0) {
+            MArgList fileArgs;
+            db.getFlagArgumentList("-f", input, fileArgs);
+            name = fileArgs.asString(0);
+        }
+        precision.addScene(name.asChar(), data);
+    }
+
+    CheckFixtures::CheckReport report = precision.finish();
+    showReport("gsSortPrecision", report);
+    if (!report.passed()) {
+        displayError(MString("gsSortPrecision: ") + report.error.c_str());
+        return MS::kFailure;
+    }
+    MIntArray result;
+    for (size_t inversions : precision.inversions())
+        result.append((int)std::min<size_t>(inversions, 0x7FFFFFFF));
+    setResult(result);
+    return MS::kSuccess;
+}
+
+// ===========================================================================
+// gsCoherenceCheck
+// ===========================================================================
+const MString GSCoherenceCheckCmd::commandName("gsCoherenceCheck");
+
+MSyntax GSCoherenceCheckCmd::newSyntax() {
+    MSyntax s;
+    s.addFlag("-f",  "-file",       MSyntax::kString);
+    s.addFlag("-s",  "-synthetic",  MSyntax::kLong);
+    s.addFlag("-fr", "-frames",     MSyntax::kLong);
+    s.addFlag("-kb", "-keyBits",    MSyntax::kLong);
+    return s;
+}
+
+MStatus GSCoherenceCheckCmd::doIt(const MArgList& args) {
+    MStatus st;
+    MArgDatabase db(syntax(), args, &st);
+    if (!st) return st;
+
+    int frames = 8, keyBits = SplatSort::kFullKeyBits;
+    if (db.isFlagSet("-fr")) db.getFlagArgument("-fr", 0, frames);
+    if (db.isFlagSet("-kb")) db.getFlagArgument("-kb", 0, keyBits);
+
+    GaussianData data;
+    if (!loadCheckInput(db, "gsCoherenceCheck", data)) return MS::kFailure;
+
+    CheckFixtures::CheckReport report = CheckFixtures::coherenceCheck(data, frames, keyBits);
+    showReport("gsCoherenceCheck", report);
+    if (!report.passed()) {
+        displayError(MString("gsCoherenceCheck: ") + report.error.c_str());
+        return MS::kFailure;
+    }
+    setResult(report.value);
+    return MS::kSuccess;
+}
@@ -0,0 +1,245 @@
+#pragma once
+
+#include <maya/MPxCommand.h>
+#include <maya/MString.h>
+#include <maya/MSyntax.h>
+
+// ---------------------------------------------------------------------------
+// Check and benchmark commands. Those reading splats take -file <path> or
+// -synthetic <count> (random splats in a temporary file, CheckFixtures);
+// the cameras they look through come from CheckFixtures too.
+// ---------------------------------------------------------------------------
+
+// gsBenchPLY -file <path> | -synthetic <count> [-iterations <n>]
+// Times PLYReader::readStream (ifstream, row-by-row) against PLYReader::read
+// (memory-mapped) with and without the fixed-layout decoders, and against a
+// plain memcpy of the file. -synthetic writes a canonical 3DGS file of
+// <count> random splats to the temp directory first. Fails when the generic
+// and fixed-layout decoders differ at all or the stream reader differs
+// beyond CheckFixtures::kStreamReadTolerance; returns the speedup (stream
+// time / mapped time). The checks are CheckFixtures::benchPLY, which the
+// headless gsBenchPLY tool runs too.
+class GSBenchPLYCmd : public MPxCommand {
+public:
+    MStatus doIt(const MArgList& args) override;
+    bool    isUndoable() const override { return false; }
+    static void*    creator()   { return new GSBenchPLYCmd; }
+    static MSyntax  newSyntax();
+    static const MString commandName;
+};
+
+// gsCompactCheck -file <path> | -synthetic <count> [-shDegree <n>] [-iterations <n>]
+// Encodes a file into compact storage (gaussianSplat.compactStorage) and
+// checks every element against the SplatCompact error bounds. Reports the
+// memory before/after, best encode and decode times and the largest error
+// per attribute; fails if any element is out of bounds, also with one
+// chunk collapsed onto a single point. Returns the largest error / bound
+// ratio. The checks are CheckFixtures::compactCheck, which the headless
+// gsCompactCheck tool runs too.
+class GSCompactCheckCmd : public MPxCommand {
+public:
+    MStatus doIt(const MArgList& args) override;
+    bool    isUndoable() const override { return false; }
+    static void*    creator()   { return new GSCompactCheckCmd; }
+    static MSyntax  newSyntax();
+    static const MString commandName;
+};
+
+// gsBenchKernels [-count <n>] [-iterations <n>] [-simd <bool>]
+// Microbenchmark of the SplatKernels load transforms (exp scales, normalise
+// quaternions, bbox; SH DC + sigmoid display colours) on <count> random
+// splats (default 1M), scalar against the SIMD level this CPU supports, on
+// one thread. Checks both give identical bits and that exp/sigmoid stay
+// within their documented error bound (CheckFixtures::benchKernels, also
+// run headless by tools/gsBenchKernels); returns the finalize speedup.
+// -simd false forces the scalar kernels for the rest of the session (true
+// restores runtime dispatch).
+class GSBenchKernelsCmd : public MPxCommand {
+public:
+    MStatus doIt(const MArgList& args) override;
+    bool    isUndoable() const override { return false; }
+    static void*    creator()   { return new GSBenchKernelsCmd; }
+    static MSyntax  newSyntax();
+    static const MString commandName;
+};
+
+// gsBenchOrder -file <path> | -synthetic <count> [-order <1|2>] [-iterations <n>]
+// Reorders a file along a Morton (1) or Hilbert (2, default) curve as
+// gaussianSplat.splatOrder does, and checks the result is a permutation of
+// the file rows. Reports the key/sort/gather times, the mean distance
+// between consecutive splats, the mean compact chunk step (SplatCompact)
+// and the best rect-selection pass (GaussianRenderManager::selectInRect
+// over the centre of the bbox) in file and curve order. Returns the
+// selection speedup.
+class GSBenchOrderCmd : public MPxCommand {
+public:
+    MStatus doIt(const MArgList& args) override;
+    bool    isUndoable() const override { return false; }
+    static void*    creator()   { return new GSBenchOrderCmd; }
+    static MSyntax  newSyntax();
+    static const MString commandName;
+};
+
+// gsPoolCheck [-operations <n>] [-seed <n>]
+// Runs <n> (default 200000) random allocate / free / grow steps on the
+// RangeAllocator behind the render manager's input pool, against a
+// brute-force model of every unit's owner. Fails on an overlapping range, a
+// missed fit, a wrong free size or an inconsistent free list. Then fills the
+// surviving ranges through a CopyPlan run with memcpy, as the pool is filled
+// on the GPU, and checks the bytes, the merging of streamed halves and that
+// out-of-bounds or overlapping plans are rejected. Reports the final
+// capacity, use and fragmentation, and the live render pool; returns the
+// number of steps run. The checks are CheckFixtures::poolCheck, which the
+// headless gsPoolCheck tool runs too.
+class GSPoolCheckCmd : public MPxCommand {
+public:
+    MStatus doIt(const MArgList& args) override;
+    bool    isUndoable() const override { return false; }
+    static void*    creator()   { return new GSPoolCheckCmd; }
+    static MSyntax  newSyntax();
+    static const MString commandName;
+};
+
+// gsPageCheck [-iterations <n>] [-seed <n>]
+// Checks the paging behind the large GPU columns (PageLayout, PagedBuffer)
+// without a device. For every column stride, <n> (default 20000) random
+// ranges of columns up to PageLayout's limits (256M rows, 3G SH values) are
+// split at page boundaries and copied between paged columns through
+// CopyPlan::addPaged; the pieces must tile the range inside their pages and
+// the plans must pass CopyPlan::validate against the page sizes. A
+// 100M-splat dataset at SH degree 3 must fit, float and compact. Then runs
+// such plans with memcpy on small pages (a few elements each) and compares
+// every element. Returns the number of ranges checked. The checks are
+// CheckFixtures::pageCheck, which the headless gsPageCheck tool runs too.
+class GSPageCheckCmd : public MPxCommand {
+public:
+    MStatus doIt(const MArgList& args) override;
+    bool    isUndoable() const override { return false; }
+    static void*    creator()   { return new GSPageCheckCmd; }
+    static MSyntax  newSyntax();
+    static const MString commandName;
+};
+
+// gsPreprocessCheck -node <gaussianSplat> | -file <path> | -synthetic <count> [-iterations <n>]
+// Checks the preprocess stage against SplatPreprocess, the CPU reference of
+// the kernel. With -file or -synthetic, frames the splats with a synthetic
+// camera and instance transform and compares a float run (the kernel's
+// precomputed covariance and world * view) against a double run (the
+// unfactored per-splat transforms), for the float and the compact
+// (SplatCompact) layout; reports the best
+// float run time of <n> (default 3). With -node, reads back that node's
+// outputs from the last viewport frame and compares them against a float
+// run with the same camera, transform and mask. Fails when a comparison is
+// outside PreprocessTolerance; returns the worst difference / tolerance.
+class GSPreprocessCheckCmd : public MPxCommand {
+public:
+    MStatus doIt(const MArgList& args) override;
+    bool    isUndoable() const override { return false; }
+    static void*    creator()   { return new GSPreprocessCheckCmd; }
+    static MSyntax  newSyntax();
+    static const MString commandName;
+};
+
+// gsCullCheck -file <path> | -synthetic <count> [-order <1|2>] [-iterations <n>]
+// Checks the chunk hierarchy behind in-instance culling (SplatBVH) against
+// SplatPreprocess. Reorders the splats along a Morton (1) or Hilbert (2,
+// default) curve, builds the hierarchy in file and curve order and, for <n>
+// (default 20) random cameras in and around the bbox, culls it and runs the
+// float reference. Fails when a drawn splat lies outside the kept ranges.
+// Reports the rows kept against the rows drawn, the nodes tested and the
+// traversal time in each order, and the hierarchy's build time and size;
+// returns the preprocess work saved in curve order (rows / rows kept). The
+// checks are CheckFixtures::cullCheck, which the headless gsCullCheck tool
+// runs too.
+class GSCullCheckCmd : public MPxCommand {
+public:
+    MStatus doIt(const MArgList& args) override;
+    bool    isUndoable() const override { return false; }
+    static void*    creator()   { return new GSCullCheckCmd; }
+    static MSyntax  newSyntax();
+    static const MString commandName;
+};
+
+// gsSortCheck -viewport | -file <path> | -synthetic <count> [-iterations <n>]
+// Checks the compaction of drawn splats before the sort (SplatSort, the CPU
+// reference of radix_sort.hlsl). With -file or -synthetic, runs the float
+// preprocess reference with a camera that sees part of the splats, checks
+// SplatSort::compact against a plain filter and SplatSort::onesweep and
+// radixSort against std::stable_sort, and reports the best of <n> (default
+// 3) times of keying and sorting every splat against compacting and sorting
+// the drawn ones; returns that speedup. With -viewport, reads back the draw
+// list of the last viewport frame and checks it holds every drawn slot
+// once, far to near and equal depths in slot order (within one step for
+// quantised keys, see SplatSort::keyBits); returns its length. The -file /
+// -synthetic checks are CheckFixtures::sortCheck, which the headless
+// gsSortCheck tool runs too.
+class GSSortCheckCmd : public MPxCommand {
+public:
+    MStatus doIt(const MArgList& args) override;
+    bool    isUndoable() const override { return false; }
+    static void*    creator()   { return new GSSortCheckCmd; }
+    static MSyntax  newSyntax();
+    static const MString commandName;
+};
+
+// gsBenchSort [-count <n>] [-iterations <n>]
+// Sorts <n> (default 4M) keys with values of uniform, depth, few-valued,
+// equal, sorted and reversed distributions through SplatSort::onesweep (the
+// single-pass sort radix_sort.hlsl runs) and SplatSort::radixSort (the
+// multi-pass one it replaced). Fails unless both match std::stable_sort
+// exactly, values included. Reports the best of <n> (default 3) times of
+// the three per distribution; returns the geometric-mean speedup of
+// onesweep over radixSort. The checks are CheckFixtures::benchSort, which
+// the headless gsBenchSort tool runs too.
+class GSBenchSortCmd : public MPxCommand {
+public:
+    MStatus doIt(const MArgList& args) override;
+    bool    isUndoable() const override { return false; }
+    static void*    creator()   { return new GSBenchSortCmd; }
+    static MSyntax  newSyntax();
+    static const MString commandName;
+};
+
+// gsSortPrecision -file <path> [-file <path> ...] | -synthetic <count> [-views <n>]
+// Measures the ordering error of reduced-precision sort keys
+// (SplatSort::keyBits) to choose a gaussianSplat.sortKeyBits. For every
+// scene, runs the float preprocess reference from the framing view and
+// <n> - 1 (default 8 in all) random cameras in and around the bbox, then
+// quantises and sorts the drawn splats at 12, 16, 20 and 24 bits as the GPU
+// does, and counts the inversions: pairs of splats whose footprints overlap
+// on screen drawn nearer first. Reports them per scene and, over all
+// scenes, per 1000 drawn splats with the quantise and sort time against
+// full 32-bit keys. Returns the inversions per precision; fails when the
+// last, 32-bit, is not 0. The measurement is CheckFixtures::SortPrecision,
+// which the headless gsSortPrecision tool runs too.
+class GSSortPrecisionCmd : public MPxCommand {
+public:
+    MStatus doIt(const MArgList& args) override;
+    bool    isUndoable() const override { return false; }
+    static void*    creator()   { return new GSSortPrecisionCmd; }
+    static MSyntax  newSyntax();
+    static const MString commandName;
+};
+
+// gsCoherenceCheck -file <path> | -synthetic <count> [-frames <n>] [-keyBits <b>]
+// Checks sorting from the last frame's order (SortCoherence, the CPU
+// reference of the incremental sort in radix_sort.hlsl). From the framing
+// view, moves the camera <n> (default 8) frames in each of five ways: not
+// at all, panning, dollying, turning slowly and orbiting fast, runs the
+// float preprocess reference with <b>-bit keys (default 32) and sorts each
+// frame as GaussianRenderManager::render would: reused, incrementally or
+// in full, as SortCoherence::classify decides. Fails unless every frame's
+// draw list matches SplatSort::onesweep (keys exactly, the same slots) and
+// the unmoved camera reuses its list. Reports per motion the frames of
+// each kind, the frames the fix-up held and the incremental against the
+// full sort time; returns the fraction of incremental frames that held.
+// The checks are CheckFixtures::coherenceCheck, which the headless
+// gsCoherenceCheck tool runs too.
+class GSCoherenceCheckCmd : public MPxCommand {
+public:
+    MStatus doIt(const MArgList& args) override;
+    bool    isUndoable() const override { return false; }
+    static void*    creator()   { return new GSCoherenceCheckCmd; }
+    static MSyntax  newSyntax();
+    static const MString commandName;
+};
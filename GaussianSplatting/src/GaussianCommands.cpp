@@ -0,0 +1,132 @@
+#define NOMINMAX
+#include "GaussianCommands.h"
+#include "GaussianNode.h"
+#include "SplatCache.h"
+#include "SplatDataset.h"
+
+#include <maya/MGlobal.h>
+#include <maya/MArgDatabase.h>
+#include <maya/MSelectionList.h>
+#include <maya/MItDependencyNodes.h>
+#include <maya/MFnDependencyNode.h>
+#include <maya/MIntArray.h>
+#include <maya/MStringArray.h>
+
+#include <vector>
+
+// ===========================================================================
+// Helpers
+// ===========================================================================
+namespace {
+
+GaussianNode* gaussianNodeFromObject(const MObject& obj) {
+    MFnDependencyNode fn(obj);
+    if (fn.typeName() != GaussianNode::typeName) return nullptr;
+    return static_cast<GaussianNode*>(fn.userNode());
+}
+
+} // namespace
+
+// ===========================================================================
+// gsCancelLoad
+// ===========================================================================
+const MString GSCancelLoadCmd::commandName("gsCancelLoad");
+
+MSyntax GSCancelLoadCmd::newSyntax() {
+    MSyntax s;
+    s.addFlag("-n", "-node", MSyntax::kString);
+    return s;
+}
+
+MStatus GSCancelLoadCmd::doIt(const MArgList& args) {
+    MStatus st;
+    MArgDatabase db(syntax(), args, &st);
+    if (!st) return st;
+
+    std::vector<GaussianNode*> nodes;
+    if (db.isFlagSet("-n")) {
+        MString name; db.getFlagArgument("-n", 0, name);
+        MSelectionList sel;
+        MObject obj;
+        GaussianNode* node = nullptr;
+        if (sel.add(name) == MS::kSuccess && sel.getDependNode(0, obj) == MS::kSuccess)
+            node = gaussianNodeFromObject(obj);
+        if (!node) {
+            displayError(MString("gsCancelLoad: no gaussianSplat named ") + name);
+            return MS::kFailure;
+        }
+        nodes.push_back(node);
+    } else {
+        for (MItDependencyNodes it(MFn::kPluginLocatorNode); !it.isDone(); it.next())
+            if (GaussianNode* node = gaussianNodeFromObject(it.thisNode())) nodes.push_back(node);
+    }
+
+    int cancelled = 0;
+    for (GaussianNode* node : nodes) {
+        if (!node->isLoading()) continue;
+        node->cancelLoad();
+        cancelled++;
+    }
+    setResult(cancelled);
+    return MS::kSuccess;
+}
+
+// ===========================================================================
+// gsCacheStats
+// ===========================================================================
+const MString GSCacheStatsCmd::commandName("gsCacheStats");
+
+MSyntax GSCacheStatsCmd::newSyntax() {
+    MSyntax s;
+    s.addFlag("-r", "-reset",  MSyntax::kNoArg);
+    s.addFlag("-e", "-enable", MSyntax::kBoolean);
+    return s;
+}
+
+MStatus GSCacheStatsCmd::doIt(const MArgList& args) {
+    MStatus st;
+    MArgDatabase db(syntax(), args, &st);
+    if (!st) return st;
+
+    if (db.isFlagSet("-e")) {
+        bool on = true;
+        db.getFlagArgument("-e", 0, on);
+        SplatCache::setEnabled(on);
+    }
+
+    MIntArray result;
+    result.append((int)SplatCache::hits());
+    result.append((int)SplatCache::misses());
+    displayInfo(MString("[gsCacheStats] ") + result[0] + " hits, " + result[1] + " misses (cache " +
+                (SplatCache::enabled() ? "on" : "off") + ")");
+    if (db.isFlagSet("-r")) SplatCache::resetStats();
+    setResult(result);
+    return MS::kSuccess;
+}
+
+// ===========================================================================
+// gsDatasetStats
+// ===========================================================================
+const MString GSDatasetStatsCmd::commandName("gsDatasetStats");
+
+MSyntax GSDatasetStatsCmd::newSyntax() {
+    return MSyntax();
+}
+
+MStatus GSDatasetStatsCmd::doIt(const MArgList&) {
+    MStringArray result;
+    size_t totalBytes = 0;
+    long   totalNodes = 0;
+    for (const SplatDataset::Info& info : SplatDataset::liveDatasets()) {
+        MString line(info.path.c_str());
+        line += MString(": ") + (int)info.owners + " nodes, " + (unsigned)info.splats + " splats, " +
+                (unsigned)(info.bytes >> 20) + " MB" + (info.loading ? " (loading)" : "");
+        result.append(line);
+        totalBytes += info.bytes;
+        totalNodes += info.owners;
+    }
+    displayInfo(MString("[gsDatasetStats] ") + result.length() + " datasets for " + (int)totalNodes +
+                " nodes, " + (unsigned)(totalBytes >> 20) + " MB");
+    setResult(result);
+    return MS::kSuccess;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <maya/MPxCommand.h>
+#include <maya/MString.h>
+#include <maya/MSyntax.h>
+
+// ---------------------------------------------------------------------------
+// Loader / dataset commands (editing commands live in GaussianSelection,
+// checks and benchmarks in GaussianCheckCommands).
+// ---------------------------------------------------------------------------
+
+// gsCancelLoad [-node <gaussianSplat>]
+// Cancels the background PLY load of one node, or of every node that is
+// still loading. Returns the number of loads cancelled.
+class GSCancelLoadCmd : public MPxCommand {
+public:
+    MStatus doIt(const MArgList& args) override;
+    bool    isUndoable() const override { return false; }
+    static void*    creator()   { return new GSCancelLoadCmd; }
+    static MSyntax  newSyntax();
+    static const MString commandName;
+};
+
+// gsCacheStats [-reset] [-enable <bool>]
+// Reports the SplatCache sidecar hit/miss counters as [hits, misses].
+// -reset zeroes them afterwards; -enable turns cache use on or off for
+// loads started from now on.
+class GSCacheStatsCmd : public MPxCommand {
+public:
+    MStatus doIt(const MArgList& args) override;
+    bool    isUndoable() const override { return false; }
+    static void*    creator()   { return new GSCacheStatsCmd; }
+    static MSyntax  newSyntax();
+    static const MString commandName;
+};
+
+// gsDatasetStats
+// Lists the datasets shared between gaussianSplat nodes (SplatDataset):
+// one "<path>: <nodes> nodes, <splats> splats, <MB> MB" string each.
+class GSDatasetStatsCmd : public MPxCommand {
+public:
+    MStatus doIt(const MArgList& args) override;
+    bool    isUndoable() const override { return false; }
+    static void*    creator()   { return new GSDatasetStatsCmd; }
+    static MSyntax  newSyntax();
+    static const MString commandName;
+};
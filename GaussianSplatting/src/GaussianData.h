@@ -3,54 +3,128 @@
 #include <cstdint>
 #include <cstddef>
 
-// Number of SH coefficients per channel stored per splat (degree 0..3 = 16 groups)
+// Highest SH degree a PLY can carry, and the matching number of float3 SH
+// groups per splat. A dataset may store fewer (GaussianData::shDegree).
+static constexpr int kMaxSHDegree      = 3;
 static constexpr int kSHCoeffsPerSplat = 16;
 
+// float3 SH groups per splat at SH degree d: 1, 4, 9, 16
+static constexpr int shCoeffsForDegree(int d) { return (d + 1) * (d + 1); }
+
 // Selection mask bit layout (1 uint per splat, shared CPU/GPU).
 // bit 0: selected   -- highlighted in viewport
 // bit 1: deleted    -- soft-deleted (radius=0 in preprocess, skipped on save)
 static constexpr uint32_t kMaskBitSelected = 1u;
 static constexpr uint32_t kMaskBitDeleted  = 2u;
 
-// Raw per-splat data as parsed from PLY
-struct GaussianSplat {
-    float position[3];  // x, y, z  (world space)
-    float f_dc[3];      // SH degree-0 color coefficients
-    float f_rest[45];   // SH degree 1-3 rest coefficients (15 groups × 3 channels); 0 if absent
-    float opacity;      // raw logit opacity
-    float scale[3];     // log-scale (exp needed before use)
-    float rotation[4];  // quaternion w,x,y,z
+// Number of floats per splat held by GaussianData at kMaxSHDegree (3 + 3 + 4 + 1 + 48)
+static constexpr int kFloatsPerSplat = 3 + 3 + 4 + 1 + kSHCoeffsPerSplat * 3;
+
+// Compact storage (gaussianSplat.compactStorage, see SplatCompact.h).
+// Consecutive runs of kCompactChunkSplats splats share one quantisation box.
+static constexpr uint32_t kCompactChunkSplats = 256;
+
+// fp16 SH values stored per splat at SH degree d, padded to whole uints
+static constexpr int compactSHHalfs(int d) { return (shCoeffsForDegree(d) * 3 + 1) & ~1; }
+
+// position = origin + q * step, q = unorm16 per axis
+struct CompactChunk {
+    float origin[3];
+    float step[3];
 };
 
-// CPU-side container + flattened GPU-ready arrays
-struct GaussianData {
-    std::vector<GaussianSplat> splats;
+// Packed columns, each a whole number of uints per splat so they upload
+// unchanged (the shaders unpack them with f16tof32 / bit shifts).
+struct CompactColumns {
+    std::vector<uint16_t>     positionQ;   // 4 per splat: x, y, z unorm16 in its chunk, 0
+    std::vector<CompactChunk> chunks;      // ceil(N / kCompactChunkSplats)
+    std::vector<uint16_t>     scaleH;      // 4 per splat: fp16 log-scale x, y, z, 0
+    std::vector<uint32_t>     rotationQ;   // snorm8 w | x << 8 | y << 16 | z << 24
+    std::vector<uint16_t>     shH;         // compactSHHalfs(shDegree) fp16 per splat
 
-    // --- debug pass arrays (positions + RGBA color, flat) ---
-    // positions = [x0,y0,z0, x1,y1,z1, ...]
-    std::vector<float> positions;
-    // colors    = [r0,g0,b0,a0, r1,g1,b1,a1, ...]  (a = sigmoid(opacity))
-    std::vector<float> colors;
+    bool empty() const { return rotationQ.empty(); }
+};
 
-    // --- compute-shader / production pass arrays ---
-    // Each is tightly packed, N elements, uploaded as StructuredBuffers.
+// CPU-side splat store: one structure-of-arrays, laid out exactly as the
+// GPU StructuredBuffers expect so it can be uploaded without another copy.
+// Values the PLY stores in a different form (log-scale, un-normalised
+// quaternion, planar f_rest) are converted once at load and re-derived on
+// demand by the accessors below (only gsSavePLY needs them).
+struct GaussianData {
+    // positions = [x0,y0,z0, x1,y1,z1, ...]  (object space)
+    std::vector<float> positions;
     std::vector<float> scaleWS;     // float3 per splat: exp(log_scale)
     std::vector<float> rotationWS;  // float4 per splat: quaternion w,x,y,z (normalised)
     std::vector<float> opacityRaw;  // float  per splat: raw logit
-    // SH coefficients: 16 float3 groups per splat, laid out as
-    //   [sh0_r, sh0_g, sh0_b,  sh1_r, sh1_g, sh1_b, ...,  sh15_r, sh15_g, sh15_b]
-    //   groups 0      = f_dc_0/1/2
-    //   groups 1..15  = f_rest_0..44  (may be zeroed if PLY has no higher-order SH)
-    std::vector<float> shCoeffs;    // float3 × 16 × N = 48 floats per splat
+    // SH coefficients: shStride() float3 groups per splat, laid out as
+    //   [sh0_r, sh0_g, sh0_b,  sh1_r, sh1_g, sh1_b, ...]
+    //   group  0      = f_dc_0/1/2
+    //   groups 1..    = f_rest_*  (only up to shDegree; nothing is stored above it)
+    std::vector<float> shCoeffs;    // float3 × shStride() × N
 
-    // Axis-aligned bounding box (object space), filled by buildGPUArrays()
+    // Compact datasets hold their positions, scales, rotations and SH here
+    // instead; the four float columns above are then empty (opacityRaw is
+    // kept). Read them through the per-row accessors below.
+    CompactColumns packed;
+
+    // File row of each row when the rows were reordered after loading
+    // (gaussianSplat.splatOrder, SplatOrder.h); empty otherwise.
+    std::vector<uint32_t> sourceIndex;
+    // > 1: the loader stored the rows stratified (PLYReadControl::sampleStride)
+    // and sourceIndex is empty. Use fileRow() rather than either field.
+    size_t sampleStride = 1;
+
+    // SH degree held in shCoeffs, and the degree the source file carried
+    // (shDegree <= sourceSHDegree). Set by the loader before resize().
+    int shDegree       = kMaxSHDegree;
+    int sourceSHDegree = kMaxSHDegree;
+
+    // Axis-aligned bounding box (object space), filled by finalize()
     float bboxMin[3] = { 0.f, 0.f, 0.f };
     float bboxMax[3] = { 0.f, 0.f, 0.f };
 
-    size_t count() const { return splats.size(); }
-    bool   empty() const { return splats.empty(); }
+    size_t count()   const { return opacityRaw.size(); }
+    // Row of the source file that row i was loaded from
+    size_t fileRow(size_t i) const;
+    bool   empty()   const { return opacityRaw.empty(); }
+    bool   compact() const { return !packed.empty(); }
+    // CPU bytes held by the columns
+    size_t memoryBytes() const;
+
+    // float3 SH groups / floats per splat in shCoeffs
+    int    shStride() const { return shCoeffsForDegree(shDegree); }
+    size_t shFloats() const { return (size_t)shStride() * 3; }
 
-    // Rebuild all flattened arrays from splats (call after loading)
-    void buildGPUArrays();
+    // Size every column for N splats at shDegree (contents unspecified).
+    // clear() empties the columns but keeps the SH degree fields.
+    void resize(size_t N);
     void clear();
+
+    // Loaders write PLY values straight into the columns (log-scale into
+    // scaleWS, raw quaternion into rotationWS), then call finalize to
+    // exp the scales, normalise the quaternions and compute the bbox.
+    // finalizeRange grows bmin/bmax; disjoint ranges may run concurrently.
+    void finalize();
+    void finalizeRange(size_t begin, size_t end, float bmin[3], float bmax[3]);
+
+    // f_rest_j of a file with `perChannel` rest coefficients per channel
+    // lives in SH group 1 + j % perChannel, channel j / perChannel (the PLY
+    // stores all red, then all green, then all blue). Returns the float
+    // offset inside a splat's SH block; only valid when that group is stored.
+    static size_t restSlot(int j, int perChannel = kSHCoeffsPerSplat - 1) {
+        return 3 + (size_t)(j % perChannel) * 3 + (size_t)(j / perChannel);
+    }
+
+    // ---- per-row values, valid for float and compact datasets ----
+    void position(size_t i, float out[3]) const;
+    void rotation(size_t i, float out[4]) const;   // normalised w,x,y,z
+    void shRow(size_t i, float* out) const;        // shFloats() floats
+
+    // ---- lazily derived PLY values ----
+    void logScale(size_t i, float out[3]) const;
+    void restCoeffs(size_t i, float out[45]) const;   // planar f_rest_0..44, 0 above shDegree
+    // Debug display colour: SH DC -> linear RGB, alpha = sigmoid(opacity).
+    // displayColors fills rows [begin, end), 4 floats each.
+    void displayColor(size_t i, float rgba[4]) const;
+    void displayColors(size_t begin, size_t end, float* rgba) const;
 };
@@ -1 +1,103 @@
-// GaussianDataNode is deprecated. All functionality merged into GaussianNode.
+#include "GaussianDataNode.h"
+
+#include <maya/MFnTypedAttribute.h>
+#include <maya/MFnNumericAttribute.h>
+#include <maya/MGlobal.h>
+#include <maya/MPlug.h>
+
+// ---------------------------------------------------------------------------
+// Static member definitions
+// ---------------------------------------------------------------------------
+MTypeId GaussianDataNode::typeId   { 0x00127A01 };
+MString GaussianDataNode::typeName { "gaussianSplatData" };
+
+MObject GaussianDataNode::aFilePath;
+MObject GaussianDataNode::aSHDegree;
+MObject GaussianDataNode::aCompactStorage;
+MObject GaussianDataNode::aSplatOrder;
+MObject GaussianDataNode::aLoadProgress;
+MObject GaussianDataNode::aLoadTick;
+MObject GaussianDataNode::aOutData;
+
+// ---------------------------------------------------------------------------
+void* GaussianDataNode::creator() { return new GaussianDataNode(); }
+
+MStatus GaussianDataNode::initialize() {
+    MFnTypedAttribute   tAttr;
+    MFnNumericAttribute nAttr;
+
+    aFilePath = tAttr.create("filePath", "fp", MFnData::kString);
+    tAttr.setUsedAsFilename(true);
+    tAttr.setStorable(true);
+    CHECK_MSTATUS_AND_RETURN_IT(addAttribute(aFilePath));
+
+    aSHDegree = nAttr.create("shDegree", "shd", MFnNumericData::kInt, kMaxSHDegree);
+    nAttr.setMin(0);
+    nAttr.setMax(kMaxSHDegree);
+    nAttr.setStorable(true);
+    CHECK_MSTATUS_AND_RETURN_IT(addAttribute(aSHDegree));
+
+    aCompactStorage = nAttr.create("compactStorage", "cst", MFnNumericData::kBoolean, false);
+    nAttr.setStorable(true);
+    CHECK_MSTATUS_AND_RETURN_IT(addAttribute(aCompactStorage));
+
+    aSplatOrder = nAttr.create("splatOrder", "sor", MFnNumericData::kInt, (int)SplatOrder::File);
+    nAttr.setMin((int)SplatOrder::File);
+    nAttr.setMax((int)SplatOrder::Hilbert);
+    nAttr.setStorable(true);
+    CHECK_MSTATUS_AND_RETURN_IT(addAttribute(aSplatOrder));
+
+    aLoadProgress = nAttr.create("loadProgress", "lp", MFnNumericData::kFloat, 0.0f);
+    nAttr.setWritable(false);
+    nAttr.setStorable(false);
+    CHECK_MSTATUS_AND_RETURN_IT(addAttribute(aLoadProgress));
+
+    aLoadTick = nAttr.create("loadTick", "ltk", MFnNumericData::kInt, 0);
+    nAttr.setStorable(false);
+    nAttr.setHidden(true);
+    nAttr.setConnectable(false);
+    CHECK_MSTATUS_AND_RETURN_IT(addAttribute(aLoadTick));
+
+    aOutData = nAttr.create("outData", "od", MFnNumericData::kInt, 0);
+    nAttr.setWritable(false);
+    nAttr.setStorable(false);
+    CHECK_MSTATUS_AND_RETURN_IT(addAttribute(aOutData));
+
+    attributeAffects(aFilePath, aOutData);
+    attributeAffects(aFilePath, aLoadProgress);
+    attributeAffects(aSHDegree, aOutData);
+    attributeAffects(aSHDegree, aLoadProgress);
+    attributeAffects(aCompactStorage, aOutData);
+    attributeAffects(aCompactStorage, aLoadProgress);
+    attributeAffects(aSplatOrder, aOutData);
+    attributeAffects(aSplatOrder, aLoadProgress);
+    attributeAffects(aLoadTick, aOutData);
+    attributeAffects(aLoadTick, aLoadProgress);
+
+    return MS::kSuccess;
+}
+
+// ---------------------------------------------------------------------------
+// compute  --  same loading rules as GaussianNode::compute: a new path or
+// load setting acquires the (possibly shared) dataset, and every evaluation
+// picks up the rows finished so far.
+// ---------------------------------------------------------------------------
+MStatus GaussianDataNode::compute(const MPlug& plug, MDataBlock& dataBlock) {
+    if (plug != aOutData && plug != aLoadProgress)
+        return MS::kUnknownParameter;
+
+    MString newPath = dataBlock.inputValue(aFilePath).asString();
+    SplatDataset::Settings settings =
+        DatasetLoader::readSettings(dataBlock, aSHDegree, aCompactStorage, aSplatOrder);
+    dataBlock.inputValue(aLoadTick);
+
+    if (m_loader.changed(newPath, settings)) m_loader.begin(newPath, settings);
+    m_loader.poll();
+
+    const std::shared_ptr<SplatDataset>& ds = m_loader.dataset();
+    dataBlock.outputValue(aOutData).setInt(ds ? (int)ds->readyCount() : 0);
+    dataBlock.outputValue(aLoadProgress).setFloat(ds ? ds->progress() : 0.f);
+    dataBlock.setClean(aOutData);
+    dataBlock.setClean(aLoadProgress);
+    return MS::kSuccess;
+}
@@ -1,3 +1,55 @@
 #pragma once
-// GaussianDataNode is deprecated. Data now lives directly in GaussianNode.
-// This header is kept only so old includes compile without modification.
+#include <maya/MPxNode.h>
+#include <maya/MString.h>
+#include <maya/MTypeId.h>
+#include <maya/MObject.h>
+#include <memory>
+#include "DatasetLoader.h"
+#include "SplatDataset.h"
+
+// ---------------------------------------------------------------------------
+// GaussianDataNode  --  dependency node that owns one loaded splat file, for
+// drawing it several times.
+//
+// Connect outData to the inData of any number of gaussianSplat shapes; each
+// shape then shows this node's dataset under its own transform and ignores
+// its own filePath and load settings. The shapes share the CPU columns and
+// the GPU input buffers, and the render manager keeps a single copy of the
+// rows in its merged pool however many shapes draw them (see
+// GaussianRenderManager). Every shape still has its own selection mask.
+//
+// Attributes:
+//   filePath       (string, input) -- path to the .ply file
+//   shDegree       (int, 0-3)      -- as gaussianSplat.shDegree
+//   compactStorage (bool)          -- as gaussianSplat.compactStorage
+//   splatOrder     (int, 0-2)      -- as gaussianSplat.splatOrder
+//   loadProgress   (float, output) -- 0..1 while a background load runs
+//   outData        (int, output)   -- rows loaded so far; connect to
+//                                     gaussianSplat.inData
+// ---------------------------------------------------------------------------
+class GaussianDataNode : public MPxNode {
+public:
+    static void*   creator();
+    static MStatus initialize();
+
+    MStatus compute(const MPlug& plug, MDataBlock& dataBlock) override;
+
+    static MTypeId typeId;
+    static MString typeName;
+
+    static MObject aFilePath;
+    static MObject aSHDegree;
+    static MObject aCompactStorage;
+    static MObject aSplatOrder;
+    static MObject aLoadProgress;
+    static MObject aLoadTick;      // hidden; bumped by the load timer
+    static MObject aOutData;
+
+    // The dataset as of the last evaluation; null when filePath is empty or
+    // the load failed. Evaluate outData first to pick up attribute changes.
+    const std::shared_ptr<SplatDataset>& dataset() const { return m_loader.dataset(); }
+
+private:
+    // Connected shapes run their own loaders for the viewport refresh
+    DatasetLoader m_loader { this, aLoadTick, false };
+};
@@ -1,6 +1,5 @@
 #include "GaussianDrawOverride.h"
 #include "GaussianNode.h"
-// GaussianDataNode.h removed — data now lives in GaussianNode directly
 #include "GaussianRenderManager.h"
 #include "ShaderLoader.h"
 
@@ -78,11 +77,18 @@ GaussianDrawData::~GaussianDrawData() { releaseAll(); }
 void GaussianDrawData::releaseAll()
 {
     releaseDebugResources();
-    sharedSrvPositionWS = sharedSrvScale = sharedSrvRotation = nullptr;
-    sharedSrvOpacity = sharedSrvSHCoeffs = nullptr;
+    clearSharedSrvs();
     inputsReady = false;
 }
 
+void GaussianDrawData::clearSharedSrvs()
+{
+    std::fill(std::begin(sharedSrvPositionWS), std::end(sharedSrvPositionWS), nullptr);
+    std::fill(std::begin(sharedSrvOpacity),    std::end(sharedSrvOpacity),    nullptr);
+    std::fill(std::begin(sharedSrvSHCoeffs),   std::end(sharedSrvSHCoeffs),   nullptr);
+    sharedSrvChunks = nullptr;
+}
+
 void GaussianDrawData::releaseDebugResources()
 {
     SAFE_RELEASE(dbgVS);
@@ -98,14 +104,16 @@ void GaussianDrawData::releaseDebugResources()
 // ---------------------------------------------------------------------------
 // initDebugPipeline
 // ---------------------------------------------------------------------------
-bool GaussianDrawData::initDebugPipeline(ID3D11Device* device)
+bool GaussianDrawData::initDebugPipeline(ID3D11Device* device, bool compact)
 {
     HRESULT hr;
     std::string src = gs::LoadShader("debug.hlsl");
     if (src.empty()) return false;
 
+    const D3D_SHADER_MACRO compactDefines[] = { { "GS_COMPACT", "1" }, { nullptr, nullptr } };
     ID3DBlob* vsBlob = nullptr, *gsBlob = nullptr, *psBlob = nullptr;
-    if (!CompileStage(src.c_str(), src.size(), "VS", "vs_5_0", &vsBlob)) return false;
+    if (!CompileStage(src.c_str(), src.size(), "VS", "vs_5_0", &vsBlob,
+                      compact ? compactDefines : nullptr)) return false;
     if (!CompileStage(src.c_str(), src.size(), "GS", "gs_5_0", &gsBlob)) { vsBlob->Release(); return false; }
     if (!CompileStage(src.c_str(), src.size(), "PS", "ps_5_0", &psBlob)) { vsBlob->Release(); gsBlob->Release(); return false; }
 
@@ -152,7 +160,8 @@ bool GaussianDrawData::initDebugPipeline(ID3D11Device* device)
         if (FAILED(hr)) goto dbg_cleanup;
     }
 
-    dbgReady = true;
+    dbgReady   = true;
+    dbgCompact = compact;
 dbg_cleanup:
     vsBlob->Release(); gsBlob->Release(); psBlob->Release();
     if (!dbgReady) MGlobal::displayError("[GaussianSplat] Debug pipeline init failed.");
@@ -204,20 +213,8 @@ MUserData* GaussianDrawOverride::prepareForDraw(
     MHWRender::MRenderer* renderer = MHWRender::MRenderer::theRenderer();
     ID3D11Device* device = static_cast<ID3D11Device*>(renderer->GPUDeviceHandle());
 
-    // Init debug pipeline (lazy, once)
-    if (!data->dbgReady && device) {
-        if (data->initDebugPipeline(device))
-            MGlobal::displayInfo("[GaussianSplat] Debug pipeline: OK");
-        else
-            MGlobal::displayError("[GaussianSplat] Debug pipeline: FAILED");
-    }
-
     // Clear shared SRV refs each frame
-    data->sharedSrvPositionWS = nullptr;
-    data->sharedSrvScale      = nullptr;
-    data->sharedSrvRotation   = nullptr;
-    data->sharedSrvOpacity    = nullptr;
-    data->sharedSrvSHCoeffs   = nullptr;
+    data->clearSharedSrvs();
     data->inputsReady         = false;
     data->vertexCount         = 0;
     data->registeredWithManager = false;
@@ -226,6 +223,18 @@ MUserData* GaussianDrawOverride::prepareForDraw(
     MPlug dataReadyPlug(m_node->thisMObject(), GaussianNode::aDataReady);
     dataReadyPlug.asBool();
 
+    // Init debug pipeline (lazy; rebuilt when the node switches between
+    // float and compact storage)
+    bool compact = m_node->gaussianData().compact();
+    if (data->dbgReady && data->dbgCompact != compact)
+        data->releaseDebugResources();
+    if (!data->dbgReady && device) {
+        if (data->initDebugPipeline(device, compact))
+            MGlobal::displayInfo("[GaussianSplat] Debug pipeline: OK");
+        else
+            MGlobal::displayError("[GaussianSplat] Debug pipeline: FAILED");
+    }
+
     if (!m_node->hasData()) return data;
 
     // Lazy GPU upload of input buffers (owned by this node)
@@ -234,11 +243,12 @@ MUserData* GaussianDrawOverride::prepareForDraw(
     if (!m_node->areInputsReady()) return data;
 
     // Copy non-owning SRV pointers (for debug path)
-    data->sharedSrvPositionWS = m_node->srvPositionWS();
-    data->sharedSrvScale      = m_node->srvScale();
-    data->sharedSrvRotation   = m_node->srvRotation();
-    data->sharedSrvOpacity    = m_node->srvOpacity();
-    data->sharedSrvSHCoeffs   = m_node->srvSHCoeffs();
+    const SplatDataset& ds = *m_node->dataset();
+    ds.gpuPositionWS().srvs(data->sharedSrvPositionWS);
+    ds.gpuOpacity().srvs(data->sharedSrvOpacity);
+    ds.gpuSHCoeffs().srvs(data->sharedSrvSHCoeffs);
+    data->sharedSrvChunks     = ds.gpuChunks().srv(0);
+    data->shStride            = (uint32_t)m_node->gaussianData().shStride();
     data->inputsReady         = true;
 
     uint32_t N = m_node->splatCount();
@@ -284,6 +294,10 @@ MUserData* GaussianDrawOverride::prepareForDraw(
     MPlug rmPlug(m_node->thisMObject(), GaussianNode::aRenderMode);
     data->renderMode = rmPlug.asInt();
 
+    // Sort key precision
+    MPlug skbPlug(m_node->thisMObject(), GaussianNode::aSortKeyBits);
+    data->sortKeyBits = skbPlug.asInt();
+
     // -----------------------------------------------------------------------
     // Register with GaussianRenderManager for merged production rendering
     // -----------------------------------------------------------------------
@@ -306,8 +320,10 @@ MUserData* GaussianDrawOverride::prepareForDraw(
     // handled inside registerInstance to prevent count multiplication when
     // Maya calls prepareForDraw multiple times per logical frame.
     RenderInstance inst;
-    inst.node       = m_node;
-    inst.splatCount = N;
+    inst.node          = m_node;
+    inst.dataset       = m_node->dataset().get();
+    inst.splatCount    = N;
+    inst.splatCapacity = m_node->splatCapacity();
     std::memcpy(inst.worldMat, data->worldMat, 64);
     mgr.registerInstance(inst);
     data->registeredWithManager = true;
@@ -365,7 +381,7 @@ void GaussianDrawOverride::draw(const MHWRender::MDrawContext& context,
     // -----------------------------------------------------------------------
     if (useProd && !mgr.renderedThisFrame())
     {
-        mgr.render(device, ctx, data->renderMode);
+        mgr.render(device, ctx, data->renderMode, data->sortKeyBits);
     }
     // If manager already rendered this frame, this draw() is a no-op for production.
     // The merged pipeline already drew ALL instances in one pass.
@@ -389,28 +405,33 @@ void GaussianDrawOverride::draw(const MHWRender::MDrawContext& context,
                 cb->pointSize = data->pointSize;
                 cb->vpWidth   = data->vpWidth;
                 cb->vpHeight  = data->vpHeight;
-                cb->shStride  = (uint32_t)kSHCoeffsPerSplat;
+                cb->shStride  = data->shStride;
                 ctx->Unmap(data->dbgCB, 0);
             }
         }
 
-        // Bind shared StructuredBuffers as VS SRVs
-        ID3D11ShaderResourceView* vsSRVs[] = {
-            data->sharedSrvPositionWS, data->sharedSrvOpacity, data->sharedSrvSHCoeffs
-        };
+        // Bind shared StructuredBuffers as VS SRVs: t0 position pages,
+        // t4 opacity pages, t8 SH pages, t56 chunks (debug.hlsl)
+        const UINT kRowPages = PageLayout::kMaxRowPages, kSHPages = PageLayout::kMaxSHPages;
+        const UINT kNumSRVs  = 2 * kRowPages + kSHPages + 1;
+        ID3D11ShaderResourceView* vsSRVs[kNumSRVs] = {};
+        std::copy_n(data->sharedSrvPositionWS, kRowPages, vsSRVs);
+        std::copy_n(data->sharedSrvOpacity,    kRowPages, vsSRVs + kRowPages);
+        std::copy_n(data->sharedSrvSHCoeffs,   kSHPages,  vsSRVs + 2 * kRowPages);
+        vsSRVs[kNumSRVs - 1] = data->sharedSrvChunks;
         ctx->IASetInputLayout(nullptr);
         ctx->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_POINTLIST);
         ctx->VSSetShader(data->dbgVS, nullptr, 0);
         ctx->VSSetConstantBuffers(0, 1, &data->dbgCB);
-        ctx->VSSetShaderResources(0, 3, vsSRVs);
+        ctx->VSSetShaderResources(0, kNumSRVs, vsSRVs);
         ctx->GSSetShader(data->dbgGS, nullptr, 0);
         ctx->GSSetConstantBuffers(0, 1, &data->dbgCB);
         ctx->PSSetShader(data->dbgPS, nullptr, 0);
         ctx->Draw(data->vertexCount, 0);
 
         // Unbind
-        ID3D11ShaderResourceView* nullSRVs[3] = {};
-        ctx->VSSetShaderResources(0, 3, nullSRVs);
+        ID3D11ShaderResourceView* nullSRVs[kNumSRVs] = {};
+        ctx->VSSetShaderResources(0, kNumSRVs, nullSRVs);
     }
 
     // Restore Maya state
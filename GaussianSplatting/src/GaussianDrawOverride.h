@@ -9,6 +9,7 @@
 #include <cstdint>
 
 #include "GaussianData.h"
+#include "PageLayout.h"
 
 class GaussianNode;
 
@@ -37,6 +38,7 @@ public:
     float        vpHeight     = 720.f;
     unsigned int vertexCount  = 0;
     int          renderMode   = 0;   // 0=auto, 1=debug, 2=production, 3=diagnostic
+    int          sortKeyBits  = 32;  // depth sort key precision (GaussianNode)
 
     // -----------------------------------------------------------------------
     // Debug pipeline  (VS+GS+PS, reads from shared StructuredBuffers)
@@ -51,17 +53,19 @@ public:
     ID3D11RasterizerState* rsState       = nullptr;
     ID3D11DepthStencilState* dsState     = nullptr;
 
-    bool dbgReady = false;
+    bool dbgReady   = false;
+    bool dbgCompact = false;   // debug shaders built for compact inputs
 
     // -----------------------------------------------------------------------
-    // Non-owning references to shared input SRVs (from GaussianDataNode).
+    // Non-owning references to shared input SRVs (from the node's SplatDataset),
+    // one per page (see PageLayout; null past the dataset's pages).
     // Refreshed every frame in prepareForDraw. Do NOT Release() these.
     // -----------------------------------------------------------------------
-    ID3D11ShaderResourceView* sharedSrvPositionWS = nullptr;
-    ID3D11ShaderResourceView* sharedSrvScale      = nullptr;
-    ID3D11ShaderResourceView* sharedSrvRotation   = nullptr;
-    ID3D11ShaderResourceView* sharedSrvOpacity    = nullptr;
-    ID3D11ShaderResourceView* sharedSrvSHCoeffs   = nullptr;
+    ID3D11ShaderResourceView* sharedSrvPositionWS[PageLayout::kMaxRowPages] = {};
+    ID3D11ShaderResourceView* sharedSrvOpacity[PageLayout::kMaxRowPages]    = {};
+    ID3D11ShaderResourceView* sharedSrvSHCoeffs[PageLayout::kMaxSHPages]    = {};
+    ID3D11ShaderResourceView* sharedSrvChunks     = nullptr;             // compact inputs only
+    uint32_t                  shStride            = kSHCoeffsPerSplat;   // float3 SH groups per splat
     bool inputsReady = false;
 
     // Whether this instance was registered with the RenderManager this frame
@@ -70,12 +74,12 @@ public:
     // -----------------------------------------------------------------------
     // Init / release
     // -----------------------------------------------------------------------
-    bool initDebugPipeline(ID3D11Device* device);
+    bool initDebugPipeline(ID3D11Device* device, bool compact);
+    void releaseDebugResources();
     void releaseAll();
+    void clearSharedSrvs();
 
 private:
-    void releaseDebugResources();
-
     GaussianDrawData(const GaussianDrawData&)            = delete;
     GaussianDrawData& operator=(const GaussianDrawData&) = delete;
 };
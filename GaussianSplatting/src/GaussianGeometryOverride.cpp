@@ -184,7 +184,7 @@ void GaussianGeometryOverride::populateGeometry(
         if (buf) {
             float* dst = static_cast<float*>(buf->acquire(count, /*writeOnly=*/true));
             if (dst) {
-                std::memcpy(dst, gd.colors.data(), count * 4 * sizeof(float));
+                gd.displayColors(0, count, dst);
                 buf->commit(dst);
             }
         }
@@ -1,9 +1,12 @@
 #include "GaussianNode.h"
-#include "PLYReader.h"
+#include "GaussianDataNode.h"
 
 #include <maya/MFnTypedAttribute.h>
 #include <maya/MFnNumericAttribute.h>
 #include <maya/MGlobal.h>
+#include <maya/MPlug.h>
+#include <maya/MPlugArray.h>
+#include <maya/MFnDependencyNode.h>
 
 #include <algorithm>
 #include <cstring>
@@ -18,13 +21,24 @@ MString GaussianNode::drawRegistrantId     { "gaussianSplatPlugin" };
 
 MObject GaussianNode::aFilePath;
 MObject GaussianNode::aDataReady;
+MObject GaussianNode::aLoadProgress;
+MObject GaussianNode::aLoadTick;
+MObject GaussianNode::aSHDegree;
+MObject GaussianNode::aCompactStorage;
+MObject GaussianNode::aSplatOrder;
+MObject GaussianNode::aInData;
 MObject GaussianNode::aPointSize;
 MObject GaussianNode::aRenderMode;
+MObject GaussianNode::aSortKeyBits;
+
+const GaussianData GaussianNode::s_emptyData;
 
 // ---------------------------------------------------------------------------
 void* GaussianNode::creator() { return new GaussianNode(); }
 
-GaussianNode::~GaussianNode() { releaseInputBuffers(); }
+GaussianNode::~GaussianNode() {
+    releaseData();
+}
 
 MStatus GaussianNode::initialize() {
     MFnTypedAttribute   tAttr;
@@ -41,6 +55,38 @@ MStatus GaussianNode::initialize() {
     nAttr.setHidden(true);
     CHECK_MSTATUS_AND_RETURN_IT(addAttribute(aDataReady));
 
+    aLoadProgress = nAttr.create("loadProgress", "lp", MFnNumericData::kFloat, 0.0f);
+    nAttr.setWritable(false);
+    nAttr.setStorable(false);
+    CHECK_MSTATUS_AND_RETURN_IT(addAttribute(aLoadProgress));
+
+    aLoadTick = nAttr.create("loadTick", "ltk", MFnNumericData::kInt, 0);
+    nAttr.setStorable(false);
+    nAttr.setHidden(true);
+    nAttr.setConnectable(false);
+    CHECK_MSTATUS_AND_RETURN_IT(addAttribute(aLoadTick));
+
+    aSHDegree = nAttr.create("shDegree", "shd", MFnNumericData::kInt, kMaxSHDegree);
+    nAttr.setMin(0);
+    nAttr.setMax(kMaxSHDegree);
+    nAttr.setStorable(true);
+    CHECK_MSTATUS_AND_RETURN_IT(addAttribute(aSHDegree));
+
+    aCompactStorage = nAttr.create("compactStorage", "cst", MFnNumericData::kBoolean, false);
+    nAttr.setStorable(true);
+    CHECK_MSTATUS_AND_RETURN_IT(addAttribute(aCompactStorage));
+
+    aSplatOrder = nAttr.create("splatOrder", "sor", MFnNumericData::kInt, (int)SplatOrder::File);
+    nAttr.setMin((int)SplatOrder::File);
+    nAttr.setMax((int)SplatOrder::Hilbert);
+    nAttr.setStorable(true);
+    CHECK_MSTATUS_AND_RETURN_IT(addAttribute(aSplatOrder));
+
+    aInData = nAttr.create("inData", "ind", MFnNumericData::kInt, 0);
+    nAttr.setStorable(false);
+    nAttr.setKeyable(false);
+    CHECK_MSTATUS_AND_RETURN_IT(addAttribute(aInData));
+
     aPointSize = nAttr.create("pointSize", "ps", MFnNumericData::kFloat, 4.0f);
     nAttr.setMin(0.5f);
     nAttr.setMax(64.0f);
@@ -55,186 +101,151 @@ MStatus GaussianNode::initialize() {
     nAttr.setKeyable(true);
     CHECK_MSTATUS_AND_RETURN_IT(addAttribute(aRenderMode));
 
+    aSortKeyBits = nAttr.create("sortKeyBits", "skb", MFnNumericData::kInt, 32);
+    nAttr.setMin(8);
+    nAttr.setMax(32);
+    nAttr.setStorable(true);
+    nAttr.setKeyable(false);
+    CHECK_MSTATUS_AND_RETURN_IT(addAttribute(aSortKeyBits));
+
     attributeAffects(aFilePath, aDataReady);
+    attributeAffects(aFilePath, aLoadProgress);
+    attributeAffects(aSHDegree, aDataReady);
+    attributeAffects(aSHDegree, aLoadProgress);
+    attributeAffects(aCompactStorage, aDataReady);
+    attributeAffects(aCompactStorage, aLoadProgress);
+    attributeAffects(aSplatOrder, aDataReady);
+    attributeAffects(aSplatOrder, aLoadProgress);
+    attributeAffects(aLoadTick, aDataReady);
+    attributeAffects(aLoadTick, aLoadProgress);
+    attributeAffects(aInData, aDataReady);
+    attributeAffects(aInData, aLoadProgress);
 
     return MS::kSuccess;
 }
 
 // ---------------------------------------------------------------------------
-// compute  --  triggered when filePath changes; loads the PLY file.
+// compute  --  triggered when filePath/shDegree/compactStorage/splatOrder
+// or inData change or the load timer ticks. Picks up the (possibly shared)
+// dataset for a new path, storage setting or data node and adopts finished
+// data.
 // ---------------------------------------------------------------------------
 MStatus GaussianNode::compute(const MPlug& plug, MDataBlock& dataBlock) {
-    if (plug != aDataReady)
+    if (plug != aDataReady && plug != aLoadProgress)
         return MS::kUnknownParameter;
 
-    MString newPath = dataBlock.inputValue(aFilePath).asString();
-
-    if (newPath != m_loadedPath) {
-        m_data.clear();
-        releaseInputBuffers();
-        m_loadedPath = newPath;
-
-        if (newPath.length() > 0) {
-            std::string err;
-            if (PLYReader::read(newPath.asChar(), m_data, err)) {
-                MGlobal::displayInfo(MString("[GaussianSplatData] Loaded ") +
-                                     (unsigned int)m_data.count() + " splats.");
-
-                if (!m_data.scaleWS.empty()) {
-                    float sMin = 1e30f, sMax = -1e30f, sSum = 0.f;
-                    int   allOnes = 0;
-                    for (float v : m_data.scaleWS) {
-                        if (v < sMin) sMin = v;
-                        if (v > sMax) sMax = v;
-                        sSum += v;
-                        if (v > 0.999f && v < 1.001f) allOnes++;
-                    }
-                    float avg = sSum / (float)m_data.scaleWS.size();
-                    bool  missingScale = (allOnes == (int)m_data.scaleWS.size());
-
-                    MString ms("[GaussianSplatData] Scale (after exp): min=");
-                    ms += sMin; ms += " max="; ms += sMax; ms += " avg="; ms += avg;
-                    if (missingScale)
-                        ms += "  <<< ALL 1.0 -- PLY likely missing scale_0/1/2! >>>";
-                    MGlobal::displayInfo(ms);
-                }
-
-                m_inputsDirty = true;
-            } else {
-                MGlobal::displayError(MString("[GaussianSplatData] ") + err.c_str());
-            }
+    // A connected gaussianSplatData node overrides the node's own file
+    if (GaussianDataNode* source = inputDataNode()) {
+        dataBlock.inputValue(aInData);          // evaluates the data node
+        if (!m_fromDataNode || source->dataset() != dataset()) {
+            releaseData();
+            m_fromDataNode = true;
+            m_loader.adopt(source->dataset());
         }
+        return finishCompute(dataBlock);
+    }
+    if (m_fromDataNode) {
+        // Disconnected: fall back to filePath below
+        releaseData();
+        m_loader.forget();
+        m_fromDataNode = false;
     }
 
-    dataBlock.outputValue(aDataReady).setBool(!m_data.empty());
-    dataBlock.setClean(plug);
+    MString newPath = dataBlock.inputValue(aFilePath).asString();
+    SplatDataset::Settings settings =
+        DatasetLoader::readSettings(dataBlock, aSHDegree, aCompactStorage, aSplatOrder);
+    dataBlock.inputValue(aLoadTick);
+
+    if (m_loader.changed(newPath, settings)) {
+        // A new path or storage setting replaces whatever is shown, sharing
+        // the dataset of any other node showing the same file contents with
+        // the same settings
+        releaseData();
+        m_loader.begin(newPath, settings);
+        if (dataset() && !dataset()->isLoading())
+            MGlobal::displayInfo(MString("[GaussianSplatData] Sharing loaded data: ") + newPath);
+    }
+    return finishCompute(dataBlock);
+}
+
+MStatus GaussianNode::finishCompute(MDataBlock& dataBlock) {
+    // A failed load was reported by the dataset; every node sharing it ends up empty
+    if (!m_loader.poll()) releaseData();
+
+    float progress = dataset() ? dataset()->progress() : 0.f;
+    dataBlock.outputValue(aDataReady).setBool(hasData());
+    dataBlock.outputValue(aLoadProgress).setFloat(progress);
+    dataBlock.setClean(aDataReady);
+    dataBlock.setClean(aLoadProgress);
     return MS::kSuccess;
 }
 
+// The gaussianSplatData node connected to inData, if any
+GaussianDataNode* GaussianNode::inputDataNode() const {
+    MPlugArray sources;
+    MPlug(thisMObject(), aInData).connectedTo(sources, true, false);
+    if (sources.length() == 0) return nullptr;
+    MFnDependencyNode fn(sources[0].node());
+    return dynamic_cast<GaussianDataNode*>(fn.userNode());
+}
+
+// Drops the dataset but keeps the loaded path and settings (see
+// DatasetLoader::release)
+void GaussianNode::releaseData() {
+    m_loader.release();
+    releaseSelectionMaskBuffer();
+    m_emptyVersion = SplatDataset::nextVersion();
+}
+
+void GaussianNode::cancelLoad() {
+    if (!isLoading()) return;
+    m_loader.cancel();
+    releaseData();
+}
+
 // ---------------------------------------------------------------------------
 // boundingBox
 // ---------------------------------------------------------------------------
 MBoundingBox GaussianNode::boundingBox() const {
-    if (m_data.empty())
+    if (!hasData())
         return MBoundingBox(MPoint(-1, -1, -1), MPoint(1, 1, 1));
-    return MBoundingBox(
-        MPoint(m_data.bboxMin[0], m_data.bboxMin[1], m_data.bboxMin[2]),
-        MPoint(m_data.bboxMax[0], m_data.bboxMax[1], m_data.bboxMax[2]));
+    const float* lo = dataset()->bboxMin();
+    const float* hi = dataset()->bboxMax();
+    return MBoundingBox(MPoint(lo[0], lo[1], lo[2]), MPoint(hi[0], hi[1], hi[2]));
 }
 
 // ---------------------------------------------------------------------------
 // GPU buffer helpers
 // ---------------------------------------------------------------------------
-#define SAFE_RELEASE(p) do { if (p) { (p)->Release(); (p) = nullptr; } } while(0)
-
-void GaussianNode::releaseInputBuffers() {
-    SAFE_RELEASE(m_sbPositionWS); SAFE_RELEASE(m_srvPositionWS);
-    SAFE_RELEASE(m_sbScale);      SAFE_RELEASE(m_srvScale);
-    SAFE_RELEASE(m_sbRotation);   SAFE_RELEASE(m_srvRotation);
-    SAFE_RELEASE(m_sbOpacity);    SAFE_RELEASE(m_srvOpacity);
-    SAFE_RELEASE(m_sbSHCoeffs);   SAFE_RELEASE(m_srvSHCoeffs);
-    releaseSelectionMaskBuffer();
-    m_inputsReady = false;
-}
-
 void GaussianNode::releaseSelectionMaskBuffer() {
-    SAFE_RELEASE(m_uavSelectionMask);
-    SAFE_RELEASE(m_srvSelectionMask);
-    SAFE_RELEASE(m_sbSelectionMask);
+    m_selectionMask.release();
     m_maskShadow.clear();
 }
 
-bool GaussianNode::createSRVBuffer(ID3D11Device* device,
-                                    const char*   name,
-                                    const void*   initData,
-                                    uint32_t      numElements,
-                                    uint32_t      stride,
-                                    ID3D11Buffer**             outBuf,
-                                    ID3D11ShaderResourceView** outSRV)
-{
-    uint32_t totalBytes = numElements * stride;
-    D3D11_BUFFER_DESC bd = {};
-    bd.ByteWidth           = totalBytes;
-    bd.Usage               = D3D11_USAGE_DEFAULT;
-    bd.BindFlags           = D3D11_BIND_SHADER_RESOURCE;
-    bd.MiscFlags           = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
-    bd.StructureByteStride = stride;
-
-    D3D11_SUBRESOURCE_DATA init = { initData, 0, 0 };
-    if (FAILED(device->CreateBuffer(&bd, initData ? &init : nullptr, outBuf))) {
-        MGlobal::displayError(MString("[GaussianSplat] CreateBuffer failed for '") + name +
-                              "' (" + (unsigned int)(totalBytes/1024/1024) + " MB).");
-        return false;
-    }
-
-    D3D11_SHADER_RESOURCE_VIEW_DESC srvd = {};
-    srvd.ViewDimension         = D3D11_SRV_DIMENSION_BUFFEREX;
-    srvd.BufferEx.FirstElement = 0;
-    srvd.BufferEx.NumElements  = numElements;
-    if (FAILED(device->CreateShaderResourceView(*outBuf, &srvd, outSRV))) {
-        MGlobal::displayError(MString("[GaussianSplat] CreateSRV failed for '") + name + "'.");
-        SAFE_RELEASE(*outBuf);
-        return false;
-    }
-    return true;
-}
-
 bool GaussianNode::createSelectionMaskBuffer(ID3D11Device* device, uint32_t N) {
     releaseSelectionMaskBuffer();
-    m_maskShadow.assign(N, 0u);
-
-    D3D11_BUFFER_DESC bd = {};
-    bd.ByteWidth           = N * sizeof(uint32_t);
-    bd.Usage               = D3D11_USAGE_DEFAULT;
-    bd.BindFlags           = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
-    bd.MiscFlags           = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
-    bd.StructureByteStride = sizeof(uint32_t);
-
-    D3D11_SUBRESOURCE_DATA init = { m_maskShadow.data(), 0, 0 };
-    if (FAILED(device->CreateBuffer(&bd, &init, &m_sbSelectionMask))) {
-        MGlobal::displayError("[GaussianSplat] CreateBuffer failed for selectionMask.");
-        return false;
-    }
-
-    D3D11_SHADER_RESOURCE_VIEW_DESC srvd = {};
-    srvd.ViewDimension         = D3D11_SRV_DIMENSION_BUFFEREX;
-    srvd.BufferEx.FirstElement = 0;
-    srvd.BufferEx.NumElements  = N;
-    if (FAILED(device->CreateShaderResourceView(m_sbSelectionMask, &srvd, &m_srvSelectionMask))) {
-        releaseSelectionMaskBuffer();
-        return false;
-    }
-
-    D3D11_UNORDERED_ACCESS_VIEW_DESC uavd = {};
-    uavd.ViewDimension       = D3D11_UAV_DIMENSION_BUFFER;
-    uavd.Buffer.FirstElement = 0;
-    uavd.Buffer.NumElements  = N;
-    if (FAILED(device->CreateUnorderedAccessView(m_sbSelectionMask, &uavd, &m_uavSelectionMask))) {
-        releaseSelectionMaskBuffer();
+    m_selectionMask.init(PageLayout(sizeof(uint32_t), PageLayout::kMaxRowPages), "selectionMask",
+                         PagedBuffer::kUnorderedAccess | PagedBuffer::kZeroed);
+    if (!m_selectionMask.resize(device, nullptr, N)) {
+        m_selectionMask.release();
         return false;
     }
+    m_maskShadow.assign(N, 0u);
 
     m_maskVersion++;
+    m_deleteVersion++;
     return true;
 }
 
+// The input buffers belong to the shared dataset; the selection mask is this
+// node's own and is recreated (cleared) whenever the dataset's rows change.
 bool GaussianNode::uploadInputBuffersIfNeeded(ID3D11Device* device) {
-    if (!m_inputsDirty || m_data.empty()) return m_inputsReady;
-
-    releaseInputBuffers();
-    uint32_t N = (uint32_t)m_data.count();
-    MGlobal::displayInfo(MString("[GaussianSplatData] Uploading GPU buffers for ") + N + " splats...");
-
-    if (!createSRVBuffer(device, "positionWS", m_data.positions.data(),  N, sizeof(float)*3, &m_sbPositionWS, &m_srvPositionWS)) return false;
-    if (!createSRVBuffer(device, "scale",      m_data.scaleWS.data(),    N, sizeof(float)*3, &m_sbScale,      &m_srvScale))      return false;
-    if (!createSRVBuffer(device, "rotation",   m_data.rotationWS.data(), N, sizeof(float)*4, &m_sbRotation,   &m_srvRotation))   return false;
-    if (!createSRVBuffer(device, "opacity",    m_data.opacityRaw.data(), N, sizeof(float),   &m_sbOpacity,    &m_srvOpacity))    return false;
-    if (!createSRVBuffer(device, "shCoeffs",   m_data.shCoeffs.data(), N * kSHCoeffsPerSplat, sizeof(float)*3, &m_sbSHCoeffs, &m_srvSHCoeffs)) return false;
-    if (!createSelectionMaskBuffer(device, N)) return false;
-
-    m_inputsReady = true;
-    m_inputsDirty = false;
-    MGlobal::displayInfo("[GaussianSplatData] GPU buffers uploaded successfully.");
+    if (!hasData()) return false;
+    if (!dataset()->uploadIfNeeded(device)) return false;
+    if (m_selectionMask.empty() || m_maskDataVersion != dataset()->version()) {
+        if (!createSelectionMaskBuffer(device, dataset()->capacity())) return false;
+        m_maskDataVersion = dataset()->version();
+    }
     return true;
 }
 
@@ -242,21 +253,22 @@ bool GaussianNode::uploadInputBuffersIfNeeded(ID3D11Device* device) {
 // Selection mask helpers
 // ---------------------------------------------------------------------------
 void GaussianNode::restoreAll(ID3D11DeviceContext* ctx) {
-    if (!m_sbSelectionMask || m_maskShadow.empty()) return;
+    if (m_selectionMask.empty() || m_maskShadow.empty()) return;
     std::fill(m_maskShadow.begin(), m_maskShadow.end(), 0u);
-    ctx->UpdateSubresource(m_sbSelectionMask, 0, nullptr, m_maskShadow.data(), 0, 0);
+    uploadMask(ctx);
     m_maskVersion++;
+    m_deleteVersion++;
 }
 
 void GaussianNode::clearSelection(ID3D11DeviceContext* ctx) {
-    if (!m_sbSelectionMask || m_maskShadow.empty()) return;
+    if (m_selectionMask.empty() || m_maskShadow.empty()) return;
     for (auto& v : m_maskShadow) v &= ~kMaskBitSelected;
-    ctx->UpdateSubresource(m_sbSelectionMask, 0, nullptr, m_maskShadow.data(), 0, 0);
+    uploadMask(ctx);
     m_maskVersion++;
 }
 
 void GaussianNode::deleteSelected(ID3D11DeviceContext* ctx) {
-    if (!m_sbSelectionMask || m_maskShadow.empty()) return;
+    if (m_selectionMask.empty() || m_maskShadow.empty()) return;
     uint32_t numDeleted = 0;
     for (auto& v : m_maskShadow) {
         if (v & kMaskBitSelected) {
@@ -264,31 +276,19 @@ void GaussianNode::deleteSelected(ID3D11DeviceContext* ctx) {
             numDeleted++;
         }
     }
-    ctx->UpdateSubresource(m_sbSelectionMask, 0, nullptr, m_maskShadow.data(), 0, 0);
+    uploadMask(ctx);
     m_maskVersion++;
+    m_deleteVersion++;
     MGlobal::displayInfo(MString("[GaussianSplatData] Soft-deleted ") + (unsigned)numDeleted + " splats.");
 }
 
 bool GaussianNode::readbackMask(ID3D11Device* device, ID3D11DeviceContext* ctx) {
-    if (!m_sbSelectionMask || m_maskShadow.empty()) return false;
-
-    ID3D11Buffer* staging = nullptr;
-    D3D11_BUFFER_DESC bd = {};
-    bd.ByteWidth      = (UINT)(m_maskShadow.size() * sizeof(uint32_t));
-    bd.Usage          = D3D11_USAGE_STAGING;
-    bd.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
-    if (FAILED(device->CreateBuffer(&bd, nullptr, &staging))) return false;
-
-    ctx->CopyResource(staging, m_sbSelectionMask);
-    D3D11_MAPPED_SUBRESOURCE mapped;
-    if (FAILED(ctx->Map(staging, 0, D3D11_MAP_READ, 0, &mapped))) {
-        staging->Release();
-        return false;
-    }
-    std::memcpy(m_maskShadow.data(), mapped.pData, bd.ByteWidth);
-    ctx->Unmap(staging, 0);
-    staging->Release();
-    return true;
+    if (m_selectionMask.empty() || m_maskShadow.empty()) return false;
+    return m_selectionMask.read(device, ctx, 0, m_maskShadow.size(), m_maskShadow.data());
+}
+
+void GaussianNode::uploadMask(ID3D11DeviceContext* ctx) {
+    if (m_selectionMask.empty() || m_maskShadow.empty()) return;
+    m_selectionMask.update(ctx, 0, m_maskShadow.size(), m_maskShadow.data());
 }
 
-#undef SAFE_RELEASE
@@ -6,20 +6,53 @@
 #include <maya/MBoundingBox.h>
 #include <d3d11.h>
 #include <cstdint>
+#include <memory>
 #include <vector>
+#include "DatasetLoader.h"
 #include "GaussianData.h"
+#include "PagedBuffer.h"
+#include "SplatDataset.h"
+
+class GaussianDataNode;
 
 // ---------------------------------------------------------------------------
 // GaussianNode  --  self-contained MPxLocatorNode.
 //
-// Owns a loaded .ply file's CPU data AND all DX11 GPU input buffers.
-// Each gaussianSplat node is fully independent (no shared data node).
+// Shows a loaded .ply file. The CPU data and DX11 GPU input buffers live in
+// a SplatDataset, shared with every other node that references the same
+// file contents with the same load settings; each node owns its selection
+// mask. With inData connected to a gaussianSplatData node the shape shows
+// that node's dataset instead, so one file can be instanced under several
+// transforms (see GaussianDataNode).
 //
 // Attributes:
-//   filePath   (string, input)   -- path to the .ply file
-//   dataReady  (bool,   output)  -- set true once PLY is loaded
-//   pointSize  (float)           -- debug display point radius in pixels
-//   renderMode (int, 0-3)        -- 0=auto, 1=debug, 2=prod, 3=diag
+//   filePath     (string, input)   -- path to the .ply file
+//   dataReady    (bool,   output)  -- set true once PLY is loaded
+//   loadProgress (float,  output)  -- 0..1 while a background load runs
+//   shDegree     (int, 0-3)        -- highest SH degree loaded; lower values
+//                                     reload with fewer coefficients per splat
+//   compactStorage (bool)          -- keep the finished cloud in the packed
+//                                     fp16/unorm16/snorm8 form (SplatCompact.h)
+//                                     on the CPU and GPU
+//   splatOrder   (int, 0-2)        -- row order once loaded: 0=file,
+//                                     1=Morton, 2=Hilbert curve (SplatOrder.h)
+//   inData       (int, input)      -- from gaussianSplatData.outData; when
+//                                     connected, overrides filePath and the
+//                                     load settings above
+//   pointSize    (float)           -- debug display point radius in pixels
+//   renderMode   (int, 0-3)        -- 0=auto, 1=debug, 2=prod, 3=diag
+//   sortKeyBits  (int, 8-32)       -- depth sort precision: 8-24 quantise view
+//                                     depth to that many bits (2-3 sort
+//                                     passes instead of 4), above 24 keep the
+//                                     full float key (SplatSort::keyBits)
+//
+// PLY files are read on a background thread (PLYLoadJob). A Maya timer
+// (DatasetLoader) polls the dataset and dirties dataReady/loadProgress;
+// each evaluation picks up the rows finished so far, so a large cloud draws
+// progressively (stratified subsample first) while it loads. GPU buffers are sized for the whole file
+// up front and filled by appending the new rows. With compactStorage the
+// float rows are streamed as usual and packed once the load has finished;
+// a splatOrder other than file likewise reorders them at that point.
 // ---------------------------------------------------------------------------
 class GaussianNode : public MPxLocatorNode {
 public:
@@ -42,34 +75,53 @@ public:
     // Maya attributes
     static MObject aFilePath;
     static MObject aDataReady;
+    static MObject aLoadProgress;
+    static MObject aLoadTick;      // hidden; bumped by the load timer
+    static MObject aSHDegree;
+    static MObject aCompactStorage;
+    static MObject aSplatOrder;
+    static MObject aInData;
     static MObject aPointSize;
     static MObject aRenderMode;
+    static MObject aSortKeyBits;
 
     // --- CPU data ---
-    const GaussianData& gaussianData() const { return m_data; }
-    bool     hasData()    const { return !m_data.empty(); }
-    uint32_t splatCount() const { return (uint32_t)m_data.count(); }
+    // While loading, only the first splatCount() rows are valid; the arrays
+    // are already sized for splatCapacity() rows.
+    const GaussianData& gaussianData() const { return dataset() ? dataset()->data() : s_emptyData; }
+    bool     hasData()       const { return splatCount() > 0; }
+    uint32_t splatCount()    const { return dataset() ? dataset()->readyCount() : 0; }
+    uint32_t splatCapacity() const { return dataset() ? dataset()->capacity() : 0; }
+    // Changes whenever the rows are replaced or cleared
+    uint64_t dataVersion() const { return dataset() ? dataset()->version() : m_emptyVersion; }
+    // The shared dataset, or null when there is no file or the load failed
+    const std::shared_ptr<SplatDataset>& dataset() const { return m_loader.dataset(); }
+
+    // --- Background loading ---
+    bool isLoading() const { return dataset() && dataset()->isLoading(); }
+    // Cancels an in-flight load (for every node sharing it); the node stays
+    // empty until filePath or a load setting changes.
+    void cancelLoad();
 
     // --- GPU input buffers (lazy upload, called from prepareForDraw) ---
     bool uploadInputBuffersIfNeeded(ID3D11Device* device);
-    bool areInputsReady() const { return m_inputsReady; }
+    bool areInputsReady() const { return dataset() && dataset()->inputsReady() && !m_selectionMask.empty(); }
 
-    ID3D11ShaderResourceView* srvPositionWS() const { return m_srvPositionWS; }
-    ID3D11ShaderResourceView* srvScale()      const { return m_srvScale; }
-    ID3D11ShaderResourceView* srvRotation()   const { return m_srvRotation; }
-    ID3D11ShaderResourceView* srvOpacity()    const { return m_srvOpacity; }
-    ID3D11ShaderResourceView* srvSHCoeffs()   const { return m_srvSHCoeffs; }
+    // The input buffers themselves are the dataset's (dataset()->gpuPositionWS(), ...)
 
     // --- Selection mask (one uint per splat; bit0=selected, bit1=deleted) ---
-    ID3D11Buffer*              bufSelectionMask() const { return m_sbSelectionMask; }
-    ID3D11ShaderResourceView*  srvSelectionMask() const { return m_srvSelectionMask; }
-    ID3D11UnorderedAccessView* uavSelectionMask() const { return m_uavSelectionMask; }
+    // Paged like the dataset's row columns (PageLayout::kMaxRowPages)
+    const PagedBuffer& selectionMask() const { return m_selectionMask; }
+    // Uploads the whole CPU shadow after it was edited in place
+    void uploadMask(ID3D11DeviceContext* ctx);
 
     const std::vector<uint32_t>& maskShadow()       const { return m_maskShadow; }
     std::vector<uint32_t>&       maskShadowMutable()      { return m_maskShadow; }
 
     uint64_t maskVersion()  const { return m_maskVersion; }
     void markMaskChanged()        { m_maskVersion++; }
+    // Changes only with the deleted bits (which splats are drawn at all)
+    uint64_t deleteVersion() const { return m_deleteVersion; }
 
     void restoreAll    (ID3D11DeviceContext* ctx);
     void clearSelection(ID3D11DeviceContext* ctx);
@@ -79,38 +131,22 @@ public:
 private:
     friend class GaussianDrawOverride;
 
-    GaussianData m_data;
-    MString      m_loadedPath;
-
-    ID3D11Buffer*             m_sbPositionWS  = nullptr;
-    ID3D11ShaderResourceView* m_srvPositionWS = nullptr;
-    ID3D11Buffer*             m_sbScale       = nullptr;
-    ID3D11ShaderResourceView* m_srvScale      = nullptr;
-    ID3D11Buffer*             m_sbRotation    = nullptr;
-    ID3D11ShaderResourceView* m_srvRotation   = nullptr;
-    ID3D11Buffer*             m_sbOpacity     = nullptr;
-    ID3D11ShaderResourceView* m_srvOpacity    = nullptr;
-    ID3D11Buffer*             m_sbSHCoeffs    = nullptr;
-    ID3D11ShaderResourceView* m_srvSHCoeffs   = nullptr;
-
-    ID3D11Buffer*              m_sbSelectionMask  = nullptr;
-    ID3D11ShaderResourceView*  m_srvSelectionMask = nullptr;
-    ID3D11UnorderedAccessView* m_uavSelectionMask = nullptr;
+    static const GaussianData s_emptyData;
+
+    DatasetLoader m_loader { this, aLoadTick, true };
+    bool          m_fromDataNode = false;  // the dataset came through inData
+    uint64_t      m_emptyVersion = SplatDataset::nextVersion();
+
+    PagedBuffer                m_selectionMask;
     std::vector<uint32_t>      m_maskShadow;
     uint64_t                   m_maskVersion = 0;
+    uint64_t                   m_deleteVersion = 0;
+    uint64_t                   m_maskDataVersion = 0;   // dataVersion() the mask was sized for
 
-    bool m_inputsReady = false;
-    bool m_inputsDirty = true;
+    MStatus finishCompute(MDataBlock& dataBlock);
+    GaussianDataNode* inputDataNode() const;
+    void releaseData();
 
     bool createSelectionMaskBuffer(ID3D11Device* device, uint32_t N);
     void releaseSelectionMaskBuffer();
-    void releaseInputBuffers();
-
-    static bool createSRVBuffer(ID3D11Device* device,
-                                const char*   name,
-                                const void*   initData,
-                                uint32_t      numElements,
-                                uint32_t      stride,
-                                ID3D11Buffer**             outBuf,
-                                ID3D11ShaderResourceView** outSRV);
 };
@@ -3,6 +3,13 @@
 #include "GaussianNode.h"
 #include "GaussianData.h"
 #include "ShaderLoader.h"
+#include "SplatBVH.h"
+#include "SplatCompact.h"
+#include "SplatDataset.h"
+#include "SplatKernels.h"
+#include "SplatPreprocess.h"
+#include "SplatSort.h"
+#include "CopyPlan.h"
 
 #include <maya/MGlobal.h>
 
@@ -12,6 +19,7 @@
 #pragma comment(lib, "d3dcompiler.lib")
 
 #include <algorithm>
+#include <cfloat>
 #include <cstring>
 #include <cmath>
 #include <functional>
@@ -33,15 +41,36 @@
 // Constants
 // ===========================================================================
 static const uint32_t kSortGroupSize      = 256;
-static const uint32_t kSortItemsPerThread = 16;
+static const uint32_t kSortItemsPerThread = 8;
 static const uint32_t kSortTileSize       = kSortGroupSize * kSortItemsPerThread;
 static const uint32_t kRadixSize          = 256;
+// Sort arguments (radix_sort.hlsl): byte offsets of the indirect dispatch
+// and draw arguments after the kept count, then those of the incremental
+// sort
+static const uint32_t kSortArgsUints      = 20;
+static const uint32_t kSortDispatchArgs   = 4;
+static const uint32_t kSortDrawArgs       = 16;
+static const uint32_t kSortSeedArgs       = 32;
+static const uint32_t kSortFixupArgs      = 44;
+static const uint32_t kSortMergeArgs      = 56;
+static const uint32_t kSortFallbackArgs   = 68;
+// Sort state (radix_sort.hlsl): 4 passes of kRadixSize digit counts, then
+// 4 Onesweep tile counters, the KeyGen one, the depth range and the
+// incremental sort's counters
+static const uint32_t kSortStateUints     = 4 * kRadixSize + 16;
+// Slots per per-slot dispatch (preprocess, keygen, depth pass): 32768 groups
+// of 256, under the 65535-group limit, and a divisor of the output page size
+// so each dispatch stays within one page
+static const uint32_t kSlotBatch          = 1u << 23;
+static_assert((1u << PageLayout::kPageShift) % kSlotBatch == 0, "");
+// Rows decoded at a time by the CPU rect selection on compact datasets
+static const uint32_t kSelectBlockRows    = 4096;
 
 // ===========================================================================
 // CB layouts (must match HLSL)
 // ===========================================================================
 
-// Merged preprocess CB: NO worldMat (uses per-splat lookup instead)
+// Merged preprocess CB: NO worldMat (uses per-instance lookup instead)
 struct CBPreprocessMerged {
     float    viewMat[16];
     float    projMat[16];
@@ -52,9 +81,16 @@ struct CBPreprocessMerged {
     int      filmHeight;
     uint32_t gaussCount;
     uint32_t debugFixedRadius;
-    float    pad2, pad3;
+    uint32_t instanceCount;
+    uint32_t slotBase;          // first slot of the dispatch's kSlotBatch batch
+    uint32_t rangeBase;         // the dispatch's ranges in gDispatchRanges
+    uint32_t rangeCount;
+    uint32_t threadCount;
+    uint32_t padding1;
 };
 static_assert(sizeof(CBPreprocessMerged) % 16 == 0, "");
+// gInstanceMats element (InstanceMats in merged_preprocess.hlsl)
+static_assert(sizeof(PreprocessInstance) == 128, "");
 
 struct CBRender {
     float vpWidth, vpHeight;
@@ -64,9 +100,16 @@ static_assert(sizeof(CBRender) % 16 == 0, "");
 
 struct CBSort {
     uint32_t numElements;
-    uint32_t numBlocks;
+    uint32_t tileBase;          // KeyGen: groups of the earlier dispatches
     uint32_t shift;
-    uint32_t pad;
+    uint32_t slotBase;          // KeyGen: first slot of the dispatch's kSlotBatch batch
+    uint32_t rangeBase;         // KeyGen: the dispatch's preprocess ranges
+    uint32_t rangeCount;
+    uint32_t threadCount;
+    uint32_t pass;              // Onesweep pass
+    uint32_t keyBits;           // KeyGen, GlobalHist: SplatSort::keyBits
+    uint32_t padding[3];
+    float    depthProj[4];      // GlobalHist: projection _33, _34, _43, _44
 };
 static_assert(sizeof(CBSort) % 16 == 0, "");
 
@@ -76,7 +119,8 @@ struct CBDepth {
     uint32_t splatCount;
     uint32_t radiusCap;
     float    alphaThreshold;
-    float    pad0, pad1, pad2;
+    uint32_t slotBase;          // first slot of the dispatch
+    float    pad1, pad2;
 };
 static_assert(sizeof(CBDepth) % 16 == 0, "");
 
@@ -152,7 +196,7 @@ void GaussianRenderManager::registerInstance(const RenderInstance& inst) {
     for (const auto& existing : m_instances)
         if (existing.node == inst.node) return;
     m_instances.push_back(inst);
-    m_totalSplats += inst.splatCount;
+    m_totalSplats += inst.splatCapacity;
 }
 
 void GaussianRenderManager::setFrameData(const float viewMat[16], const float projMat[16],
@@ -249,18 +293,21 @@ bool GaussianRenderManager::createSRVBuffer(ID3D11Device* device, const char* na
 bool GaussianRenderManager::initPipeline(ID3D11Device* device) {
     HRESULT hr;
 
-    // Compile merged preprocess CS
+    // Compile merged preprocess CS, for float and for compact input pools
     {
         std::string src = gs::LoadShader("merged_preprocess.hlsl");
         if (src.empty()) return false;
-        ID3DBlob* blob = nullptr;
-        if (!CompileStage(src.c_str(), src.size(),
-                          "PreprocessKernel", "cs_5_0", &blob))
-            return false;
-        hr = device->CreateComputeShader(blob->GetBufferPointer(), blob->GetBufferSize(),
-                                          nullptr, &m_preprocessCS);
-        blob->Release();
-        if (FAILED(hr)) return false;
+        const D3D_SHADER_MACRO compactDefines[] = { { "GS_COMPACT", "1" }, { nullptr, nullptr } };
+        for (bool compact : { false, true }) {
+            ID3DBlob* blob = nullptr;
+            if (!CompileStage(src.c_str(), src.size(), "PreprocessKernel", "cs_5_0", &blob,
+                              compact ? compactDefines : nullptr))
+                return false;
+            hr = device->CreateComputeShader(blob->GetBufferPointer(), blob->GetBufferSize(), nullptr,
+                                              compact ? &m_preprocessCompactCS : &m_preprocessCS);
+            blob->Release();
+            if (FAILED(hr)) return false;
+        }
     }
 
     // Preprocess CB
@@ -336,10 +383,18 @@ bool GaussianRenderManager::initSortPipeline(ID3D11Device* device) {
 
     struct KernelDef { const char* define; const char* entry; ID3D11ComputeShader** out; };
     KernelDef kernels[] = {
-        { "KEYGEN_KERNEL",  "KeyGenKernel",  &m_sortCS_keygen  },
-        { "COUNT_KERNEL",   "CountKernel",   &m_sortCS_count   },
-        { "SCAN_KERNEL",    "ScanKernel",    &m_sortCS_scan    },
-        { "SCATTER_KERNEL", "ScatterKernel", &m_sortCS_scatter },
+        { "KEYGEN_KERNEL",    "KeyGenKernel",   &m_sortCS_keygen  },
+        { "SORT_ARGS_KERNEL", "SortArgsKernel", &m_sortCS_args    },
+        { "GLOBAL_HIST_KERNEL", "GlobalHistKernel", &m_sortCS_hist     },
+        { "GLOBAL_SCAN_KERNEL", "GlobalScanKernel", &m_sortCS_scan     },
+        { "ONESWEEP_KERNEL",    "OnesweepKernel",   &m_sortCS_onesweep },
+        { "COHERENCE_MARK_KERNEL",     "CoherenceMarkKernel",     &m_sortCS_mark     },
+        { "COHERENCE_SEED_KERNEL",     "CoherenceSeedKernel",     &m_sortCS_seed     },
+        { "COHERENCE_ENTRANTS_KERNEL", "CoherenceEntrantsKernel", &m_sortCS_entrants },
+        { "COHERENCE_ARGS_KERNEL",     "CoherenceArgsKernel",     &m_sortCS_coherenceArgs },
+        { "COHERENCE_FIXUP_KERNEL",    "CoherenceFixupKernel",    &m_sortCS_fixup    },
+        { "COHERENCE_CHECK_KERNEL",    "CoherenceCheckKernel",    &m_sortCS_check    },
+        { "COHERENCE_MERGE_KERNEL",    "CoherenceMergeKernel",    &m_sortCS_merge    },
     };
 
     for (auto& k : kernels) {
@@ -400,8 +455,8 @@ bool GaussianRenderManager::runSelection(ID3D11Device* /*device*/, ID3D11DeviceC
                                          int mode)
 {
     // CPU-only rect selection: no GPU dispatch, no readback stall.
-    // We own m_maskShadow (always in sync) and upload via UpdateSubresource.
-    if (!node || !node->areInputsReady() || !node->bufSelectionMask())
+    // We own m_maskShadow (always in sync) and upload it page by page.
+    if (!node || !node->areInputsReady())
         return false;
 
     uint32_t N = node->splatCount();
@@ -416,45 +471,147 @@ bool GaussianRenderManager::runSelection(ID3D11Device* /*device*/, ID3D11DeviceC
             wvp[r*4+c] = s;
         }
 
-    const auto& splats = node->gaussianData().splats;
-    auto&       mask   = node->maskShadowMutable();
-
-    for (uint32_t i = 0; i < N; i++) {
-        uint32_t cur = mask[i];
-        if (cur & 2u) continue;  // deleted: never touch
+    auto& mask = node->maskShadowMutable();
+    uint32_t selectedCount = selectInRect(node->gaussianData(), N, wvp, rectMinX, rectMinY,
+                                          rectMaxX, rectMaxY, mode, mask.data());
+    MGlobal::displayInfo(MString("[GS Select] ") + selectedCount + "/" + N +
+                         " splats selected (mode=" + mode + ")");
 
-        const float* p = splats[i].position;
-        // row-vector * wvp
-        float cx = p[0]*wvp[0] + p[1]*wvp[4] + p[2]*wvp[8]  + wvp[12];
-        float cy = p[0]*wvp[1] + p[1]*wvp[5] + p[2]*wvp[9]  + wvp[13];
-        float cw = p[0]*wvp[3] + p[1]*wvp[7] + p[2]*wvp[11] + wvp[15];
+    node->uploadMask(ctx);
+    node->markMaskChanged();
+    m_selectionDirty = true;
+    return true;
+}
 
-        bool inRect = false;
-        if (cw > 0.f) {
-            float nx = cx / cw, ny = cy / cw;
-            inRect = (nx >= rectMinX && nx <= rectMaxX &&
-                      ny >= rectMinY && ny <= rectMaxY);
+uint32_t GaussianRenderManager::selectInRect(const GaussianData& gd, uint32_t N, const float wvp[16],
+                                             float rectMinX, float rectMinY,
+                                             float rectMaxX, float rectMaxY,
+                                             int mode, uint32_t* mask)
+{
+    // Float datasets are read in place; compact ones are decoded a block
+    // at a time, positions only
+    std::vector<float> decoded;
+    if (gd.compact()) decoded.resize(kSelectBlockRows * 3);
+
+    for (uint32_t b = 0; b < N; b += kSelectBlockRows) {
+        const uint32_t n = std::min(kSelectBlockRows, N - b);
+        const float* pos = gd.positions.data() + (size_t)b * 3;
+        if (gd.compact()) {
+            SplatCompact::decodeRows(gd, b, b + n, decoded.data(), nullptr, nullptr, nullptr);
+            pos = decoded.data();
         }
 
-        uint32_t oldSel = cur & 1u;
-        uint32_t newSel;
-        if      (mode == 0) newSel = inRect ? 1u : 0u;
-        else if (mode == 1) newSel = (inRect || oldSel) ? 1u : 0u;
-        else if (mode == 2) newSel = inRect ? 0u : oldSel;
-        else                newSel = inRect ? (oldSel ^ 1u) : oldSel;
+        for (uint32_t r = 0; r < n; r++) {
+            const uint32_t i = b + r;
+            uint32_t cur = mask[i];
+            if (cur & 2u) continue;  // deleted: never touch
+
+            const float* p = pos + (size_t)r * 3;
+            // row-vector * wvp
+            float cx = p[0]*wvp[0] + p[1]*wvp[4] + p[2]*wvp[8]  + wvp[12];
+            float cy = p[0]*wvp[1] + p[1]*wvp[5] + p[2]*wvp[9]  + wvp[13];
+            float cw = p[0]*wvp[3] + p[1]*wvp[7] + p[2]*wvp[11] + wvp[15];
+
+            bool inRect = false;
+            if (cw > 0.f) {
+                float nx = cx / cw, ny = cy / cw;
+                inRect = (nx >= rectMinX && nx <= rectMaxX &&
+                          ny >= rectMinY && ny <= rectMaxY);
+            }
+
+            uint32_t oldSel = cur & 1u;
+            uint32_t newSel;
+            if      (mode == 0) newSel = inRect ? 1u : 0u;
+            else if (mode == 1) newSel = (inRect || oldSel) ? 1u : 0u;
+            else if (mode == 2) newSel = inRect ? 0u : oldSel;
+            else                newSel = inRect ? (oldSel ^ 1u) : oldSel;
 
-        mask[i] = (cur & ~1u) | newSel;
+            mask[i] = (cur & ~1u) | newSel;
+        }
     }
 
     uint32_t selectedCount = 0;
-    for (const auto& v : mask) if (v & 1u) selectedCount++;
-    MGlobal::displayInfo(MString("[GS Select] ") + selectedCount + "/" + N +
-                         " splats selected (mode=" + mode + ")");
+    for (uint32_t i = 0; i < N; i++) if (mask[i] & 1u) selectedCount++;
+    return selectedCount;
+}
 
-    ctx->UpdateSubresource(node->bufSelectionMask(), 0, nullptr, mask.data(), 0, 0);
-    node->markMaskChanged();
-    m_selectionDirty = true;
-    return true;
+// ===========================================================================
+// Instance frustum cull (the bound is derived in SplatBVH.h)
+// ===========================================================================
+bool GaussianRenderManager::instanceInView(const float bboxMin[3], const float bboxMax[3], float maxScale,
+                                           const float worldView[16], const float projMat[16],
+                                           const float tanHalfFov[2], float filmWidth, float filmHeight)
+{
+    CullFrustum frustum(worldView, projMat, tanHalfFov, filmWidth, filmHeight);
+    return frustum.test(bboxMin, bboxMax, maxScale) != CullFrustum::kOutside;
+}
+
+void GaussianRenderManager::cullInstances() {
+    m_instanceSlot.assign(m_instances.size(), kCulled);
+    m_visibleSlots     = 0;
+    m_visibleInstances = 0;
+    for (size_t i = 0; i < m_instances.size(); i++) {
+        const RenderInstance& inst = m_instances[i];
+        const SplatDataset&   ds   = *inst.dataset;
+        if (inst.splatCount == 0 || ds.readyCount() == 0) continue;
+        PreprocessInstance mats(inst.worldMat, m_viewMat);
+        if (!instanceInView(ds.bboxMin(), ds.bboxMax(), ds.maxScale(), mats.worldView, m_projMat,
+                            m_tanHalfFov, m_vpWidth, m_vpHeight))
+            continue;
+        m_instanceSlot[i] = m_visibleSlots;
+        m_visibleSlots += inst.splatCapacity;
+        m_visibleInstances++;
+    }
+}
+
+// ===========================================================================
+// Sort coherence: the SortFrame of this frame (see SplatCoherence.h). The
+// slot table covers the visible instances' slot ranges and loaded rows.
+// ===========================================================================
+SortFrame GaussianRenderManager::currentSortFrame() const {
+    SortFrame frame;
+    uint64_t h = SortCoherence::hashBytes(m_uploadedSlots.data(), m_uploadedSlots.size(),
+                                          SortCoherence::kHashSeed);
+    h = SortCoherence::hash(m_visibleSlots, h);
+    h = SortCoherence::hash(m_mergedCompact, h);
+
+    float lo[3] = { FLT_MAX, FLT_MAX, FLT_MAX }, hi[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    for (size_t i = 0; i < m_instances.size(); i++) {
+        if (m_instanceSlot[i] == kCulled) continue;
+        const RenderInstance& inst = m_instances[i];
+        h = SortCoherence::hash(inst.node, h);
+        h = SortCoherence::hash(inst.dataset->version(), h);
+        h = SortCoherence::hash(inst.node->deleteVersion(), h);
+        h = SortCoherence::hash(inst.worldMat, h);
+
+        // World bounds of the dataset's box: its corners, row vectors
+        const float* bmin = inst.dataset->bboxMin();
+        const float* bmax = inst.dataset->bboxMax();
+        for (int c = 0; c < 8; c++) {
+            float p[3] = { (c & 1) ? bmax[0] : bmin[0], (c & 2) ? bmax[1] : bmin[1],
+                           (c & 4) ? bmax[2] : bmin[2] };
+            for (int k = 0; k < 3; k++) {
+                float w = p[0] * inst.worldMat[k] + p[1] * inst.worldMat[4 + k] +
+                          p[2] * inst.worldMat[8 + k] + inst.worldMat[12 + k];
+                lo[k] = std::min(lo[k], w);
+                hi[k] = std::max(hi[k], w);
+            }
+        }
+    }
+    h = SortCoherence::hash(m_projMat, h);
+    h = SortCoherence::hash(m_tanHalfFov, h);
+    h = SortCoherence::hash(m_vpWidth, h);
+    h = SortCoherence::hash(m_vpHeight, h);
+    h = SortCoherence::hash(m_debugFixedRadius, h);
+    h = SortCoherence::hash(m_sortKeyBits, h);
+
+    frame.sceneHash = h;
+    std::memcpy(frame.viewMat, m_viewMat, sizeof(frame.viewMat));
+    float diag = 0.f;
+    for (int k = 0; k < 3; k++) diag += (hi[k] - lo[k]) * (hi[k] - lo[k]);
+    frame.sceneRadius = hi[0] >= lo[0] ? 0.5f * std::sqrt(diag) : 0.f;
+    frame.valid = true;
+    return frame;
 }
 
 bool GaussianRenderManager::initDepthPassPipeline(ID3D11Device* device) {
@@ -525,11 +682,18 @@ bool GaussianRenderManager::initDepthPassPipeline(ID3D11Device* device) {
 bool GaussianRenderManager::createComputeOutputs(ID3D11Device* device, uint32_t N) {
     releaseComputeOutputs();
 
-    if (!createUAVBuffer(device, "m_positionSS", N, sizeof(float)*2, &m_ubPositionSS, &m_uavPositionSS, &m_srvPositionSS)) return false;
-    if (!createUAVBuffer(device, "m_depth",      N, sizeof(float),   &m_ubDepth,      &m_uavDepth,      &m_srvDepth))      return false;
-    if (!createUAVBuffer(device, "m_radius",     N, sizeof(float),   &m_ubRadius,     &m_uavRadius,     &m_srvRadius))     return false;
-    if (!createUAVBuffer(device, "m_color",      N, sizeof(float)*3, &m_ubColor,      &m_uavColor,      &m_srvColor))      return false;
-    if (!createUAVBuffer(device, "m_cov2D",      N, sizeof(float)*4, &m_ubCov2D,      &m_uavCov2D,      &m_srvCov2D))      return false;
+    struct Output { PagedBuffer* buf; const char* name; uint32_t stride; };
+    const Output outputs[] = {
+        { &m_outPositionSS, "m_positionSS", sizeof(float)*2 },
+        { &m_outDepth,      "m_depth",      sizeof(float)   },
+        { &m_outRadius,     "m_radius",     sizeof(float)   },
+        { &m_outColor,      "m_color",      sizeof(float)*3 },
+        { &m_outCov2D,      "m_cov2D",      sizeof(float)*4 },
+    };
+    for (const Output& o : outputs) {
+        o.buf->init(PageLayout(o.stride, PageLayout::kMaxSlotPages), o.name, PagedBuffer::kUnorderedAccess);
+        if (!o.buf->resize(device, nullptr, N)) return false;
+    }
 
     if (m_sortReady) {
         if (!createSortBuffers(device, N))
@@ -544,14 +708,46 @@ bool GaussianRenderManager::createComputeOutputs(ID3D11Device* device, uint32_t
 bool GaussianRenderManager::createSortBuffers(ID3D11Device* device, uint32_t N) {
     releaseSortBuffers();
 
-    uint32_t numBlocks = (N + kSortTileSize - 1) / kSortTileSize;
+    // Lookback status: kRadixSize per Onesweep tile, which also covers one
+    // per KeyGen group (kSortGroupSize slots, plus one partial per batch)
+    uint32_t numTiles = (N + kSortTileSize - 1) / kSortTileSize;
+    uint32_t numStatus = std::max(numTiles * kRadixSize, (N + kSortGroupSize - 1) / kSortGroupSize + 64);
 
     if (!createUAVBuffer(device, "sortKeysA", N, sizeof(uint32_t), &m_sortKeysA, &m_sortKeysA_UAV, &m_sortKeysA_SRV)) return false;
     if (!createUAVBuffer(device, "sortKeysB", N, sizeof(uint32_t), &m_sortKeysB, &m_sortKeysB_UAV, &m_sortKeysB_SRV)) return false;
     if (!createUAVBuffer(device, "sortValsA", N, sizeof(uint32_t), &m_sortValsA, &m_sortValsA_UAV, &m_sortValsA_SRV)) return false;
     if (!createUAVBuffer(device, "sortValsB", N, sizeof(uint32_t), &m_sortValsB, &m_sortValsB_UAV, &m_sortValsB_SRV)) return false;
-    if (!createUAVBuffer(device, "sortBlockHist", numBlocks * kRadixSize, sizeof(uint32_t),
-                         &m_sortBlockHist, &m_sortBlockHist_UAV, &m_sortBlockHist_SRV)) return false;
+    if (!createUAVBuffer(device, "sortKeysC", N, sizeof(uint32_t), &m_sortKeysC, &m_sortKeysC_UAV, &m_sortKeysC_SRV)) return false;
+    if (!createUAVBuffer(device, "sortValsC", N, sizeof(uint32_t), &m_sortValsC, &m_sortValsC_UAV, &m_sortValsC_SRV)) return false;
+    if (!createUAVBuffer(device, "sortPrevOrder", N, sizeof(uint32_t),
+                         &m_sortPrevOrder, &m_sortPrevOrder_UAV, &m_sortPrevOrder_SRV)) return false;
+    if (!createUAVBuffer(device, "sortState", kSortStateUints, sizeof(uint32_t),
+                         &m_sortState, &m_sortState_UAV, &m_sortState_SRV)) return false;
+    if (!createUAVBuffer(device, "sortTileState", numStatus, sizeof(uint32_t),
+                         &m_sortTileState, &m_sortTileState_UAV, &m_sortTileState_SRV)) return false;
+
+    // Indirect arguments: raw views, the only kind an args buffer may have
+    D3D11_BUFFER_DESC bd = {};
+    bd.ByteWidth = kSortArgsUints * sizeof(uint32_t);
+    bd.Usage     = D3D11_USAGE_DEFAULT;
+    bd.BindFlags = D3D11_BIND_UNORDERED_ACCESS | D3D11_BIND_SHADER_RESOURCE;
+    bd.MiscFlags = D3D11_RESOURCE_MISC_DRAWINDIRECT_ARGS | D3D11_RESOURCE_MISC_BUFFER_ALLOW_RAW_VIEWS;
+    if (FAILED(device->CreateBuffer(&bd, nullptr, &m_sortArgs))) {
+        MGlobal::displayError("[GS-Manager] CreateBuffer(args) failed: sortArgs");
+        return false;
+    }
+    D3D11_UNORDERED_ACCESS_VIEW_DESC uavd = {};
+    uavd.Format             = DXGI_FORMAT_R32_TYPELESS;
+    uavd.ViewDimension      = D3D11_UAV_DIMENSION_BUFFER;
+    uavd.Buffer.NumElements = kSortArgsUints;
+    uavd.Buffer.Flags       = D3D11_BUFFER_UAV_FLAG_RAW;
+    if (FAILED(device->CreateUnorderedAccessView(m_sortArgs, &uavd, &m_sortArgs_UAV))) return false;
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvd = {};
+    srvd.Format               = DXGI_FORMAT_R32_TYPELESS;
+    srvd.ViewDimension        = D3D11_SRV_DIMENSION_BUFFEREX;
+    srvd.BufferEx.NumElements = kSortArgsUints;
+    srvd.BufferEx.Flags       = D3D11_BUFFEREX_SRV_FLAG_RAW;
+    if (FAILED(device->CreateShaderResourceView(m_sortArgs, &srvd, &m_sortArgs_SRV))) return false;
 
     return true;
 }
@@ -591,179 +787,523 @@ bool GaussianRenderManager::createDepthTexture(ID3D11Device* device, uint32_t w,
 }
 
 // ===========================================================================
-// buildMergedInputs  --  CPU concatenate all instance data, upload to GPU
+// Merged input pool
 //
-// The large splat-data buffers (pos/scale/rotation/opacity/SH/instanceID)
-// are only rebuilt when the instance set actually changes (different data
-// nodes or different splat counts). World matrices are tiny and updated
-// every frame since transforms can change.
+// One block per distinct dataset shown, sub-allocated from the pool columns
+// and kept across frames. Blocks are created (and filled) when a dataset
+// first appears, appended to while it streams, and freed once the dataset is
+// gone or has replaced its rows. Blocks no instance showed this frame stay
+// resident until their space is needed, so toggling a node's visibility or
+// Maya culling it does not copy anything again.
 // ===========================================================================
-bool GaussianRenderManager::buildMergedInputs(ID3D11Device* device, ID3D11DeviceContext* ctx) {
-    uint32_t N = m_totalSplats;
-    uint32_t numInstances = (uint32_t)m_instances.size();
+bool GaussianRenderManager::growPool(ID3D11Device* device, ID3D11DeviceContext* ctx,
+                                     RangeAllocator& alloc, uint32_t newCapacity) {
+    bool ok;
+    const char* what;
+    if (&alloc == &m_rowAlloc) {
+        what = " rows";
+        ok = m_poolPosition.resize(device, ctx, newCapacity) &&
+             (m_mergedCompact ? m_poolScale.resize(device, ctx, newCapacity) &&
+                                m_poolRotation.resize(device, ctx, newCapacity)
+                              : m_poolCovDiag.resize(device, ctx, newCapacity) &&
+                                m_poolCovOffDiag.resize(device, ctx, newCapacity)) &&
+             m_poolOpacity.resize(device, ctx, newCapacity);
+    } else if (&alloc == &m_shAlloc) {
+        what = m_mergedCompact ? " SH uints" : " SH groups";
+        ok = m_poolSH.resize(device, ctx, newCapacity);
+    } else {
+        what = " chunks";
+        ok = m_poolChunks.resize(device, ctx, newCapacity);
+    }
+    if (!ok) return false;
+    alloc.grow(newCapacity);
+    MGlobal::displayInfo(MString("[GS-Manager] Pool grown to ") + newCapacity + what);
+    return true;
+}
 
-    if (N == 0 || numInstances == 0) return false;
+// A free range of `size` units: evicts the blocks no instance showed this
+// frame if nothing fits, and grows the pool if that is not enough either.
+bool GaussianRenderManager::allocateRange(ID3D11Device* device, ID3D11DeviceContext* ctx,
+                                          RangeAllocator& alloc, uint32_t size, uint32_t& offset) {
+    offset = alloc.allocate(size);
+    if (offset != RangeAllocator::kInvalid) return true;
+
+    size_t before = m_poolBlocks.size();
+    for (size_t b = 0; b < m_poolBlocks.size();) {
+        if (m_poolBlocks[b].lastFrame != m_frameStamp) {
+            freeBlock(m_poolBlocks[b]);
+            m_poolBlocks.erase(m_poolBlocks.begin() + b);
+        } else {
+            ++b;
+        }
+    }
+    if (m_poolBlocks.size() != before) {
+        offset = alloc.allocate(size);
+        if (offset != RangeAllocator::kInvalid) return true;
+    }
 
-    // Compute a signature of the current instance set to detect changes.
-    // Hash = XOR-combine of (dataNode pointer, splatCount) per instance.
-    size_t sig = 0;
-    for (uint32_t i = 0; i < numInstances; i++) {
-        auto ptr = reinterpret_cast<uintptr_t>(m_instances[i].node);
-        sig ^= std::hash<uintptr_t>()(ptr) + 0x9e3779b9 + (sig << 6) + (sig >> 2);
-        sig ^= std::hash<uint32_t>()(m_instances[i].splatCount) + 0x9e3779b9 + (sig << 6) + (sig >> 2);
+    // Grow by the usual factor, but not past what the column's pages can
+    // hold unless the range itself needs it (then resize reports the limit)
+    const PagedBuffer& col = &alloc == &m_rowAlloc ? m_poolPosition :
+                             &alloc == &m_shAlloc  ? m_poolSH : m_poolChunks;
+    uint32_t need = alloc.capacityToFit(size);
+    uint32_t cap  = RangeAllocator::grownCapacity(alloc.capacity(), need);
+    cap = (uint32_t)std::max<uint64_t>(need, std::min<uint64_t>(cap, col.layout().maxElements()));
+    if (!growPool(device, ctx, alloc, cap)) return false;
+    offset = alloc.allocate(size);
+    return offset != RangeAllocator::kInvalid;
+}
+
+bool GaussianRenderManager::allocateBlock(ID3D11Device* device, ID3D11DeviceContext* ctx,
+                                          const std::shared_ptr<SplatDataset>& dataset,
+                                          PoolBlock& block) {
+    const GaussianData& gd = dataset->data();
+    block.dataset   = dataset;
+    block.version   = dataset->version();
+    block.capacity  = dataset->capacity();
+    block.shStride  = (uint32_t)gd.shStride();
+    block.lastFrame = m_frameStamp;
+
+    uint32_t shPer  = m_mergedCompact ? (uint32_t)compactSHHalfs(gd.shDegree) / 2 : block.shStride;
+    uint32_t chunks = m_mergedCompact ? (block.capacity + kCompactChunkSplats - 1) / kCompactChunkSplats : 0;
+    if ((uint64_t)block.capacity * shPer > m_poolSH.layout().maxElements()) {
+        MGlobal::displayError(MString("[GS-Manager] ") + block.capacity + " splats need more SH than the pool's " +
+                              (unsigned)m_poolSH.layout().maxElements() + " elements.");
+        return false;
+    }
+    if (!allocateRange(device, ctx, m_rowAlloc, block.capacity, block.firstRow)) return false;
+    if (!allocateRange(device, ctx, m_shAlloc, block.capacity * shPer, block.shBase)) {
+        m_rowAlloc.free(block.firstRow);
+        return false;
     }
+    block.firstChunk = 0;
+    if (chunks && !allocateRange(device, ctx, m_chunkAlloc, chunks, block.firstChunk)) {
+        m_rowAlloc.free(block.firstRow);
+        m_shAlloc.free(block.shBase);
+        return false;
+    }
+
+    block.uploaded = 0;     // filled by fillPoolBlocks()
+    return true;
+}
 
-    bool needRebuild = (sig != m_cachedSignature) || !m_inputsUploaded;
+void GaussianRenderManager::freeBlock(const PoolBlock& block) {
+    m_rowAlloc.free(block.firstRow);
+    m_shAlloc.free(block.shBase);
+    if (m_mergedCompact) m_chunkAlloc.free(block.firstChunk);
+}
 
-    // --- Rebuild large buffers only when instance set changes ---
-    if (needRebuild) {
-        std::vector<float>    mergedPos;       mergedPos.reserve((size_t)N * 3);
-        std::vector<float>    mergedScale;     mergedScale.reserve((size_t)N * 3);
-        std::vector<float>    mergedRotation;  mergedRotation.reserve((size_t)N * 4);
-        std::vector<float>    mergedOpacity;   mergedOpacity.reserve(N);
-        std::vector<float>    mergedSH;        mergedSH.reserve((size_t)N * 48);
-        std::vector<uint32_t> instanceIDs;     instanceIDs.reserve(N);
+// Uploads rows [first, last) of `gd` into the block from the CPU columns:
+// as stored, or decoded when a compact dataset sits in a float pool, with
+// the covariance computed for a float pool. The block's chunks go with its
+// first rows.
+void GaussianRenderManager::uploadBlockRows(ID3D11DeviceContext* ctx, const PoolBlock& block,
+                                            const GaussianData& gd, uint32_t first, uint32_t last) {
+    if (last <= first) return;
+    uint32_t count = last - first;
+    uint32_t row   = block.firstRow + first;
+
+    auto update = [&](const PagedBuffer& col, const void* src, uint32_t firstElem, uint32_t elems) {
+        col.update(ctx, firstElem, elems, src);
+    };
 
-        for (uint32_t i = 0; i < numInstances; i++) {
-            const RenderInstance& inst = m_instances[i];
-            const GaussianData& gd = inst.node->gaussianData();
-            uint32_t cnt = inst.splatCount;
-
-            mergedPos.insert(mergedPos.end(),
-                             gd.positions.begin(), gd.positions.begin() + (size_t)cnt * 3);
-            mergedScale.insert(mergedScale.end(),
-                               gd.scaleWS.begin(), gd.scaleWS.begin() + (size_t)cnt * 3);
-            mergedRotation.insert(mergedRotation.end(),
-                                  gd.rotationWS.begin(), gd.rotationWS.begin() + (size_t)cnt * 4);
-            mergedOpacity.insert(mergedOpacity.end(),
-                                 gd.opacityRaw.begin(), gd.opacityRaw.begin() + cnt);
-            mergedSH.insert(mergedSH.end(),
-                            gd.shCoeffs.begin(), gd.shCoeffs.begin() + (size_t)cnt * 48);
-            instanceIDs.insert(instanceIDs.end(), cnt, i);
+    if (m_mergedCompact && first == 0)
+        update(m_poolChunks, gd.packed.chunks.data(), block.firstChunk, (uint32_t)gd.packed.chunks.size());
+    update(m_poolOpacity, &gd.opacityRaw[first], row, count);
+    if (m_mergedCompact) {
+        const CompactColumns& p = gd.packed;
+        uint32_t halfs = (uint32_t)compactSHHalfs(gd.shDegree);
+        update(m_poolPosition, &p.positionQ[(size_t)first * 4], row, count);
+        update(m_poolScale,    &p.scaleH[(size_t)first * 4],    row, count);
+        update(m_poolRotation, &p.rotationQ[first],             row, count);
+        update(m_poolSH,       &p.shH[(size_t)first * halfs],
+               block.shBase + first * (halfs / 2), count * (halfs / 2));
+    } else {
+        std::vector<float> diag((size_t)count * 3), offDiag((size_t)count * 3);
+        if (gd.compact()) {
+            std::vector<float> pos((size_t)count * 3), scale((size_t)count * 3);
+            std::vector<float> rot((size_t)count * 4), sh((size_t)count * gd.shFloats());
+            SplatCompact::decodeRows(gd, first, last, pos.data(), scale.data(), rot.data(), sh.data());
+            gs::Covariance3D(scale.data(), rot.data(), count, diag.data(), offDiag.data());
+            update(m_poolPosition, pos.data(), row, count);
+            update(m_poolSH,       sh.data(), block.shBase + first * block.shStride, count * block.shStride);
+        } else {
+            gs::Covariance3D(&gd.scaleWS[(size_t)first * 3], &gd.rotationWS[(size_t)first * 4], count,
+                             diag.data(), offDiag.data());
+            update(m_poolPosition, &gd.positions[(size_t)first * 3], row, count);
+            update(m_poolSH,       &gd.shCoeffs[(size_t)first * gd.shFloats()],
+                   block.shBase + first * block.shStride, count * block.shStride);
         }
+        update(m_poolCovDiag,    diag.data(),    row, count);
+        update(m_poolCovOffDiag, offDiag.data(), row, count);
+    }
+}
 
-        bool needRealloc = (m_mergedAllocN != N) || (m_mergedAllocInstances != numInstances);
+// Empty columns in the float or compact layout (the dataset buffers use the
+// same strides, so blocks can be copied from them page by page). Only the
+// covariance or only the scale/quaternion columns grow, by layout.
+void GaussianRenderManager::initPoolColumns(bool compact) {
+    using PL = PageLayout;
+    m_poolPosition.init(PL(compact ? sizeof(uint16_t) * 4 : sizeof(float) * 3, PL::kMaxRowPages), "poolPosition");
+    m_poolCovDiag.init(PL(sizeof(float) * 3, PL::kMaxRowPages), "poolCovDiag");
+    m_poolCovOffDiag.init(PL(sizeof(float) * 3, PL::kMaxRowPages), "poolCovOffDiag");
+    m_poolScale.init(PL(sizeof(uint16_t) * 4, PL::kMaxRowPages), "poolScale");
+    m_poolRotation.init(PL(sizeof(uint32_t), PL::kMaxRowPages), "poolRotation");
+    m_poolOpacity.init(PL(sizeof(float), PL::kMaxRowPages), "poolOpacity");
+    m_poolSH.init(PL(compact ? sizeof(uint32_t) : sizeof(float) * 3, PL::kMaxSHPages), "poolSH");
+    m_poolChunks.init(PL(sizeof(CompactChunk), 1), "poolChunks");
+}
 
-        if (needRealloc) {
-            releaseMergedInputs();
+// ===========================================================================
+// buildMergedInputs  --  bring the pool up to date with this frame's
+// instances, then write the per-instance tables (world matrices, slots,
+// pool layout; tiny, rewritten every frame since transforms and loaded rows
+// change).
+// ===========================================================================
+bool GaussianRenderManager::buildMergedInputs(ID3D11Device* device, ID3D11DeviceContext* ctx) {
+    uint32_t N = m_totalSplats;
+    uint32_t numInstances = (uint32_t)m_instances.size();
 
-            if (!createSRVBuffer(device, "mergedPosWS", mergedPos.data(), N, sizeof(float)*3,
-                                 &m_mergedPositionWS, &m_mergedSrvPosWS)) return false;
-            if (!createSRVBuffer(device, "mergedScale", mergedScale.data(), N, sizeof(float)*3,
-                                 &m_mergedScale, &m_mergedSrvScale)) return false;
-            if (!createSRVBuffer(device, "mergedRotation", mergedRotation.data(), N, sizeof(float)*4,
-                                 &m_mergedRotation, &m_mergedSrvRotation)) return false;
-            if (!createSRVBuffer(device, "mergedOpacity", mergedOpacity.data(), N, sizeof(float),
-                                 &m_mergedOpacity, &m_mergedSrvOpacity)) return false;
-            if (!createSRVBuffer(device, "mergedSH", mergedSH.data(), N * kSHCoeffsPerSplat, sizeof(float)*3,
-                                 &m_mergedSHCoeffs, &m_mergedSrvSH)) return false;
-            if (!createSRVBuffer(device, "instanceID", instanceIDs.data(), N, sizeof(uint32_t),
-                                 &m_instanceIDBuf, &m_instanceIDSrv)) return false;
+    if (N == 0 || numInstances == 0) return false;
 
-            m_mergedAllocInstances = numInstances;
+    // When every dataset shown uses compact storage the pool holds the packed
+    // columns unchanged (read by the GS_COMPACT preprocess kernel); otherwise
+    // compact datasets are expanded into a float pool. A switch between the
+    // two starts the pool over.
+    bool compactPool = true;
+    for (const RenderInstance& inst : m_instances)
+        compactPool = compactPool && inst.dataset->data().compact();
+    if (compactPool != m_mergedCompact || m_poolPosition.empty()) {
+        releaseMergedInputs();
+        m_mergedCompact = compactPool;
+        initPoolColumns(compactPool);
+    }
 
-            // Also reallocate compute outputs and sort buffers
-            if (!createComputeOutputs(device, N)) return false;
+    // Free the blocks whose dataset is gone or has replaced its rows
+    for (size_t b = 0; b < m_poolBlocks.size();) {
+        std::shared_ptr<SplatDataset> ds = m_poolBlocks[b].dataset.lock();
+        if (!ds || ds->version() != m_poolBlocks[b].version) {
+            freeBlock(m_poolBlocks[b]);
+            m_poolBlocks.erase(m_poolBlocks.begin() + b);
         } else {
-            ctx->UpdateSubresource(m_mergedPositionWS, 0, nullptr, mergedPos.data(), 0, 0);
-            ctx->UpdateSubresource(m_mergedScale, 0, nullptr, mergedScale.data(), 0, 0);
-            ctx->UpdateSubresource(m_mergedRotation, 0, nullptr, mergedRotation.data(), 0, 0);
-            ctx->UpdateSubresource(m_mergedOpacity, 0, nullptr, mergedOpacity.data(), 0, 0);
-            ctx->UpdateSubresource(m_mergedSHCoeffs, 0, nullptr, mergedSH.data(), 0, 0);
-            ctx->UpdateSubresource(m_instanceIDBuf, 0, nullptr, instanceIDs.data(), 0, 0);
+            ++b;
         }
+    }
 
-        m_cachedSignature = sig;
-        m_inputsUploaded  = true;
+    // Versions are unique per dataset and change with its rows
+    auto findBlock = [&](uint64_t version) -> int {
+        for (size_t b = 0; b < m_poolBlocks.size(); b++)
+            if (m_poolBlocks[b].version == version) return (int)b;
+        return -1;
+    };
 
-        MGlobal::displayInfo(MString("[GS-Manager] Merged inputs rebuilt: ") +
-                             N + " splats, " + numInstances + " instances");
+    // Mark the resident blocks shown this frame first, so making room for
+    // the new ones never evicts them
+    for (const RenderInstance& inst : m_instances) {
+        int b = findBlock(inst.dataset->version());
+        if (b >= 0) m_poolBlocks[b].lastFrame = m_frameStamp;
     }
+    uint32_t newBlocks = 0, newRows = 0;
+    for (const RenderInstance& inst : m_instances) {
+        if (findBlock(inst.dataset->version()) >= 0) continue;
+        PoolBlock block;
+        if (!allocateBlock(device, ctx, inst.node->dataset(), block)) return false;
+        m_poolBlocks.push_back(block);
+        newBlocks++;
+        newRows += block.capacity;
+    }
+    m_instanceBlock.resize(numInstances);
+    for (uint32_t i = 0; i < numInstances; i++)
+        m_instanceBlock[i] = (uint32_t)findBlock(m_instances[i].dataset->version());
+
+    uint32_t copiedRows = 0, uploadedRows = 0;
+    if (!fillPoolBlocks(device, ctx, copiedRows, uploadedRows)) return false;
+
+    if (newBlocks)
+        MGlobal::displayInfo(MString("[GS-Manager] Pool: +") + newBlocks + " datasets (" + newRows +
+                             " rows; " + copiedRows + " copied on the GPU, " + uploadedRows +
+                             " uploaded), " + m_rowAlloc.used() + "/" + m_rowAlloc.capacity() +
+                             " rows in use by " + (unsigned)m_poolBlocks.size() + " datasets" +
+                             (m_mergedCompact ? " (compact)" : ""));
+
+    // Culled instances keep their blocks (and keep streaming) but take no
+    // slots; with nothing in view there is nothing more to lay out
+    N = m_visibleSlots;
+    if (N == 0) return true;
+
+    // Compute outputs and sort buffers cover the visible instances' slots;
+    // the sort keeps single buffers, which caps the slot space at one SRV's
+    // elements
+    if (N > PageLayout::kMaxPageElements) {
+        MGlobal::displayError(MString("[GS-Manager] ") + N + " merged splats; at most " +
+                              PageLayout::kMaxPageElements + " can be drawn at once.");
+        return false;
+    }
+    if (N > m_mergedAllocN &&
+        !createComputeOutputs(device, std::min(RangeAllocator::grownCapacity(m_mergedAllocN, N),
+                                               PageLayout::kMaxPageElements)))
+        return false;
 
-    // --- Always update world matrices (tiny: numInstances * 64 bytes) ---
+    // --- Per-instance tables (tiny: 152 bytes per visible instance) ---
+    // world * view is formed here once per instance rather than per splat in
+    // the kernel. Each table is uploaded only when its contents change.
     {
-        std::vector<float> worldMats;
-        worldMats.reserve((size_t)numInstances * 16);
+        const uint32_t numVisible = m_visibleInstances;
+        std::vector<PreprocessInstance> mats;
+        std::vector<uint32_t>           slots, instanceSH;
+        mats.reserve(numVisible);
+        slots.reserve((size_t)numVisible * 2);
+        instanceSH.reserve((size_t)numVisible * 4);
         for (uint32_t i = 0; i < numInstances; i++) {
-            for (int j = 0; j < 16; j++)
-                worldMats.push_back(m_instances[i].worldMat[j]);
+            if (m_instanceSlot[i] == kCulled) continue;
+            const RenderInstance& inst  = m_instances[i];
+            const PoolBlock&      block = m_poolBlocks[m_instanceBlock[i]];
+            mats.emplace_back(inst.worldMat, m_viewMat);
+            slots.insert(slots.end(), { m_instanceSlot[i], std::min(inst.splatCount, block.uploaded) });
+            instanceSH.insert(instanceSH.end(), { block.firstRow, block.shBase, block.shStride,
+                                                  block.firstChunk });
         }
 
-        bool needReallocMats = (m_mergedAllocInstances != numInstances) || !m_worldMatsBuf;
-        if (needReallocMats) {
-            SAFE_RELEASE(m_worldMatsBuf);
-            SAFE_RELEASE(m_worldMatsSrv);
-            if (!createSRVBuffer(device, "worldMats", worldMats.data(), numInstances,
-                                 sizeof(float)*16, &m_worldMatsBuf, &m_worldMatsSrv))
+        bool needReallocTables = (m_mergedAllocInstances != numVisible) || !m_instanceMatsBuf;
+        if (needReallocTables) {
+            SAFE_RELEASE(m_instanceMatsBuf);  SAFE_RELEASE(m_instanceMatsSrv);
+            SAFE_RELEASE(m_instanceSlotsBuf); SAFE_RELEASE(m_instanceSlotsSrv);
+            SAFE_RELEASE(m_instanceSHBuf);    SAFE_RELEASE(m_instanceSHSrv);
+            m_mergedAllocInstances = 0;
+            if (!createSRVBuffer(device, "instanceMats", mats.data(), numVisible,
+                                 sizeof(PreprocessInstance), &m_instanceMatsBuf, &m_instanceMatsSrv) ||
+                !createSRVBuffer(device, "instanceSlots", slots.data(), numVisible,
+                                 sizeof(uint32_t)*2, &m_instanceSlotsBuf, &m_instanceSlotsSrv) ||
+                !createSRVBuffer(device, "instanceSH", instanceSH.data(), numVisible,
+                                 sizeof(uint32_t)*4, &m_instanceSHBuf, &m_instanceSHSrv))
                 return false;
+            m_mergedAllocInstances = numVisible;
+        }
+
+        auto upload = [&](ID3D11Buffer* buf, std::vector<uint8_t>& uploaded, const void* data, size_t bytes) {
+            const uint8_t* p = static_cast<const uint8_t*>(data);
+            if (!needReallocTables && uploaded.size() == bytes && std::equal(p, p + bytes, uploaded.begin()))
+                return;
+            if (!needReallocTables) ctx->UpdateSubresource(buf, 0, nullptr, data, 0, 0);
+            uploaded.assign(p, p + bytes);
+        };
+        upload(m_instanceMatsBuf,  m_uploadedInstanceMats, mats.data(), mats.size() * sizeof(PreprocessInstance));
+        upload(m_instanceSlotsBuf, m_uploadedSlots,        slots.data(), slots.size() * sizeof(uint32_t));
+        upload(m_instanceSHBuf,    m_uploadedInstanceSH,   instanceSH.data(), instanceSH.size() * sizeof(uint32_t));
+    }
+
+    return true;
+}
+
+// ===========================================================================
+// buildDispatchRanges  --  the slots preprocess runs over this frame: each
+// visible instance's loaded rows, narrowed by its dataset's chunk hierarchy
+// (SplatBVH) to the chunks that may be on screen, cut into kSlotBatch
+// dispatches. Runs that meet, within an instance or across two, are merged.
+// ===========================================================================
+bool GaussianRenderManager::buildDispatchRanges(ID3D11Device* device, ID3D11DeviceContext* ctx) {
+    m_dispatchRanges.clear();
+    m_dispatchBatches.clear();
+    m_dispatchThreads = 0;
+
+    std::vector<SplatBVH::Range> chunks;
+    for (size_t i = 0; i < m_instances.size(); i++) {
+        if (m_instanceSlot[i] == kCulled) continue;
+        const RenderInstance& inst = m_instances[i];
+        const uint32_t rows = std::min(inst.splatCount, m_poolBlocks[m_instanceBlock[i]].uploaded);
+        const SplatBVH& bvh = inst.dataset->bvh();
+        chunks.clear();
+        if (bvh.empty()) {
+            if (rows > 0) chunks.push_back({ 0, rows, 0.f });   // still loading
+        } else {
+            PreprocessInstance mats(inst.worldMat, m_viewMat);
+            bvh.cull(CullFrustum(mats.worldView, m_projMat, m_tanHalfFov, m_vpWidth, m_vpHeight),
+                     rows, chunks);
+        }
+
+        for (const SplatBVH::Range& r : chunks) {
+            for (uint32_t slot = m_instanceSlot[i] + r.first, end = slot + r.count; slot < end;) {
+                const uint32_t base = slot - slot % kSlotBatch;
+                const uint32_t n    = std::min(end, base + kSlotBatch) - slot;
+                if (m_dispatchBatches.empty() || m_dispatchBatches.back().slotBase != base)
+                    m_dispatchBatches.push_back({ base, (uint32_t)(m_dispatchRanges.size() / 2), 0, 0 });
+                DispatchBatch& batch = m_dispatchBatches.back();
+                const size_t   last  = m_dispatchRanges.size();
+                bool extends = batch.rangeCount > 0 &&
+                               m_dispatchRanges[last - 2] + (batch.threads - m_dispatchRanges[last - 1]) == slot;
+                if (!extends) {
+                    m_dispatchRanges.insert(m_dispatchRanges.end(), { slot, batch.threads });
+                    batch.rangeCount++;
+                }
+                batch.threads     += n;
+                m_dispatchThreads += n;
+                slot              += n;
+            }
+        }
+    }
+    if (m_dispatchRanges.empty()) return true;
+
+    const uint32_t count = (uint32_t)(m_dispatchRanges.size() / 2);
+    if (count > m_dispatchRangesAlloc) {
+        uint32_t alloc = RangeAllocator::grownCapacity(m_dispatchRangesAlloc, count);
+        SAFE_RELEASE(m_dispatchRangesBuf); SAFE_RELEASE(m_dispatchRangesSrv);
+        m_dispatchRangesAlloc = 0;
+        if (!createSRVBuffer(device, "dispatchRanges", nullptr, alloc, sizeof(uint32_t) * 2,
+                             &m_dispatchRangesBuf, &m_dispatchRangesSrv))
+            return false;
+        m_dispatchRangesAlloc = alloc;
+    }
+    D3D11_BOX box = {};
+    box.right  = count * (UINT)sizeof(uint32_t) * 2;
+    box.bottom = 1;
+    box.back   = 1;
+    ctx->UpdateSubresource(m_dispatchRangesBuf, 0, &box, m_dispatchRanges.data(), 0, 0);
+    return true;
+}
+
+// ===========================================================================
+// fillPoolBlocks  --  bring every resident block up to its dataset's loaded
+// rows: new blocks from row 0, streaming datasets from where the last frame
+// stopped. Rows already in the dataset's own input buffers (see
+// SplatDataset::uploadIfNeeded) are copied GPU-to-GPU through one CopyPlan,
+// which is checked against the buffer sizes before anything is issued. The
+// rest are uploaded from the CPU columns: rows the dataset has not uploaded
+// yet, and compact datasets expanded into a float pool, whose layouts
+// differ. A rejected plan falls back to the CPU upload as well. Both sides
+// are paged with the same strides; the plan works on single pages and cuts
+// each run where either side changes page.
+// ===========================================================================
+bool GaussianRenderManager::fillPoolBlocks(ID3D11Device* device, ID3D11DeviceContext* ctx,
+                                           uint32_t& copiedRows, uint32_t& uploadedRows) {
+    // Plan buffers are single pages: destination page p of column c is
+    // c * kMaxSHPages + p; sources are appended page by page per block.
+    // kShape0/1 are the covariance columns of a float pool, the scale and
+    // quaternion of a compact one.
+    enum { kPosition, kShape0, kShape1, kOpacity, kSH, kChunks, kColumns };
+    const uint32_t kDestPages = PageLayout::kMaxSHPages;
+    PagedBuffer* const columns[kColumns] = {
+        &m_poolPosition, m_mergedCompact ? &m_poolScale : &m_poolCovDiag,
+        m_mergedCompact ? &m_poolRotation : &m_poolCovOffDiag, &m_poolOpacity, &m_poolSH, &m_poolChunks
+    };
+    copiedRows = uploadedRows = 0;
+
+    CopyPlan                   plan;
+    std::vector<ID3D11Buffer*> sources;
+    std::vector<uint64_t>      sourceBytes;
+    std::vector<std::pair<PoolBlock*, uint32_t>> copied;    // block, rows after the plan
+
+    for (PoolBlock& block : m_poolBlocks) {
+        std::shared_ptr<SplatDataset> ds = block.dataset.lock();
+        if (!ds || ds->readyCount() <= block.uploaded) continue;
+        const GaussianData& gd = ds->data();
+        if (gd.compact() != m_mergedCompact) continue;
+        ds->uploadIfNeeded(device);
+        uint32_t onGpu = std::min(ds->uploadedCount(), ds->readyCount());
+        if (onGpu <= block.uploaded) continue;
+
+        const PagedBuffer* const srcCols[kColumns] = {
+            &ds->gpuPositionWS(), m_mergedCompact ? &ds->gpuScale() : &ds->gpuCovDiag(),
+            m_mergedCompact ? &ds->gpuRotation() : &ds->gpuCovOffDiag(), &ds->gpuOpacity(),
+            &ds->gpuSHCoeffs(), &ds->gpuChunks()
+        };
+        uint32_t srcBase[kColumns];
+        for (int c = 0; c < kColumns; c++) {
+            srcBase[c] = (uint32_t)sources.size();
+            for (uint32_t pg = 0; pg < srcCols[c]->pageCount(); pg++) {
+                sources.push_back(srcCols[c]->buf(pg));
+                sourceBytes.push_back((uint64_t)srcCols[c]->pageElements(pg) * srcCols[c]->layout().stride());
+            }
+        }
+        auto addColumn = [&](int c, uint64_t srcFirst, uint64_t dstFirst, uint64_t count) {
+            plan.addPaged(srcCols[c]->layout(), srcBase[c], srcFirst,
+                          columns[c]->layout(), c * kDestPages, dstFirst, count);
+        };
+
+        uint32_t shPer = m_mergedCompact ? (uint32_t)compactSHHalfs(gd.shDegree) / 2 : block.shStride;
+        uint32_t first = block.uploaded;
+        for (int c = kPosition; c <= kOpacity; c++)
+            addColumn(c, first, (uint64_t)block.firstRow + first, onGpu - first);
+        addColumn(kSH, (uint64_t)first * shPer, block.shBase + (uint64_t)first * shPer,
+                  (uint64_t)(onGpu - first) * shPer);
+        if (m_mergedCompact && first == 0)
+            addColumn(kChunks, 0, block.firstChunk, gd.packed.chunks.size());
+        copied.emplace_back(&block, onGpu);
+    }
+
+    if (!plan.empty()) {
+        std::vector<uint64_t> destBytes((size_t)kColumns * kDestPages, 0);
+        for (int c = 0; c < kColumns; c++)
+            for (uint32_t pg = 0; pg < columns[c]->pageCount(); pg++)
+                destBytes[c * kDestPages + pg] =
+                    (uint64_t)columns[c]->pageElements(pg) * columns[c]->layout().stride();
+        std::string error;
+        if (plan.validate(sourceBytes, destBytes, &error)) {
+            for (const BufferCopy& c : plan.copies()) {
+                D3D11_BOX box = {};
+                box.left   = (UINT)c.srcOffset;
+                box.right  = (UINT)(c.srcOffset + c.bytes);
+                box.bottom = 1;
+                box.back   = 1;
+                ctx->CopySubresourceRegion(columns[c.dest / kDestPages]->buf(c.dest % kDestPages), 0,
+                                           (UINT)c.dstOffset, 0, 0, sources[c.source], 0, &box);
+            }
+            for (auto& [block, rows] : copied) {
+                copiedRows     += rows - block->uploaded;
+                block->uploaded = rows;
+            }
         } else {
-            ctx->UpdateSubresource(m_worldMatsBuf, 0, nullptr, worldMats.data(), 0, 0);
+            MGlobal::displayError(MString("[GS-Manager] Pool copy plan rejected (") + error.c_str() +
+                                  "); uploading from the CPU instead.");
         }
     }
 
+    for (PoolBlock& block : m_poolBlocks) {
+        std::shared_ptr<SplatDataset> ds = block.dataset.lock();
+        if (!ds || ds->readyCount() <= block.uploaded) continue;
+        uploadBlockRows(ctx, block, ds->data(), block.uploaded, ds->readyCount());
+        uploadedRows  += ds->readyCount() - block.uploaded;
+        block.uploaded = ds->readyCount();
+    }
     return true;
 }
 
 // ===========================================================================
-// updateMergedSelection  --  concat per-instance selection masks into the
-// merged buffer using GPU-side CopySubresourceRegion. Skips work if no
-// instance's mask has changed since last call and the instance set matches.
+// updateMergedSelection  --  copy per-instance selection masks into their
+// slot ranges of the merged buffer using GPU-side CopySubresourceRegion.
+// Only instances whose mask version or slot range changed are copied.
 // ===========================================================================
 bool GaussianRenderManager::updateMergedSelection(ID3D11Device* device,
                                                    ID3D11DeviceContext* ctx) {
-    uint32_t N = m_totalSplats;
+    uint32_t N = m_visibleSlots;
     uint32_t numInstances = (uint32_t)m_instances.size();
     if (N == 0 || numInstances == 0) return false;
 
-    // Allocate / reallocate if size changed
-    bool needRealloc = (!m_mergedSelection) ||
-                        (m_instanceMaskVersions.size() != numInstances);
-    if (needRealloc) {
-        SAFE_RELEASE(m_mergedSelection);
-        SAFE_RELEASE(m_srvMergedSelection);
-        std::vector<uint32_t> zeroes(N, 0u);
-        if (!createSRVBuffer(device, "mergedSelection", zeroes.data(),
-                             N, sizeof(uint32_t),
-                             &m_mergedSelection, &m_srvMergedSelection))
+    // Sized like the compute outputs; grown only when they grow
+    if (m_mergedSelection.capacity() < N) {
+        if (m_mergedSelection.empty())
+            m_mergedSelection.init(PageLayout(sizeof(uint32_t), PageLayout::kMaxSlotPages),
+                                   "mergedSelection", PagedBuffer::kZeroed);
+        if (!m_mergedSelection.resize(device, ctx, std::max(N, m_mergedAllocN)))
             return false;
-        m_instanceMaskVersions.assign(numInstances, (uint64_t)-1);
         m_selectionDirty = true;
     }
 
-    // Check if any per-instance mask version drifted
-    bool anyChanged = m_selectionDirty;
-    if (!anyChanged) {
-        for (uint32_t i = 0; i < numInstances; i++) {
-            if (m_instanceMaskVersions[i] != m_instances[i].node->maskVersion()) {
-                anyChanged = true;
-                break;
-            }
-        }
-    }
-    if (!anyChanged) return true;
-
-    // Concatenate via CopySubresourceRegion (GPU-side byte copy per instance).
-    uint32_t byteOffset = 0;
+    m_selectionSlots.resize(numInstances);
     for (uint32_t i = 0; i < numInstances; i++) {
         const RenderInstance& inst = m_instances[i];
-        GaussianNode* dn = inst.node;
-        uint32_t cnt = inst.splatCount;
-        if (!dn->bufSelectionMask() || cnt == 0) {
-            byteOffset += cnt * sizeof(uint32_t);
-            continue;
+        GaussianNode* dn    = inst.node;
+        uint32_t      cnt   = inst.splatCapacity;
+        uint32_t      first = m_instanceSlot[i];
+        SelectionSlot& seen = m_selectionSlots[i];
+        // A culled instance's range may be handed to others; copy it again
+        // once it is back in view
+        if (first == kCulled) { seen = SelectionSlot(); continue; }
+        bool stale = m_selectionDirty || seen.node != dn || seen.first != first ||
+                     seen.version != dn->maskVersion();
+        if (stale && !dn->selectionMask().empty() && cnt > 0) {
+            m_mergedSelection.copyFrom(ctx, first, dn->selectionMask(), 0, cnt);
+            seen = { dn, first, dn->maskVersion() };
         }
-        D3D11_BOX box = {};
-        box.left   = 0;
-        box.right  = cnt * sizeof(uint32_t);
-        box.top    = 0;
-        box.bottom = 1;
-        box.front  = 0;
-        box.back   = 1;
-        ctx->CopySubresourceRegion(m_mergedSelection, 0,
-                                    byteOffset, 0, 0,
-                                    dn->bufSelectionMask(), 0, &box);
-        byteOffset += cnt * sizeof(uint32_t);
-        m_instanceMaskVersions[i] = dn->maskVersion();
     }
 
     m_selectionDirty = false;
@@ -773,7 +1313,8 @@ bool GaussianRenderManager::updateMergedSelection(ID3D11Device* device,
 // ===========================================================================
 // render  --  main merged pipeline
 // ===========================================================================
-bool GaussianRenderManager::render(ID3D11Device* device, ID3D11DeviceContext* ctx, int renderMode) {
+bool GaussianRenderManager::render(ID3D11Device* device, ID3D11DeviceContext* ctx, int renderMode,
+                                   int sortKeyBits) {
     if (m_frameRendered) return false;  // already done this frame
     m_frameRendered = true;
 
@@ -790,13 +1331,23 @@ bool GaussianRenderManager::render(ID3D11Device* device, ID3D11DeviceContext* ct
         initDepthPassPipeline(device);  // non-fatal
     }
 
+    // Instances out of view get no slots this frame
+    cullInstances();
+
     // Build/update merged input buffers
     if (!buildMergedInputs(device, ctx)) return false;
+    if (m_visibleSlots == 0) return false;
+
+    // The chunks of the visible instances that may be on screen
+    if (!buildDispatchRanges(device, ctx)) return false;
+    if (m_dispatchThreads == 0) return false;
 
     // Refresh merged selection mask (concat per-instance masks)
     updateMergedSelection(device, ctx);
 
-    uint32_t N = m_totalSplats;
+    uint32_t N = m_visibleSlots;
+    m_debugFixedRadius = (renderMode == 3) ? 5 : 0;
+    m_sortKeyBits = (uint32_t)SplatSort::keyBits(sortKeyBits);
 
     // Ensure depth texture matches viewport
     uint32_t vpW = (uint32_t)m_vpWidth;
@@ -805,130 +1356,272 @@ bool GaussianRenderManager::render(ID3D11Device* device, ID3D11DeviceContext* ct
         createDepthTexture(device, vpW, vpH);
     }
 
-    // -- 1. Update preprocess CB --
+    // -- 1-2. Preprocess CB and dispatch, per kSlotBatch slots with ranges --
+    // The pool pages are bound once (t8..t71); each dispatch gets the output
+    // and mask pages its slots fall in. Slots no range covers read as
+    // culled: their radius is cleared first.
     {
-        D3D11_MAPPED_SUBRESOURCE mapped;
-        if (SUCCEEDED(ctx->Map(m_preprocessCB, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) {
-            CBPreprocessMerged* cb = static_cast<CBPreprocessMerged*>(mapped.pData);
-            std::memcpy(cb->viewMat,   m_viewMat,   64);
-            std::memcpy(cb->projMat,   m_projMat,   64);
-            std::memcpy(cb->cameraPos, m_cameraPos,  12);
-            cb->padding0       = 0.f;
-            cb->tanHalfFov[0]  = m_tanHalfFov[0];
-            cb->tanHalfFov[1]  = m_tanHalfFov[1];
-            cb->filmWidth      = (int)m_vpWidth;
-            cb->filmHeight     = (int)m_vpHeight;
-            cb->gaussCount     = N;
-            cb->debugFixedRadius = (renderMode == 3) ? 5 : 0;
-            cb->pad2 = cb->pad3 = 0.f;
-            ctx->Unmap(m_preprocessCB, 0);
+        if (m_dispatchThreads < N) {
+            const UINT zeros[4] = {};
+            for (uint32_t page = 0; page <= m_outRadius.layout().pageOf(N - 1); page++)
+                ctx->ClearUnorderedAccessViewUint(m_outRadius.uav(page), zeros);
         }
-    }
 
-    // -- 2. Dispatch preprocess --
-    {
-        ID3D11ShaderResourceView* srvs[] = {
-            m_mergedSrvPosWS, m_mergedSrvScale, m_mergedSrvRotation,
-            m_mergedSrvOpacity, m_mergedSrvSH, m_instanceIDSrv, m_worldMatsSrv,
-            m_srvMergedSelection
-        };
-        ID3D11UnorderedAccessView* uavs[] = {
-            m_uavPositionSS, m_uavDepth, m_uavRadius, m_uavColor, m_uavCov2D
+        const uint32_t kRowPages = PageLayout::kMaxRowPages;
+        ID3D11ShaderResourceView* srvs[8 + 4 * kRowPages + PageLayout::kMaxSHPages] = {
+            m_instanceSlotsSrv, m_instanceMatsSrv, nullptr, m_instanceSHSrv, m_poolChunks.srv(0),
+            m_dispatchRangesSrv
         };
-        ctx->CSSetShader(m_preprocessCS, nullptr, 0);
+        m_poolPosition.srvs(srvs + 8);
+        (m_mergedCompact ? m_poolScale : m_poolCovDiag).srvs(srvs + 8 + kRowPages);
+        (m_mergedCompact ? m_poolRotation : m_poolCovOffDiag).srvs(srvs + 8 + 2 * kRowPages);
+        m_poolOpacity.srvs(srvs + 8 + 3 * kRowPages);
+        m_poolSH.srvs(srvs + 8 + 4 * kRowPages);
+        const UINT kNumSRVs = (UINT)(sizeof(srvs) / sizeof(srvs[0]));
+
+        ctx->CSSetShader(m_mergedCompact ? m_preprocessCompactCS : m_preprocessCS, nullptr, 0);
         ctx->CSSetConstantBuffers(0, 1, &m_preprocessCB);
-        ctx->CSSetShaderResources(0, 8, srvs);
-        ctx->CSSetUnorderedAccessViews(0, 5, uavs, nullptr);
+        for (const DispatchBatch& batch : m_dispatchBatches) {
+            D3D11_MAPPED_SUBRESOURCE mapped;
+            if (SUCCEEDED(ctx->Map(m_preprocessCB, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) {
+                CBPreprocessMerged* cb = static_cast<CBPreprocessMerged*>(mapped.pData);
+                std::memcpy(cb->viewMat,   m_viewMat,   64);
+                std::memcpy(cb->projMat,   m_projMat,   64);
+                std::memcpy(cb->cameraPos, m_cameraPos,  12);
+                cb->padding0       = 0.f;
+                cb->tanHalfFov[0]  = m_tanHalfFov[0];
+                cb->tanHalfFov[1]  = m_tanHalfFov[1];
+                cb->filmWidth      = (int)m_vpWidth;
+                cb->filmHeight     = (int)m_vpHeight;
+                cb->gaussCount     = N;
+                cb->debugFixedRadius = m_debugFixedRadius;
+                cb->instanceCount  = m_visibleInstances;
+                cb->slotBase       = batch.slotBase;
+                cb->rangeBase      = batch.firstRange;
+                cb->rangeCount     = batch.rangeCount;
+                cb->threadCount    = batch.threads;
+                cb->padding1       = 0;
+                ctx->Unmap(m_preprocessCB, 0);
+            }
 
-        ctx->Dispatch((N + 255) / 256, 1, 1);
+            uint32_t page = m_outDepth.layout().pageOf(batch.slotBase);
+            srvs[2] = m_mergedSelection.srv(page);
+            ID3D11UnorderedAccessView* uavs[] = {
+                m_outPositionSS.uav(page), m_outDepth.uav(page), m_outRadius.uav(page),
+                m_outColor.uav(page), m_outCov2D.uav(page)
+            };
+            ctx->CSSetShaderResources(0, kNumSRVs, srvs);
+            ctx->CSSetUnorderedAccessViews(0, 5, uavs, nullptr);
+            ctx->Dispatch((batch.threads + 255) / 256, 1, 1);
+        }
 
         ID3D11UnorderedAccessView* nullUAVs[5] = {};
         ctx->CSSetUnorderedAccessViews(0, 5, nullUAVs, nullptr);
-        ID3D11ShaderResourceView* nullSRVs[8] = {};
-        ctx->CSSetShaderResources(0, 8, nullSRVs);
+        ID3D11ShaderResourceView* nullSRVs[kNumSRVs] = {};
+        ctx->CSSetShaderResources(0, kNumSRVs, nullSRVs);
     }
 
-    // -- 3. GPU Radix Sort --
-    {
-        uint32_t numBlocks = (N + kSortTileSize - 1) / kSortTileSize;
-
-        // 3a. KeyGen
-        {
-            CBSort scb = { N, numBlocks, 0, 0 };
+    // -- 3. GPU Radix Sort of the drawn slots --
+    // Against the last sorted frame: unchanged, the draw list and its
+    // arguments in the sort buffers stand; a small camera move sorts
+    // incrementally from the last order (SplatCoherence.h)
+    if (!m_sortArgs) return false;   // sort buffers failed to allocate
+    const SortFrame sortFrame = currentSortFrame();
+    m_sortMode = SortCoherence::classify(m_lastSortFrame, sortFrame);
+    if (m_sortMode != SortCoherence::kReuse) {
+        const bool incremental = (m_sortMode == SortCoherence::kIncremental);
+        const float depthProj[4] = { m_projMat[10], m_projMat[11], m_projMat[14], m_projMat[15] };
+        auto setSortCB = [&](CBSort scb) {
+            scb.keyBits = m_sortKeyBits;
+            std::memcpy(scb.depthProj, depthProj, sizeof(depthProj));
             D3D11_MAPPED_SUBRESOURCE mapped;
             if (SUCCEEDED(ctx->Map(m_sortCB, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) {
                 std::memcpy(mapped.pData, &scb, sizeof(scb));
                 ctx->Unmap(m_sortCB, 0);
             }
+        };
+        const UINT zeros[4] = {};
+        ID3D11ShaderResourceView*  nullSRVs[5] = {};
+        ID3D11UnorderedAccessView* nullUAVs[5] = {};
+        // Stages of CoherenceArgsKernel (radix_sort.hlsl)
+        auto coherenceArgs = [&](uint32_t stage) {
+            ctx->CSSetShader(m_sortCS_coherenceArgs, nullptr, 0);
+            ctx->CSSetConstantBuffers(0, 1, &m_sortCB);
+            setSortCB({ 0, 0, 0, 0, 0, 0, 0, stage });
+            ID3D11UnorderedAccessView* argsUAV[] = { m_sortArgs_UAV, m_sortState_UAV };
+            ctx->CSSetUnorderedAccessViews(0, 2, argsUAV, nullptr);
+            ctx->Dispatch(1, 1, 1);
+            ctx->CSSetUnorderedAccessViews(0, 2, nullUAVs, nullptr);
+        };
+        ctx->ClearUnorderedAccessViewUint(m_sortState_UAV, zeros);
+        if (incremental) coherenceArgs(0);   // the last kept count
+        ctx->ClearUnorderedAccessViewUint(m_sortArgs_UAV, zeros);
+        ctx->ClearUnorderedAccessViewUint(m_sortTileState_UAV, zeros);
+
+        // 3a. KeyGen over the preprocessed slots, per batch with its output
+        // pages: the drawn ones go to keys/vals A in slot order, and counted
+        {
             ctx->CSSetShader(m_sortCS_keygen, nullptr, 0);
             ctx->CSSetConstantBuffers(0, 1, &m_sortCB);
-            ID3D11ShaderResourceView* kgSRV[] = { m_srvDepth };
-            ctx->CSSetShaderResources(0, 1, kgSRV);
-            ID3D11UnorderedAccessView* kgUAV[] = { m_sortKeysA_UAV, m_sortValsA_UAV };
-            ctx->CSSetUnorderedAccessViews(0, 2, kgUAV, nullptr);
-            ctx->Dispatch((N + kSortGroupSize - 1) / kSortGroupSize, 1, 1);
-            ID3D11ShaderResourceView*  n1[1] = {};
-            ID3D11UnorderedAccessView* n2[2] = {};
-            ctx->CSSetShaderResources(0, 1, n1);
-            ctx->CSSetUnorderedAccessViews(0, 2, n2, nullptr);
+            ID3D11UnorderedAccessView* kgUAV[] = {
+                m_sortKeysA_UAV, m_sortValsA_UAV, m_sortState_UAV, m_sortTileState_UAV, m_sortArgs_UAV
+            };
+            ctx->CSSetUnorderedAccessViews(0, 5, kgUAV, nullptr);
+            uint32_t tileBase = 0;
+            for (const DispatchBatch& batch : m_dispatchBatches) {
+                const uint32_t groups = (batch.threads + kSortGroupSize - 1) / kSortGroupSize;
+                setSortCB({ N, tileBase, 0, batch.slotBase, batch.firstRange, batch.rangeCount, batch.threads, 0 });
+                uint32_t page = m_outDepth.layout().pageOf(batch.slotBase);
+                ID3D11ShaderResourceView* kgSRV[] = {
+                    m_outDepth.srv(page), m_outRadius.srv(page), m_dispatchRangesSrv
+                };
+                ctx->CSSetShaderResources(0, 3, kgSRV);
+                ctx->Dispatch(groups, 1, 1);
+                tileBase += groups;
+            }
+            ctx->CSSetShaderResources(0, 3, nullSRVs);
+            ctx->CSSetUnorderedAccessViews(0, 5, nullUAVs, nullptr);
+
+            // 3b. Indirect arguments from the kept count
+            ctx->CSSetShader(m_sortCS_args, nullptr, 0);
+            ctx->CSSetUnorderedAccessViews(0, 1, &m_sortArgs_UAV, nullptr);
+            ctx->Dispatch(1, 1, 1);
+            ctx->CSSetUnorderedAccessViews(0, 1, nullUAVs, nullptr);
         }
 
-        // 3b. Four radix passes
-        for (uint32_t pass = 0; pass < 4; pass++) {
-            bool even = (pass % 2 == 0);
-            auto keysInSRV  = even ? m_sortKeysA_SRV  : m_sortKeysB_SRV;
-            auto keysOutUAV = even ? m_sortKeysB_UAV  : m_sortKeysA_UAV;
-            auto valsInSRV  = even ? m_sortValsA_SRV  : m_sortValsB_SRV;
-            auto valsOutUAV = even ? m_sortValsB_UAV  : m_sortValsA_UAV;
-
-            {
-                CBSort scb = { N, numBlocks, pass * 8, 0 };
-                D3D11_MAPPED_SUBRESOURCE mapped;
-                if (SUCCEEDED(ctx->Map(m_sortCB, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) {
-                    std::memcpy(mapped.pData, &scb, sizeof(scb));
-                    ctx->Unmap(m_sortCB, 0);
-                }
-            }
+        // 3c. Keys quantised to m_sortKeyBits (when below 32), the digit
+        // counts of all passes, then their first entries
+        {
+            ctx->CSSetShader(m_sortCS_hist, nullptr, 0);
+            setSortCB({});
+            ID3D11ShaderResourceView*  hSRV[] = { nullptr, m_sortArgs_SRV };
+            ID3D11UnorderedAccessView* hUAV[] = { m_sortState_UAV, m_sortKeysA_UAV };
+            ctx->CSSetShaderResources(0, 2, hSRV);
+            ctx->CSSetUnorderedAccessViews(0, 2, hUAV, nullptr);
+            ctx->DispatchIndirect(m_sortArgs, kSortDispatchArgs);
+            ctx->CSSetShaderResources(0, 2, nullSRVs);
+            ctx->CSSetUnorderedAccessViews(0, 2, nullUAVs, nullptr);
+
+            ctx->CSSetShader(m_sortCS_scan, nullptr, 0);
+            ctx->CSSetUnorderedAccessViews(0, 1, &m_sortState_UAV, nullptr);
+            ctx->Dispatch(1, 1, 1);
+            ctx->CSSetUnorderedAccessViews(0, 1, nullUAVs, nullptr);
+        }
 
-            // Count
-            {
-                ctx->CSSetShader(m_sortCS_count, nullptr, 0);
-                ctx->CSSetConstantBuffers(0, 1, &m_sortCB);
-                ctx->CSSetShaderResources(0, 1, &keysInSRV);
-                ctx->CSSetUnorderedAccessViews(0, 1, &m_sortBlockHist_UAV, nullptr);
-                ctx->Dispatch(numBlocks, 1, 1);
-                ID3D11ShaderResourceView*  n1[1] = {};
-                ID3D11UnorderedAccessView* n1u[1] = {};
-                ctx->CSSetShaderResources(0, 1, n1);
-                ctx->CSSetUnorderedAccessViews(0, 1, n1u, nullptr);
+        // One Onesweep pass over the tiles at `argsOffset` per 8 key bits,
+        // ping-ponging A -> B -> A
+        auto onesweep = [&](uint32_t passes, uint32_t argsOffset) {
+            ctx->CSSetShader(m_sortCS_onesweep, nullptr, 0);
+            ctx->CSSetConstantBuffers(0, 1, &m_sortCB);
+            for (uint32_t pass = 0; pass < passes; pass++) {
+                bool even = (pass % 2 == 0);
+                ID3D11ShaderResourceView* osSRV[] = {
+                    even ? m_sortKeysA_SRV : m_sortKeysB_SRV, even ? m_sortValsA_SRV : m_sortValsB_SRV,
+                    m_sortArgs_SRV
+                };
+                ID3D11UnorderedAccessView* osUAV[] = {
+                    even ? m_sortKeysB_UAV : m_sortKeysA_UAV, even ? m_sortValsB_UAV : m_sortValsA_UAV,
+                    m_sortState_UAV, m_sortTileState_UAV
+                };
+                ctx->ClearUnorderedAccessViewUint(m_sortTileState_UAV, zeros);
+                setSortCB({ 0, 0, pass * 8, 0, 0, 0, 0, pass });
+                ctx->CSSetShaderResources(0, 3, osSRV);
+                ctx->CSSetUnorderedAccessViews(0, 4, osUAV, nullptr);
+                ctx->DispatchIndirect(m_sortArgs, argsOffset);
+                ctx->CSSetShaderResources(0, 3, nullSRVs);
+                ctx->CSSetUnorderedAccessViews(0, 4, nullUAVs, nullptr);
             }
+        };
 
-            // Scan
-            {
-                ctx->CSSetShader(m_sortCS_scan, nullptr, 0);
-                ctx->CSSetConstantBuffers(0, 1, &m_sortCB);
-                ctx->CSSetUnorderedAccessViews(0, 1, &m_sortBlockHist_UAV, nullptr);
-                ctx->Dispatch(1, 1, 1);
-                ID3D11UnorderedAccessView* n1u[1] = {};
-                ctx->CSSetUnorderedAccessViews(0, 1, n1u, nullptr);
-            }
+        if (!incremental) {
+            // 3d. The full sort; the result ends in B after an odd count
+            const uint32_t passes = (uint32_t)SplatSort::passCount((int)m_sortKeyBits);
+            m_sortedInB = (passes % 2) != 0;
+            onesweep(passes, kSortDispatchArgs);
+        } else {
+            ctx->CSSetConstantBuffers(0, 1, &m_sortCB);
 
-            // Scatter
-            {
-                ctx->CSSetShader(m_sortCS_scatter, nullptr, 0);
-                ctx->CSSetConstantBuffers(0, 1, &m_sortCB);
-                ID3D11ShaderResourceView* scSRV[] = { keysInSRV, valsInSRV, m_sortBlockHist_SRV };
-                ctx->CSSetShaderResources(0, 3, scSRV);
-                ID3D11UnorderedAccessView* scUAV[] = { keysOutUAV, valsOutUAV };
-                ctx->CSSetUnorderedAccessViews(0, 2, scUAV, nullptr);
-                ctx->Dispatch(numBlocks, 1, 1);
-                ID3D11ShaderResourceView*  n3[3] = {};
-                ID3D11UnorderedAccessView* n2[2] = {};
-                ctx->CSSetShaderResources(0, 3, n3);
-                ctx->CSSetUnorderedAccessViews(0, 2, n2, nullptr);
+            // 3d. Each kept slot's entry in A, by slot (keys B)
+            ctx->CSSetShader(m_sortCS_mark, nullptr, 0);
+            ID3D11ShaderResourceView* mkSRV[] = { m_sortArgs_SRV, m_sortValsA_SRV };
+            ctx->CSSetShaderResources(0, 2, mkSRV);
+            ctx->CSSetUnorderedAccessViews(0, 1, &m_sortKeysB_UAV, nullptr);
+            ctx->DispatchIndirect(m_sortArgs, kSortDispatchArgs);
+            ctx->CSSetShaderResources(0, 2, nullSRVs);
+            ctx->CSSetUnorderedAccessViews(0, 1, nullUAVs, nullptr);
+
+            // 3e. Survivors into C in the last order, their last rank by slot
+            // (vals B), then the entrants behind them
+            coherenceArgs(1);
+            ctx->ClearUnorderedAccessViewUint(m_sortTileState_UAV, zeros);
+            ctx->CSSetShader(m_sortCS_seed, nullptr, 0);
+            setSortCB({});
+            ID3D11ShaderResourceView* sdSRV[] = {
+                m_sortKeysA_SRV, m_sortValsA_SRV, m_sortKeysB_SRV, m_sortPrevOrder_SRV, m_sortArgs_SRV
+            };
+            ID3D11UnorderedAccessView* sdUAV[] = {
+                m_sortKeysC_UAV, m_sortValsC_UAV, m_sortState_UAV, m_sortTileState_UAV, m_sortValsB_UAV
+            };
+            ctx->CSSetShaderResources(0, 5, sdSRV);
+            ctx->CSSetUnorderedAccessViews(0, 5, sdUAV, nullptr);
+            ctx->DispatchIndirect(m_sortArgs, kSortSeedArgs);
+            ctx->CSSetShaderResources(0, 5, nullSRVs);
+            ctx->CSSetUnorderedAccessViews(0, 5, nullUAVs, nullptr);
+
+            ctx->CSSetShader(m_sortCS_entrants, nullptr, 0);
+            ID3D11ShaderResourceView* enSRV[] = {
+                m_sortKeysA_SRV, m_sortValsA_SRV, m_sortValsB_SRV, m_sortPrevOrder_SRV, m_sortArgs_SRV
+            };
+            ID3D11UnorderedAccessView* enUAV[] = { m_sortKeysC_UAV, m_sortValsC_UAV, m_sortState_UAV };
+            ctx->CSSetShaderResources(0, 5, enSRV);
+            ctx->CSSetUnorderedAccessViews(0, 3, enUAV, nullptr);
+            ctx->DispatchIndirect(m_sortArgs, kSortDispatchArgs);
+            ctx->CSSetShaderResources(0, 5, nullSRVs);
+            ctx->CSSetUnorderedAccessViews(0, 3, nullUAVs, nullptr);
+
+            // 3f. Fix-up: survivor windows, shifted windows, the entrants
+            coherenceArgs(2);
+            ctx->CSSetShader(m_sortCS_fixup, nullptr, 0);
+            ID3D11UnorderedAccessView* fxUAV[] = { m_sortKeysC_UAV, m_sortValsC_UAV };
+            ctx->CSSetShaderResources(0, 1, &m_sortState_SRV);
+            ctx->CSSetUnorderedAccessViews(0, 2, fxUAV, nullptr);
+            for (uint32_t stage = 0; stage < 3; stage++) {
+                setSortCB({ 0, 0, 0, 0, 0, 0, 0, stage });
+                if (stage < 2) ctx->DispatchIndirect(m_sortArgs, kSortFixupArgs);
+                else           ctx->Dispatch(1, 1, 1);
             }
+            ctx->CSSetShaderResources(0, 1, nullSRVs);
+            ctx->CSSetUnorderedAccessViews(0, 2, nullUAVs, nullptr);
+
+            ctx->CSSetShader(m_sortCS_check, nullptr, 0);
+            ctx->CSSetShaderResources(0, 1, &m_sortKeysC_SRV);
+            ctx->CSSetUnorderedAccessViews(0, 1, &m_sortState_UAV, nullptr);
+            ctx->DispatchIndirect(m_sortArgs, kSortFixupArgs);
+            ctx->CSSetShaderResources(0, 1, nullSRVs);
+            ctx->CSSetUnorderedAccessViews(0, 1, nullUAVs, nullptr);
+
+            // 3g. Merged into A if the fix-up held, sorted in full if not:
+            // the GPU gives the other no groups. An even pass count leaves
+            // the full sort in A as well.
+            coherenceArgs(3);
+            ctx->CSSetShader(m_sortCS_merge, nullptr, 0);
+            ID3D11ShaderResourceView* mgSRV[] = { m_sortKeysC_SRV, m_sortValsC_SRV, m_sortState_SRV };
+            ID3D11UnorderedAccessView* mgUAV[] = { m_sortKeysA_UAV, m_sortValsA_UAV };
+            ctx->CSSetShaderResources(0, 3, mgSRV);
+            ctx->CSSetUnorderedAccessViews(0, 2, mgUAV, nullptr);
+            ctx->DispatchIndirect(m_sortArgs, kSortMergeArgs);
+            ctx->CSSetShaderResources(0, 3, nullSRVs);
+            ctx->CSSetUnorderedAccessViews(0, 2, nullUAVs, nullptr);
+
+            const uint32_t passes = (uint32_t)SplatSort::passCount((int)m_sortKeyBits);
+            m_sortedInB = false;
+            onesweep((passes + 1) & ~1u, kSortFallbackArgs);
         }
         ctx->CSSetShader(nullptr, nullptr, 0);
+
+        // The order the next frame may start from
+        ctx->CopyResource(m_sortPrevOrder, m_sortedInB ? m_sortValsB : m_sortValsA);
+        m_lastSortFrame = sortFrame;
     }
 
     // -- 4. Update render CB --
@@ -943,28 +1636,37 @@ bool GaussianRenderManager::render(ID3D11Device* device, ID3D11DeviceContext* ct
         }
     }
 
-    // -- 5. Render (sorted instanced draw) --
+    // -- 5. Render (sorted instanced draw of the kept count) --
     {
         float blendFactor[] = { 1.f, 1.f, 1.f, 1.f };
         ctx->OMSetBlendState(m_blendState, blendFactor, 0xFFFFFFFF);
         ctx->RSSetState(m_rsState);
         ctx->OMSetDepthStencilState(m_dsState, 0);
 
-        ID3D11ShaderResourceView* vsSRVs[] = {
-            m_srvPositionSS, m_srvRadius, m_srvColor,
-            m_srvCov2D, m_srvDepth, m_sortValsA_SRV, m_srvMergedSelection
-        };
+        // Both pages of each output and of the mask (t0..t11, production.hlsl),
+        // then the sorted indices
+        const uint32_t kSlotPages = PageLayout::kMaxSlotPages;
+        ID3D11ShaderResourceView* vsSRVs[6 * kSlotPages + 1] = {};
+        m_outPositionSS.srvs(vsSRVs);
+        m_outRadius.srvs(vsSRVs + kSlotPages);
+        m_outColor.srvs(vsSRVs + 2 * kSlotPages);
+        m_outCov2D.srvs(vsSRVs + 3 * kSlotPages);
+        m_outDepth.srvs(vsSRVs + 4 * kSlotPages);
+        m_mergedSelection.srvs(vsSRVs + 5 * kSlotPages);
+        vsSRVs[6 * kSlotPages] = sortedIndicesSRV();
+        const UINT kNumVSSRVs = 6 * kSlotPages + 1;
+
         ctx->IASetInputLayout(nullptr);
         ctx->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
         ctx->VSSetShader(m_prodVS, nullptr, 0);
         ctx->VSSetConstantBuffers(0, 1, &m_prodCB);
-        ctx->VSSetShaderResources(0, 7, vsSRVs);
+        ctx->VSSetShaderResources(0, kNumVSSRVs, vsSRVs);
         ctx->GSSetShader(nullptr, nullptr, 0);
         ctx->PSSetShader(m_prodPS, nullptr, 0);
-        ctx->DrawInstanced(4, N, 0, 0);
+        ctx->DrawInstancedIndirect(m_sortArgs, kSortDrawArgs);
 
-        ID3D11ShaderResourceView* nullSRVs7[7] = {};
-        ctx->VSSetShaderResources(0, 7, nullSRVs7);
+        ID3D11ShaderResourceView* nullVSSRVs[kNumVSSRVs] = {};
+        ctx->VSSetShaderResources(0, kNumVSSRVs, nullVSSRVs);
     }
 
     // -- 6. Depth pass --
@@ -974,8 +1676,8 @@ bool GaussianRenderManager::render(ID3D11Device* device, ID3D11DeviceContext* ct
         uint32_t W = m_depthTexW;
         uint32_t H = m_depthTexH;
 
-        // 6a. Update depth CB
-        {
+        // 6a. Update depth CB (rewritten per dispatch below with its first slot)
+        auto updateDepthCB = [&](uint32_t slotBase) {
             D3D11_MAPPED_SUBRESOURCE mapped;
             if (SUCCEEDED(ctx->Map(m_depthCB, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) {
                 CBDepth* cb = static_cast<CBDepth*>(mapped.pData);
@@ -984,10 +1686,12 @@ bool GaussianRenderManager::render(ID3D11Device* device, ID3D11DeviceContext* ct
                 cb->splatCount     = N;
                 cb->radiusCap      = 16;
                 cb->alphaThreshold = 0.5f;
-                cb->pad0 = cb->pad1 = cb->pad2 = 0.f;
+                cb->slotBase       = slotBase;
+                cb->pad1 = cb->pad2 = 0.f;
                 ctx->Unmap(m_depthCB, 0);
             }
-        }
+        };
+        updateDepthCB(0);
 
         // 6b. Clear depth UAV
         {
@@ -997,15 +1701,20 @@ bool GaussianRenderManager::render(ID3D11Device* device, ID3D11DeviceContext* ct
             ctx->Dispatch((W + 15) / 16, (H + 15) / 16, 1);
         }
 
-        // 6c. Depth pass kernel
+        // 6c. Depth pass kernel, per kSlotBatch slots with their output pages
         {
-            ID3D11ShaderResourceView* srvs[] = {
-                m_srvPositionSS, m_srvRadius, m_srvDepth, m_srvCov2D
-            };
             ctx->CSSetShader(m_depthPassCS, nullptr, 0);
             ctx->CSSetConstantBuffers(0, 1, &m_depthCB);
-            ctx->CSSetShaderResources(0, 4, srvs);
-            ctx->Dispatch((N + 255) / 256, 1, 1);
+            for (uint32_t base = 0; base < N; base += kSlotBatch) {
+                uint32_t page = m_outDepth.layout().pageOf(base);
+                ID3D11ShaderResourceView* srvs[] = {
+                    m_outPositionSS.srv(page), m_outRadius.srv(page),
+                    m_outDepth.srv(page), m_outCov2D.srv(page)
+                };
+                updateDepthCB(base);
+                ctx->CSSetShaderResources(0, 4, srvs);
+                ctx->Dispatch((std::min(kSlotBatch, N - base) + 255) / 256, 1, 1);
+            }
 
             ID3D11ShaderResourceView*  nullSRV4[4] = {};
             ID3D11UnorderedAccessView* nullUAV1[1] = {};
@@ -1041,32 +1750,112 @@ bool GaussianRenderManager::render(ID3D11Device* device, ID3D11DeviceContext* ct
     return true;
 }
 
+// ===========================================================================
+// readInstanceOutputs  --  GPU outputs of one instance, for gsPreprocessCheck
+// ===========================================================================
+bool GaussianRenderManager::readInstanceOutputs(ID3D11Device* device, ID3D11DeviceContext* ctx,
+                                                const GaussianNode* node, PreprocessOutputs& out,
+                                                uint32_t& rows, float worldMat[16]) const {
+    if (!m_frameRendered || m_instanceBlock.size() != m_instances.size() ||
+        m_instanceSlot.size() != m_instances.size())
+        return false;
+
+    for (size_t i = 0; i < m_instances.size(); i++) {
+        const RenderInstance& inst = m_instances[i];
+        if (inst.node != node) continue;
+        // Culled: the kernel did not run over it
+        uint32_t first = m_instanceSlot[i];
+        if (first == kCulled) return false;
+        // As buildMergedInputs wrote the instance's slot range
+        rows = std::min(inst.splatCount, m_poolBlocks[m_instanceBlock[i]].uploaded);
+        if ((uint64_t)first + rows > m_outRadius.capacity()) return false;
+        std::memcpy(worldMat, inst.worldMat, 64);
+
+        out.resize(rows);
+        return m_outPositionSS.read(device, ctx, first, rows, out.positionSS.data()) &&
+               m_outDepth.read(device, ctx, first, rows, out.depth.data()) &&
+               m_outRadius.read(device, ctx, first, rows, out.radius.data()) &&
+               m_outColor.read(device, ctx, first, rows, out.color.data()) &&
+               m_outCov2D.read(device, ctx, first, rows, out.cov2D.data());
+    }
+    return false;
+}
+
+// ===========================================================================
+// readDrawList  --  the sorted draw list of the last frame, for gsSortCheck
+// ===========================================================================
+// `bytes` of a buffer from byte `offset` into CPU memory, through a staging copy
+static bool readBufferBytes(ID3D11Device* device, ID3D11DeviceContext* ctx, ID3D11Buffer* buf,
+                            uint32_t offset, uint32_t bytes, void* dst) {
+    if (bytes == 0) return true;
+    ID3D11Buffer* staging = nullptr;
+    D3D11_BUFFER_DESC bd = {};
+    bd.ByteWidth      = bytes;
+    bd.Usage          = D3D11_USAGE_STAGING;
+    bd.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+    if (FAILED(device->CreateBuffer(&bd, nullptr, &staging))) return false;
+
+    D3D11_BOX box = {};
+    box.left   = offset;
+    box.right  = offset + bytes;
+    box.bottom = 1;
+    box.back   = 1;
+    ctx->CopySubresourceRegion(staging, 0, 0, 0, 0, buf, 0, &box);
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    bool ok = SUCCEEDED(ctx->Map(staging, 0, D3D11_MAP_READ, 0, &mapped));
+    if (ok) {
+        std::memcpy(dst, mapped.pData, bytes);
+        ctx->Unmap(staging, 0);
+    }
+    SAFE_RELEASE(staging);
+    return ok;
+}
+
+bool GaussianRenderManager::readDrawList(ID3D11Device* device, ID3D11DeviceContext* ctx,
+                                         std::vector<uint32_t>& slots, std::vector<float>& depth,
+                                         std::vector<float>& radius) const {
+    const uint32_t N = m_visibleSlots;
+    if (!m_frameRendered || !m_sortArgs || N == 0 || N > m_mergedAllocN) return false;
+
+    uint32_t args[kSortArgsUints] = {};
+    if (!readBufferBytes(device, ctx, m_sortArgs, 0, sizeof(args), args) || args[0] > N)
+        return false;
+    slots.resize(args[0]);
+    depth.resize(N);
+    radius.resize(N);
+    return readBufferBytes(device, ctx, m_sortedInB ? m_sortValsB : m_sortValsA, 0,
+                           args[0] * (uint32_t)sizeof(uint32_t), slots.data()) &&
+           m_outDepth.read(device, ctx, 0, N, depth.data()) &&
+           m_outRadius.read(device, ctx, 0, N, radius.data());
+}
+
 // ===========================================================================
 // Release helpers
 // ===========================================================================
 void GaussianRenderManager::releaseMergedInputs() {
-    SAFE_RELEASE(m_mergedPositionWS); SAFE_RELEASE(m_mergedSrvPosWS);
-    SAFE_RELEASE(m_mergedScale);      SAFE_RELEASE(m_mergedSrvScale);
-    SAFE_RELEASE(m_mergedRotation);   SAFE_RELEASE(m_mergedSrvRotation);
-    SAFE_RELEASE(m_mergedOpacity);    SAFE_RELEASE(m_mergedSrvOpacity);
-    SAFE_RELEASE(m_mergedSHCoeffs);   SAFE_RELEASE(m_mergedSrvSH);
-    SAFE_RELEASE(m_instanceIDBuf);    SAFE_RELEASE(m_instanceIDSrv);
-    SAFE_RELEASE(m_worldMatsBuf);     SAFE_RELEASE(m_worldMatsSrv);
-    SAFE_RELEASE(m_mergedSelection);  SAFE_RELEASE(m_srvMergedSelection);
-    m_mergedAllocN = 0;
+    for (PagedBuffer* col : { &m_poolPosition, &m_poolCovDiag, &m_poolCovOffDiag, &m_poolScale,
+                              &m_poolRotation, &m_poolOpacity, &m_poolSH, &m_poolChunks })
+        col->release();
+    SAFE_RELEASE(m_instanceSlotsBuf); SAFE_RELEASE(m_instanceSlotsSrv);
+    SAFE_RELEASE(m_instanceMatsBuf);  SAFE_RELEASE(m_instanceMatsSrv);
+    SAFE_RELEASE(m_instanceSHBuf);    SAFE_RELEASE(m_instanceSHSrv);
+    SAFE_RELEASE(m_dispatchRangesBuf); SAFE_RELEASE(m_dispatchRangesSrv);
+    m_dispatchRangesAlloc = 0;
+    m_mergedSelection.release();
+    m_rowAlloc.reset(0);
+    m_shAlloc.reset(0);
+    m_chunkAlloc.reset(0);
+    m_poolBlocks.clear();
+    m_instanceBlock.clear();
     m_mergedAllocInstances = 0;
-    m_cachedSignature = 0;
-    m_inputsUploaded  = false;
-    m_instanceMaskVersions.clear();
+    m_mergedCompact = false;
+    m_selectionSlots.clear();
     m_selectionDirty = true;
 }
 
 void GaussianRenderManager::releaseComputeOutputs() {
-    SAFE_RELEASE(m_ubPositionSS); SAFE_RELEASE(m_uavPositionSS); SAFE_RELEASE(m_srvPositionSS);
-    SAFE_RELEASE(m_ubDepth);      SAFE_RELEASE(m_uavDepth);      SAFE_RELEASE(m_srvDepth);
-    SAFE_RELEASE(m_ubRadius);     SAFE_RELEASE(m_uavRadius);     SAFE_RELEASE(m_srvRadius);
-    SAFE_RELEASE(m_ubColor);      SAFE_RELEASE(m_uavColor);      SAFE_RELEASE(m_srvColor);
-    SAFE_RELEASE(m_ubCov2D);      SAFE_RELEASE(m_uavCov2D);      SAFE_RELEASE(m_srvCov2D);
+    for (PagedBuffer* out : { &m_outPositionSS, &m_outDepth, &m_outRadius, &m_outColor, &m_outCov2D })
+        out->release();
     releaseSortBuffers();
     m_mergedAllocN = 0;
 }
@@ -1076,7 +1865,13 @@ void GaussianRenderManager::releaseSortBuffers() {
     SAFE_RELEASE(m_sortKeysB); SAFE_RELEASE(m_sortKeysB_UAV); SAFE_RELEASE(m_sortKeysB_SRV);
     SAFE_RELEASE(m_sortValsA); SAFE_RELEASE(m_sortValsA_UAV); SAFE_RELEASE(m_sortValsA_SRV);
     SAFE_RELEASE(m_sortValsB); SAFE_RELEASE(m_sortValsB_UAV); SAFE_RELEASE(m_sortValsB_SRV);
-    SAFE_RELEASE(m_sortBlockHist); SAFE_RELEASE(m_sortBlockHist_UAV); SAFE_RELEASE(m_sortBlockHist_SRV);
+    SAFE_RELEASE(m_sortKeysC); SAFE_RELEASE(m_sortKeysC_UAV); SAFE_RELEASE(m_sortKeysC_SRV);
+    SAFE_RELEASE(m_sortValsC); SAFE_RELEASE(m_sortValsC_UAV); SAFE_RELEASE(m_sortValsC_SRV);
+    SAFE_RELEASE(m_sortPrevOrder); SAFE_RELEASE(m_sortPrevOrder_UAV); SAFE_RELEASE(m_sortPrevOrder_SRV);
+    SAFE_RELEASE(m_sortState); SAFE_RELEASE(m_sortState_UAV); SAFE_RELEASE(m_sortState_SRV);
+    SAFE_RELEASE(m_sortTileState); SAFE_RELEASE(m_sortTileState_UAV); SAFE_RELEASE(m_sortTileState_SRV);
+    SAFE_RELEASE(m_sortArgs); SAFE_RELEASE(m_sortArgs_UAV); SAFE_RELEASE(m_sortArgs_SRV);
+    m_lastSortFrame = SortFrame();   // its draw list is gone
 }
 
 void GaussianRenderManager::releaseDepthPassResources() {
@@ -1096,6 +1891,7 @@ void GaussianRenderManager::releaseDepthPassResources() {
 
 void GaussianRenderManager::releasePipeline() {
     SAFE_RELEASE(m_preprocessCS);
+    SAFE_RELEASE(m_preprocessCompactCS);
     SAFE_RELEASE(m_preprocessCB);
     SAFE_RELEASE(m_prodVS);
     SAFE_RELEASE(m_prodPS);
@@ -1104,9 +1900,17 @@ void GaussianRenderManager::releasePipeline() {
     SAFE_RELEASE(m_rsState);
     SAFE_RELEASE(m_dsState);
     SAFE_RELEASE(m_sortCS_keygen);
-    SAFE_RELEASE(m_sortCS_count);
+    SAFE_RELEASE(m_sortCS_args);
+    SAFE_RELEASE(m_sortCS_hist);
     SAFE_RELEASE(m_sortCS_scan);
-    SAFE_RELEASE(m_sortCS_scatter);
+    SAFE_RELEASE(m_sortCS_onesweep);
+    SAFE_RELEASE(m_sortCS_mark);
+    SAFE_RELEASE(m_sortCS_seed);
+    SAFE_RELEASE(m_sortCS_entrants);
+    SAFE_RELEASE(m_sortCS_coherenceArgs);
+    SAFE_RELEASE(m_sortCS_fixup);
+    SAFE_RELEASE(m_sortCS_check);
+    SAFE_RELEASE(m_sortCS_merge);
     SAFE_RELEASE(m_sortCB);
     SAFE_RELEASE(m_selectCS);
     SAFE_RELEASE(m_selectCB);
@@ -1122,6 +1926,11 @@ void GaussianRenderManager::releaseAll() {
     releasePipeline();
     m_instances.clear();
     m_totalSplats = 0;
+    m_instanceSlot.clear();
+    m_visibleSlots = m_visibleInstances = 0;
+    m_dispatchRanges.clear();
+    m_dispatchBatches.clear();
+    m_dispatchThreads = 0;
     m_frameRendered = false;
 }
 
@@ -1,9 +1,16 @@
 #pragma once
 #include <d3d11.h>
 #include <cstdint>
+#include <memory>
 #include <vector>
+#include "PagedBuffer.h"
+#include "RangeAllocator.h"
+#include "SplatCoherence.h"
 
 class GaussianNode;
+class SplatDataset;
+struct GaussianData;
+struct PreprocessOutputs;
 
 // ===========================================================================
 // GaussianRenderManager  --  Singleton that merges all GaussianSplat instances
@@ -14,12 +21,35 @@ class GaussianNode;
 //   2. registerInstance(...)  -- called from each DrawOverride::prepareForDraw
 //   3. render(ctx, ...)      -- called from the FIRST DrawOverride::draw;
 //                               subsequent draw() calls are no-ops
+//
+// Instances that show the same SplatDataset (nodes sharing a file, or shapes
+// connected to one gaussianSplatData node) share one block of rows in the
+// merged input pool. The preprocess kernel runs over the instances' slots
+// (capacity each, so outputs, sort and selection stay per instance) and
+// finds a slot's instance and pool row through the per-instance tables, so
+// ten instances of one file cost one copy of its rows plus ten transforms.
+//
+// Instances whose splats cannot reach the viewport (instanceInView) get no
+// slots that frame: preprocess, sort and draw run over the visible
+// instances' slots only, while their datasets stay resident in the pool.
+// Inside a visible instance, the dataset's chunk hierarchy (SplatBVH)
+// narrows preprocess further to the row ranges that may be on screen.
+// Only the slots preprocess draws are sorted and drawn: key generation
+// compacts them into a dense list and the sort and the draw take its count
+// through indirect arguments. The sort is a stable Onesweep radix sort,
+// one dispatch per 8-bit pass (radix_sort.hlsl, SplatSort.h); a sort key
+// precision below 32 bits quantises view depth and runs fewer passes.
+// Frames that only differ from the last sorted one by a small camera move
+// seed the sort with its order and repair it; with the camera unchanged as
+// well, the last draw list is drawn again unsorted (SplatCoherence.h).
 // ===========================================================================
 
 struct RenderInstance {
-    GaussianNode* node;            // source data (self-contained gaussianSplat)
+    GaussianNode*       node;      // gaussianSplat shape (transform, mask)
+    const SplatDataset* dataset;   // node->dataset(): the rows it shows
     float         worldMat[16];    // per-instance world transform
-    uint32_t      splatCount;      // node->splatCount()
+    uint32_t      splatCount;      // node->splatCount()     (rows loaded so far)
+    uint32_t      splatCapacity;   // node->splatCapacity()  (rows in the file)
 };
 
 class GaussianRenderManager {
@@ -36,11 +66,25 @@ public:
                       float vpWidth, float vpHeight);
 
     bool canRender() const;
+    // Merged slot count (sum of instance capacities; slots of splats still
+    // loading are skipped by the preprocess kernel). At most
+    // PageLayout::kMaxPageElements, see render().
     uint32_t totalSplatCount() const { return m_totalSplats; }
+    // Slots and instances the last render() kept after the frustum cull
+    uint32_t visibleSplatCount()    const { return m_visibleSlots; }
+    uint32_t visibleInstanceCount() const { return m_visibleInstances; }
+    // Slots the last render() preprocessed: the visible instances' loaded
+    // rows in chunks that survived the SplatBVH cull
+    uint32_t preprocessedSplatCount() const { return m_dispatchThreads; }
+    // Input pool rows in use (sum of resident dataset capacities) and allocated
+    uint32_t poolRowCount()    const { return m_rowAlloc.used(); }
+    uint32_t poolRowCapacity() const { return m_rowAlloc.capacity(); }
 
     // Execute the merged pipeline. Returns true if rendering happened.
     // renderMode: 0=auto, 2=production, 3=diagnostic (fixed radius)
-    bool render(ID3D11Device* device, ID3D11DeviceContext* ctx, int renderMode);
+    // sortKeyBits: depth sort key precision, see SplatSort::keyBits
+    bool render(ID3D11Device* device, ID3D11DeviceContext* ctx, int renderMode,
+                int sortKeyBits = 32);
 
     // --- Marquee selection (invoked from Maya commands) -------------------
     // Project all splats of `node` through worldMat * viewProj into NDC,
@@ -59,6 +103,24 @@ public:
                       float rectMaxX, float rectMaxY,
                       int mode);
 
+    // The CPU pass behind runSelection: applies the rect test to rows
+    // [0, count) of `mask` with wvp = worldMat * viewProj. Returns the
+    // number of selected rows afterwards.
+    static uint32_t selectInRect(const GaussianData& gd, uint32_t count, const float wvp[16],
+                                 float rectMinX, float rectMinY,
+                                 float rectMaxX, float rectMaxY,
+                                 int mode, uint32_t* mask);
+
+    // The instance cull: can any splat of an instance be drawn? Its rows
+    // lie in the object-space box [bboxMin, bboxMax] with scales up to
+    // maxScale; worldView and projMat are row-major, the camera as
+    // setFrameData takes it. Conservative against the preprocess kernel's
+    // culls (CullFrustum, SplatBVH.h); always true for a non-perspective
+    // projection.
+    static bool instanceInView(const float bboxMin[3], const float bboxMax[3], float maxScale,
+                               const float worldView[16], const float projMat[16],
+                               const float tanHalfFov[2], float filmWidth, float filmHeight);
+
     // Explicitly mark the merged selection buffer as stale. Called by
     // commands that modify a data node's mask outside runSelection().
     void markSelectionDirty() { m_selectionDirty = true; }
@@ -73,19 +135,48 @@ public:
     const float* projMatrix()     const { return m_projMat; }
     float        viewportWidth()  const { return m_vpWidth; }
     float        viewportHeight() const { return m_vpHeight; }
+    const float* cameraPosition() const { return m_cameraPos; }
+    const float* tanHalfFov()     const { return m_tanHalfFov; }
+    // Fixed radius the last render() drew with (renderMode 3), 0 otherwise
+    uint32_t     debugFixedRadius() const { return m_debugFixedRadius; }
+    // Sort key bits the last render() sorted with (SplatSort::keyBits)
+    uint32_t     sortKeyBits() const { return m_sortKeyBits; }
+    // How the last render() came by its draw list
+    SortCoherence::Mode sortMode() const { return m_sortMode; }
 
     // Cleanup (call from uninitializePlugin)
     void releaseAll();
 
     // Access to merged compute outputs for depth pass (used by individual draw overrides)
-    // These are valid only after render() returns true.
-    ID3D11ShaderResourceView* srvPositionSS() const { return m_srvPositionSS; }
-    ID3D11ShaderResourceView* srvRadius()     const { return m_srvRadius; }
-    ID3D11ShaderResourceView* srvDepth()      const { return m_srvDepth; }
-    ID3D11ShaderResourceView* srvColor()      const { return m_srvColor; }
-    ID3D11ShaderResourceView* srvCov2D()      const { return m_srvCov2D; }
-    ID3D11ShaderResourceView* sortedIndicesSRV() const { return m_sortValsA_SRV; }
-    ID3D11ShaderResourceView* srvMergedSelection() const { return m_srvMergedSelection; }
+    // These are valid only after render() returns true. Paged by slot, see
+    // PageLayout::kMaxSlotPages.
+    const PagedBuffer& outPositionSS() const { return m_outPositionSS; }
+    const PagedBuffer& outRadius()     const { return m_outRadius; }
+    const PagedBuffer& outDepth()      const { return m_outDepth; }
+    const PagedBuffer& outColor()      const { return m_outColor; }
+    const PagedBuffer& outCov2D()      const { return m_outCov2D; }
+    // Slots drawn by the last render(), far to near; only the first
+    // (GPU-side) kept count entries are valid
+    ID3D11ShaderResourceView* sortedIndicesSRV() const {
+        return m_sortedInB ? m_sortValsB_SRV : m_sortValsA_SRV;
+    }
+    const PagedBuffer& mergedSelection() const { return m_mergedSelection; }
+
+    // Reads back the preprocess outputs of `node`'s slots from the last
+    // render() into `out` (one row per slot, SplatPreprocess layout), with
+    // the number of rows the kernel had loaded and the instance's world
+    // matrix. Fails if the node was not drawn in that frame. Stalls the GPU;
+    // for gsPreprocessCheck.
+    bool readInstanceOutputs(ID3D11Device* device, ID3D11DeviceContext* ctx,
+                             const GaussianNode* node, PreprocessOutputs& out,
+                             uint32_t& rows, float worldMat[16]) const;
+
+    // Reads back the sorted draw list of the last render() into `slots`,
+    // and the depth and radius of every visible slot (visibleSplatCount()
+    // of them). Stalls the GPU; for gsSortCheck.
+    bool readDrawList(ID3D11Device* device, ID3D11DeviceContext* ctx,
+                      std::vector<uint32_t>& slots, std::vector<float>& depth,
+                      std::vector<float>& radius) const;
 
     // Depth pass resources (shared across all instances)
     ID3D11ComputeShader*       depthClearCS()  const { return m_depthClearCS; }
@@ -114,6 +205,14 @@ private:
     std::vector<RenderInstance> m_instances;
     uint32_t                   m_totalSplats   = 0;
 
+    // Instance cull (cullInstances, once per render): first merged slot of
+    // each instance, kCulled when it is out of view or has no rows yet.
+    // Visible instances take consecutive slot ranges in registration order.
+    static constexpr uint32_t  kCulled = 0xFFFFFFFFu;
+    std::vector<uint32_t>      m_instanceSlot;
+    uint32_t                   m_visibleSlots     = 0;
+    uint32_t                   m_visibleInstances = 0;
+
     // Camera / viewport (set once per frame)
     float m_viewMat[16]    = {};
     float m_projMat[16]    = {};
@@ -121,71 +220,135 @@ private:
     float m_tanHalfFov[2]  = {};
     float m_vpWidth        = 0.f;
     float m_vpHeight       = 0.f;
+    uint32_t m_debugFixedRadius = 0;
+    uint32_t m_sortKeyBits      = 32;
+    bool     m_sortedInB        = false;   // odd pass count: result in keys/vals B
+
+    // What the draw list in the sort buffers was last sorted for, and how
+    // the last render() used it
+    SortFrame           m_lastSortFrame;
+    SortCoherence::Mode m_sortMode = SortCoherence::kFullSort;
 
     // --- Pipeline ready flags ---
     bool m_pipelineReady   = false;
     bool m_sortReady       = false;
     bool m_depthPassReady  = false;
 
-    // --- Merged input StructuredBuffers (concatenated from all instances) ---
-    ID3D11Buffer*             m_mergedPositionWS  = nullptr;
-    ID3D11ShaderResourceView* m_mergedSrvPosWS    = nullptr;
-    ID3D11Buffer*             m_mergedScale       = nullptr;
-    ID3D11ShaderResourceView* m_mergedSrvScale    = nullptr;
-    ID3D11Buffer*             m_mergedRotation    = nullptr;
-    ID3D11ShaderResourceView* m_mergedSrvRotation = nullptr;
-    ID3D11Buffer*             m_mergedOpacity     = nullptr;
-    ID3D11ShaderResourceView* m_mergedSrvOpacity  = nullptr;
-    ID3D11Buffer*             m_mergedSHCoeffs    = nullptr;
-    ID3D11ShaderResourceView* m_mergedSrvSH       = nullptr;
-
-    // Per-splat instance ID (indexes into worldMats)
-    ID3D11Buffer*             m_instanceIDBuf     = nullptr;
-    ID3D11ShaderResourceView* m_instanceIDSrv     = nullptr;
-
-    // Per-instance world matrices
-    ID3D11Buffer*             m_worldMatsBuf      = nullptr;
-    ID3D11ShaderResourceView* m_worldMatsSrv      = nullptr;
-
-    // Merged per-splat selection mask (concatenated from all instances' masks).
-    // Rebuilt when instance set or any instance's mask changes.
-    ID3D11Buffer*             m_mergedSelection    = nullptr;
-    ID3D11ShaderResourceView* m_srvMergedSelection = nullptr;
+    // --- Merged input pool (one block per distinct dataset) ---
+    // Persistent across frames: each dataset gets its own rows, SH and chunk
+    // ranges from the allocators below, filled when the block is created and
+    // appended to while the dataset streams (GPU copies from the dataset's
+    // own input buffers where the layouts match, see fillPoolBlocks). Adding,
+    // removing or reloading an instance only allocates, fills or frees its
+    // dataset's ranges. When a range does not fit, blocks no instance used
+    // this frame are evicted first, then the columns grow by
+    // RangeAllocator::kGrowthFactor with a GPU-side copy of the old contents.
+    // The columns are paged (PageLayout::kMaxRowPages pages for rows,
+    // kMaxSHPages for SH), so a pool past one buffer's size limit still
+    // binds; growing only replaces the last page.
+    //
+    // A float pool holds each row's object-space covariance (computed when
+    // the dataset's rows are uploaded, see SplatDataset::gpuCovDiag) instead
+    // of its scale and quaternion; a compact pool keeps the packed scale and
+    // quaternion and the kernel builds the covariance from them.
+    PagedBuffer m_poolPosition;    // float3, or uint2 unorm16 when compact
+    PagedBuffer m_poolCovDiag;     // float3 xx, yy, zz (float pool)
+    PagedBuffer m_poolCovOffDiag;  // float3 xy, xz, yz (float pool)
+    PagedBuffer m_poolScale;       // uint2 fp16 log-scale (compact pool)
+    PagedBuffer m_poolRotation;    // uint snorm8 quaternion (compact pool)
+    PagedBuffer m_poolOpacity;     // float
+    PagedBuffer m_poolSH;          // float3 groups, or uints of fp16 pairs
+    PagedBuffer m_poolChunks;      // CompactChunk, compact pools only (one page)
+
+    RangeAllocator m_rowAlloc;     // rows of the position/scale/rotation/opacity columns
+    RangeAllocator m_shAlloc;      // elements of m_poolSH
+    RangeAllocator m_chunkAlloc;   // elements of m_poolChunks
+
+    struct PoolBlock {
+        std::weak_ptr<SplatDataset> dataset;
+        uint64_t version    = 0;       // dataset version the rows belong to
+        uint32_t firstRow   = 0;
+        uint32_t capacity   = 0;
+        uint32_t shBase     = 0;       // first SH group (uint when compact)
+        uint32_t shStride   = 0;       // SH groups per splat
+        uint32_t firstChunk = 0;
+        uint32_t uploaded   = 0;       // rows already in the pool columns
+        uint64_t lastFrame  = 0;       // last frame an instance showed it
+    };
+    std::vector<PoolBlock> m_poolBlocks;
+    std::vector<uint32_t>  m_instanceBlock;   // pool block of each instance
+
+    // Preprocess dispatch ranges, rebuilt every frame: uint2 { first slot,
+    // first thread of its dispatch } per run of slots to preprocess, cut at
+    // kSlotBatch boundaries. One dispatch per batch of slots that has any;
+    // slots outside every range (culled chunks, rows not loaded yet) only
+    // get their radius cleared.
+    struct DispatchBatch {
+        uint32_t slotBase;      // first slot of the kSlotBatch batch
+        uint32_t firstRange;
+        uint32_t rangeCount;
+        uint32_t threads;
+    };
+    std::vector<uint32_t>      m_dispatchRanges;
+    std::vector<DispatchBatch> m_dispatchBatches;
+    uint32_t                   m_dispatchThreads     = 0;
+    uint32_t                   m_dispatchRangesAlloc = 0;   // ranges the buffer holds
+    ID3D11Buffer*              m_dispatchRangesBuf   = nullptr;
+    ID3D11ShaderResourceView*  m_dispatchRangesSrv   = nullptr;
+
+    // The three tables below hold the visible instances only, in slot order.
+    // Per-instance slots: uint2 { first merged slot, rows loaded }. Sorted
+    // by first slot; the kernel binary-searches it for a slot's instance.
+    ID3D11Buffer*             m_instanceSlotsBuf  = nullptr;
+    ID3D11ShaderResourceView* m_instanceSlotsSrv  = nullptr;
+
+    // Per-instance matrices: PreprocessInstance { world, world * view }
+    ID3D11Buffer*             m_instanceMatsBuf   = nullptr;
+    ID3D11ShaderResourceView* m_instanceMatsSrv   = nullptr;
+
+    // Per-instance pool layout: uint4 { first pool row, SH base, SH groups
+    // per splat, first chunk } of the instance's dataset block. Datasets may
+    // load different SH degrees, so the SH column is packed per block rather
+    // than at a fixed 16 per splat. The SH base counts float3 groups, or
+    // uints in a compact pool.
+    ID3D11Buffer*             m_instanceSHBuf     = nullptr;
+    ID3D11ShaderResourceView* m_instanceSHSrv     = nullptr;
+
+    // Compact pool (every dataset shown uses compactStorage): the columns
+    // hold the packed SplatCompact layout and m_poolChunks the blocks'
+    // position chunks. Switching between a float and a compact pool
+    // rebuilds it.
+    bool                      m_mergedCompact     = false;
+
+    // Merged per-slot selection mask (per-instance masks copied into their
+    // slot ranges, paged like the compute outputs). An instance's range is
+    // copied again when its mask version or its slot range changes.
+    PagedBuffer               m_mergedSelection;
     bool                      m_selectionDirty     = true;
-    std::vector<uint64_t>     m_instanceMaskVersions;  // last seen per-instance version
-
-    uint32_t m_mergedAllocN = 0;   // currently allocated merged capacity
-    uint32_t m_mergedAllocInstances = 0;
-
-    // Cache signature: detect when the instance set changes so we only
-    // rebuild the large concatenated input buffers on actual changes.
-    // Signature = hash of (dataNode pointer, splatCount) per instance.
-    size_t m_cachedSignature = 0;
-    bool   m_inputsUploaded  = false;  // true once large buffers are valid
+    struct SelectionSlot {
+        const GaussianNode* node    = nullptr;
+        uint32_t            first   = 0;
+        uint64_t            version = 0;
+    };
+    std::vector<SelectionSlot> m_selectionSlots;   // as last copied, per instance
+
+    uint32_t m_mergedAllocN = 0;   // slots allocated in the compute outputs
+    uint32_t m_mergedAllocInstances = 0;   // rows of the instance tables
+    // Bytes of the instance tables as last uploaded; a table is only written
+    // again when it changes (a transform, the camera, streamed rows)
+    std::vector<uint8_t> m_uploadedSlots, m_uploadedInstanceMats, m_uploadedInstanceSH;
 
     // --- Compute outputs (written by preprocess, read by sort & render) ---
-    ID3D11Buffer*              m_ubPositionSS  = nullptr;
-    ID3D11UnorderedAccessView* m_uavPositionSS = nullptr;
-    ID3D11ShaderResourceView*  m_srvPositionSS = nullptr;
-
-    ID3D11Buffer*              m_ubDepth    = nullptr;
-    ID3D11UnorderedAccessView* m_uavDepth   = nullptr;
-    ID3D11ShaderResourceView*  m_srvDepth   = nullptr;
-
-    ID3D11Buffer*              m_ubRadius   = nullptr;
-    ID3D11UnorderedAccessView* m_uavRadius  = nullptr;
-    ID3D11ShaderResourceView*  m_srvRadius  = nullptr;
-
-    ID3D11Buffer*              m_ubColor    = nullptr;
-    ID3D11UnorderedAccessView* m_uavColor   = nullptr;
-    ID3D11ShaderResourceView*  m_srvColor   = nullptr;
-
-    ID3D11Buffer*              m_ubCov2D    = nullptr;
-    ID3D11UnorderedAccessView* m_uavCov2D   = nullptr;
-    ID3D11ShaderResourceView*  m_srvCov2D   = nullptr;
+    // Paged by slot; each preprocess dispatch writes within one page.
+    PagedBuffer m_outPositionSS;   // float2
+    PagedBuffer m_outDepth;        // float
+    PagedBuffer m_outRadius;       // float
+    PagedBuffer m_outColor;        // float3
+    PagedBuffer m_outCov2D;        // float4 (inverse cov2D + opacity)
 
     // --- Shaders ---
     ID3D11ComputeShader*  m_preprocessCS  = nullptr;
+    ID3D11ComputeShader*  m_preprocessCompactCS = nullptr;   // GS_COMPACT variant
     ID3D11Buffer*         m_preprocessCB  = nullptr;
     ID3D11VertexShader*   m_prodVS        = nullptr;
     ID3D11PixelShader*    m_prodPS        = nullptr;
@@ -203,9 +366,17 @@ private:
 
     // --- Sort ---
     ID3D11ComputeShader*       m_sortCS_keygen  = nullptr;
-    ID3D11ComputeShader*       m_sortCS_count   = nullptr;
+    ID3D11ComputeShader*       m_sortCS_args    = nullptr;
+    ID3D11ComputeShader*       m_sortCS_hist    = nullptr;
     ID3D11ComputeShader*       m_sortCS_scan    = nullptr;
-    ID3D11ComputeShader*       m_sortCS_scatter = nullptr;
+    ID3D11ComputeShader*       m_sortCS_onesweep = nullptr;
+    ID3D11ComputeShader*       m_sortCS_mark     = nullptr;
+    ID3D11ComputeShader*       m_sortCS_seed     = nullptr;
+    ID3D11ComputeShader*       m_sortCS_entrants = nullptr;
+    ID3D11ComputeShader*       m_sortCS_coherenceArgs = nullptr;
+    ID3D11ComputeShader*       m_sortCS_fixup    = nullptr;
+    ID3D11ComputeShader*       m_sortCS_check    = nullptr;
+    ID3D11ComputeShader*       m_sortCS_merge    = nullptr;
     ID3D11Buffer*              m_sortCB         = nullptr;
 
     ID3D11Buffer*              m_sortKeysA      = nullptr;
@@ -222,9 +393,34 @@ private:
     ID3D11UnorderedAccessView* m_sortValsB_UAV  = nullptr;
     ID3D11ShaderResourceView*  m_sortValsB_SRV  = nullptr;
 
-    ID3D11Buffer*              m_sortBlockHist      = nullptr;
-    ID3D11UnorderedAccessView* m_sortBlockHist_UAV  = nullptr;
-    ID3D11ShaderResourceView*  m_sortBlockHist_SRV  = nullptr;
+    // Incremental sort: survivors then entrants (keys/vals C), and the last
+    // sorted draw list, copied after every sort
+    ID3D11Buffer*              m_sortKeysC      = nullptr;
+    ID3D11UnorderedAccessView* m_sortKeysC_UAV  = nullptr;
+    ID3D11ShaderResourceView*  m_sortKeysC_SRV  = nullptr;
+    ID3D11Buffer*              m_sortValsC      = nullptr;
+    ID3D11UnorderedAccessView* m_sortValsC_UAV  = nullptr;
+    ID3D11ShaderResourceView*  m_sortValsC_SRV  = nullptr;
+    ID3D11Buffer*              m_sortPrevOrder     = nullptr;
+    ID3D11UnorderedAccessView* m_sortPrevOrder_UAV = nullptr;
+    ID3D11ShaderResourceView*  m_sortPrevOrder_SRV = nullptr;
+
+    // Digit counts / first entries of the four passes and the tile
+    // counters (layout in radix_sort.hlsl), cleared every frame
+    ID3D11Buffer*              m_sortState          = nullptr;
+    ID3D11UnorderedAccessView* m_sortState_UAV      = nullptr;
+    ID3D11ShaderResourceView*  m_sortState_SRV      = nullptr;
+    // Decoupled-lookback status per tile (and per digit in the Onesweep
+    // passes), cleared before KeyGen and before every pass
+    ID3D11Buffer*              m_sortTileState      = nullptr;
+    ID3D11UnorderedAccessView* m_sortTileState_UAV  = nullptr;
+    ID3D11ShaderResourceView*  m_sortTileState_SRV  = nullptr;
+
+    // Kept count and the indirect arguments derived from it (raw uints,
+    // layout in radix_sort.hlsl): cleared, then counted by KeyGenKernel
+    ID3D11Buffer*              m_sortArgs           = nullptr;
+    ID3D11UnorderedAccessView* m_sortArgs_UAV       = nullptr;
+    ID3D11ShaderResourceView*  m_sortArgs_SRV       = nullptr;
 
     // --- Depth pass ---
     ID3D11ComputeShader*       m_depthClearCS   = nullptr;
@@ -251,8 +447,27 @@ private:
     // instance's mask version has changed since last call.
     bool updateMergedSelection(ID3D11Device* device, ID3D11DeviceContext* ctx);
 
+    // Fills m_instanceSlot / m_visibleSlots / m_visibleInstances for this
+    // frame's instances and camera. Called from render().
+    void cullInstances();
+
+    // This frame's SortFrame, after buildMergedInputs. Called from render().
+    SortFrame currentSortFrame() const;
+
     // --- Buffer management ---
     bool buildMergedInputs(ID3D11Device* device, ID3D11DeviceContext* ctx);
+    bool buildDispatchRanges(ID3D11Device* device, ID3D11DeviceContext* ctx);
+    bool allocateBlock(ID3D11Device* device, ID3D11DeviceContext* ctx,
+                       const std::shared_ptr<SplatDataset>& dataset, PoolBlock& block);
+    void freeBlock(const PoolBlock& block);
+    bool allocateRange(ID3D11Device* device, ID3D11DeviceContext* ctx,
+                       RangeAllocator& alloc, uint32_t size, uint32_t& offset);
+    bool growPool(ID3D11Device* device, ID3D11DeviceContext* ctx,
+                  RangeAllocator& alloc, uint32_t newCapacity);
+    void uploadBlockRows(ID3D11DeviceContext* ctx, const PoolBlock& block,
+                         const GaussianData& gd, uint32_t first, uint32_t last);
+    bool fillPoolBlocks(ID3D11Device* device, ID3D11DeviceContext* ctx,
+                        uint32_t& copiedRows, uint32_t& uploadedRows);
     bool createComputeOutputs(ID3D11Device* device, uint32_t N);
     bool createSortBuffers(ID3D11Device* device, uint32_t N);
     bool createDepthTexture(ID3D11Device* device, uint32_t w, uint32_t h);
@@ -267,6 +482,7 @@ private:
                          const void* initData, uint32_t numElements, uint32_t stride,
                          ID3D11Buffer** outBuf, ID3D11ShaderResourceView** outSRV);
 
+    void initPoolColumns(bool compact);
     void releaseMergedInputs();
     void releaseComputeOutputs();
     void releaseSortBuffers();
@@ -303,14 +303,17 @@ MSyntax GSSavePLYCmd::newSyntax() {
     MSyntax s;
     s.addFlag("-f", "-file", MSyntax::kString);
     s.addFlag("-n", "-node", MSyntax::kString);
+    s.addFlag("-o", "-originalOrder", MSyntax::kBoolean);
     return s;
 }
 
+// rows: the order to write rows in (all N of them), or empty for row order.
 static bool writeBinaryPLY(const char* path, const GaussianData& data,
                             const std::vector<uint32_t>& mask,
+                            const std::vector<uint32_t>& rows,
                             size_t& keptOut)
 {
-    size_t N = data.splats.size();
+    size_t N = data.count();
     size_t kept = 0;
     for (size_t i = 0; i < N; i++)
         if (!(mask[i] & kMaskBitDeleted)) kept++;
@@ -332,17 +335,21 @@ static bool writeBinaryPLY(const char* path, const GaussianData& data,
     fprintf(f, "property float rot_0\nproperty float rot_1\nproperty float rot_2\nproperty float rot_3\n");
     fprintf(f, "end_header\n");
 
-    const float zeroNormal[3] = { 0.f, 0.f, 0.f };
-    for (size_t i = 0; i < N; i++) {
+    // One row = 62 floats; log-scale and planar f_rest are re-derived from
+    // the render-ready (or compact) columns. Quaternions are written normalised.
+    float row[62] = {};                       // nx/ny/nz (row[3..5]) stay 0
+    std::vector<float> sh(data.shFloats());
+    for (size_t r = 0; r < N; r++) {
+        const size_t i = rows.empty() ? r : rows[r];
         if (mask[i] & kMaskBitDeleted) continue;
-        const GaussianSplat& s = data.splats[i];
-        fwrite(s.position,  sizeof(float),  3, f);
-        fwrite(zeroNormal,  sizeof(float),  3, f);
-        fwrite(s.f_dc,      sizeof(float),  3, f);
-        fwrite(s.f_rest,    sizeof(float), 45, f);
-        fwrite(&s.opacity,  sizeof(float),  1, f);
-        fwrite(s.scale,     sizeof(float),  3, f);
-        fwrite(s.rotation,  sizeof(float),  4, f);
+        data.position(i, row + 0);
+        data.shRow(i, sh.data());
+        std::memcpy(row + 6, sh.data(), 3 * sizeof(float));
+        data.restCoeffs(i, row + 9);
+        row[54] = data.opacityRaw[i];
+        data.logScale(i, row + 55);
+        data.rotation(i, row + 58);
+        fwrite(row, sizeof(float), 62, f);
     }
     fclose(f);
     return true;
@@ -377,7 +384,11 @@ MStatus GSSavePLYCmd::doIt(const MArgList& args) {
         }
     }
 
-    if (!node->areInputsReady() || !node->bufSelectionMask()) {
+    if (node->isLoading()) {
+        displayError("gsSavePLY: node is still loading (wait or run gsCancelLoad).");
+        return MS::kFailure;
+    }
+    if (!node->areInputsReady()) {
         displayError("gsSavePLY: data node has no GPU buffers yet (render once first).");
         return MS::kFailure;
     }
@@ -392,19 +403,33 @@ MStatus GSSavePLYCmd::doIt(const MArgList& args) {
 
     const auto& mask = node->maskShadow();
     const auto& data = node->gaussianData();
-    if (mask.size() != data.splats.size()) {
+    if (mask.size() != data.count()) {
         displayError("gsSavePLY: mask / splat count mismatch.");
         return MS::kFailure;
     }
 
+    // Rows are written in file order by default. Only rows reordered along
+    // a curve (splatOrder, sourceIndex set) keep that order unless
+    // -originalOrder true; the stratified order of a background load
+    // (sampleStride > 1) is never the default. -originalOrder false writes
+    // memory order whatever it is.
+    bool original = data.sourceIndex.empty();
+    if (db.isFlagSet("-o")) db.getFlagArgument("-o", 0, original);
+    if (data.sourceIndex.empty() && data.sampleStride <= 1) original = false;   // memory order is file order
+    std::vector<uint32_t> rows;
+    if (original) {
+        rows.resize(data.count());
+        for (size_t i = 0; i < data.count(); i++) rows[data.fileRow(i)] = (uint32_t)i;
+    }
+
     size_t kept = 0;
-    if (!writeBinaryPLY(path.asChar(), data, mask, kept)) {
+    if (!writeBinaryPLY(path.asChar(), data, mask, rows, kept)) {
         displayError(MString("gsSavePLY: failed to open for write: ") + path);
         return MS::kFailure;
     }
 
     displayInfo(MString("[gsSavePLY] Wrote ") + (unsigned)kept + " / " +
-                (unsigned)data.splats.size() + " splats to " + path);
+                (unsigned)data.count() + " splats to " + path);
     setResult((int)kept);
     return MS::kSuccess;
 }
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// ===========================================================================
+// MappedFile  --  read-only memory mapping of a whole file.
+//
+// Used by PLYReader to parse multi-GB captures without streaming them
+// through std::ifstream. The mapping stays valid until close() or
+// destruction; pointers returned by data() must not outlive it.
+// ===========================================================================
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Maps `path` read-only. Returns false and sets errorMsg on failure.
+    bool open(const std::string& path, std::string& errorMsg);
+    void close();
+
+    bool        isOpen() const { return m_data != nullptr; }
+    const char* data()   const { return m_data; }
+    size_t      size()   const { return m_size; }
+
+private:
+    const char* m_data = nullptr;
+    size_t      m_size = 0;
+
+#ifdef _WIN32
+    void* m_file    = nullptr;   // HANDLE
+    void* m_mapping = nullptr;   // HANDLE
+#else
+    int   m_fd      = -1;
+#endif
+};
@@ -0,0 +1,109 @@
+#include "PLYLoadJob.h"
+#include "SplatCache.h"
+
+#include <chrono>
+#include <cstdio>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <new>
+#include <thread>
+
+// Every n-th row of a binary file is decoded and published first
+static constexpr size_t kStreamSampleStride = 256;
+
+// ===========================================================================
+// Worker registry: every thread start() launched and has not been joined.
+// A worker marks itself exited as its very last step; start() joins those,
+// stopAll() joins the rest.
+// ===========================================================================
+namespace {
+struct Worker {
+    std::weak_ptr<PLYLoadJob> job;
+    std::thread               thread;
+    bool                      exited = false;
+};
+
+std::mutex        s_workersMutex;
+std::list<Worker> s_workers;
+}
+
+PLYLoadJob::PLYLoadJob(const std::string& path, int shDegree)
+    : m_path(path), m_data(std::make_shared<GaussianData>())
+{
+    m_control.sampleStride = kStreamSampleStride;
+    m_control.shDegree     = shDegree;
+}
+
+std::shared_ptr<PLYLoadJob> PLYLoadJob::start(const std::string& path, int shDegree) {
+    std::shared_ptr<PLYLoadJob> job(new PLYLoadJob(path, shDegree));
+
+    std::lock_guard<std::mutex> lock(s_workersMutex);
+    for (auto it = s_workers.begin(); it != s_workers.end();) {
+        if (!it->exited) { ++it; continue; }
+        it->thread.join();
+        it = s_workers.erase(it);
+    }
+
+    s_workers.emplace_back();
+    auto self = std::prev(s_workers.end());
+    self->job = job;
+    // The worker cannot reach `exited` before this returns: it needs the lock
+    self->thread = std::thread([job, self]() mutable {
+        run(std::move(job));
+        std::lock_guard<std::mutex> lock(s_workersMutex);
+        self->exited = true;
+    });
+    return job;
+}
+
+void PLYLoadJob::stopAll() {
+    // Taken out of the registry first: the workers still lock it to mark
+    // themselves exited, and the list nodes stay valid in `workers`
+    std::list<Worker> workers;
+    {
+        std::lock_guard<std::mutex> lock(s_workersMutex);
+        workers.swap(s_workers);
+    }
+    for (Worker& w : workers)
+        if (auto job = w.job.lock()) job->cancel();
+    for (Worker& w : workers) w.thread.join();
+    if (!workers.empty())
+        fprintf(stderr, "[PLYLoadJob] stopped %zu worker(s)\n", workers.size());
+}
+
+void PLYLoadJob::run(std::shared_ptr<PLYLoadJob> job) {
+    auto t0 = std::chrono::steady_clock::now();
+
+    // The source is fingerprinted once, here on the worker and before it is
+    // read; the cache load and the cache store both use this key.
+    SplatCache::SourceKey key;
+    const bool cached = SplatCache::enabled() && SplatCache::sourceKey(job->m_path, key);
+
+    // The worker thread must never throw: a multi-GB file can fail to
+    // allocate, which becomes an ordinary load error.
+    std::string err;
+    bool ok = false, fromCache = false;
+    try {
+        fromCache = cached && SplatCache::load(job->m_path, key, *job->m_data, &job->m_control);
+        ok = fromCache || PLYReader::read(job->m_path, *job->m_data, err, &job->m_control);
+    } catch (const std::bad_alloc&) {
+        err = "Out of memory while loading " + job->m_path;
+    }
+
+    job->m_elapsedMs = std::chrono::duration<double, std::milli>(
+                           std::chrono::steady_clock::now() - t0).count();
+    job->m_succeeded = ok && !job->cancelled();
+    if (!job->m_succeeded) {
+        job->m_error = err.empty() ? "Load cancelled" : err;
+        fprintf(stderr, "[PLYLoadJob] %s: %s\n", job->m_path.c_str(), job->m_error.c_str());
+    }
+    job->m_finished.store(true, std::memory_order_release);
+
+    // Written after finishing so the node does not wait on it; data() is
+    // immutable from here on. cancel() still stops it (stopAll()).
+    if (job->m_succeeded && !fromCache && cached) {
+        if (!SplatCache::store(job->m_path, key, *job->m_data, err, &job->m_control))
+            fprintf(stderr, "[PLYLoadJob] cache not written: %s\n", err.c_str());
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include "GaussianData.h"
+#include "PLYReader.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+// ===========================================================================
+// PLYLoadJob  --  one PLYReader::read running on a worker thread.
+//
+// A valid SplatCache sidecar is used instead of the PLY when present; after
+// a successful parse the worker writes one for the next open.
+//
+// The job object is shared between the owner (SplatDataset) and the worker,
+// so the owner may drop or cancel it at any time without waiting. The
+// worker threads themselves are kept in a registry and joined by
+// stopAll() before the plugin unloads; that includes a cache write still
+// running after the owner has let go of the job.
+//
+// The GaussianData being filled is visible from the start: the reader sizes
+// it once and publishes a growing prefix of finished rows (readyCount(),
+// release/acquire). The owner can draw rows [0, readyCount()) while the rest
+// is still decoding; binary files put a stratified subsample first so that
+// prefix already covers the whole cloud. No locks on either side.
+// ===========================================================================
+class PLYLoadJob {
+public:
+    // Starts reading `path` in the background, keeping SH up to shDegree.
+    static std::shared_ptr<PLYLoadJob> start(const std::string& path,
+                                             int shDegree = kMaxSHDegree);
+
+    PLYLoadJob(const PLYLoadJob&)            = delete;
+    PLYLoadJob& operator=(const PLYLoadJob&) = delete;
+
+    // Cancels every running job (including pending cache writes) and joins
+    // its worker. Called from uninitializePlugin, before anything else is
+    // torn down; start() must not be called concurrently.
+    static void stopAll();
+
+    // Asks the reader to stop at its next checkpoint. The worker then
+    // finishes with error "Load cancelled"; a cache write after it is
+    // abandoned too.
+    void cancel() { m_control.cancel.store(true, std::memory_order_relaxed); }
+
+    const std::string& path()      const { return m_path; }
+    float              progress()  const { return m_control.progress(); }
+    bool               cancelled() const { return m_control.cancelled(); }
+    bool               finished()  const { return m_finished.load(std::memory_order_acquire); }
+
+    // Rows of data() that are complete and safe to read on this thread.
+    size_t readyCount() const { return m_control.rowsReady.load(std::memory_order_acquire); }
+    // The data being loaded. Only rows [0, readyCount()) may be read until
+    // finished() && succeeded(); the arrays are never resized meanwhile.
+    std::shared_ptr<const GaussianData> data() const { return m_data; }
+
+    // Valid once finished().
+    bool               succeeded() const { return m_succeeded; }
+    const std::string& error()     const { return m_error; }
+    double             elapsedMs() const { return m_elapsedMs; }
+
+private:
+    PLYLoadJob(const std::string& path, int shDegree);
+    static void run(std::shared_ptr<PLYLoadJob> job);
+
+    std::string                   m_path;
+    std::shared_ptr<GaussianData> m_data;
+    PLYReadControl                m_control;
+    std::atomic<bool>             m_finished { false };
+
+    // Written by the worker before m_finished
+    bool        m_succeeded = false;
+    std::string m_error;
+    double      m_elapsedMs = 0.0;
+};
@@ -1,105 +1,151 @@
 #include "PLYReader.h"
+#include "MappedFile.h"
+#include "ParallelFor.h"
+#include "SplatCompact.h"
+#include "SplatKernels.h"
 
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <chrono>
+#include <cfloat>
 #include <cmath>
+#include <cstddef>
 #include <cstring>
 #include <cstdio>
+#include <charconv>
+#include <type_traits>
+
+static constexpr float kSH_C0 = 0.28209479177387814f;   // 1 / (2*sqrt(pi))
 
 // ---------------------------------------------------------------------------
-// Colour helpers
+// GaussianData helpers
 // ---------------------------------------------------------------------------
-static constexpr float kSH_C0 = 0.28209479177387814f;   // 1 / (2*sqrt(pi))
+static constexpr size_t kDecodeChunkRows = 16384;     // rows per worker chunk
+static constexpr size_t kStreamWaveRows  = 1u << 20;  // rows published per wave
+
+// Per-worker partial of the finalize pass, padded to its own cache line:
+// the bbox, and min/max/sum of the log-scales as read (before the exp), so
+// the load statistics need no pass of their own
+struct alignas(64) BoundsPartial {
+    float  bmin[3]     = {  1e30f,  1e30f,  1e30f };
+    float  bmax[3]     = { -1e30f, -1e30f, -1e30f };
+    float  logScaleMin =  1e30f;
+    float  logScaleMax = -1e30f;
+    double logScaleSum = 0.0;
+};
 
-static inline float shToLinear(float sh) {
-    float v = 0.5f + kSH_C0 * sh;
-    return v < 0.f ? 0.f : (v > 1.f ? 1.f : v);
+// GaussianData::finalizeRange plus the scale statistics, on rows still hot
+// in cache from the decode
+static void finalizeRows(GaussianData& d, size_t begin, size_t end, BoundsPartial& b) {
+    const float* ls  = d.scaleWS.data();
+    float        lo  = b.logScaleMin, hi = b.logScaleMax, sum = 0.f;
+    for (size_t i = begin * 3; i < end * 3; ++i) {
+        lo   = std::min(lo, ls[i]);
+        hi   = std::max(hi, ls[i]);
+        sum += ls[i];
+    }
+    b.logScaleMin  = lo;
+    b.logScaleMax  = hi;
+    b.logScaleSum += sum;
+    d.finalizeRange(begin, end, b.bmin, b.bmax);
 }
 
-static inline float sigmoid(float x) {
-    return 1.0f / (1.0f + std::exp(-x));
+// Sets d's bbox; returns the merged partial for logSplatStats
+static BoundsPartial reduceBounds(const std::vector<BoundsPartial>& parts, GaussianData& d) {
+    BoundsPartial all;
+    for (const auto& p : parts) {
+        for (int k = 0; k < 3; ++k) {
+            all.bmin[k] = std::min(all.bmin[k], p.bmin[k]);
+            all.bmax[k] = std::max(all.bmax[k], p.bmax[k]);
+        }
+        all.logScaleMin  = std::min(all.logScaleMin, p.logScaleMin);
+        all.logScaleMax  = std::max(all.logScaleMax, p.logScaleMax);
+        all.logScaleSum += p.logScaleSum;
+    }
+    std::copy(all.bmin, all.bmin + 3, d.bboxMin);
+    std::copy(all.bmax, all.bmax + 3, d.bboxMax);
+    return all;
 }
 
-static inline float quatLen(const float q[4]) {
-    return std::sqrt(q[0]*q[0] + q[1]*q[1] + q[2]*q[2] + q[3]*q[3]);
+void GaussianData::resize(size_t N) {
+    positions.resize(N * 3);
+    scaleWS.resize(N * 3);
+    rotationWS.resize(N * 4);
+    opacityRaw.resize(N);
+    shCoeffs.resize(N * shFloats());
 }
 
-// ---------------------------------------------------------------------------
-// GaussianData helpers
-// ---------------------------------------------------------------------------
-void GaussianData::buildGPUArrays() {
-    const size_t N = splats.size();
-
-    bboxMin[0] = bboxMin[1] = bboxMin[2] =  1e30f;
-    bboxMax[0] = bboxMax[1] = bboxMax[2] = -1e30f;
+void GaussianData::clear() {
+    // shrink_to_fit: a reload must not keep the previous scene's capacity
+    positions.clear();  positions.shrink_to_fit();
+    scaleWS.clear();    scaleWS.shrink_to_fit();
+    rotationWS.clear(); rotationWS.shrink_to_fit();
+    opacityRaw.clear(); opacityRaw.shrink_to_fit();
+    shCoeffs.clear();   shCoeffs.shrink_to_fit();
+    packed = CompactColumns();
+    sourceIndex.clear(); sourceIndex.shrink_to_fit();
+    sampleStride = 1;
+}
 
-    positions.clear();   positions.reserve(N * 3);
-    colors.clear();      colors.reserve(N * 4);
-    scaleWS.clear();     scaleWS.reserve(N * 3);
-    rotationWS.clear();  rotationWS.reserve(N * 4);
-    opacityRaw.clear();  opacityRaw.reserve(N);
-    shCoeffs.clear();    shCoeffs.reserve(N * kSHCoeffsPerSplat * 3);
+size_t GaussianData::fileRow(size_t i) const {
+    if (!sourceIndex.empty()) return sourceIndex[i];
+    const size_t k = sampleStride, N = count();
+    if (k <= 1) return i;
+    // Inverse of decodeBinaryColumns' stratified output order
+    const size_t S = (N + k - 1) / k;
+    if (i < S) return i * k;
+    const size_t q = i - S;
+    return q / (k - 1) * k + 1 + q % (k - 1);
+}
 
-    for (const auto& s : splats) {
-        // debug pass
-        positions.push_back(s.position[0]);
-        positions.push_back(s.position[1]);
-        positions.push_back(s.position[2]);
+void GaussianData::finalizeRange(size_t begin, size_t end, float bmin[3], float bmax[3]) {
+    // exp(log_scale), normalised quaternions, bbox; SIMD where available
+    gs::FinalizeRows(positions.data() + begin * 3, scaleWS.data() + begin * 3,
+                     rotationWS.data() + begin * 4, end - begin, bmin, bmax);
+}
 
-        for (int k = 0; k < 3; ++k) {
-            if (s.position[k] < bboxMin[k]) bboxMin[k] = s.position[k];
-            if (s.position[k] > bboxMax[k]) bboxMax[k] = s.position[k];
-        }
+void GaussianData::finalize() {
+    std::vector<BoundsPartial> parts(gs::WorkerCount());
+    gs::ParallelFor(count(), kDecodeChunkRows,
+        [&](size_t begin, size_t end, unsigned worker) {
+            finalizeRange(begin, end, parts[worker].bmin, parts[worker].bmax);
+        });
+    reduceBounds(parts, *this);
+}
 
-        colors.push_back(shToLinear(s.f_dc[0]));
-        colors.push_back(shToLinear(s.f_dc[1]));
-        colors.push_back(shToLinear(s.f_dc[2]));
-        colors.push_back(sigmoid(s.opacity));
-
-        // compute pass — scale: exp(log_scale)
-        scaleWS.push_back(std::exp(s.scale[0]));
-        scaleWS.push_back(std::exp(s.scale[1]));
-        scaleWS.push_back(std::exp(s.scale[2]));
-
-        // compute pass — rotation: normalised quaternion
-        float len = quatLen(s.rotation);
-        if (len < 1e-6f) len = 1.f;
-        rotationWS.push_back(s.rotation[0] / len);
-        rotationWS.push_back(s.rotation[1] / len);
-        rotationWS.push_back(s.rotation[2] / len);
-        rotationWS.push_back(s.rotation[3] / len);
-
-        // compute pass — raw logit opacity
-        opacityRaw.push_back(s.opacity);
-
-        // compute pass — SH coefficients (16 float3 per splat)
-        // group 0: f_dc
-        shCoeffs.push_back(s.f_dc[0]);
-        shCoeffs.push_back(s.f_dc[1]);
-        shCoeffs.push_back(s.f_dc[2]);
-        // groups 1..15: f_rest (45 floats = 15 groups × 3 channels)
-        // f_rest is stored as all-red, then all-green, then all-blue in the PLY.
-        // Re-interleave to float3 groups expected by the shader (r,g,b per group).
-        // f_rest[0..14]  = red   for groups 1..15
-        // f_rest[15..29] = green for groups 1..15
-        // f_rest[30..44] = blue  for groups 1..15
-        for (int g = 0; g < 15; ++g) {
-            shCoeffs.push_back(s.f_rest[g]);        // red   channel, group g+1
-            shCoeffs.push_back(s.f_rest[g + 15]);   // green channel, group g+1
-            shCoeffs.push_back(s.f_rest[g + 30]);   // blue  channel, group g+1
-        }
+void GaussianData::logScale(size_t i, float out[3]) const {
+    if (compact()) {                      // stored as fp16 log-scale already
+        gs::HalfToFloat(&packed.scaleH[i * 4], out, 3);
+        return;
     }
+    // exp() underflows to 0 below ~-87; clamp so the round trip stays finite
+    for (int k = 0; k < 3; ++k)
+        out[k] = std::log(std::max(scaleWS[i * 3 + k], FLT_MIN));
 }
 
-void GaussianData::clear() {
-    splats.clear();
-    positions.clear();
-    colors.clear();
-    scaleWS.clear();
-    rotationWS.clear();
-    opacityRaw.clear();
-    shCoeffs.clear();
+void GaussianData::restCoeffs(size_t i, float out[45]) const {
+    float sh[kSHCoeffsPerSplat * 3];
+    shRow(i, sh);
+    const int stored = shStride() - 1;
+    for (int j = 0; j < 45; ++j) out[j] = (j % 15) < stored ? sh[restSlot(j)] : 0.f;
+}
+
+void GaussianData::displayColor(size_t i, float rgba[4]) const {
+    displayColors(i, i + 1, rgba);
+}
+
+void GaussianData::displayColors(size_t begin, size_t end, float* rgba) const {
+    if (!compact()) {
+        gs::DisplayColors(shCoeffs.data() + begin * shFloats(), shFloats(),
+                          opacityRaw.data() + begin, end - begin, rgba);
+        return;
+    }
+    for (size_t i = begin; i < end; ++i, rgba += 4) {
+        float sh[3];
+        gs::HalfToFloat(&packed.shH[i * compactSHHalfs(shDegree)], sh, 3);
+        gs::DisplayColors(sh, 3, &opacityRaw[i], 1, rgba);
+    }
 }
 
 // ---------------------------------------------------------------------------
@@ -107,43 +153,72 @@ void GaussianData::clear() {
 // ---------------------------------------------------------------------------
 enum class PLYFormat { ASCII, BinaryLE, Unknown };
 
+enum class PropType { Int8, UInt8, Int16, UInt16, Int32, UInt32, Float32, Float64 };
+
 struct PropDef {
     std::string name;
     std::string typeName;
+    PropType type     = PropType::Int32;
     int  byteSize = 4;
     bool isFloat  = false;
 };
 
+struct PLYHeader {
+    PLYFormat            format      = PLYFormat::Unknown;
+    int                  vertexCount = 0;
+    std::vector<PropDef> props;
+    std::vector<int>     offsets;     // byte offset of each property within a row
+    int                  rowBytes    = 0;
+};
+
+// Vertex layouts with a compile-time decoder (see decodeFixedRows)
+enum class KnownLayout { None, Canonical3DGS, Canonical3DGSNoNormals };
+
+// Indices of the 3DGS properties inside PLYHeader::props (-1 = absent)
+struct VertexLayout {
+    int iX, iY, iZ;
+    int iR, iG, iB;
+    int iOp;
+    int iRed, iGreen, iBlue;
+    bool useRGBFallback;
+    int iSX, iSY, iSZ;
+    int iRW, iRX, iRY, iRZ;
+    int iRest[45];
+    int restPerChannel;     // f_rest_* per colour channel in the file (0, 3, 8 or 15)
+    int shDegree;           // SH degree the file carries
+    KnownLayout known;
+};
+
+static void parsePropType(PropDef& p) {
+    const std::string& t = p.typeName;
+    if      (t == "float"  || t == "float32") { p.type = PropType::Float32; p.byteSize = 4; p.isFloat = true; }
+    else if (t == "double" || t == "float64") { p.type = PropType::Float64; p.byteSize = 8; p.isFloat = true; }
+    else if (t == "uchar"  || t == "uint8")   { p.type = PropType::UInt8;   p.byteSize = 1; }
+    else if (t == "char"   || t == "int8")    { p.type = PropType::Int8;    p.byteSize = 1; }
+    else if (t == "ushort" || t == "uint16")  { p.type = PropType::UInt16;  p.byteSize = 2; }
+    else if (t == "short"  || t == "int16")   { p.type = PropType::Int16;   p.byteSize = 2; }
+    else if (t == "uint"   || t == "uint32")  { p.type = PropType::UInt32;  p.byteSize = 4; }
+    else                                      { p.type = PropType::Int32;   p.byteSize = 4; }
+}
+
 // ---------------------------------------------------------------------------
-// PLYReader::read
+// parseHeader  --  consumes "ply" ... "end_header" from `in`.
 // ---------------------------------------------------------------------------
-bool PLYReader::read(const std::string& filepath,
-                     GaussianData&      outData,
-                     std::string&       errorMsg)
-{
-    std::ifstream file(filepath, std::ios::binary);
-    if (!file.is_open()) {
-        errorMsg = "Cannot open: " + filepath;
-        return false;
-    }
-
-    // ---- parse header ----
+static bool parseHeader(std::istream& in, PLYHeader& h, std::string& errorMsg) {
     {
         std::string line;
-        if (!std::getline(file, line) || line.find("ply") == std::string::npos) {
+        if (!std::getline(in, line) || line.find("ply") == std::string::npos) {
             errorMsg = "Not a PLY file";
             return false;
         }
     }
 
-    PLYFormat format       = PLYFormat::Unknown;
-    int       vertexCount  = 0;
-    std::vector<PropDef> props;
     bool inVertexElem = false;
+    bool sawEnd       = false;
 
-    for (std::string line; std::getline(file, line); ) {
+    for (std::string line; std::getline(in, line); ) {
         if (!line.empty() && line.back() == '\r') line.pop_back();
-        if (line == "end_header") break;
+        if (line == "end_header") { sawEnd = true; break; }
 
         std::istringstream ss(line);
         std::string tok;
@@ -151,73 +226,694 @@ bool PLYReader::read(const std::string& filepath,
 
         if (tok == "format") {
             std::string fmt; ss >> fmt;
-            if      (fmt == "ascii")                 format = PLYFormat::ASCII;
-            else if (fmt == "binary_little_endian")  format = PLYFormat::BinaryLE;
+            if      (fmt == "ascii")                 h.format = PLYFormat::ASCII;
+            else if (fmt == "binary_little_endian")  h.format = PLYFormat::BinaryLE;
 
         } else if (tok == "element") {
             std::string name; ss >> name;
             inVertexElem = (name == "vertex");
-            if (inVertexElem) ss >> vertexCount;
+            if (inVertexElem) ss >> h.vertexCount;
 
         } else if (tok == "property" && inVertexElem) {
             PropDef p;
             ss >> p.typeName >> p.name;
-            if      (p.typeName == "float"   || p.typeName == "float32") { p.byteSize = 4; p.isFloat = true; }
-            else if (p.typeName == "double"  || p.typeName == "float64") { p.byteSize = 8; p.isFloat = true; }
-            else if (p.typeName == "uchar"   || p.typeName == "uint8")   { p.byteSize = 1; p.isFloat = false; }
-            else if (p.typeName == "int"     || p.typeName == "int32"
-                  || p.typeName == "uint"    || p.typeName == "uint32")  { p.byteSize = 4; p.isFloat = false; }
-            else                                                          { p.byteSize = 4; p.isFloat = false; }
-            props.push_back(p);
+            parsePropType(p);
+            h.props.push_back(p);
         }
     }
 
-    if (format == PLYFormat::Unknown) { errorMsg = "Unknown PLY format";  return false; }
-    if (vertexCount <= 0)             { errorMsg = "No vertices in PLY";   return false; }
+    if (!sawEnd)                            { errorMsg = "PLY header has no end_header"; return false; }
+    if (h.format == PLYFormat::Unknown)     { errorMsg = "Unknown PLY format";  return false; }
+    if (h.vertexCount <= 0)                 { errorMsg = "No vertices in PLY";   return false; }
+
+    h.offsets.assign(h.props.size(), 0);
+    h.rowBytes = 0;
+    for (int i = 0; i < (int)h.props.size(); i++) {
+        h.offsets[i] = h.rowBytes;
+        h.rowBytes  += h.props[i].byteSize;
+    }
+    return true;
+}
+
+// Canonical 3DGS vertex: x y z [nx ny nz] f_dc_0..2 f_rest_0..44 opacity
+// scale_0..2 rot_0..3, all float32 -- what the reference trainer and
+// gsSavePLY write. Field positions are in floats from the start of a row.
+template <bool kNormals>
+struct Layout3DGS {
+    static constexpr size_t kDC      = kNormals ? 6 : 3;
+    static constexpr size_t kRest    = kDC + 3;
+    static constexpr size_t kOpacity = kRest + 45;
+    static constexpr size_t kScale   = kOpacity + 1;
+    static constexpr size_t kRot     = kScale + 3;
+    static constexpr size_t kFloats  = kRot + 4;
+};
 
-    // ---- build property index map ----
+template <typename Layout>
+static bool matchesLayout(const PLYHeader& h) {
+    if (h.props.size() != Layout::kFloats) return false;
+    auto is = [&](size_t i, const char* name) {
+        return h.props[i].type == PropType::Float32 && h.props[i].name == name;
+    };
+    static const char* const kXYZ[]   = { "x", "y", "z" };
+    static const char* const kNrm[]   = { "nx", "ny", "nz" };
+    static const char* const kDC[]    = { "f_dc_0", "f_dc_1", "f_dc_2" };
+    static const char* const kScale[] = { "scale_0", "scale_1", "scale_2" };
+    static const char* const kRot[]   = { "rot_0", "rot_1", "rot_2", "rot_3" };
+    for (size_t k = 0; k < 3; ++k)
+        if (!is(k, kXYZ[k]) || !is(Layout::kDC + k, kDC[k]) || !is(Layout::kScale + k, kScale[k]))
+            return false;
+    if (Layout::kDC == 6)
+        for (size_t k = 0; k < 3; ++k) if (!is(3 + k, kNrm[k])) return false;
+    for (size_t k = 0; k < 4; ++k) if (!is(Layout::kRot + k, kRot[k])) return false;
+    if (!is(Layout::kOpacity, "opacity")) return false;
+    for (int j = 0; j < 45; ++j) {
+        char buf[16];
+        std::snprintf(buf, sizeof(buf), "f_rest_%d", j);
+        if (!is(Layout::kRest + j, buf)) return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// resolveLayout  --  find the 3DGS properties and log what was discovered.
+// ---------------------------------------------------------------------------
+static bool resolveLayout(const PLYHeader& h, VertexLayout& L, std::string& errorMsg) {
     auto findProp = [&](const char* name) -> int {
-        for (int i = 0; i < (int)props.size(); i++)
-            if (props[i].name == name) return i;
+        for (int i = 0; i < (int)h.props.size(); i++)
+            if (h.props[i].name == name) return i;
         return -1;
     };
 
-    int iX  = findProp("x"),      iY   = findProp("y"),     iZ  = findProp("z");
-    int iR  = findProp("f_dc_0"), iG   = findProp("f_dc_1"), iB = findProp("f_dc_2");
-    int iOp = findProp("opacity");
+    L.iX  = findProp("x");      L.iY = findProp("y");      L.iZ = findProp("z");
+    L.iR  = findProp("f_dc_0"); L.iG = findProp("f_dc_1"); L.iB = findProp("f_dc_2");
+    L.iOp = findProp("opacity");
 
     // Fallback: uint8 red/green/blue when SH DC coefficients are absent
-    int iRed = findProp("red"), iGreen = findProp("green"), iBlue = findProp("blue");
-    bool useRGBFallback = (iR < 0 || iG < 0 || iB < 0) &&
-                          (iRed >= 0 && iGreen >= 0 && iBlue >= 0);
-    int iSX = findProp("scale_0"), iSY = findProp("scale_1"), iSZ = findProp("scale_2");
-    int iRW = findProp("rot_0"),   iRX = findProp("rot_1"),
-        iRY = findProp("rot_2"),   iRZ = findProp("rot_3");
+    L.iRed = findProp("red"); L.iGreen = findProp("green"); L.iBlue = findProp("blue");
+    L.useRGBFallback = (L.iR < 0 || L.iG < 0 || L.iB < 0) &&
+                       (L.iRed >= 0 && L.iGreen >= 0 && L.iBlue >= 0);
+    L.iSX = findProp("scale_0"); L.iSY = findProp("scale_1"); L.iSZ = findProp("scale_2");
+    L.iRW = findProp("rot_0");   L.iRX = findProp("rot_1");
+    L.iRY = findProp("rot_2");   L.iRZ = findProp("rot_3");
 
     // f_rest_0 .. f_rest_44
-    int iRest[45];
     for (int i = 0; i < 45; ++i) {
         char buf[16];
         std::snprintf(buf, sizeof(buf), "f_rest_%d", i);
-        iRest[i] = findProp(buf);
+        L.iRest[i] = findProp(buf);
     }
 
-    if (iX < 0 || iY < 0 || iZ < 0) {
+    if (L.iX < 0 || L.iY < 0 || L.iZ < 0) {
         errorMsg = "PLY missing position properties (x/y/z)";
         return false;
     }
 
-    // byte offsets per property
-    std::vector<int> offsets(props.size(), 0);
-    int rowBytes = 0;
-    for (int i = 0; i < (int)props.size(); i++) {
-        offsets[i] = rowBytes;
-        rowBytes   += props[i].byteSize;
+    // 3DGS writes (d+1)^2 - 1 rest coefficients per channel for SH degree d.
+    // Anything else keeps the historical 15-per-channel mapping.
+    int restCount = 0;
+    while (restCount < 45 && L.iRest[restCount] >= 0) ++restCount;
+    L.shDegree       = kMaxSHDegree;
+    L.restPerChannel = kSHCoeffsPerSplat - 1;
+    for (int d = 0; d <= kMaxSHDegree; ++d)
+        if (restCount == 3 * (shCoeffsForDegree(d) - 1)) {
+            L.shDegree       = d;
+            L.restPerChannel = shCoeffsForDegree(d) - 1;
+        }
+    if (L.useRGBFallback) L.shDegree = 0;
+
+    L.known = matchesLayout<Layout3DGS<true>>(h)  ? KnownLayout::Canonical3DGS
+            : matchesLayout<Layout3DGS<false>>(h) ? KnownLayout::Canonical3DGSNoNormals
+            :                                       KnownLayout::None;
+
+    // ---- diagnostic: log property discovery ----
+    auto propInfo = [&](int idx) -> std::string {
+        if (idx < 0) return "MISSING";
+        return h.props[idx].typeName + " (byte " + std::to_string(h.offsets[idx]) + ")";
+    };
+    fprintf(stderr, "[PLYReader] %d vertices, %d properties, %d bytes/row\n",
+            h.vertexCount, (int)h.props.size(), h.rowBytes);
+    fprintf(stderr, "[PLYReader] x=%s  y=%s  z=%s\n",
+            propInfo(L.iX).c_str(), propInfo(L.iY).c_str(), propInfo(L.iZ).c_str());
+    fprintf(stderr, "[PLYReader] f_dc_0=%s  f_dc_1=%s  f_dc_2=%s\n",
+            propInfo(L.iR).c_str(), propInfo(L.iG).c_str(), propInfo(L.iB).c_str());
+    fprintf(stderr, "[PLYReader] red=%s  green=%s  blue=%s  useRGBFallback=%d\n",
+            propInfo(L.iRed).c_str(), propInfo(L.iGreen).c_str(), propInfo(L.iBlue).c_str(),
+            (int)L.useRGBFallback);
+    fprintf(stderr, "[PLYReader] opacity=%s  scale_0=%s  rot_0=%s\n",
+            propInfo(L.iOp).c_str(), propInfo(L.iSX).c_str(), propInfo(L.iRW).c_str());
+    static const char* const kKnownNames[] = { "generic", "canonical 3DGS", "canonical 3DGS (no normals)" };
+    fprintf(stderr, "[PLYReader] layout: %s, SH degree %d\n", kKnownNames[(int)L.known], L.shDegree);
+    return true;
+}
+
+// Sizes outData for N rows at the SH degree to store: what the file has,
+// capped by the caller's request.
+static void prepareOutput(GaussianData& outData, const VertexLayout& L, size_t N,
+                          PLYReadControl* control)
+{
+    const int requested = control ? std::clamp(control->shDegree, 0, kMaxSHDegree) : kMaxSHDegree;
+    outData.clear();
+    outData.sourceSHDegree = L.shDegree;
+    outData.shDegree       = std::min(L.shDegree, requested);
+    outData.resize(N);
+    if (control) control->rowsTotal.store(N, std::memory_order_relaxed);
+}
+
+// ---------------------------------------------------------------------------
+// logSplatStats  --  sample first few splats + scale statistics.
+// ---------------------------------------------------------------------------
+static void logSplatStats(const GaussianData& data, const BoundsPartial& stats) {
+    int vertexCount = (int)data.count();
+    int nSample = std::min(5, vertexCount);
+    for (int i = 0; i < nSample; ++i) {
+        const float* p  = &data.positions[i * 3];
+        const float* r  = &data.rotationWS[i * 4];
+        const float* sh = &data.shCoeffs[(size_t)i * data.shFloats()];
+        float ls[3];
+        data.logScale(i, ls);
+        fprintf(stderr, "[PLYReader] splat[%d] pos=(%.3f,%.3f,%.3f) scale=(%.4f,%.4f,%.4f) "
+                "opacity=%.3f rot=(%.3f,%.3f,%.3f,%.3f) f_dc=(%.3f,%.3f,%.3f)\n",
+                i, p[0], p[1], p[2],
+                ls[0], ls[1], ls[2],
+                data.opacityRaw[i],
+                r[0], r[1], r[2], r[3],
+                sh[0], sh[1], sh[2]);
+    }
+    if (vertexCount == 0) return;
+    // Scale statistics (log space, as stored in the PLY), gathered by finalizeRows
+    fprintf(stderr, "[PLYReader] scale stats: min=%.4f max=%.4f avg=%.4f\n",
+            stats.logScaleMin, stats.logScaleMax, (float)(stats.logScaleSum / (vertexCount * 3.0)));
+    if (stats.logScaleMin > -0.001f && stats.logScaleMax < 0.001f)
+        fprintf(stderr, "[PLYReader] all scales are 1.0 after exp: PLY likely missing scale_0/1/2!\n");
+    fprintf(stderr, "[PLYReader] If scale values are positive (e.g. 0.001~1.0), "
+            "PLY may store LINEAR scale (not log-scale).\n");
+}
+
+// ---------------------------------------------------------------------------
+// Column gather (mapped binary path)
+//
+// A column is one property pulled out of `rowCount` consecutive fixed-size
+// rows and written to a float destination with an arbitrary stride. The type
+// switch happens once per column instead of once per field, and rows are
+// walked in cache-sized blocks so all columns of a block are served from L2
+// instead of re-streaming the whole mapping once per property.
+// ---------------------------------------------------------------------------
+static constexpr size_t kGatherBlockRows = 4096;
+static constexpr size_t kMaxHeaderBytes  = 64 * 1024;
+
+struct ColumnSource {
+    PropType type     = PropType::Float32;
+    int      offset   = -1;     // -1 = property absent -> constant `fallback`
+    float    scale    = 1.f;    // applied to integer columns only
+    float    bias     = 0.f;
+    float    fallback = 0.f;
+};
+
+// Float property; non-float or missing properties read as `fallback`
+// (matches the per-row getf() semantics of the stream reader).
+static ColumnSource floatColumn(const PLYHeader& h, int idx, float fallback) {
+    ColumnSource c;
+    c.fallback = fallback;
+    if (idx >= 0 && h.props[idx].isFloat) {
+        c.type   = h.props[idx].type;
+        c.offset = h.offsets[idx];
+    }
+    return c;
+}
+
+// uint8 colour property remapped as v * scale + bias.
+static ColumnSource u8Column(const PLYHeader& h, int idx, float scale, float bias) {
+    ColumnSource c;
+    if (idx >= 0) {
+        c.type   = PropType::UInt8;
+        c.offset = h.offsets[idx];
+        c.scale  = scale;
+        c.bias   = bias;
+    }
+    return c;
+}
+
+template <typename T>
+static inline void gatherTyped(const char* src, size_t rowBytes, size_t rowCount,
+                               float scale, float bias,
+                               float* dst, size_t dstStride)
+{
+    for (size_t i = 0; i < rowCount; ++i) {
+        T v;
+        std::memcpy(&v, src + i * rowBytes, sizeof(T));
+        if constexpr (std::is_floating_point_v<T>) dst[i * dstStride] = (float)v;
+        else                                       dst[i * dstStride] = (float)v * scale + bias;
+    }
+}
+
+static void gatherColumn(const char* rows, size_t rowBytes, size_t rowCount,
+                         const ColumnSource& c, float* dst, size_t dstStride)
+{
+    if (c.offset < 0) {
+        for (size_t i = 0; i < rowCount; ++i) dst[i * dstStride] = c.fallback;
+        return;
+    }
+    const char* src = rows + c.offset;
+    switch (c.type) {
+    case PropType::Float32: gatherTyped<float>   (src, rowBytes, rowCount, c.scale, c.bias, dst, dstStride); break;
+    case PropType::Float64: gatherTyped<double>  (src, rowBytes, rowCount, c.scale, c.bias, dst, dstStride); break;
+    case PropType::UInt8:   gatherTyped<uint8_t> (src, rowBytes, rowCount, c.scale, c.bias, dst, dstStride); break;
+    case PropType::Int8:    gatherTyped<int8_t>  (src, rowBytes, rowCount, c.scale, c.bias, dst, dstStride); break;
+    case PropType::UInt16:  gatherTyped<uint16_t>(src, rowBytes, rowCount, c.scale, c.bias, dst, dstStride); break;
+    case PropType::Int16:   gatherTyped<int16_t> (src, rowBytes, rowCount, c.scale, c.bias, dst, dstStride); break;
+    case PropType::UInt32:  gatherTyped<uint32_t>(src, rowBytes, rowCount, c.scale, c.bias, dst, dstStride); break;
+    case PropType::Int32:   gatherTyped<int32_t> (src, rowBytes, rowCount, c.scale, c.bias, dst, dstStride); break;
     }
+}
+
+// Fixed-layout decoder: every offset and type is a compile-time constant, so
+// each row is one memcpy into registers followed by straight stores into the
+// SoA columns. kDegree is the SH degree being stored; higher f_rest values
+// are never touched. Reads n rows `rowStride` bytes apart into output rows
+// [dstRow, dstRow + n).
+template <typename Layout, int kDegree>
+static void decodeFixedRows(const char* rows, size_t rowStride, size_t n,
+                            GaussianData& d, size_t dstRow)
+{
+    constexpr size_t shStride = (size_t)shCoeffsForDegree(kDegree) * 3;
+    constexpr int    kStored  = shCoeffsForDegree(kDegree) - 1;   // rest groups kept
+    float* pos = &d.positions[dstRow * 3];
+    float* sh  = &d.shCoeffs[dstRow * shStride];
+    float* op  = &d.opacityRaw[dstRow];
+    float* sc  = &d.scaleWS[dstRow * 3];
+    float* rot = &d.rotationWS[dstRow * 4];
+    for (size_t i = 0; i < n; ++i, pos += 3, sh += shStride, sc += 3, rot += 4) {
+        float r[Layout::kFloats];
+        std::memcpy(r, rows + i * rowStride, sizeof(r));
+        pos[0] = r[0]; pos[1] = r[1]; pos[2] = r[2];
+        sh[0] = r[Layout::kDC]; sh[1] = r[Layout::kDC + 1]; sh[2] = r[Layout::kDC + 2];
+        for (int j = 0; j < 45; ++j)
+            if (j % 15 < kStored) sh[GaussianData::restSlot(j)] = r[Layout::kRest + j];
+        op[i] = r[Layout::kOpacity];
+        sc[0] = r[Layout::kScale]; sc[1] = r[Layout::kScale + 1]; sc[2] = r[Layout::kScale + 2];
+        rot[0] = r[Layout::kRot];     rot[1] = r[Layout::kRot + 1];
+        rot[2] = r[Layout::kRot + 2]; rot[3] = r[Layout::kRot + 3];
+    }
+}
+
+using FixedDecodeFn = void (*)(const char*, size_t, size_t, GaussianData&, size_t);
+
+template <typename Layout>
+static FixedDecodeFn fixedDecoder(int degree) {
+    switch (degree) {
+    case 0:  return &decodeFixedRows<Layout, 0>;
+    case 1:  return &decodeFixedRows<Layout, 1>;
+    case 2:  return &decodeFixedRows<Layout, 2>;
+    default: return &decodeFixedRows<Layout, 3>;
+    }
+}
+
+static FixedDecodeFn fixedDecoder(KnownLayout known, int degree) {
+    switch (known) {
+    case KnownLayout::Canonical3DGS:          return fixedDecoder<Layout3DGS<true>>(degree);
+    case KnownLayout::Canonical3DGSNoNormals: return fixedDecoder<Layout3DGS<false>>(degree);
+    default:                                  return nullptr;
+    }
+}
+
+// Decode the binary vertex block straight out of the mapping into the
+// GaussianData columns (bbox included), split across worker threads.
+// See PLYReadControl for the streaming order and publication rules.
+static BoundsPartial decodeBinaryColumns(const char* vertexBlock, const PLYHeader& h,
+                                const VertexLayout& L, GaussianData& outData,
+                                PLYReadControl* control)
+{
+    // One column per stored float: destination of row 0 plus the column
+    // stride, so SH de-interleaving happens in the gather itself.
+    // A missing rot_0 reads as 1 (identity), like readStream.
+    struct Column { ColumnSource src; float* dst; size_t stride; };
+    std::vector<Column> cols;
+    cols.reserve(kFloatsPerSplat);
+
+    const size_t shStride = outData.shFloats();
+    float* pos = outData.positions.data();
+    float* sh  = outData.shCoeffs.data();
+    float* sc  = outData.scaleWS.data();
+    float* rot = outData.rotationWS.data();
+
+    cols.push_back({ floatColumn(h, L.iX, 0.f), pos + 0, 3 });
+    cols.push_back({ floatColumn(h, L.iY, 0.f), pos + 1, 3 });
+    cols.push_back({ floatColumn(h, L.iZ, 0.f), pos + 2, 3 });
+
+    if (L.useRGBFallback) {
+        // Convert uint8 [0,255] -> linear [0,1] -> SH DC space
+        const float scale = 1.f / (255.f * kSH_C0);
+        const float bias  = -0.5f / kSH_C0;
+        cols.push_back({ u8Column(h, L.iRed,   scale, bias), sh + 0, shStride });
+        cols.push_back({ u8Column(h, L.iGreen, scale, bias), sh + 1, shStride });
+        cols.push_back({ u8Column(h, L.iBlue,  scale, bias), sh + 2, shStride });
+    } else {
+        cols.push_back({ floatColumn(h, L.iR, 0.f), sh + 0, shStride });
+        cols.push_back({ floatColumn(h, L.iG, 0.f), sh + 1, shStride });
+        cols.push_back({ floatColumn(h, L.iB, 0.f), sh + 2, shStride });
+    }
+    // Rest coefficients above the stored SH degree are never read.
+    const int stored = outData.shStride() - 1;
+    for (int j = 0; j < 3 * L.restPerChannel; ++j)
+        if (j % L.restPerChannel < stored)
+            cols.push_back({ floatColumn(h, L.iRest[j], 0.f), sh + GaussianData::restSlot(j, L.restPerChannel), shStride });
+    cols.push_back({ floatColumn(h, L.iOp, 0.f), outData.opacityRaw.data(), 1 });
+    cols.push_back({ floatColumn(h, L.iSX, 0.f), sc + 0, 3 });
+    cols.push_back({ floatColumn(h, L.iSY, 0.f), sc + 1, 3 });
+    cols.push_back({ floatColumn(h, L.iSZ, 0.f), sc + 2, 3 });
+    cols.push_back({ floatColumn(h, L.iRW, 1.f), rot + 0, 4 });
+    cols.push_back({ floatColumn(h, L.iRX, 0.f), rot + 1, 4 });
+    cols.push_back({ floatColumn(h, L.iRY, 0.f), rot + 2, 4 });
+    cols.push_back({ floatColumn(h, L.iRZ, 0.f), rot + 3, 4 });
+
+    const size_t rowBytes = (size_t)h.rowBytes;
+    const size_t N        = (size_t)h.vertexCount;
+
+    // Known layouts skip the per-column gather entirely.
+    const FixedDecodeFn fixed = (control && control->genericDecode) ? nullptr : fixedDecoder(L.known, outData.shDegree);
+
+    // Output order. k == 1: file order. k > 1: output rows [0, S) are file
+    // rows 0, k, 2k, ... (one strided run), output rows [S, N) are the
+    // remaining file rows in order, i.e. runs of k-1 rows between samples.
+    const size_t k = (control && control->sampleStride > 1 && N > control->sampleStride)
+                   ? control->sampleStride : 1;
+    const size_t S = k > 1 ? (N + k - 1) / k : 0;
+    outData.sampleStride = k;
+
+    // Decodes n rows (file rows fileRow, fileRow+step, ...) into output rows
+    // [dstRow, dstRow+n), then exp/normalises them while still hot in cache.
+    auto decodeRun = [&](size_t fileRow, size_t step, size_t dstRow, size_t n, BoundsPartial& b) {
+        const char* rows = vertexBlock + fileRow * rowBytes;
+        if (fixed) {
+            fixed(rows, rowBytes * step, n, outData, dstRow);
+        } else {
+            for (const Column& c : cols)
+                gatherColumn(rows, rowBytes * step, n, c.src, c.dst + dstRow * c.stride, c.stride);
+        }
+        finalizeRows(outData, dstRow, dstRow + n, b);
+        if (control) control->rowsDone.fetch_add(n, std::memory_order_relaxed);
+    };
+
+    // Decodes output rows [o0, o1) as a sequence of contiguous runs.
+    auto decodeOutput = [&](size_t o0, size_t o1, BoundsPartial& b) {
+        for (size_t o = o0, n = 0; o < o1; o += n) {
+            if (control && control->cancelled()) return;
+            if (k == 1) {
+                n = std::min(kGatherBlockRows, o1 - o);
+                decodeRun(o, 1, o, n, b);
+            } else if (o < S) {
+                n = std::min({ kGatherBlockRows, S - o, o1 - o });
+                decodeRun(o * k, k, o, n, b);
+            } else {
+                size_t q = o - S, g = q / (k - 1), r = q % (k - 1);
+                n = std::min(k - 1 - r, o1 - o);
+                decodeRun(g * k + 1 + r, 1, o, n, b);
+            }
+        }
+    };
+
+    // Rows are fixed-size, so each worker owns an independent output range.
+    // With a control the rows are decoded in waves, each followed by
+    // publishing the completed prefix.
+    std::vector<BoundsPartial> parts(gs::WorkerCount());
+    auto runWave = [&](size_t o0, size_t o1) {
+        gs::ParallelFor(o1 - o0, kDecodeChunkRows, [&](size_t begin, size_t end, unsigned worker) {
+            decodeOutput(o0 + begin, o0 + end, parts[worker]);
+        });
+        if (control && !control->cancelled()) control->publish(o1);
+    };
+
+    if (S > 0) runWave(0, S);
+    const size_t waveRows = control ? kStreamWaveRows : N;
+    for (size_t o = S; o < N && !(control && control->cancelled()); o += waveRows)
+        runWave(o, std::min(N, o + waveRows));
+    return reduceBounds(parts, outData);
+}
+
+// ---------------------------------------------------------------------------
+// ASCII vertex block
+// ---------------------------------------------------------------------------
+static constexpr size_t kAsciiSegmentBytes = PLYReader::kAsciiSegmentBytes;
+
+// Stores one decoded row; get(idx, fallback) returns property idx as float,
+// getColor(idx) the raw [0,255] value of a colour property.
+template <typename Get, typename GetColor>
+static inline void storeRow(GaussianData& d, size_t i, const VertexLayout& L,
+                            Get&& get, GetColor&& getColor)
+{
+    float* pos = &d.positions[i * 3];
+    float* sh  = &d.shCoeffs[i * d.shFloats()];
+    float* sc  = &d.scaleWS[i * 3];
+    float* rot = &d.rotationWS[i * 4];
+    pos[0] = get(L.iX, 0.f);
+    pos[1] = get(L.iY, 0.f);
+    pos[2] = get(L.iZ, 0.f);
+    if (L.useRGBFallback) {
+        // Convert uint8 [0,255] → linear [0,1] → SH DC space
+        sh[0] = (getColor(L.iRed)   / 255.f - 0.5f) / kSH_C0;
+        sh[1] = (getColor(L.iGreen) / 255.f - 0.5f) / kSH_C0;
+        sh[2] = (getColor(L.iBlue)  / 255.f - 0.5f) / kSH_C0;
+    } else {
+        sh[0] = get(L.iR, 0.f);
+        sh[1] = get(L.iG, 0.f);
+        sh[2] = get(L.iB, 0.f);
+    }
+    const int stored = d.shStride() - 1;
+    for (int j = 0; j < 3 * L.restPerChannel; ++j)
+        if (j % L.restPerChannel < stored)
+            sh[GaussianData::restSlot(j, L.restPerChannel)] = get(L.iRest[j], 0.f);
+    d.opacityRaw[i] = get(L.iOp, 0.f);
+    sc[0]  = get(L.iSX, 0.f);
+    sc[1]  = get(L.iSY, 0.f);
+    sc[2]  = get(L.iSZ, 0.f);
+    rot[0] = get(L.iRW, 1.f);
+    rot[1] = get(L.iRX, 0.f);
+    rot[2] = get(L.iRY, 0.f);
+    rot[3] = get(L.iRZ, 0.f);
+}
+
+static inline bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+// Parses the next whitespace-separated number in [p, end). A missing or
+// malformed token reads as 0, like operator>> into a zeroed value.
+static inline const char* parseAsciiValue(const char* p, const char* end, float& out) {
+    while (p < end && isBlank(*p)) ++p;
+    if (p < end && *p == '+') ++p;                  // from_chars rejects a leading '+'
+    auto r = std::from_chars(p, end, out);
+    if (r.ec == std::errc()) return r.ptr;
+    out = 0.f;
+    while (p < end && !isBlank(*p)) ++p;
+    return p;
+}
+
+// Line boundaries of the text body, cut into ~kAsciiSegmentBytes segments.
+// Segment s holds the lines starting in [begin[s], begin[s+1]); its first
+// line is row firstRow[s]. Every begin[] except the first sits just after a
+// '\n', so segments can be parsed independently.
+struct AsciiLineIndex {
+    std::vector<const char*> begin;      // numSegments + 1
+    std::vector<size_t>      firstRow;   // numSegments + 1; back() = line count
+    size_t segments() const { return firstRow.size() - 1; }
+    size_t lines() const    { return firstRow.back(); }
+};
+
+static AsciiLineIndex indexAsciiLines(const char* body, const char* bodyEnd) {
+    const size_t bytes = (size_t)(bodyEnd - body);
+    const size_t numSegments = std::max<size_t>(1, (bytes + kAsciiSegmentBytes - 1) / kAsciiSegmentBytes);
+
+    AsciiLineIndex idx;
+    idx.begin.resize(numSegments + 1);
+    idx.firstRow.assign(numSegments + 1, 0);
+
+    // Snap each nominal cut to the start of the next line.
+    idx.begin[0] = body;
+    for (size_t s = 1; s < numSegments; ++s) {
+        const char* cut = std::max(body + s * kAsciiSegmentBytes - 1, idx.begin[s - 1]);
+        const void* nl  = std::memchr(cut, '\n', (size_t)(bodyEnd - cut));
+        idx.begin[s] = nl ? static_cast<const char*>(nl) + 1 : bodyEnd;
+    }
+    idx.begin[numSegments] = bodyEnd;
+
+    // Count lines per segment in parallel, then prefix-sum into row numbers.
+    gs::ParallelFor(numSegments, 1, [&](size_t s0, size_t s1, unsigned) {
+        for (size_t s = s0; s < s1; ++s) {
+            const char* b = idx.begin[s];
+            const char* e = idx.begin[s + 1];
+            size_t n = (size_t)std::count(b, e, '\n');
+            if (e == bodyEnd && e > b && e[-1] != '\n') ++n;   // unterminated last line
+            idx.firstRow[s + 1] = n;
+        }
+    });
+    for (size_t s = 0; s < numSegments; ++s) idx.firstRow[s + 1] += idx.firstRow[s];
+    return idx;
+}
+
+// Parses the first h.vertexCount lines into outData, one segment per task,
+// with no per-line allocation. Rows come out in file order; with a control
+// they are published in waves of ~kStreamWaveRows.
+static BoundsPartial decodeAsciiLines(const AsciiLineIndex& idx, const PLYHeader& h,
+                             const VertexLayout& L, GaussianData& outData,
+                             PLYReadControl* control)
+{
+    const size_t N = (size_t)h.vertexCount;
+    const size_t usedSegments = (size_t)(std::lower_bound(idx.firstRow.begin(), idx.firstRow.end(), N)
+                                         - idx.firstRow.begin());
+
+    const unsigned W = gs::WorkerCount();
+    std::vector<BoundsPartial>      parts(W);
+    std::vector<std::vector<float>> vals(W, std::vector<float>(h.props.size(), 0.f));
+
+    auto parseSegment = [&](size_t s, unsigned worker) {
+        std::vector<float>& v = vals[worker];
+        const char*  p      = idx.begin[s];
+        const char*  segEnd = idx.begin[s + 1];
+        const size_t row0   = idx.firstRow[s];
+        const size_t row1   = std::min(idx.firstRow[s + 1], N);
+        for (size_t row = row0; row < row1; ++row) {
+            const void* nl  = std::memchr(p, '\n', (size_t)(segEnd - p));
+            const char* eol = nl ? static_cast<const char*>(nl) : segEnd;
+            for (float& x : v) p = parseAsciiValue(p, eol, x);
+            storeRow(outData, row, L, [&](int i, float fallback) { return i >= 0 ? v[i] : fallback; },
+                                      [&](int i) { return v[i]; });
+            p = eol + 1;
+        }
+        finalizeRows(outData, row0, row1, parts[worker]);
+        if (control) control->rowsDone.fetch_add(row1 - row0, std::memory_order_relaxed);
+    };
+
+    const size_t waveRows = control ? kStreamWaveRows : N;
+    for (size_t s0 = 0; s0 < usedSegments && !(control && control->cancelled()); ) {
+        size_t target = idx.firstRow[s0] + waveRows;
+        size_t s1 = (size_t)(std::lower_bound(idx.firstRow.begin() + s0 + 1,
+                                              idx.firstRow.begin() + usedSegments, target)
+                             - idx.firstRow.begin());
+        gs::ParallelFor(s1 - s0, 1, [&](size_t b, size_t e, unsigned worker) {
+            for (size_t s = s0 + b; s < s0 + e; ++s) {
+                if (control && control->cancelled()) return;
+                parseSegment(s, worker);
+            }
+        });
+        if (control && !control->cancelled()) control->publish(std::min(idx.firstRow[s1], N));
+        s0 = s1;
+    }
+    return reduceBounds(parts, outData);
+}
+
+// ---------------------------------------------------------------------------
+// PLYReader::read  --  memory-mapped path
+// ---------------------------------------------------------------------------
+bool PLYReader::read(const std::string& filepath,
+                     GaussianData&      outData,
+                     std::string&       errorMsg,
+                     PLYReadControl*    control)
+{
+    auto t0 = std::chrono::steady_clock::now();
+
+    MappedFile file;
+    if (!file.open(filepath, errorMsg)) {
+        // Mapping can fail on exotic file systems; the stream reader still works.
+        fprintf(stderr, "[PLYReader] %s -- falling back to stream reader\n", errorMsg.c_str());
+        return readStream(filepath, outData, errorMsg, control);
+    }
+
+    // ---- locate and parse header ----
+    const char*  data = file.data();
+    const size_t size = file.size();
+    const size_t scan = std::min(size, kMaxHeaderBytes);
+
+    static const char kEnd[] = "end_header";
+    const char* end = std::search(data, data + scan, kEnd, kEnd + sizeof(kEnd) - 1);
+    if (end == data + scan) {
+        errorMsg = (std::strncmp(data, "ply", std::min<size_t>(size, 3)) == 0)
+                 ? "PLY header has no end_header" : "Not a PLY file";
+        return false;
+    }
+    const char* body = std::find(end, data + size, '\n');
+    if (body == data + size) { errorMsg = "PLY file has no vertex data"; return false; }
+    ++body;
+
+    PLYHeader h;
+    {
+        std::istringstream hs(std::string(data, body));
+        if (!parseHeader(hs, h, errorMsg)) return false;
+    }
+
+    VertexLayout L;
+    if (!resolveLayout(h, L, errorMsg)) return false;
+
+    // ---- validate the vertex block fits in the mapping ----
+    AsciiLineIndex lines;
+    if (h.format == PLYFormat::ASCII) {
+        lines = indexAsciiLines(body, data + size);
+        if (lines.lines() < (size_t)h.vertexCount) {
+            errorMsg = "Unexpected EOF in ASCII data (need " + std::to_string(h.vertexCount) +
+                       " lines, have " + std::to_string(lines.lines()) + ")";
+            return false;
+        }
+    } else {
+        const size_t dataOffset = (size_t)(body - data);
+        const size_t needBytes  = (size_t)h.rowBytes * (size_t)h.vertexCount;
+        if (size - dataOffset < needBytes) {
+            errorMsg = "Unexpected EOF in binary data (file truncated: need " +
+                       std::to_string(needBytes) + " bytes, have " +
+                       std::to_string(size - dataOffset) + ")";
+            return false;
+        }
+    }
+
+    // ---- read vertices ----
+    prepareOutput(outData, L, (size_t)h.vertexCount, control);
+    BoundsPartial stats = h.format == PLYFormat::ASCII
+                        ? decodeAsciiLines(lines, h, L, outData, control)
+                        : decodeBinaryColumns(body, h, L, outData, control);
+    file.close();
+
+    if (control && control->cancelled()) {
+        errorMsg = "Load cancelled";
+        return false;
+    }
+
+    logSplatStats(outData, stats);
+
+    double ms = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - t0).count();
+    fprintf(stderr, "[PLYReader] mapped %s read: %d splats, %.1f MB in %.1f ms (%u threads)\n",
+            h.format == PLYFormat::ASCII ? "ascii" : "binary",
+            h.vertexCount, size / (1024.0 * 1024.0), ms, gs::WorkerCount());
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// PLYReader::readStream  --  std::ifstream path (row-by-row)
+// ---------------------------------------------------------------------------
+bool PLYReader::readStream(const std::string& filepath,
+                           GaussianData&      outData,
+                           std::string&       errorMsg,
+                           PLYReadControl*    control)
+{
+    std::ifstream file(filepath, std::ios::binary);
+    if (!file.is_open()) {
+        errorMsg = "Cannot open: " + filepath;
+        return false;
+    }
+
+    // ---- parse header ----
+    PLYHeader h;
+    if (!parseHeader(file, h, errorMsg)) return false;
+
+    VertexLayout L;
+    if (!resolveLayout(h, L, errorMsg)) return false;
+
+    const std::vector<PropDef>& props   = h.props;
+    const std::vector<int>&     offsets = h.offsets;
+    const int vertexCount = h.vertexCount;
+    const int rowBytes    = h.rowBytes;
 
     // ---- helper: read float from a raw row buffer ----
-    auto getf = [&](const char* row, int idx) -> float {
-        if (idx < 0 || !props[idx].isFloat) return 0.f;
+    // Missing or non-float properties read as `fallback`, as in the mapped
+    // reader's floatColumn (rot_0 falls back to 1, the identity)
+    auto getf = [&](const char* row, int idx, float fallback) -> float {
+        if (idx < 0 || !props[idx].isFloat) return fallback;
         if (props[idx].byteSize == 8) {          // double / float64
             double d;
             std::memcpy(&d, row + offsets[idx], 8);
@@ -236,122 +932,55 @@ bool PLYReader::read(const std::string& filepath,
         return v;
     };
 
-    // ---- diagnostic: log property discovery ----
-    {
-        auto propInfo = [&](int idx) -> std::string {
-            if (idx < 0) return "MISSING";
-            return props[idx].typeName + " (byte " + std::to_string(offsets[idx]) + ")";
-        };
-        fprintf(stderr, "[PLYReader] %d vertices, %d properties, %d bytes/row\n",
-                vertexCount, (int)props.size(), rowBytes);
-        fprintf(stderr, "[PLYReader] x=%s  y=%s  z=%s\n",
-                propInfo(iX).c_str(), propInfo(iY).c_str(), propInfo(iZ).c_str());
-        fprintf(stderr, "[PLYReader] f_dc_0=%s  f_dc_1=%s  f_dc_2=%s\n",
-                propInfo(iR).c_str(), propInfo(iG).c_str(), propInfo(iB).c_str());
-        fprintf(stderr, "[PLYReader] red=%s  green=%s  blue=%s  useRGBFallback=%d\n",
-                propInfo(iRed).c_str(), propInfo(iGreen).c_str(), propInfo(iBlue).c_str(),
-                (int)useRGBFallback);
-        fprintf(stderr, "[PLYReader] opacity=%s  scale_0=%s  rot_0=%s\n",
-                propInfo(iOp).c_str(), propInfo(iSX).c_str(), propInfo(iRW).c_str());
-    }
-
     // ---- read vertices ----
-    outData.clear();
-    outData.splats.resize(vertexCount);
+    prepareOutput(outData, L, (size_t)vertexCount, control);
+
+    // Rows are finalized (and published to a streaming reader) every
+    // kGatherBlockRows rows.
+    BoundsPartial bounds;
+    size_t finalized = 0;
+    auto checkpoint = [&](int i) -> bool {
+        if ((i % kGatherBlockRows) != 0) return true;
+        finalizeRows(outData, finalized, (size_t)i, bounds);
+        finalized = (size_t)i;
+        if (!control) return true;
+        control->rowsDone.store((size_t)i, std::memory_order_relaxed);
+        control->publish((size_t)i);
+        if (!control->cancelled()) return true;
+        errorMsg = "Load cancelled";
+        return false;
+    };
 
-    if (format == PLYFormat::BinaryLE) {
+    if (h.format == PLYFormat::BinaryLE) {
         std::vector<char> row(rowBytes);
         for (int i = 0; i < vertexCount; i++) {
+            if (!checkpoint(i)) return false;
             file.read(row.data(), rowBytes);
             if (file.fail()) { errorMsg = "Unexpected EOF in binary data"; return false; }
-            GaussianSplat& s = outData.splats[i];
-            s.position[0] = getf(row.data(), iX);
-            s.position[1] = getf(row.data(), iY);
-            s.position[2] = getf(row.data(), iZ);
-            if (useRGBFallback) {
-                // Convert uint8 [0,255] → linear [0,1] → SH DC space
-                s.f_dc[0] = (getu8(row.data(), iRed)   / 255.f - 0.5f) / kSH_C0;
-                s.f_dc[1] = (getu8(row.data(), iGreen) / 255.f - 0.5f) / kSH_C0;
-                s.f_dc[2] = (getu8(row.data(), iBlue)  / 255.f - 0.5f) / kSH_C0;
-            } else {
-                s.f_dc[0] = getf(row.data(), iR);
-                s.f_dc[1] = getf(row.data(), iG);
-                s.f_dc[2] = getf(row.data(), iB);
-            }
-            s.opacity     = getf(row.data(), iOp);
-            s.scale[0]    = getf(row.data(), iSX);
-            s.scale[1]    = getf(row.data(), iSY);
-            s.scale[2]    = getf(row.data(), iSZ);
-            s.rotation[0] = getf(row.data(), iRW);
-            s.rotation[1] = getf(row.data(), iRX);
-            s.rotation[2] = getf(row.data(), iRY);
-            s.rotation[3] = getf(row.data(), iRZ);
-            for (int j = 0; j < 45; ++j)
-                s.f_rest[j] = getf(row.data(), iRest[j]);
+            storeRow(outData, i, L, [&](int idx, float fallback) { return getf(row.data(), idx, fallback); },
+                                    [&](int idx) { return (float)getu8(row.data(), idx); });
         }
     } else { // ASCII
+        std::vector<float> vals(props.size(), 0.f);
         for (int i = 0; i < vertexCount; i++) {
+            if (!checkpoint(i)) return false;
             std::string line;
             if (!std::getline(file, line)) { errorMsg = "Unexpected EOF in ASCII data"; return false; }
             if (!line.empty() && line.back() == '\r') line.pop_back();
             std::istringstream ss(line);
-            std::vector<float> vals(props.size(), 0.f);
+            std::fill(vals.begin(), vals.end(), 0.f);
             for (auto& v : vals) ss >> v;
-            GaussianSplat& s = outData.splats[i];
-            s.position[0] = iX  >= 0 ? vals[iX]  : 0.f;
-            s.position[1] = iY  >= 0 ? vals[iY]  : 0.f;
-            s.position[2] = iZ  >= 0 ? vals[iZ]  : 0.f;
-            if (useRGBFallback) {
-                s.f_dc[0] = (vals[iRed]   / 255.f - 0.5f) / kSH_C0;
-                s.f_dc[1] = (vals[iGreen] / 255.f - 0.5f) / kSH_C0;
-                s.f_dc[2] = (vals[iBlue]  / 255.f - 0.5f) / kSH_C0;
-            } else {
-                s.f_dc[0] = iR >= 0 ? vals[iR] : 0.f;
-                s.f_dc[1] = iG >= 0 ? vals[iG] : 0.f;
-                s.f_dc[2] = iB >= 0 ? vals[iB] : 0.f;
-            }
-            s.opacity     = iOp >= 0 ? vals[iOp] : 0.f;
-            s.scale[0]    = iSX >= 0 ? vals[iSX] : 0.f;
-            s.scale[1]    = iSY >= 0 ? vals[iSY] : 0.f;
-            s.scale[2]    = iSZ >= 0 ? vals[iSZ] : 0.f;
-            s.rotation[0] = iRW >= 0 ? vals[iRW] : 1.f;
-            s.rotation[1] = iRX >= 0 ? vals[iRX] : 0.f;
-            s.rotation[2] = iRY >= 0 ? vals[iRY] : 0.f;
-            s.rotation[3] = iRZ >= 0 ? vals[iRZ] : 0.f;
-            for (int j = 0; j < 45; ++j)
-                s.f_rest[j] = iRest[j] >= 0 ? vals[iRest[j]] : 0.f;
+            storeRow(outData, i, L, [&](int idx, float fallback) { return idx >= 0 ? vals[idx] : fallback; },
+                                    [&](int idx) { return vals[idx]; });
         }
     }
 
-    // ---- diagnostic: sample first few splats ----
-    {
-        int nSample = std::min(5, vertexCount);
-        for (int i = 0; i < nSample; ++i) {
-            const auto& s = outData.splats[i];
-            fprintf(stderr, "[PLYReader] splat[%d] pos=(%.3f,%.3f,%.3f) scale=(%.4f,%.4f,%.4f) "
-                    "opacity=%.3f rot=(%.3f,%.3f,%.3f,%.3f) f_dc=(%.3f,%.3f,%.3f)\n",
-                    i, s.position[0], s.position[1], s.position[2],
-                    s.scale[0], s.scale[1], s.scale[2],
-                    s.opacity,
-                    s.rotation[0], s.rotation[1], s.rotation[2], s.rotation[3],
-                    s.f_dc[0], s.f_dc[1], s.f_dc[2]);
-        }
-        // Scale statistics
-        float sMin = 1e30f, sMax = -1e30f, sSum = 0.f;
-        for (int i = 0; i < vertexCount; ++i) {
-            for (int j = 0; j < 3; ++j) {
-                float v = outData.splats[i].scale[j];
-                sMin = std::min(sMin, v);
-                sMax = std::max(sMax, v);
-                sSum += v;
-            }
-        }
-        fprintf(stderr, "[PLYReader] scale stats: min=%.4f max=%.4f avg=%.4f\n",
-                sMin, sMax, sSum / (vertexCount * 3.0f));
-        fprintf(stderr, "[PLYReader] If scale values are positive (e.g. 0.001~1.0), "
-                "PLY may store LINEAR scale (not log-scale).\n");
+    finalizeRows(outData, finalized, (size_t)vertexCount, bounds);
+    BoundsPartial stats = reduceBounds({ bounds }, outData);
+    if (control) {
+        control->rowsDone.store((size_t)vertexCount, std::memory_order_relaxed);
+        control->publish((size_t)vertexCount);
     }
-
-    outData.buildGPUArrays();
+    logSplatStats(outData, stats);
     return true;
 }
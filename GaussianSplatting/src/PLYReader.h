@@ -1,12 +1,62 @@
 #pragma once
 #include "GaussianData.h"
+#include <atomic>
+#include <cstddef>
 #include <string>
 
+// Optional progress / cancellation / streaming hook for PLYReader. Written
+// by the reading thread(s), polled by anyone else (e.g. the node's load timer).
+//
+// Streaming: outData is sized before any row is decoded and never resized
+// afterwards (not even on failure), and rows [0, rowsReady) are complete
+// (finalized) once rowsReady is observed with acquire ordering. Another
+// thread may read that prefix while the load continues.
+struct PLYReadControl {
+    // Set before the read. > 1: binary files store every n-th row first
+    // (a stratified subsample covering the whole cloud), then the rest in
+    // file order, so a short prefix already shows the full extent.
+    size_t sampleStride = 0;
+    // Set before the read. true: decode known layouts through the generic
+    // per-column path too (benchmarking the fixed-layout decoders).
+    bool genericDecode = false;
+    // Set before the read. Highest SH degree to decode and store (0..3);
+    // coefficients above it are skipped entirely.
+    int shDegree = kMaxSHDegree;
+
+    std::atomic<bool>   cancel    { false };
+    std::atomic<size_t> rowsDone  { 0 };
+    std::atomic<size_t> rowsTotal { 0 };
+    std::atomic<size_t> rowsReady { 0 };
+
+    float progress() const {
+        size_t total = rowsTotal.load(std::memory_order_relaxed);
+        return total ? (float)rowsDone.load(std::memory_order_relaxed) / (float)total : 0.f;
+    }
+    bool cancelled() const { return cancel.load(std::memory_order_relaxed); }
+    void publish(size_t rows) { rowsReady.store(rows, std::memory_order_release); }
+};
+
 class PLYReader {
 public:
+    // ASCII bodies are split into tasks of about this many bytes, each cut
+    // moved forward to the next line start
+    static constexpr size_t kAsciiSegmentBytes = 1u << 20;
+
     // Reads a 3DGS PLY file (binary_little_endian or ASCII).
-    // Returns true on success; sets errorMsg on failure.
+    // The file is memory-mapped; binary files are decoded column by column,
+    // ASCII files are split at line boundaries and parsed with from_chars,
+    // both across worker threads.
+    // Returns true on success; sets errorMsg on failure (including when
+    // `control` requests cancellation). outData is unspecified on failure.
     static bool read(const std::string& filepath,
                      GaussianData&      outData,
-                     std::string&       errorMsg);
+                     std::string&       errorMsg,
+                     PLYReadControl*    control = nullptr);
+
+    // Row-by-row std::ifstream reader. Used as a fallback when the file
+    // cannot be mapped, and as the gsBenchPLY baseline.
+    static bool readStream(const std::string& filepath,
+                           GaussianData&      outData,
+                           std::string&       errorMsg,
+                           PLYReadControl*    control = nullptr);
 };
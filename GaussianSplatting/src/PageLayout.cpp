@@ -0,0 +1,36 @@
+#include "PageLayout.h"
+
+#include <algorithm>
+
+PageLayout::PageLayout(uint32_t stride, uint32_t maxPages)
+    : PageLayout(stride, maxPages, shiftFor(stride)) {}
+
+PageLayout::PageLayout(uint32_t stride, uint32_t maxPages, uint32_t pageShift)
+    : m_stride(stride), m_maxPages(std::max(1u, maxPages)), m_pageShift(pageShift) {}
+
+uint32_t PageLayout::shiftFor(uint32_t stride) {
+    uint32_t shift = kPageShift;
+    while (shift > 0 && ((1ull << shift) * std::max(1u, stride) > kMaxPageBytes ||
+                         (1ull << shift) > kMaxPageElements))
+        shift--;
+    return shift;
+}
+
+uint32_t PageLayout::elementsInPage(uint64_t elements, uint32_t page) const {
+    uint64_t start = pageStart(page);
+    if (start >= elements) return 0;
+    return (uint32_t)std::min<uint64_t>(elements - start, pageElements());
+}
+
+std::vector<PageLayout::Piece> PageLayout::split(uint64_t first, uint64_t count) const {
+    std::vector<Piece> pieces;
+    uint64_t done = 0;
+    while (done < count) {
+        uint64_t i     = first + done;
+        uint32_t local = localOf(i);
+        uint64_t n     = std::min<uint64_t>(count - done, pageElements() - local);
+        pieces.push_back({ pageOf(i), local, (uint32_t)n, done });
+        done += n;
+    }
+    return pieces;
+}
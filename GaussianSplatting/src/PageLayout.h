@@ -0,0 +1,83 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ===========================================================================
+// PageLayout  --  how a column of fixed-stride elements is split into pages
+// (separate GPU buffers) to stay under the per-buffer limits.
+//
+// A D3D11 structured buffer's ByteWidth is a UINT, resources above 128 MB
+// are only guaranteed up to a quarter of video memory (2 GB at most), and a
+// buffer SRV covers at most 2^27 elements. A page holds 2^pageShift
+// elements, so element i lives at (i >> pageShift, i & pageMask) and
+// shaders locate it with a shift and a mask. Every page is full except the
+// last. Pure arithmetic on 64-bit indices: gsPageCheck runs it at simulated
+// sizes far beyond what fits in memory.
+//
+// kPageShift is shared with the shaders (kPageShift in merged_preprocess,
+// production, depth_pass, radix_sort and debug.hlsl); so are the page
+// counts the render manager binds (kMaxRowPages, ...).
+// ===========================================================================
+class PageLayout {
+public:
+    static constexpr uint32_t kPageShift       = 26;           // 64M elements
+    static constexpr uint64_t kMaxPageBytes    = 1ull << 30;   // 1 GB
+    static constexpr uint32_t kMaxPageElements = 1u << 27;     // D3D11 buffer SRV limit
+
+    // Rows (position, scale, rotation, opacity): up to 256M splats
+    static constexpr uint32_t kMaxRowPages  = 4;
+    // SH: 3G float3 groups (or uints of fp16 pairs when compact), enough
+    // for 100M splats at degree 3 either way (16 groups or 24 uints per
+    // splat). Element indices stay below 2^32 for the shaders, and the
+    // preprocess binds 8 + 4 * kMaxRowPages + kMaxSHPages = 72 of the 128
+    // SRV slots.
+    static constexpr uint32_t kMaxSHPages   = 48;
+    // Per-slot outputs and masks: the sort keeps its keys in single buffers,
+    // so the merged slot space stops at kMaxPageElements, two 2^26 pages
+    static constexpr uint32_t kMaxSlotPages = kMaxPageElements >> kPageShift;
+
+    PageLayout() = default;
+    // kPageShift, or less for strides whose full page would pass kMaxPageBytes
+    PageLayout(uint32_t stride, uint32_t maxPages);
+    // An explicit shift; gsPageCheck uses small pages to test real copies
+    PageLayout(uint32_t stride, uint32_t maxPages, uint32_t pageShift);
+
+    // Largest shift <= kPageShift whose page fits kMaxPageBytes and
+    // kMaxPageElements
+    static uint32_t shiftFor(uint32_t stride);
+
+    uint32_t stride()       const { return m_stride; }
+    uint32_t maxPages()     const { return m_maxPages; }
+    uint32_t pageShift()    const { return m_pageShift; }
+    uint64_t pageElements() const { return 1ull << m_pageShift; }
+    uint64_t pageMask()     const { return pageElements() - 1; }
+    uint64_t pageBytes()    const { return pageElements() * m_stride; }
+    // Elements the layout can hold in maxPages() pages
+    uint64_t maxElements()  const { return pageElements() * m_maxPages; }
+    bool     fits(uint64_t elements) const { return elements <= maxElements(); }
+
+    uint32_t pageOf(uint64_t i)  const { return (uint32_t)(i >> m_pageShift); }
+    uint32_t localOf(uint64_t i) const { return (uint32_t)(i & pageMask()); }
+    uint64_t pageStart(uint32_t page) const { return (uint64_t)page << m_pageShift; }
+
+    // Pages and per-page element counts of a column of `elements`
+    uint32_t pageCount(uint64_t elements) const {
+        return (uint32_t)((elements + pageMask()) >> m_pageShift);
+    }
+    uint32_t elementsInPage(uint64_t elements, uint32_t page) const;
+
+    // Elements [first, first + count) cut at page boundaries
+    struct Piece {
+        uint32_t page;
+        uint32_t local;     // first element within the page
+        uint32_t count;
+        uint64_t offset;    // elements from `first` to the piece
+    };
+    std::vector<Piece> split(uint64_t first, uint64_t count) const;
+
+private:
+    uint32_t m_stride    = 0;
+    uint32_t m_maxPages  = 1;
+    uint32_t m_pageShift = kPageShift;
+};
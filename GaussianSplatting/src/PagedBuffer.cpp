@@ -0,0 +1,194 @@
+#include "PagedBuffer.h"
+
+#include <maya/MGlobal.h>
+#include <maya/MString.h>
+
+#include <algorithm>
+#include <cstring>
+
+#define SAFE_RELEASE(p) do { if (p) { (p)->Release(); (p) = nullptr; } } while(0)
+
+void PagedBuffer::init(const PageLayout& layout, const char* name, unsigned flags) {
+    release();
+    m_layout = layout;
+    m_name   = name;
+    m_flags  = flags;
+}
+
+void PagedBuffer::releasePage(Page& page) {
+    SAFE_RELEASE(page.uav);
+    SAFE_RELEASE(page.srv);
+    SAFE_RELEASE(page.buf);
+    page.elements = 0;
+}
+
+void PagedBuffer::release() {
+    for (Page& page : m_pages) releasePage(page);
+    m_pages.clear();
+    m_capacity = 0;
+}
+
+bool PagedBuffer::createPage(ID3D11Device* device, uint32_t index, uint32_t elements, Page& page) const {
+    const uint32_t stride = m_layout.stride();
+    D3D11_BUFFER_DESC bd = {};
+    bd.ByteWidth           = elements * stride;     // <= PageLayout::kMaxPageBytes
+    bd.Usage               = D3D11_USAGE_DEFAULT;
+    bd.BindFlags           = D3D11_BIND_SHADER_RESOURCE |
+                             ((m_flags & kUnorderedAccess) ? D3D11_BIND_UNORDERED_ACCESS : 0);
+    bd.MiscFlags           = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+    bd.StructureByteStride = stride;
+
+    std::vector<uint8_t> zeroes((m_flags & kZeroed) ? bd.ByteWidth : 0, 0);
+    D3D11_SUBRESOURCE_DATA init = { zeroes.data(), 0, 0 };
+    if (FAILED(device->CreateBuffer(&bd, zeroes.empty() ? nullptr : &init, &page.buf))) {
+        MGlobal::displayError(MString("[GaussianSplat] CreateBuffer failed for '") + m_name.c_str() +
+                              "' page " + index + " (" + (unsigned)(bd.ByteWidth >> 20) + " MB).");
+        return false;
+    }
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvd = {};
+    srvd.ViewDimension         = D3D11_SRV_DIMENSION_BUFFEREX;
+    srvd.BufferEx.FirstElement = 0;
+    srvd.BufferEx.NumElements  = elements;
+    bool ok = SUCCEEDED(device->CreateShaderResourceView(page.buf, &srvd, &page.srv));
+    if (ok && (m_flags & kUnorderedAccess)) {
+        D3D11_UNORDERED_ACCESS_VIEW_DESC uavd = {};
+        uavd.ViewDimension      = D3D11_UAV_DIMENSION_BUFFER;
+        uavd.Buffer.NumElements = elements;
+        ok = SUCCEEDED(device->CreateUnorderedAccessView(page.buf, &uavd, &page.uav));
+    }
+    if (!ok) {
+        MGlobal::displayError(MString("[GaussianSplat] Creating views failed for '") + m_name.c_str() +
+                              "' page " + index + ".");
+        releasePage(page);
+        return false;
+    }
+    page.elements = elements;
+    return true;
+}
+
+bool PagedBuffer::resize(ID3D11Device* device, ID3D11DeviceContext* ctx, uint64_t elements) {
+    if (elements <= m_capacity) return true;
+    if (!m_layout.fits(elements)) {
+        MGlobal::displayError(MString("[GaussianSplat] '") + m_name.c_str() + "' needs " +
+                              m_layout.pageCount(elements) + " pages of " +
+                              (unsigned)m_layout.pageElements() + " elements; at most " +
+                              m_layout.maxPages() + " are supported.");
+        return false;
+    }
+
+    // Build the new pages first so a failure leaves the buffer as it was
+    uint32_t        oldPages = pageCount();
+    uint32_t        newPages = m_layout.pageCount(elements);
+    uint32_t        first    = oldPages;          // first page to (re)create
+    std::vector<Page> created;
+    if (oldPages && m_pages.back().elements < m_layout.elementsInPage(elements, oldPages - 1))
+        first = oldPages - 1;
+    for (uint32_t p = first; p < newPages; p++) {
+        Page page;
+        if (!createPage(device, p, m_layout.elementsInPage(elements, p), page)) {
+            for (Page& c : created) releasePage(c);
+            return false;
+        }
+        created.push_back(page);
+    }
+
+    if (first < oldPages) {
+        // Grown last page: GPU copy of what it held
+        Page& old = m_pages[first];
+        D3D11_BOX box = {};
+        box.right  = old.elements * m_layout.stride();
+        box.bottom = 1;
+        box.back   = 1;
+        ctx->CopySubresourceRegion(created.front().buf, 0, 0, 0, 0, old.buf, 0, &box);
+        releasePage(old);
+        m_pages.pop_back();
+    }
+    m_pages.insert(m_pages.end(), created.begin(), created.end());
+    m_capacity = elements;
+    return true;
+}
+
+void PagedBuffer::srvs(ID3D11ShaderResourceView** out) const {
+    for (uint32_t p = 0; p < m_layout.maxPages(); p++) out[p] = srv(p);
+}
+
+void PagedBuffer::update(ID3D11DeviceContext* ctx, uint64_t first, uint64_t count, const void* src) const {
+    const uint32_t stride = m_layout.stride();
+    for (const PageLayout::Piece& piece : m_layout.split(first, count)) {
+        D3D11_BOX box = {};
+        box.left   = piece.local * stride;
+        box.right  = (piece.local + piece.count) * stride;
+        box.bottom = 1;
+        box.back   = 1;
+        ctx->UpdateSubresource(m_pages[piece.page].buf, 0, &box,
+                               static_cast<const char*>(src) + piece.offset * stride, 0, 0);
+    }
+}
+
+void PagedBuffer::copyFrom(ID3D11DeviceContext* ctx, uint64_t dstFirst,
+                           ID3D11Buffer* src, uint64_t srcFirst, uint64_t count) const {
+    const uint32_t stride = m_layout.stride();
+    for (const PageLayout::Piece& piece : m_layout.split(dstFirst, count)) {
+        D3D11_BOX box = {};
+        box.left   = (UINT)((srcFirst + piece.offset) * stride);
+        box.right  = box.left + piece.count * stride;
+        box.bottom = 1;
+        box.back   = 1;
+        ctx->CopySubresourceRegion(m_pages[piece.page].buf, 0, piece.local * stride, 0, 0, src, 0, &box);
+    }
+}
+
+void PagedBuffer::copyFrom(ID3D11DeviceContext* ctx, uint64_t dstFirst,
+                           const PagedBuffer& src, uint64_t srcFirst, uint64_t count) const {
+    const uint32_t stride = m_layout.stride();
+    if (src.m_layout.stride() != stride) return;
+    for (const PageLayout::Piece& dst : m_layout.split(dstFirst, count)) {
+        for (const PageLayout::Piece& piece : src.m_layout.split(srcFirst + dst.offset, dst.count)) {
+            D3D11_BOX box = {};
+            box.left   = piece.local * stride;
+            box.right  = box.left + piece.count * stride;
+            box.bottom = 1;
+            box.back   = 1;
+            ctx->CopySubresourceRegion(m_pages[dst.page].buf, 0, (UINT)((dst.local + piece.offset) * stride), 0, 0,
+                                       src.m_pages[piece.page].buf, 0, &box);
+        }
+    }
+}
+
+bool PagedBuffer::read(ID3D11Device* device, ID3D11DeviceContext* ctx,
+                       uint64_t first, uint64_t count, void* dst) const {
+    if (first + count > m_capacity) return false;
+    const uint32_t stride = m_layout.stride();
+    for (const PageLayout::Piece& piece : m_layout.split(first, count)) {
+        ID3D11Buffer* staging = nullptr;
+        D3D11_BUFFER_DESC bd = {};
+        bd.ByteWidth      = piece.count * stride;
+        bd.Usage          = D3D11_USAGE_STAGING;
+        bd.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+        if (FAILED(device->CreateBuffer(&bd, nullptr, &staging))) {
+            MGlobal::displayError(MString("[GaussianSplat] Staging buffer failed for '") +
+                                  m_name.c_str() + "' page " + piece.page + ".");
+            return false;
+        }
+
+        D3D11_BOX box = {};
+        box.left   = piece.local * stride;
+        box.right  = box.left + bd.ByteWidth;
+        box.bottom = 1;
+        box.back   = 1;
+        ctx->CopySubresourceRegion(staging, 0, 0, 0, 0, m_pages[piece.page].buf, 0, &box);
+
+        D3D11_MAPPED_SUBRESOURCE mapped;
+        if (FAILED(ctx->Map(staging, 0, D3D11_MAP_READ, 0, &mapped))) {
+            SAFE_RELEASE(staging);
+            return false;
+        }
+        std::memcpy(static_cast<char*>(dst) + piece.offset * stride, mapped.pData, bd.ByteWidth);
+        ctx->Unmap(staging, 0);
+        SAFE_RELEASE(staging);
+    }
+    return true;
+}
+
+#undef SAFE_RELEASE
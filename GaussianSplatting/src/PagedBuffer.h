@@ -0,0 +1,85 @@
+#pragma once
+#include <d3d11.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "PageLayout.h"
+
+// ===========================================================================
+// PagedBuffer  --  one logical structured buffer stored as PageLayout pages,
+// each its own ID3D11Buffer with an SRV (and a UAV when asked for).
+//
+// Shaders declare the column as an array of layout().maxPages() buffers and
+// pick the page with element >> kPageShift; srvs() fills that array. Growing
+// keeps the full pages as they are, replaces the last partial page with a
+// larger one (its contents copied on the GPU) and appends new pages, so a
+// buffer far beyond one ByteWidth grows without a full copy.
+// ===========================================================================
+class PagedBuffer {
+public:
+    enum Flags : unsigned {
+        kUnorderedAccess = 1,   // also create a UAV per page
+        kZeroed          = 2,   // new elements start at zero
+    };
+
+    PagedBuffer() = default;
+    ~PagedBuffer() { release(); }
+    PagedBuffer(const PagedBuffer&)            = delete;
+    PagedBuffer& operator=(const PagedBuffer&) = delete;
+
+    // Releases the pages and sets up an empty buffer; `name` is for errors
+    void init(const PageLayout& layout, const char* name, unsigned flags = 0);
+    void release();
+
+    // Grows to hold `elements` (smaller values are ignored). `ctx` may be
+    // null while the buffer is empty. Fails, leaving the current pages, when
+    // the layout cannot hold that many or a page cannot be created.
+    bool resize(ID3D11Device* device, ID3D11DeviceContext* ctx, uint64_t elements);
+
+    const PageLayout& layout()    const { return m_layout; }
+    uint64_t          capacity()  const { return m_capacity; }
+    uint32_t          pageCount() const { return (uint32_t)m_pages.size(); }
+    bool              empty()     const { return m_pages.empty(); }
+    uint64_t          bytes()     const { return m_capacity * m_layout.stride(); }
+
+    ID3D11Buffer*              buf(uint32_t page) const { return page < m_pages.size() ? m_pages[page].buf : nullptr; }
+    ID3D11ShaderResourceView*  srv(uint32_t page) const { return page < m_pages.size() ? m_pages[page].srv : nullptr; }
+    ID3D11UnorderedAccessView* uav(uint32_t page) const { return page < m_pages.size() ? m_pages[page].uav : nullptr; }
+    uint32_t pageElements(uint32_t page) const { return page < m_pages.size() ? m_pages[page].elements : 0; }
+
+    // layout().maxPages() SRVs, null past pageCount()
+    void srvs(ID3D11ShaderResourceView** out) const;
+
+    // Elements [first, first + count) from CPU memory (count elements)
+    void update(ID3D11DeviceContext* ctx, uint64_t first, uint64_t count, const void* src) const;
+    // `count` elements of an unpaged buffer, from element srcFirst, into
+    // elements [dstFirst, dstFirst + count)
+    void copyFrom(ID3D11DeviceContext* ctx, uint64_t dstFirst,
+                  ID3D11Buffer* src, uint64_t srcFirst, uint64_t count) const;
+    // The same from another paged buffer of the same stride; a piece is
+    // copied wherever either side crosses a page boundary
+    void copyFrom(ID3D11DeviceContext* ctx, uint64_t dstFirst,
+                  const PagedBuffer& src, uint64_t srcFirst, uint64_t count) const;
+    // Elements [first, first + count) into CPU memory, through one staging
+    // buffer per page touched. Stalls until the GPU has written them; for
+    // diagnostics and readbacks, not per frame.
+    bool read(ID3D11Device* device, ID3D11DeviceContext* ctx,
+              uint64_t first, uint64_t count, void* dst) const;
+
+private:
+    struct Page {
+        ID3D11Buffer*              buf      = nullptr;
+        ID3D11ShaderResourceView*  srv      = nullptr;
+        ID3D11UnorderedAccessView* uav      = nullptr;
+        uint32_t                   elements = 0;
+    };
+
+    bool createPage(ID3D11Device* device, uint32_t index, uint32_t elements, Page& page) const;
+    static void releasePage(Page& page);
+
+    PageLayout        m_layout;
+    std::string       m_name;
+    unsigned          m_flags    = 0;
+    std::vector<Page> m_pages;
+    uint64_t          m_capacity = 0;
+};
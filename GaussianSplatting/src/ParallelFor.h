@@ -0,0 +1,54 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// ===========================================================================
+// ParallelFor  --  minimal fork/join helper for CPU-side splat processing.
+//
+// [0, count) is cut into chunks of `chunkSize` items that worker threads claim
+// from a shared atomic cursor, so uneven chunks (page faults on a cold
+// mapping, variable-length ASCII lines) balance themselves. The calling
+// thread takes part as worker 0.
+//
+// fn(begin, end, worker) is invoked once per chunk. `worker` is in
+// [0, WorkerCount()) and is stable for the duration of the call, so callers
+// can keep per-worker partial results (bbox, histograms) in a vector sized
+// by WorkerCount() and reduce them afterwards without locking.
+// ===========================================================================
+namespace gs {
+
+inline unsigned WorkerCount() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1u : n;
+}
+
+template <typename Fn>
+void ParallelFor(size_t count, size_t chunkSize, Fn&& fn) {
+    if (count == 0) return;
+    chunkSize = std::max<size_t>(1, chunkSize);
+
+    const size_t   numChunks  = (count + chunkSize - 1) / chunkSize;
+    const unsigned numWorkers = (unsigned)std::min<size_t>(WorkerCount(), numChunks);
+
+    std::atomic<size_t> next{ 0 };
+    auto run = [&](unsigned worker) {
+        for (size_t c = next.fetch_add(1); c < numChunks; c = next.fetch_add(1)) {
+            size_t begin = c * chunkSize;
+            size_t end   = std::min(count, begin + chunkSize);
+            fn(begin, end, worker);
+        }
+    };
+
+    if (numWorkers <= 1) { run(0); return; }
+
+    std::vector<std::thread> threads;
+    threads.reserve(numWorkers - 1);
+    for (unsigned w = 1; w < numWorkers; w++) threads.emplace_back(run, w);
+    run(0);
+    for (auto& t : threads) t.join();
+}
+
+} // namespace gs
@@ -0,0 +1,63 @@
+#pragma once
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ===========================================================================
+// RadixSortPairs  --  stable LSD radix sort of 32-bit keys, with a value
+// array moved along.
+//
+// Each of `passes` passes sorts by the next DigitBits bits, lowest first:
+// every block of `blockRows` keys counts its digits in parallel, a serial
+// digit-major scan turns the counts into each block's output offsets, and
+// the blocks scatter in parallel. Blocks scatter their rows in order, so
+// each pass (and the sort) is stable. Keys must fit in DigitBits * passes
+// bits. Used by SplatReorder (curve keys) and SplatSort (depth keys).
+// ===========================================================================
+namespace gs {
+
+template <int DigitBits, typename Value>
+void RadixSortPairs(std::vector<uint32_t>& keys, std::vector<Value>& values, int passes,
+                    size_t blockRows = 65536)
+{
+    constexpr uint32_t kDigits = 1u << DigitBits;
+    const size_t N = keys.size();
+    if (N < 2) return;
+
+    std::vector<uint32_t> keyB(N);
+    std::vector<Value>    valB(N);
+    const size_t numBlocks = (N + blockRows - 1) / blockRows;
+    std::vector<uint32_t> offsets(numBlocks * kDigits);
+
+    for (int shift = 0; shift < passes * DigitBits; shift += DigitBits) {
+        ParallelFor(N, blockRows, [&](size_t begin, size_t end, unsigned) {
+            uint32_t* count = &offsets[(begin / blockRows) * kDigits];
+            std::fill(count, count + kDigits, 0u);
+            for (size_t i = begin; i < end; ++i) count[(keys[i] >> shift) & (kDigits - 1)]++;
+        });
+
+        uint32_t sum = 0;
+        for (uint32_t digit = 0; digit < kDigits; ++digit)
+            for (size_t b = 0; b < numBlocks; ++b) {
+                uint32_t c = offsets[b * kDigits + digit];
+                offsets[b * kDigits + digit] = sum;
+                sum += c;
+            }
+
+        ParallelFor(N, blockRows, [&](size_t begin, size_t end, unsigned) {
+            uint32_t* next = &offsets[(begin / blockRows) * kDigits];
+            for (size_t i = begin; i < end; ++i) {
+                uint32_t dst = next[(keys[i] >> shift) & (kDigits - 1)]++;
+                keyB[dst] = keys[i];
+                valB[dst] = values[i];
+            }
+        });
+        keys.swap(keyB);
+        values.swap(valB);
+    }
+}
+
+} // namespace gs
@@ -0,0 +1,108 @@
+#include "RangeAllocator.h"
+
+#include <algorithm>
+#include <iterator>
+
+uint32_t RangeAllocator::allocate(uint32_t size) {
+    if (size == 0) return kInvalid;
+    for (auto it = m_free.begin(); it != m_free.end(); ++it) {
+        if (it->second < size) continue;
+        uint32_t offset = it->first;
+        uint32_t rest   = it->second - size;
+        m_free.erase(it);
+        if (rest) m_free.emplace(offset + size, rest);
+        m_ranges.emplace(offset, size);
+        m_used += size;
+        return offset;
+    }
+    return kInvalid;
+}
+
+uint32_t RangeAllocator::free(uint32_t offset) {
+    auto r = m_ranges.find(offset);
+    if (r == m_ranges.end()) return 0;
+    uint32_t size = r->second;
+    m_ranges.erase(r);
+    m_used -= size;
+
+    // Merge with the free ranges right after and right before
+    uint32_t start = offset, end = offset + size;
+    auto next = m_free.lower_bound(end);
+    if (next != m_free.end() && next->first == end) {
+        end += next->second;
+        next = m_free.erase(next);
+    }
+    if (next != m_free.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == start) {
+            start = prev->first;
+            m_free.erase(prev);
+        }
+    }
+    m_free.emplace(start, end - start);
+    return size;
+}
+
+void RangeAllocator::grow(uint32_t newCapacity) {
+    if (newCapacity <= m_capacity) return;
+    uint32_t start = m_capacity;
+    if (!m_free.empty()) {
+        auto last = std::prev(m_free.end());
+        if (last->first + last->second == m_capacity) {
+            start = last->first;
+            m_free.erase(last);
+        }
+    }
+    m_free.emplace(start, newCapacity - start);
+    m_capacity = newCapacity;
+}
+
+void RangeAllocator::reset(uint32_t capacity) {
+    m_free.clear();
+    m_ranges.clear();
+    m_used     = 0;
+    m_capacity = capacity;
+    if (capacity) m_free.emplace(0u, capacity);
+}
+
+uint32_t RangeAllocator::largestFree() const {
+    uint32_t best = 0;
+    for (const auto& f : m_free) best = std::max(best, f.second);
+    return best;
+}
+
+uint32_t RangeAllocator::tailFree() const {
+    if (m_free.empty()) return 0;
+    auto last = std::prev(m_free.end());
+    return last->first + last->second == m_capacity ? last->second : 0;
+}
+
+uint32_t RangeAllocator::capacityToFit(uint32_t size) const {
+    if (largestFree() >= size) return m_capacity;
+    uint64_t needed = (uint64_t)m_capacity - tailFree() + size;
+    return (uint32_t)std::min<uint64_t>(needed, kInvalid - 1);
+}
+
+bool RangeAllocator::validate() const {
+    // Walk both maps in offset order; every unit must be covered once
+    auto f = m_free.begin();
+    auto r = m_ranges.begin();
+    uint32_t pos = 0, used = 0;
+    bool lastWasFree = false;
+    while (f != m_free.end() || r != m_ranges.end()) {
+        bool takeFree = r == m_ranges.end() || (f != m_free.end() && f->first < r->first);
+        auto& it      = takeFree ? f : r;
+        if (it->first != pos || it->second == 0) return false;
+        if (takeFree && lastWasFree) return false;   // should have been merged
+        pos += it->second;
+        if (!takeFree) used += it->second;
+        lastWasFree = takeFree;
+        ++it;
+    }
+    return pos == m_capacity && used == m_used;
+}
+
+uint32_t RangeAllocator::grownCapacity(uint32_t current, uint32_t needed) {
+    uint64_t grown = (uint64_t)(current * kGrowthFactor);
+    return (uint32_t)std::min<uint64_t>(std::max<uint64_t>(grown, needed), kInvalid - 1);
+}
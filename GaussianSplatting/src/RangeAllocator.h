@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+// ===========================================================================
+// RangeAllocator  --  first-fit free-list sub-allocator over [0, capacity).
+//
+// Hands out contiguous ranges of abstract units (rows, SH groups, chunks)
+// inside one large buffer. Freed ranges are merged with their free
+// neighbours, so the free list never holds two adjacent ranges. grow()
+// extends the space at the end without moving existing ranges; callers
+// grow the backing buffer to match (grownCapacity() gives the geometric
+// step). No GPU dependency: gsPoolCheck exercises it against a brute-force
+// model.
+// ===========================================================================
+class RangeAllocator {
+public:
+    static constexpr uint32_t kInvalid = 0xFFFFFFFFu;
+
+    explicit RangeAllocator(uint32_t capacity = 0) { reset(capacity); }
+
+    // Offset of a new range of `size` units, or kInvalid when size is 0 or
+    // no free range is large enough.
+    uint32_t allocate(uint32_t size);
+    // Releases a range returned by allocate(); unknown offsets are ignored.
+    // Returns the size that was freed (0 for an unknown offset).
+    uint32_t free(uint32_t offset);
+    // Extends the space to newCapacity; smaller values are ignored.
+    void     grow(uint32_t newCapacity);
+    // Drops every range and sets the capacity.
+    void     reset(uint32_t capacity);
+
+    uint32_t capacity()    const { return m_capacity; }
+    uint32_t used()        const { return m_used; }
+    size_t   rangeCount()  const { return m_ranges.size(); }
+    size_t   freeCount()   const { return m_free.size(); }
+    uint32_t largestFree() const;
+    // Free units at the end of the space (merged with whatever grow() adds)
+    uint32_t tailFree()    const;
+    // Capacity after the smallest grow() that makes room for `size` units
+    uint32_t capacityToFit(uint32_t size) const;
+
+    // Internal consistency: ranges and free ranges are disjoint, cover
+    // [0, capacity) exactly, and no two free ranges touch.
+    bool validate() const;
+
+    // At least `needed`, and at least kGrowthFactor times `current`
+    static constexpr double kGrowthFactor = 1.5;
+    static uint32_t grownCapacity(uint32_t current, uint32_t needed);
+
+private:
+    uint32_t m_capacity = 0;
+    uint32_t m_used     = 0;
+    std::map<uint32_t, uint32_t> m_free;     // offset -> size
+    std::map<uint32_t, uint32_t> m_ranges;   // allocated: offset -> size
+};
@@ -0,0 +1,200 @@
+#include "SplatBVH.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <cmath>
+
+// ===========================================================================
+// CullFrustum
+// ===========================================================================
+CullFrustum::CullFrustum(const float worldView[16], const float projMat[16],
+                         const float tanHalfFov[2], float filmWidth, float filmHeight)
+{
+    // w = c * -z only for a perspective projection; anything else is kept
+    const float* P = projMat;
+    if (P[3] != 0.f || P[7] != 0.f || P[15] != 0.f || !(P[11] < 0.f)) return;
+    if (filmWidth <= 0.f || filmHeight <= 0.f || tanHalfFov[0] <= 0.f || tanHalfFov[1] <= 0.f) return;
+    const float c = -P[11];
+
+    const float focalX = 0.5f * filmWidth  / tanHalfFov[0];
+    const float focalY = 0.5f * filmHeight / tanHalfFov[1];
+    const float limX = 1.3f * tanHalfFov[0], limY = 1.3f * tanHalfFov[1];
+    const float G = std::sqrt(focalX * focalX * (1.f + limX * limX) + focalY * focalY * (1.f + limY * limY));
+    float wv3 = 0.f, axis = 0.f;
+    for (int r = 0; r < 3; r++) {
+        float row = 0.f;
+        for (int k = 0; k < 3; k++) row += worldView[r * 4 + k] * worldView[r * 4 + k];
+        wv3 += row;
+        axis = std::max(axis, row);
+    }
+    // 1% over the largest scale: compact pools round the scales to fp16
+    const float reach = 6.f * 1.01f * std::sqrt(wv3) * G * c;
+    const float bx = 1.f + 6.f / filmWidth, by = 1.f + 6.f / filmHeight;
+
+    // M = worldView * proj: clip_j = sum_r p_r M[r][j] + M[3][j]
+    float M[16];
+    for (int r = 0; r < 4; r++)
+        for (int j = 0; j < 4; j++)
+            M[r * 4 + j] = worldView[r * 4] * P[j] + worldView[r * 4 + 1] * P[4 + j] +
+                           worldView[r * 4 + 2] * P[8 + j] + worldView[r * 4 + 3] * P[12 + j];
+
+    for (int r = 0; r < 4; r++) {
+        const float x = M[r * 4], y = M[r * 4 + 1], w = M[r * 4 + 3];
+        m_plane[0][r] = worldView[r * 4 + 2];
+        m_plane[1][r] =  x - bx * w;
+        m_plane[2][r] = -x - bx * w;
+        m_plane[3][r] =  y - by * w;
+        m_plane[4][r] = -y - by * w;
+    }
+    m_plane[0][3] += 0.2f;
+    m_reach[1] = m_reach[2] = reach / filmWidth;
+    m_reach[3] = m_reach[4] = reach / filmHeight;
+    m_pxPerUnit = std::max(focalX, focalY) * std::sqrt(axis);
+    m_active    = true;
+}
+
+CullFrustum::Result CullFrustum::test(const float bmin[3], const float bmax[3], float maxScale) const {
+    if (!m_active) return kInside;
+    const float c[3] = { 0.5f * (bmin[0] + bmax[0]), 0.5f * (bmin[1] + bmax[1]), 0.5f * (bmin[2] + bmax[2]) };
+    const float h[3] = { 0.5f * (bmax[0] - bmin[0]), 0.5f * (bmax[1] - bmin[1]), 0.5f * (bmax[2] - bmin[2]) };
+
+    Result result = kInside;
+    for (int k = 0; k < 5; k++) {
+        const float* pl  = m_plane[k];
+        const float  mid = pl[0] * c[0] + pl[1] * c[1] + pl[2] * c[2] + pl[3];
+        const float  ext = std::fabs(pl[0]) * h[0] + std::fabs(pl[1]) * h[1] + std::fabs(pl[2]) * h[2];
+        const float  lo  = mid - ext;
+        if (k == 0 ? lo >= 0.f : lo > m_reach[k] * maxScale) return kOutside;
+        if (mid + ext >= 0.f) result = kIntersects;
+    }
+    return result;
+}
+
+float CullFrustum::screenSize(const float bmin[3], const float bmax[3], float maxScale) const {
+    if (!m_active) return 0.f;
+    float diag = 0.f, nearest = m_plane[0][3];   // largest view z + 0.2 over the box
+    for (int k = 0; k < 3; k++) {
+        diag    += (bmax[k] - bmin[k]) * (bmax[k] - bmin[k]);
+        nearest += std::max(m_plane[0][k] * bmin[k], m_plane[0][k] * bmax[k]);
+    }
+    float depth = std::max(0.2f - nearest, 0.2f);
+    return m_pxPerUnit * (std::sqrt(diag) + 6.f * maxScale) / depth;
+}
+
+// ===========================================================================
+// SplatBVH
+// ===========================================================================
+void SplatBVH::clear() {
+    m_levels.clear();
+    m_rows = 0;
+}
+
+size_t SplatBVH::nodeCount() const {
+    size_t n = 0;
+    for (const std::vector<Node>& level : m_levels) n += level.size();
+    return n;
+}
+
+void SplatBVH::build(const GaussianData& gd, size_t count) {
+    clear();
+    count = std::min(count, gd.count());
+    if (count == 0) return;
+    m_rows = count;
+
+    // Leaves, straight from the columns
+    std::vector<Node> leaves((count + kLeafRows - 1) / kLeafRows);
+    const bool compact = gd.compact();
+    gs::ParallelFor(leaves.size(), 64, [&](size_t begin, size_t end, unsigned) {
+        for (size_t l = begin; l < end; l++) {
+            const size_t first = l * kLeafRows, last = std::min(count, first + kLeafRows);
+            Node  n;
+            float maxLog = -1e30f;
+            for (int k = 0; k < 3; k++) { n.bmin[k] = 1e30f; n.bmax[k] = -1e30f; }
+            n.maxScale = 0.f;
+            for (size_t i = first; i < last; i++) {
+                float p[3];
+                if (compact) {
+                    float ls[3];
+                    gd.position(i, p);
+                    gd.logScale(i, ls);
+                    maxLog = std::max({ maxLog, ls[0], ls[1], ls[2] });
+                } else {
+                    const float* s = &gd.scaleWS[i * 3];
+                    p[0] = gd.positions[i * 3]; p[1] = gd.positions[i * 3 + 1]; p[2] = gd.positions[i * 3 + 2];
+                    n.maxScale = std::max({ n.maxScale, s[0], s[1], s[2] });
+                }
+                for (int k = 0; k < 3; k++) {
+                    n.bmin[k] = std::min(n.bmin[k], p[k]);
+                    n.bmax[k] = std::max(n.bmax[k], p[k]);
+                }
+            }
+            if (compact) n.maxScale = std::exp(maxLog);
+            leaves[l] = n;
+        }
+    });
+    m_levels.push_back(std::move(leaves));
+
+    // Parents of kBranch consecutive nodes, until few enough to be roots
+    while (m_levels.back().size() > kBranch) {
+        const std::vector<Node>& below = m_levels.back();
+        std::vector<Node> level((below.size() + kBranch - 1) / kBranch);
+        for (size_t i = 0; i < level.size(); i++) {
+            Node n = below[i * kBranch];
+            for (size_t c = i * kBranch + 1; c < std::min(below.size(), (i + 1) * kBranch); c++) {
+                for (int k = 0; k < 3; k++) {
+                    n.bmin[k] = std::min(n.bmin[k], below[c].bmin[k]);
+                    n.bmax[k] = std::max(n.bmax[k], below[c].bmax[k]);
+                }
+                n.maxScale = std::max(n.maxScale, below[c].maxScale);
+            }
+            level[i] = n;
+        }
+        m_levels.push_back(std::move(level));
+    }
+}
+
+size_t SplatBVH::cull(const CullFrustum& frustum, uint32_t rows, std::vector<Range>& out) const {
+    const size_t start  = out.size();
+    size_t       tested = 0;
+    if (!m_levels.empty())
+        for (size_t i = 0; i < m_levels.back().size(); i++)
+            visit(frustum, m_levels.size() - 1, i, rows, start, out, tested);
+
+    // Rows the tree does not cover yet are kept
+    if (rows > m_rows) {
+        if (out.size() > start && out.back().first + out.back().count == m_rows)
+            out.back().count = rows - out.back().first;
+        else
+            out.push_back({ (uint32_t)m_rows, rows - (uint32_t)m_rows, 0.f });
+    }
+    return tested;
+}
+
+void SplatBVH::visit(const CullFrustum& frustum, size_t level, size_t index, uint32_t rows,
+                     size_t start, std::vector<Range>& out, size_t& tested) const {
+    uint64_t span = kLeafRows;
+    for (size_t l = 0; l < level; l++) span *= kBranch;
+    const uint64_t first = index * span;
+    const uint64_t limit = std::min<uint64_t>(rows, m_rows);
+    if (first >= limit) return;
+
+    tested++;
+    const Node& n = m_levels[level][index];
+    CullFrustum::Result r = frustum.test(n.bmin, n.bmax, n.maxScale);
+    if (r == CullFrustum::kOutside) return;
+
+    if (r == CullFrustum::kInside || level == 0) {
+        const uint32_t count = (uint32_t)(std::min(first + span, limit) - first);
+        const float    px    = frustum.screenSize(n.bmin, n.bmax, n.maxScale);
+        if (out.size() > start && out.back().first + out.back().count == first) {
+            out.back().count   += count;
+            out.back().screenPx = std::max(out.back().screenPx, px);
+        } else {
+            out.push_back({ (uint32_t)first, count, px });
+        }
+        return;
+    }
+    const std::vector<Node>& below = m_levels[level - 1];
+    for (size_t c = index * kBranch; c < std::min(below.size(), (index + 1) * kBranch); c++)
+        visit(frustum, level - 1, c, rows, start, out, tested);
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include "GaussianData.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ===========================================================================
+// CullFrustum  --  the view test behind instance and chunk culling.
+//
+// The preprocess kernel draws a splat only if its view-space z < -0.2 and
+// its screen rect, centre +- radius pixels, touches the film. With
+// w = c * -z (a perspective projection) the rect test on the right edge
+// reads x <= (1 + 2 r / W) * w in clip space. The radius is
+// ceil(3 sqrt(lambda)), lambda <= |T|^2 s^2 + 0.4 (the 0.3 dilation and the
+// 0.1 the eigenvalue may gain from the 0.01 floor) for T = J * worldView3^T,
+// so r <= 3 s |worldView3| |J| + 3 px, and |J| <= G / -z for the Jacobian
+// at the mean clamped to 1.3 x the FOV. Multiplied through by w, each film
+// edge becomes a plane that is linear in the splat's centre:
+//   x - (1 + 6 / W) * w - 6 s |worldView3| G c / W <= 0
+// Taken back through world * view * projection these are planes in object
+// space, so a box of centres lies past one of them (or behind the near
+// plane) exactly when no splat with scale <= s inside it can be drawn.
+// ===========================================================================
+struct CullFrustum {
+    enum Result { kOutside, kIntersects, kInside };
+
+    CullFrustum() = default;
+    // worldView and projMat row-major (p' = p * M), the camera as
+    // GaussianRenderManager::setFrameData takes it
+    CullFrustum(const float worldView[16], const float projMat[16],
+                const float tanHalfFov[2], float filmWidth, float filmHeight);
+
+    // Centres in [bmin, bmax] (object space) with scales up to maxScale:
+    // kOutside when none can be drawn, kInside when every centre is inside
+    // the frustum, so nothing below the box can be culled either.
+    // Everything is kInside when the projection is not a perspective one.
+    Result test(const float bmin[3], const float bmax[3], float maxScale) const;
+
+    // Estimated screen extent of the splats of such a box, in pixels: its
+    // diagonal plus 3 sigma each side, at its nearest depth
+    float screenSize(const float bmin[3], const float bmax[3], float maxScale) const;
+
+    bool active() const { return m_active; }
+
+private:
+    // Plane 0: view z + 0.2 (outside when >= 0 over the box); planes 1-4:
+    // right, left, top, bottom (outside when > reach * maxScale)
+    float m_plane[5][4] = {};
+    float m_reach[5]    = {};
+    float m_pxPerUnit   = 0.f;   // object units at depth 1 -> pixels
+    bool  m_active      = false;
+};
+
+// ===========================================================================
+// SplatBVH  --  bounding hierarchy over a dataset's rows, for culling inside
+// one instance.
+//
+// Leaves are kLeafRows consecutive rows (the SplatCompact chunks), each with
+// the bbox of its centres and its largest scale; every kBranch consecutive
+// nodes share a parent, up to a handful of roots. The tree is implicit in
+// the row order, so every node covers one contiguous row range and a
+// traversal yields ranges the preprocess dispatch can walk directly. The
+// boxes are only tight when neighbouring rows are near in space, i.e. on
+// datasets reordered along a curve (gaussianSplat.splatOrder, SplatOrder.h);
+// in file order nearly every leaf spans the whole scene and little is culled.
+// ===========================================================================
+class SplatBVH {
+public:
+    static constexpr uint32_t kLeafRows = kCompactChunkSplats;
+    static constexpr uint32_t kBranch   = 4;
+
+    struct Node {
+        float bmin[3], bmax[3];
+        float maxScale;
+    };
+
+    // Rows [first, first + count) that may hold drawn splats; screenPx is
+    // the largest CullFrustum::screenSize of the nodes merged into it
+    struct Range {
+        uint32_t first;
+        uint32_t count;
+        float    screenPx;
+    };
+
+    // Builds over rows [0, count) of a float or compact dataset, on all cores
+    void build(const GaussianData& gd, size_t count);
+    void clear();
+
+    bool   empty()     const { return m_levels.empty(); }
+    size_t rowCount()  const { return m_rows; }
+    size_t nodeCount() const;
+    size_t memoryBytes() const { return nodeCount() * sizeof(Node); }
+
+    // Appends the ranges of rows [0, rows) under `frustum` to `out`
+    // (adjacent ones merged, in row order). Returns the nodes tested.
+    size_t cull(const CullFrustum& frustum, uint32_t rows, std::vector<Range>& out) const;
+
+private:
+    // Emits the rows of node `index` at `level` that survive; ranges from
+    // out[start] on belong to this traversal and may be merged
+    void visit(const CullFrustum& frustum, size_t level, size_t index, uint32_t rows,
+               size_t start, std::vector<Range>& out, size_t& tested) const;
+
+    std::vector<std::vector<Node>> m_levels;   // [0] = leaves, back() = roots
+    size_t                         m_rows = 0;
+};
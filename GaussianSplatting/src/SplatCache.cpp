@@ -0,0 +1,299 @@
+#include "SplatCache.h"
+#include "MappedFile.h"
+#include "ParallelFor.h"
+#include "PLYReader.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <system_error>
+#include <thread>
+
+// ---------------------------------------------------------------------------
+// File layout
+//
+//   CacheHeader | source path | pad | column 0 | pad | column 1 | ...
+//
+// Every column starts on a kAlign boundary and holds count * width floats.
+// ---------------------------------------------------------------------------
+static constexpr char     kMagic[8]      = { 'G', 'S', 'C', 'A', 'C', 'H', 'E', '\0' };
+static constexpr uint32_t kVersion       = 3;
+static constexpr size_t   kAlign         = 64;
+static constexpr size_t   kNumColumns    = 5;
+static constexpr size_t   kCopyChunkRows = 65536;      // rows per worker chunk
+static constexpr size_t   kCopyWaveRows  = 1u << 20;   // rows published per wave
+static constexpr size_t   kHashBlocks    = 64;         // sampled blocks ...
+static constexpr size_t   kHashBlockSize = 64 * 1024;  // ... of this many bytes
+static constexpr size_t   kWriteChunk    = 64u << 20;  // bytes per store() write
+
+struct CacheHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t shDegree;                     // stored in the SH column
+    uint32_t sourceSHDegree;               // carried by the source file
+    uint32_t sampleStride;                 // GaussianData::sampleStride of the rows
+    uint64_t sourceSize;
+    int64_t  sourceMtime;
+    uint64_t contentHash;
+    uint64_t count;
+    uint64_t pathBytes;                    // source path follows the header
+    float    bboxMin[3];
+    float    bboxMax[3];
+    uint64_t columnOffset[kNumColumns];
+};
+
+// Floats per splat of each column, in file order
+static std::array<size_t, kNumColumns> columnWidths(int shDegree) {
+    return { 3, 3, 4, 1, (size_t)shCoeffsForDegree(shDegree) * 3 };
+}
+
+static std::array<std::vector<float>*, kNumColumns> columnsOf(GaussianData& d) {
+    return { &d.positions, &d.scaleWS, &d.rotationWS, &d.opacityRaw, &d.shCoeffs };
+}
+
+static std::array<const std::vector<float>*, kNumColumns> columnsOf(const GaussianData& d) {
+    return { &d.positions, &d.scaleWS, &d.rotationWS, &d.opacityRaw, &d.shCoeffs };
+}
+
+static size_t alignUp(size_t v) { return (v + kAlign - 1) & ~(kAlign - 1); }
+
+static std::atomic<bool>     s_enabled { true };
+static std::atomic<unsigned> s_hits    { 0 };
+static std::atomic<unsigned> s_misses  { 0 };
+
+// ---------------------------------------------------------------------------
+// Source fingerprint
+// ---------------------------------------------------------------------------
+static inline uint64_t mixHash(uint64_t h, uint64_t v) {
+    h ^= v * 0x9E3779B97F4A7C15ull;
+    h  = (h << 31) | (h >> 33);
+    return h * 0xC2B2AE3D27D4EB4Full;
+}
+
+static uint64_t hashBytes(uint64_t h, const char* p, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint64_t v;
+        std::memcpy(&v, p + i, 8);
+        h = mixHash(h, v);
+    }
+    uint64_t tail = 0;
+    std::memcpy(&tail, p + i, n - i);
+    return mixHash(h, tail ^ n);
+}
+
+bool SplatCache::statSource(const std::string& path, SourceKey& key) {
+    std::error_code ec;
+    key.size = (uint64_t)std::filesystem::file_size(path, ec);
+    if (ec) return false;
+    key.mtime = (int64_t)std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+    if (ec) return false;
+    key.hash = 0;
+    return true;
+}
+
+// The hash covers the first and last block plus kHashBlocks evenly spaced
+// ones (the whole file when small), so it costs a few MB of reads
+// regardless of the file size.
+bool SplatCache::sourceKey(const std::string& path, SourceKey& key) {
+    if (!statSource(path, key)) return false;
+
+    MappedFile file;
+    std::string err;
+    if (!file.open(path, err)) return false;
+
+    const size_t size = file.size();
+    uint64_t h = mixHash(0, size);
+    if (size <= (kHashBlocks + 2) * kHashBlockSize) {
+        h = hashBytes(h, file.data(), size);
+    } else {
+        const size_t span = size - kHashBlockSize;
+        for (size_t b = 0; b <= kHashBlocks + 1; ++b)
+            h = hashBytes(h, file.data() + span / (kHashBlocks + 1) * b, kHashBlockSize);
+    }
+    key.hash = h;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// SplatCache
+// ---------------------------------------------------------------------------
+std::string SplatCache::cachePath(const std::string& sourcePath) {
+    return sourcePath + ".gscache";
+}
+
+bool SplatCache::enabled()         { return s_enabled.load(std::memory_order_relaxed); }
+void SplatCache::setEnabled(bool on) { s_enabled.store(on, std::memory_order_relaxed); }
+
+unsigned SplatCache::hits()   { return s_hits.load(std::memory_order_relaxed); }
+unsigned SplatCache::misses() { return s_misses.load(std::memory_order_relaxed); }
+
+void SplatCache::resetStats() {
+    s_hits.store(0, std::memory_order_relaxed);
+    s_misses.store(0, std::memory_order_relaxed);
+}
+
+bool SplatCache::load(const std::string& sourcePath, const SourceKey& key, GaussianData& outData,
+                      PLYReadControl* control)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    auto miss = [&](const char* why) {
+        if (why) fprintf(stderr, "[SplatCache] %s ignored: %s\n", cachePath(sourcePath).c_str(), why);
+        s_misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    };
+
+    MappedFile cache;
+    std::string err;
+    if (!cache.open(cachePath(sourcePath), err)) return miss(nullptr);
+
+    // ---- validate ----
+    CacheHeader h;
+    if (cache.size() < sizeof(h)) return miss("truncated header");
+    std::memcpy(&h, cache.data(), sizeof(h));
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0) return miss("not a splat cache");
+    if (h.version != kVersion || h.shDegree > kMaxSHDegree || h.sourceSHDegree > kMaxSHDegree)
+        return miss("written by a different plugin version");
+
+    // A cache holding more SH than asked for is cut down while copying; one
+    // holding less only serves requests the source file could not exceed.
+    const int requested = control ? std::clamp(control->shDegree, 0, kMaxSHDegree) : kMaxSHDegree;
+    const int degree    = std::min(requested, (int)h.sourceSHDegree);
+    if ((int)h.shDegree < degree) return miss("stored at a lower SH degree");
+    if (h.pathBytes != sourcePath.size() || sizeof(h) + h.pathBytes > cache.size() ||
+        std::memcmp(cache.data() + sizeof(h), sourcePath.data(), sourcePath.size()) != 0)
+        return miss("different source path");
+
+    if (h.sourceSize != key.size || h.sourceMtime != key.mtime || h.contentHash != key.hash)
+        return miss("source file changed");
+
+    const size_t N = (size_t)h.count;
+    const auto srcWidth = columnWidths((int)h.shDegree);
+    const auto dstWidth = columnWidths(degree);
+    for (size_t c = 0; c < kNumColumns; ++c) {
+        const size_t bytes = N * srcWidth[c] * sizeof(float);
+        if (h.columnOffset[c] % kAlign != 0 || h.columnOffset[c] > cache.size() ||
+            cache.size() - h.columnOffset[c] < bytes)
+            return miss("truncated column data");
+    }
+
+    // ---- copy columns ----
+    outData.clear();
+    outData.sourceSHDegree = (int)h.sourceSHDegree;
+    outData.shDegree       = degree;
+    outData.resize(N);
+    outData.sampleStride   = std::max<size_t>(1, h.sampleStride);
+    if (control) control->rowsTotal.store(N, std::memory_order_relaxed);
+
+    auto dst = columnsOf(outData);
+    const size_t waveRows = control ? kCopyWaveRows : N;
+    for (size_t w0 = 0; w0 < N && !(control && control->cancelled()); w0 += waveRows) {
+        const size_t w1 = std::min(N, w0 + waveRows);
+        gs::ParallelFor(w1 - w0, kCopyChunkRows, [&](size_t begin, size_t end, unsigned) {
+            for (size_t c = 0; c < kNumColumns; ++c) {
+                const size_t sw  = srcWidth[c], dw = dstWidth[c];
+                const char*  src = cache.data() + h.columnOffset[c] + (w0 + begin) * sw * sizeof(float);
+                float*       out = dst[c]->data() + (w0 + begin) * dw;
+                if (sw == dw) {
+                    std::memcpy(out, src, (end - begin) * sw * sizeof(float));
+                } else {
+                    for (size_t i = 0; i < end - begin; ++i)   // leading SH groups only
+                        std::memcpy(out + i * dw, src + i * sw * sizeof(float), dw * sizeof(float));
+                }
+            }
+            if (control) control->rowsDone.fetch_add(end - begin, std::memory_order_relaxed);
+        });
+        if (control && !control->cancelled()) control->publish(w1);
+    }
+    std::memcpy(outData.bboxMin, h.bboxMin, sizeof(h.bboxMin));
+    std::memcpy(outData.bboxMax, h.bboxMax, sizeof(h.bboxMax));
+
+    s_hits.fetch_add(1, std::memory_order_relaxed);
+    double ms = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - t0).count();
+    fprintf(stderr, "[SplatCache] hit: %s (%zu splats, %.1f MB) in %.1f ms\n",
+            sourcePath.c_str(), N, cache.size() / (1024.0 * 1024.0), ms);
+    return true;
+}
+
+bool SplatCache::store(const std::string& sourcePath, const SourceKey& key, const GaussianData& data,
+                       std::string& errorMsg, const PLYReadControl* control)
+{
+    CacheHeader h = {};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version          = kVersion;
+    h.shDegree         = (uint32_t)data.shDegree;
+    h.sourceSHDegree   = (uint32_t)data.sourceSHDegree;
+    h.sampleStride     = (uint32_t)data.sampleStride;
+    h.sourceSize       = key.size;
+    h.sourceMtime      = key.mtime;
+    h.contentHash      = key.hash;
+    h.count            = data.count();
+    h.pathBytes        = sourcePath.size();
+    std::memcpy(h.bboxMin, data.bboxMin, sizeof(h.bboxMin));
+    std::memcpy(h.bboxMax, data.bboxMax, sizeof(h.bboxMax));
+
+    auto src = columnsOf(data);
+    size_t offset = alignUp(sizeof(h) + sourcePath.size());
+    for (size_t c = 0; c < kNumColumns; ++c) {
+        h.columnOffset[c] = offset;
+        offset = alignUp(offset + src[c]->size() * sizeof(float));
+    }
+
+    const std::string finalPath = cachePath(sourcePath);
+    // Per-thread temporary name: two nodes may finish the same file at once
+    const std::string tmpPath   = finalPath + ".tmp" +
+        std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            errorMsg = "Cannot write: " + tmpPath;
+            return false;
+        }
+        static const char kZeros[kAlign] = {};
+        size_t written = 0;
+        auto cancelled = [&] { return control && control->cancelled(); };
+        // Column data goes out in kWriteChunk pieces, so a cancel is seen
+        // within one chunk rather than after a multi-GB column
+        auto put = [&](const void* p, size_t n) {
+            const char* bytes = static_cast<const char*>(p);
+            for (size_t done = 0; done < n && out && !cancelled(); done += kWriteChunk)
+                out.write(bytes + done, (std::streamsize)std::min(kWriteChunk, n - done));
+            written += n;
+        };
+        auto padTo = [&](size_t pos) { put(kZeros, pos - written); };
+
+        put(&h, sizeof(h));
+        put(sourcePath.data(), sourcePath.size());
+        for (size_t c = 0; c < kNumColumns; ++c) {
+            padTo((size_t)h.columnOffset[c]);
+            put(src[c]->data(), src[c]->size() * sizeof(float));
+        }
+        padTo(offset);
+        if (!out || cancelled()) {
+            out.close();
+            std::error_code ec;
+            std::filesystem::remove(tmpPath, ec);
+            errorMsg = cancelled() ? "Write cancelled: " + tmpPath : "Write failed: " + tmpPath;
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, finalPath, ec);
+    if (ec) {
+        std::filesystem::remove(tmpPath, ec);
+        errorMsg = "Cannot replace: " + finalPath;
+        return false;
+    }
+    fprintf(stderr, "[SplatCache] wrote %s (%.1f MB)\n",
+            finalPath.c_str(), offset / (1024.0 * 1024.0));
+    return true;
+}
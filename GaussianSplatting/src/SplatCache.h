@@ -0,0 +1,69 @@
+#pragma once
+#include "GaussianData.h"
+
+#include <cstdint>
+#include <string>
+
+struct PLYReadControl;
+
+// ===========================================================================
+// SplatCache  --  sidecar cache of decoded splat columns.
+//
+// After a PLY file has been decoded, its finished GaussianData columns
+// (scale already exp'd, quaternions normalised, SH interleaved -- i.e. the
+// exact arrays SplatDataset uploads) are written next to it as
+// "<file>.gscache", each column 64-byte aligned. Re-opening the file maps
+// the cache and copies the columns straight out, skipping parsing and every
+// per-splat transform.
+//
+// A cache is only used if it matches the source path, size, modification
+// time and a content hash sampled from the source (header, tail and evenly
+// spaced blocks), so a file rewritten in place is not served stale data.
+// The loader fingerprints the source once (sourceKey) and hands the same
+// key to load() and, on a miss, to store().
+// ===========================================================================
+class SplatCache {
+public:
+    // Identity of a source file's contents
+    struct SourceKey {
+        uint64_t size  = 0;
+        int64_t  mtime = 0;
+        uint64_t hash  = 0;
+    };
+
+    static std::string cachePath(const std::string& sourcePath);
+
+    // Size and mtime from the file system only (hash left 0): two stats, no
+    // reads, cheap enough for the main thread. False if the file is missing.
+    static bool statSource(const std::string& path, SourceKey& key);
+
+    // statSource plus the sampled content hash; a few MB of reads
+    // regardless of the file size. False if unreadable.
+    static bool sourceKey(const std::string& path, SourceKey& key);
+
+    // Fills outData from a cache of sourcePath written for `key` (from
+    // sourceKey) and returns true (hit). Returns false without touching
+    // outData on a miss. With a control the rows are published like
+    // PLYReader::read and control->shDegree caps the SH degree copied out;
+    // a cancelled copy still returns true with control->cancelled() set.
+    static bool load(const std::string& sourcePath, const SourceKey& key, GaussianData& outData,
+                     PLYReadControl* control = nullptr);
+
+    // Writes the cache for sourcePath, stamped with `key`. Take the key
+    // before reading the source: a file rewritten during the read then
+    // leaves a cache that no longer matches it, rather than one that does.
+    // The file is written under a temporary name and renamed, so a
+    // concurrent load never sees a partial cache. With a control, a cancel
+    // stops the write and removes the partial file.
+    static bool store(const std::string& sourcePath, const SourceKey& key, const GaussianData& data,
+                      std::string& errorMsg, const PLYReadControl* control = nullptr);
+
+    // When disabled, PLYLoadJob neither reads nor writes caches.
+    static bool enabled();
+    static void setEnabled(bool on);
+
+    // Process-wide load() outcome counters (gsCacheStats).
+    static unsigned hits();
+    static unsigned misses();
+    static void     resetStats();
+};
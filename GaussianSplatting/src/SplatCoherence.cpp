@@ -0,0 +1,143 @@
+#include "SplatCoherence.h"
+#include "SplatSort.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+static constexpr uint32_t kNoRank = 0xFFFFFFFFu;
+
+// ===========================================================================
+// Fingerprint
+// ===========================================================================
+uint64_t SortCoherence::hashBytes(const void* data, size_t bytes, uint64_t seed) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < bytes; ++i) {
+        seed ^= p[i];
+        seed *= 0x100000001b3ull;
+    }
+    return seed;
+}
+
+// Eye position and view direction (the view's +z axis, pointing back) of a
+// row-major view matrix: its columns are the camera axes in world space
+static void cameraOf(const float v[16], float eye[3], float back[3]) {
+    for (int k = 0; k < 3; ++k) {
+        eye[k]  = -(v[12] * v[k * 4] + v[13] * v[k * 4 + 1] + v[14] * v[k * 4 + 2]);
+        back[k] = v[k * 4 + 2];
+    }
+}
+
+SortCoherence::Mode SortCoherence::classify(const SortFrame& prev, const SortFrame& cur) {
+    if (!prev.valid || !cur.valid || prev.sceneHash != cur.sceneHash) return kFullSort;
+    if (std::memcmp(prev.viewMat, cur.viewMat, sizeof(cur.viewMat)) == 0) return kReuse;
+
+    // Roll about the view direction leaves every depth as it was, so only
+    // the direction and the eye count
+    float eyeA[3], backA[3], eyeB[3], backB[3];
+    cameraOf(prev.viewMat, eyeA, backA);
+    cameraOf(cur.viewMat, eyeB, backB);
+    float dot = 0.f, lenA = 0.f, lenB = 0.f, move = 0.f;
+    for (int k = 0; k < 3; ++k) {
+        dot  += backA[k] * backB[k];
+        lenA += backA[k] * backA[k];
+        lenB += backB[k] * backB[k];
+        move += (eyeB[k] - eyeA[k]) * (eyeB[k] - eyeA[k]);
+    }
+    float cosTurn = dot / std::max(std::sqrt(lenA * lenB), 1e-12f);
+    if (cosTurn < std::cos(kMaxTurn)) return kFullSort;
+    if (std::sqrt(move) > kMaxMove * cur.sceneRadius) return kFullSort;
+    return kIncremental;
+}
+
+// ===========================================================================
+// Fix-up: as FixupKernel. Each window is sorted on its own (in parallel
+// here, one group each on the GPU), equal keys kept in the order they came
+// in, so both give the same result.
+// ===========================================================================
+bool SortCoherence::fixup(std::vector<uint32_t>& keys, std::vector<uint32_t>& values) {
+    const size_t n = keys.size();
+    for (uint32_t round = 0; round < kFixupRounds; ++round) {
+        const size_t offset     = (round & 1) ? kWindow / 2 : 0;
+        const size_t numWindows = n > offset ? (n - offset + kWindow - 1) / kWindow : 0;
+        gs::ParallelFor(numWindows, 1, [&](size_t begin, size_t end, unsigned) {
+            std::vector<uint64_t> entries;
+            for (size_t w = begin; w < end; ++w) {
+                const size_t base = offset + w * kWindow;
+                const size_t len  = std::min<size_t>(kWindow, n - base);
+                if (std::is_sorted(keys.begin() + base, keys.begin() + base + len)) continue;
+
+                // Key above, position below: a plain sort of these is stable
+                entries.resize(len);
+                for (size_t i = 0; i < len; ++i)
+                    entries[i] = (uint64_t(keys[base + i]) << 32) | uint32_t(i);
+                std::sort(entries.begin(), entries.end());
+                std::vector<uint32_t> moved(len);
+                for (size_t i = 0; i < len; ++i) {
+                    moved[i]        = values[base + uint32_t(entries[i])];
+                    keys[base + i]  = uint32_t(entries[i] >> 32);
+                }
+                std::copy(moved.begin(), moved.end(), values.begin() + base);
+            }
+        });
+    }
+    return std::is_sorted(keys.begin(), keys.end());
+}
+
+// ===========================================================================
+// Incremental sort: as the Coherence{Mark,Seed,Entrants,Fixup,Check,Merge}
+// kernels in radix_sort.hlsl
+// ===========================================================================
+bool SortCoherence::incrementalSort(const std::vector<uint32_t>& prevOrder, uint32_t slotCount,
+                                    std::vector<uint32_t>& keys, std::vector<uint32_t>& slots,
+                                    int passes) {
+    const size_t n = keys.size();
+
+    // Survivors at their last rank (holes where a slot is gone), entrants
+    // after them in slot order
+    std::vector<uint32_t> rank(slotCount, kNoRank);
+    for (size_t r = 0; r < prevOrder.size(); ++r) rank[prevOrder[r]] = (uint32_t)r;
+    std::vector<uint32_t> seedKeys(prevOrder.size()), seedSlots(prevOrder.size(), kNoRank);
+    std::vector<uint32_t> entrantKeys, entrantSlots;
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t r = rank[slots[i]];
+        if (r != kNoRank) {
+            seedKeys[r]  = keys[i];
+            seedSlots[r] = slots[i];
+        } else {
+            entrantKeys.push_back(keys[i]);
+            entrantSlots.push_back(slots[i]);
+        }
+    }
+    std::vector<uint32_t> survKeys, survSlots;
+    survKeys.reserve(n - entrantKeys.size());
+    survSlots.reserve(n - entrantKeys.size());
+    for (size_t r = 0; r < seedSlots.size(); ++r) {
+        if (seedSlots[r] == kNoRank) continue;
+        survKeys.push_back(seedKeys[r]);
+        survSlots.push_back(seedSlots[r]);
+    }
+
+    if (!fixup(survKeys, survSlots) || entrantKeys.size() > kMaxEntrants) {
+        SplatSort::onesweep(keys, slots, passes);
+        return false;
+    }
+
+    // Entrants sorted stably, then merged: survivors first on equal keys
+    std::vector<uint32_t> order(entrantKeys.size());
+    for (size_t j = 0; j < order.size(); ++j) order[j] = (uint32_t)j;
+    std::stable_sort(order.begin(), order.end(),
+                     [&](uint32_t a, uint32_t b) { return entrantKeys[a] < entrantKeys[b]; });
+    size_t s = 0, e = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (e == order.size() || (s < survKeys.size() && survKeys[s] <= entrantKeys[order[e]])) {
+            keys[i]  = survKeys[s];
+            slots[i] = survSlots[s++];
+        } else {
+            keys[i]  = entrantKeys[order[e]];
+            slots[i] = entrantSlots[order[e++]];
+        }
+    }
+    return true;
+}
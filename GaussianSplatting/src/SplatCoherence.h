@@ -0,0 +1,79 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// ===========================================================================
+// SortFrame  --  what the last draw list was sorted for.
+//
+// sceneHash covers everything besides the camera that decides which slots
+// are drawn and how their depths compare: the merged slot count, each
+// instance's slot range, node, dataset rows and version, world matrix and
+// deletions, the projection, viewport and sort key precision. The view
+// matrix is kept as is, so a moved camera can be measured against it.
+// ===========================================================================
+struct SortFrame {
+    uint64_t sceneHash   = 0;
+    float    viewMat[16] = {};     // row-major, row vectors (p' = p * M)
+    float    sceneRadius = 0.f;    // half diagonal of the visible world bboxes
+    bool     valid       = false;
+};
+
+// ===========================================================================
+// SortCoherence  --  how much of the last frame's sort a frame can reuse
+// (GaussianRenderManager::render), and the CPU reference of the incremental
+// sort in radix_sort.hlsl.
+//
+// classify(): a frame with another sceneHash sorts from scratch; one whose
+// view matrix is unchanged too (selection refreshes, attribute tweaks,
+// idle redraws) keeps the last draw list and its indirect arguments and
+// sorts nothing. A camera that turned by at most kMaxTurn and moved by at
+// most kMaxMove of the scene radius sorts incrementally: depth order along
+// the view direction changes little, so the last order is a good seed.
+//
+// incrementalSort(): the slots drawn last frame (survivors) are put back in
+// last frame's order with this frame's keys and repaired by sorting windows
+// of kWindow entries, then the same windows shifted by half a window; that
+// is enough when no survivor has to move by more than about half a window,
+// which covers equal-depth runs splitting up under a slightly moved camera
+// (a few hundred entries in a dense million-splat scene). The few
+// slots drawn only now (entrants, at most kMaxEntrants) are sorted and
+// merged in. If the survivors are still out of order afterwards, or there
+// are too many entrants, the list is sorted in full instead, as the GPU
+// decides by itself through its indirect arguments. Either way the keys
+// come out ascending; equal keys keep last frame's order when incremental.
+// ===========================================================================
+class SortCoherence {
+public:
+    enum Mode { kFullSort = 0, kIncremental = 1, kReuse = 2 };
+
+    static constexpr float    kMaxTurn     = 0.002f; // radians between view directions
+    static constexpr float    kMaxMove     = 0.02f;  // of SortFrame::sceneRadius
+    static constexpr uint32_t kWindow      = 2048;   // radix_sort.hlsl TILE_SIZE
+    static constexpr uint32_t kFixupRounds = 2;
+    static constexpr uint32_t kMaxEntrants = kWindow;
+
+    // FNV-1a, chained through `seed`
+    static constexpr uint64_t kHashSeed = 0xcbf29ce484222325ull;
+    static uint64_t hashBytes(const void* data, size_t bytes, uint64_t seed);
+    template <typename T>
+    static uint64_t hash(const T& value, uint64_t seed) {
+        static_assert(std::is_trivially_copyable<T>::value, "hash() takes plain values");
+        return hashBytes(&value, sizeof(T), seed);
+    }
+
+    static Mode classify(const SortFrame& prev, const SortFrame& cur);
+
+    // Sorts this frame's list (`keys`, `slots` as SplatSort::compact makes
+    // it, `passes` as SplatSort::onesweep takes) seeded with `prevOrder`,
+    // the last frame's sorted slots, all below `slotCount`. Returns true if
+    // the fix-up sorted it, false if it fell back to the full sort.
+    static bool incrementalSort(const std::vector<uint32_t>& prevOrder, uint32_t slotCount,
+                                std::vector<uint32_t>& keys, std::vector<uint32_t>& slots,
+                                int passes);
+
+    // kFixupRounds rounds of the windowed fix-up over `keys`, moving `values`
+    // along; returns whether `keys` is ascending afterwards
+    static bool fixup(std::vector<uint32_t>& keys, std::vector<uint32_t>& values);
+};
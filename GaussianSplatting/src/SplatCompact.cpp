@@ -0,0 +1,385 @@
+#include "SplatCompact.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GS_COMPACT_SSE2 1
+#include <emmintrin.h>
+#endif
+
+static constexpr size_t kChunksPerTask = 64;          // 16K splats per worker task
+
+// ===========================================================================
+// Half conversion
+// ===========================================================================
+namespace gs {
+
+uint16_t FloatToHalf(float f) {
+    uint32_t x; std::memcpy(&x, &f, 4);
+    uint32_t sign = (x >> 16) & 0x8000u;
+    uint32_t absx = x & 0x7fffffffu;
+    if (absx >= 0x7f800000u)                       // inf / NaN
+        return (uint16_t)(sign | (absx > 0x7f800000u ? 0x7e00u : 0x7c00u));
+    if (absx >= 0x477ff000u)                       // rounds to >= 65520: inf
+        return (uint16_t)(sign | 0x7c00u);
+    if (absx < 0x38800000u) {                      // below 2^-14: subnormal half
+        // 0.5f has an ulp of 2^-24, the half subnormal step, so the float
+        // add does the rounding.
+        float a; std::memcpy(&a, &absx, 4);
+        a += 0.5f;
+        uint32_t r; std::memcpy(&r, &a, 4);
+        return (uint16_t)(sign | (r - 0x3f000000u));
+    }
+    uint32_t odd = (absx >> 13) & 1u;
+    absx += 0xc8000fffu + odd;                     // rebias exponent, round half to even
+    return (uint16_t)(sign | (absx >> 13));
+}
+
+float HalfToFloat(uint16_t h) {
+    uint32_t sign = (uint32_t)(h & 0x8000u) << 16;
+    uint32_t em   = h & 0x7fffu;
+    uint32_t bits;
+    if (em >= 0x7c00u) {
+        bits = 0x7f800000u | ((em & 0x3ffu) << 13);
+    } else {
+        // Shift into float position and rescale by 2^112 (exponent bias
+        // difference); also handles subnormal halves.
+        uint32_t t = em << 13;
+        float f; std::memcpy(&f, &t, 4);
+        f *= 5.192296858534828e33f;                // 2^112
+        std::memcpy(&bits, &f, 4);
+    }
+    bits |= sign;
+    float out; std::memcpy(&out, &bits, 4);
+    return out;
+}
+
+#ifdef GS_COMPACT_SSE2
+// 4 floats -> 4 halves in the low 16 bits of each lane (sign-extended so
+// _mm_packs_epi32 keeps them intact). Same rounding as FloatToHalf.
+static inline __m128i floatToHalf4(__m128 f) {
+    const __m128i kF16Max      = _mm_set1_epi32((127 + 16) << 23);
+    const __m128i kNaNBit      = _mm_set1_epi32(0x200);
+    const __m128i kInfAsF16    = _mm_set1_epi32(0x7c00);
+    const __m128i kMinNormal   = _mm_set1_epi32((127 - 14) << 23);
+    const __m128i kSubnormMagic= _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+    const __m128i kNormalBias  = _mm_set1_epi32(0xfff - ((127 - 15) << 23));
+
+    __m128  signMask = _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000u));
+    __m128  justSign = _mm_and_ps(signMask, f);
+    __m128  absf     = _mm_xor_ps(f, justSign);
+    __m128i absi     = _mm_castps_si128(absf);
+
+    __m128  isNaN     = _mm_cmpunord_ps(absf, absf);
+    __m128i isRegular = _mm_cmpgt_epi32(kF16Max, absi);
+    __m128i infOrNaN  = _mm_or_si128(_mm_and_si128(_mm_castps_si128(isNaN), kNaNBit), kInfAsF16);
+
+    __m128i isSub   = _mm_cmpgt_epi32(kMinNormal, absi);
+    __m128  sub1    = _mm_add_ps(absf, _mm_castsi128_ps(kSubnormMagic));
+    __m128i sub2    = _mm_sub_epi32(_mm_castps_si128(sub1), kSubnormMagic);
+
+    __m128i mantOdd = _mm_srai_epi32(_mm_slli_epi32(absi, 31 - 13), 31);
+    __m128i round1  = _mm_add_epi32(absi, kNormalBias);
+    __m128i normal  = _mm_srli_epi32(_mm_sub_epi32(round1, mantOdd), 13);
+
+    __m128i nonSpecial = _mm_or_si128(_mm_and_si128(sub2, isSub), _mm_andnot_si128(isSub, normal));
+    __m128i joined     = _mm_or_si128(_mm_and_si128(nonSpecial, isRegular),
+                                      _mm_andnot_si128(isRegular, infOrNaN));
+    return _mm_or_si128(joined, _mm_srai_epi32(_mm_castps_si128(justSign), 16));
+}
+
+// 4 halves (zero-extended in each lane) -> 4 floats
+static inline __m128 halfToFloat4(__m128i h) {
+    const __m128i kNoSign   = _mm_set1_epi32(0x7fff);
+    const __m128  kMagic    = _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23));
+    const __m128i kWasInfNaN= _mm_set1_epi32(0x7bff);
+    const __m128  kExpInfNaN= _mm_castsi128_ps(_mm_set1_epi32(255 << 23));
+
+    __m128i expMant  = _mm_and_si128(kNoSign, h);
+    __m128i justSign = _mm_xor_si128(h, expMant);
+    __m128  scaled   = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(expMant, 13)), kMagic);
+    __m128i infNaN   = _mm_cmpgt_epi32(expMant, kWasInfNaN);
+    __m128  signInf  = _mm_or_ps(_mm_castsi128_ps(_mm_slli_epi32(justSign, 16)),
+                                 _mm_and_ps(_mm_castsi128_ps(infNaN), kExpInfNaN));
+    return _mm_or_ps(scaled, signInf);
+}
+#endif
+
+void FloatToHalf(const float* src, uint16_t* dst, size_t n) {
+    size_t i = 0;
+#ifdef GS_COMPACT_SSE2
+    for (; i + 8 <= n; i += 8) {
+        __m128i lo = floatToHalf4(_mm_loadu_ps(src + i));
+        __m128i hi = floatToHalf4(_mm_loadu_ps(src + i + 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(lo, hi));
+    }
+#endif
+    for (; i < n; ++i) dst[i] = FloatToHalf(src[i]);
+}
+
+void HalfToFloat(const uint16_t* src, float* dst, size_t n) {
+    size_t i = 0;
+#ifdef GS_COMPACT_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 8 <= n; i += 8) {
+        __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_ps(dst + i,     halfToFloat4(_mm_unpacklo_epi16(h, zero)));
+        _mm_storeu_ps(dst + i + 4, halfToFloat4(_mm_unpackhi_epi16(h, zero)));
+    }
+#endif
+    for (; i < n; ++i) dst[i] = HalfToFloat(src[i]);
+}
+
+} // namespace gs
+
+// ===========================================================================
+// Per-splat position / rotation codecs
+// ===========================================================================
+namespace {
+
+inline uint32_t packSnorm8(const float q[4]) {
+#ifdef GS_COMPACT_SSE2
+    __m128i i = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(q), _mm_set1_ps(127.f)));
+    i = _mm_packs_epi32(i, i);
+    i = _mm_packs_epi16(i, i);
+    return (uint32_t)_mm_cvtsi128_si32(i);
+#else
+    uint32_t r = 0;
+    for (int k = 0; k < 4; ++k)
+        r |= (uint32_t)(uint8_t)(int8_t)std::lrint(std::clamp(q[k], -1.f, 1.f) * 127.f) << (8 * k);
+    return r;
+#endif
+}
+
+inline void unpackSnorm8(uint32_t v, float q[4]) {
+    for (int k = 0; k < 4; ++k) q[k] = (float)(int8_t)(v >> (8 * k)) * (1.f / 127.f);
+    float len = std::sqrt(q[0]*q[0] + q[1]*q[1] + q[2]*q[2] + q[3]*q[3]);
+    if (len < 1e-6f) { q[0] = 1.f; q[1] = q[2] = q[3] = 0.f; return; }
+    for (int k = 0; k < 4; ++k) q[k] /= len;
+}
+
+// p is 3 floats; writes 4 u16 (the 4th is 0)
+inline void quantizePosition(const float* p, const float origin[3], const float inv[3], uint16_t* q) {
+#ifdef GS_COMPACT_SSE2
+    __m128 v = _mm_setr_ps(p[0], p[1], p[2], 0.f);
+    __m128 o = _mm_setr_ps(origin[0], origin[1], origin[2], 0.f);
+    __m128 s = _mm_setr_ps(inv[0], inv[1], inv[2], 0.f);
+    __m128 t = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(v, o), s), _mm_set1_ps(0.5f));
+    t = _mm_min_ps(_mm_max_ps(t, _mm_setzero_ps()), _mm_set1_ps(65535.f));
+    // No unsigned 32->16 pack in SSE2: bias into signed range and back
+    __m128i i = _mm_sub_epi32(_mm_cvttps_epi32(t), _mm_set1_epi32(32768));
+    i = _mm_xor_si128(_mm_packs_epi32(i, i), _mm_set1_epi16((short)0x8000));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(q), i);
+#else
+    for (int k = 0; k < 3; ++k)
+        q[k] = (uint16_t)std::clamp((p[k] - origin[k]) * inv[k] + 0.5f, 0.f, 65535.f);
+    q[3] = 0;
+#endif
+}
+
+inline void dequantizePosition(const uint16_t* q, const CompactChunk& c, float* p) {
+    for (int k = 0; k < 3; ++k) p[k] = c.origin[k] + (float)q[k] * c.step[k];
+}
+
+void encodeChunk(const GaussianData& src, CompactColumns& dst, size_t chunk) {
+    const size_t begin = chunk * kCompactChunkSplats;
+    const size_t end   = std::min(src.count(), begin + kCompactChunkSplats);
+    const size_t n     = end - begin;
+
+    // --- positions: chunk box, then unorm16 inside it ---
+    float bmin[3] = {  FLT_MAX,  FLT_MAX,  FLT_MAX };
+    float bmax[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    for (size_t i = begin; i < end; ++i)
+        for (int k = 0; k < 3; ++k) {
+            bmin[k] = std::min(bmin[k], src.positions[i * 3 + k]);
+            bmax[k] = std::max(bmax[k], src.positions[i * 3 + k]);
+        }
+    CompactChunk& c = dst.chunks[chunk];
+    float inv[3];
+    for (int k = 0; k < 3; ++k) {
+        c.origin[k] = bmin[k];
+        c.step[k]   = (bmax[k] - bmin[k]) / 65535.f;
+        inv[k]      = c.step[k] > 0.f ? 1.f / c.step[k] : 0.f;
+    }
+    for (size_t i = begin; i < end; ++i)
+        quantizePosition(&src.positions[i * 3], c.origin, inv, &dst.positionQ[i * 4]);
+
+    // --- scales: log, then fp16 (4 per splat) ---
+    float logs[kCompactChunkSplats * 4];
+    for (size_t i = 0; i < n; ++i) {
+        const float* s = &src.scaleWS[(begin + i) * 3];
+        for (int k = 0; k < 3; ++k) logs[i * 4 + k] = std::log(std::max(s[k], FLT_MIN));
+        logs[i * 4 + 3] = 0.f;
+    }
+    gs::FloatToHalf(logs, &dst.scaleH[begin * 4], n * 4);
+
+    // --- rotations: snorm8 ---
+    for (size_t i = begin; i < end; ++i)
+        dst.rotationQ[i] = packSnorm8(&src.rotationWS[i * 4]);
+
+    // --- SH: fp16; odd-sized rows get one zero pad half ---
+    const size_t shF   = src.shFloats();
+    const size_t halfs = (size_t)compactSHHalfs(src.shDegree);
+    if (halfs == shF) {
+        gs::FloatToHalf(&src.shCoeffs[begin * shF], &dst.shH[begin * halfs], n * shF);
+    } else {
+        for (size_t i = begin; i < end; ++i) {
+            gs::FloatToHalf(&src.shCoeffs[i * shF], &dst.shH[i * halfs], shF);
+            dst.shH[i * halfs + shF] = 0;
+        }
+    }
+}
+
+} // namespace
+
+// ===========================================================================
+// SplatCompact
+// ===========================================================================
+GaussianData SplatCompact::encode(const GaussianData& src) {
+    GaussianData out;
+    out.shDegree       = src.shDegree;
+    out.sourceSHDegree = src.sourceSHDegree;
+    std::memcpy(out.bboxMin, src.bboxMin, sizeof(out.bboxMin));
+    std::memcpy(out.bboxMax, src.bboxMax, sizeof(out.bboxMax));
+    out.opacityRaw  = src.opacityRaw;
+    out.sourceIndex  = src.sourceIndex;
+    out.sampleStride = src.sampleStride;
+
+    const size_t N         = src.count();
+    const size_t numChunks = (N + kCompactChunkSplats - 1) / kCompactChunkSplats;
+    CompactColumns& p = out.packed;
+    p.positionQ.resize(N * 4);
+    p.chunks.resize(numChunks);
+    p.scaleH.resize(N * 4);
+    p.rotationQ.resize(N);
+    p.shH.resize(N * (size_t)compactSHHalfs(src.shDegree));
+
+    gs::ParallelFor(numChunks, kChunksPerTask, [&](size_t begin, size_t end, unsigned) {
+        for (size_t c = begin; c < end; ++c) encodeChunk(src, p, c);
+    });
+    return out;
+}
+
+void SplatCompact::decodeRows(const GaussianData& d, size_t begin, size_t end,
+                              float* positions, float* scaleWS,
+                              float* rotationWS, float* shCoeffs)
+{
+    const CompactColumns& p = d.packed;
+    const size_t shF   = d.shFloats();
+    const size_t halfs = (size_t)compactSHHalfs(d.shDegree);
+    for (size_t i = begin, r = 0; i < end; ++i, ++r) {
+        if (positions)
+            dequantizePosition(&p.positionQ[i * 4], p.chunks[i / kCompactChunkSplats], positions + r * 3);
+        if (scaleWS) {
+            float l[4];
+            gs::HalfToFloat(&p.scaleH[i * 4], l, 4);
+            for (int k = 0; k < 3; ++k) scaleWS[r * 3 + k] = std::exp(l[k]);
+        }
+        if (rotationWS) unpackSnorm8(p.rotationQ[i], rotationWS + r * 4);
+    }
+    if (!shCoeffs) return;
+    if (halfs == shF) {
+        gs::HalfToFloat(&p.shH[begin * halfs], shCoeffs, (end - begin) * shF);
+    } else {
+        for (size_t i = begin, r = 0; i < end; ++i, ++r)
+            gs::HalfToFloat(&p.shH[i * halfs], shCoeffs + r * shF, shF);
+    }
+}
+
+SplatCompact::ErrorReport SplatCompact::measureError(const GaussianData& ref, const GaussianData& packed) {
+    ErrorReport total;
+    if (ref.count() != packed.count() || ref.shDegree != packed.shDegree || !packed.compact()) {
+        total.violations = (size_t)-1;
+        return total;
+    }
+
+    auto track = [](float err, float bound, float& maxErr, float& maxRatio, size_t& violations) {
+        maxErr   = std::max(maxErr, err);
+        maxRatio = std::max(maxRatio, bound > 0.f ? err / bound : (err > 0.f ? INFINITY : 0.f));
+        if (!(err <= bound)) violations++;
+    };
+    // fp16: half an ulp of the 11-bit significand, or of the subnormal step
+    auto halfBound = [](float x) { return std::fabs(x) * 0x1p-11f + 0x1p-25f; };
+
+    const size_t shF = ref.shFloats();
+    std::vector<ErrorReport> parts(gs::WorkerCount());
+    gs::ParallelFor(ref.count(), 16384, [&](size_t begin, size_t end, unsigned worker) {
+        ErrorReport& r = parts[worker];
+        std::vector<float> sh(shF);
+        for (size_t i = begin; i < end; ++i) {
+            float pos[3], rot[4], lsRef[3], lsPacked[3];
+            packed.position(i, pos);
+            const CompactChunk& c = packed.packed.chunks[i / kCompactChunkSplats];
+            for (int k = 0; k < 3; ++k) {
+                float extent = std::fabs(c.origin[k]) + 65535.f * c.step[k];
+                float bound  = 0.5f * c.step[k] + extent * 0x1p-22f;
+                track(std::fabs(pos[k] - ref.positions[i * 3 + k]), bound,
+                      r.position, r.positionRatio, r.violations);
+            }
+
+            ref.logScale(i, lsRef);
+            packed.logScale(i, lsPacked);
+            for (int k = 0; k < 3; ++k)
+                track(std::fabs(lsPacked[k] - lsRef[k]), halfBound(lsRef[k]),
+                      r.logScale, r.logScaleRatio, r.violations);
+
+            packed.rotation(i, rot);
+            for (int k = 0; k < 4; ++k)
+                track(std::fabs(rot[k] - ref.rotationWS[i * 4 + k]), kRotationBound,
+                      r.rotation, r.rotationRatio, r.violations);
+
+            packed.shRow(i, sh.data());
+            for (size_t k = 0; k < shF; ++k) {
+                float x = ref.shCoeffs[i * shF + k];
+                track(std::fabs(sh[k] - x), halfBound(x), r.sh, r.shRatio, r.violations);
+            }
+        }
+    });
+
+    for (const ErrorReport& r : parts) {
+        total.position      = std::max(total.position, r.position);
+        total.logScale      = std::max(total.logScale, r.logScale);
+        total.rotation      = std::max(total.rotation, r.rotation);
+        total.sh            = std::max(total.sh, r.sh);
+        total.positionRatio = std::max(total.positionRatio, r.positionRatio);
+        total.logScaleRatio = std::max(total.logScaleRatio, r.logScaleRatio);
+        total.rotationRatio = std::max(total.rotationRatio, r.rotationRatio);
+        total.shRatio       = std::max(total.shRatio, r.shRatio);
+        total.violations   += r.violations;
+    }
+    return total;
+}
+
+// ===========================================================================
+// GaussianData per-row accessors (float or compact)
+// ===========================================================================
+void GaussianData::position(size_t i, float out[3]) const {
+    if (compact()) {
+        dequantizePosition(&packed.positionQ[i * 4], packed.chunks[i / kCompactChunkSplats], out);
+        return;
+    }
+    std::memcpy(out, &positions[i * 3], 3 * sizeof(float));
+}
+
+void GaussianData::rotation(size_t i, float out[4]) const {
+    if (compact()) { unpackSnorm8(packed.rotationQ[i], out); return; }
+    std::memcpy(out, &rotationWS[i * 4], 4 * sizeof(float));
+}
+
+void GaussianData::shRow(size_t i, float* out) const {
+    if (compact()) { SplatCompact::decodeRows(*this, i, i + 1, nullptr, nullptr, nullptr, out); return; }
+    std::memcpy(out, &shCoeffs[i * shFloats()], shFloats() * sizeof(float));
+}
+
+size_t GaussianData::memoryBytes() const {
+    return (positions.size() + scaleWS.size() + rotationWS.size() +
+            opacityRaw.size() + shCoeffs.size()) * sizeof(float) +
+           (packed.positionQ.size() + packed.scaleH.size() + packed.shH.size()) * sizeof(uint16_t) +
+           (packed.rotationQ.size() + sourceIndex.size()) * sizeof(uint32_t) +
+           packed.chunks.size() * sizeof(CompactChunk);
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include "GaussianData.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// ===========================================================================
+// SplatCompact  --  compact storage mode for splat attributes.
+//
+//   position   3 x unorm16 relative to its chunk's box             8 B
+//   scale      3 x fp16 log-scale                                  8 B
+//   rotation   4 x snorm8 quaternion                               4 B
+//   opacity    float logit, unchanged                              4 B
+//   SH         fp16, compactSHHalfs(shDegree) per splat       8 .. 96 B
+//
+// That is ~120 B per splat at SH degree 3 (236 B as float32) and 32 B at
+// degree 0 (56 B). The same bytes are uploaded to the GPU.
+//
+// Error bounds, per element, against the float32 dataset it was encoded
+// from (fp16 has an 11-bit significand):
+//   position   step/2 of its chunk, plus float rounding of origin + q*step
+//   log-scale  |x| * 2^-11 + 2^-25
+//   SH         |x| * 2^-11 + 2^-25  (within the fp16 range, |x| <= 65504)
+//   rotation   2/127 per component after renormalising
+// measureError() checks a pair of datasets against exactly these bounds.
+//
+// Chunks are runs of kCompactChunkSplats splats in storage order, so the
+// position step depends on how spatially coherent that order is.
+// ===========================================================================
+class SplatCompact {
+public:
+    // Returns a compact copy of the float dataset `src` (same count, SH
+    // degree, opacities and bbox). Encoding runs on all cores.
+    static GaussianData encode(const GaussianData& src);
+
+    // Decodes rows [begin, end) of a compact dataset into arrays laid out
+    // like the float columns (positions, exp'd scaleWS, normalised
+    // rotationWS, shCoeffs at d.shStride()). Each pointer addresses the
+    // output for row `begin`; null pointers are skipped.
+    static void decodeRows(const GaussianData& d, size_t begin, size_t end,
+                           float* positions, float* scaleWS,
+                           float* rotationWS, float* shCoeffs);
+
+    struct ErrorReport {
+        // Largest error seen, and largest error / bound, per attribute
+        float  position = 0.f, logScale = 0.f, rotation = 0.f, sh = 0.f;
+        float  positionRatio = 0.f, logScaleRatio = 0.f, rotationRatio = 0.f, shRatio = 0.f;
+        size_t violations = 0;    // elements outside their bound
+    };
+    // Compares `packed` (from encode) with the float `reference` it was
+    // encoded from. Both must have the same count and SH degree.
+    static ErrorReport measureError(const GaussianData& reference, const GaussianData& packed);
+
+    static constexpr float kRotationBound = 2.f / 127.f;
+};
+
+// ---------------------------------------------------------------------------
+// IEEE half conversion, round to nearest even. The bulk versions use SSE2
+// where available (every x64 target) with a scalar tail.
+// ---------------------------------------------------------------------------
+namespace gs {
+
+uint16_t FloatToHalf(float f);
+float    HalfToFloat(uint16_t h);
+void     FloatToHalf(const float* src, uint16_t* dst, size_t n);
+void     HalfToFloat(const uint16_t* src, float* dst, size_t n);
+
+} // namespace gs
@@ -0,0 +1,338 @@
+#include "SplatDataset.h"
+#include "PLYLoadJob.h"
+#include "SplatCache.h"
+#include "SplatCompact.h"
+#include "SplatKernels.h"
+
+#include <maya/MGlobal.h>
+#include <maya/MString.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <unordered_map>
+
+// ---------------------------------------------------------------------------
+// Registry
+// ---------------------------------------------------------------------------
+static std::mutex s_registryMutex;
+static std::unordered_map<std::string, std::weak_ptr<SplatDataset>> s_registry;
+static std::atomic<uint64_t> s_nextVersion { 1 };
+
+uint64_t SplatDataset::nextVersion() {
+    return s_nextVersion.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Canonical path, size, mtime and settings, or "" when the file cannot be
+// stat'ed. Runs on the main thread, so no content is read here: the load
+// worker hashes the file for the cache (PLYLoadJob).
+static std::string registryKey(const std::string& path, const SplatDataset::Settings& s) {
+    SplatCache::SourceKey key;
+    if (!SplatCache::statSource(path, key)) return std::string();
+    std::error_code ec;
+    std::filesystem::path canonical = std::filesystem::weakly_canonical(path, ec);
+    std::string k = ec ? path : canonical.string();
+    k += '|' + std::to_string(key.size) + '|' + std::to_string(key.mtime);
+    k += '|' + std::to_string(s.shDegree) + '|' + std::to_string((int)s.compact) +
+         '|' + std::to_string((int)s.order);
+    return k;
+}
+
+std::shared_ptr<SplatDataset> SplatDataset::acquire(const std::string& path, const Settings& settings) {
+    const std::string key = registryKey(path, settings);
+    // Declared before the lock: dropping the last reference runs the
+    // destructor, which takes the lock itself.
+    std::shared_ptr<SplatDataset> live;
+    std::lock_guard<std::mutex> lock(s_registryMutex);
+    if (!key.empty()) {
+        auto it = s_registry.find(key);
+        if (it != s_registry.end()) live = it->second.lock();
+        // A cancelled or failed load is not handed out again
+        if (live && !live->failed()) return live;
+    }
+
+    std::shared_ptr<SplatDataset> ds(new SplatDataset(path, settings));
+    if (!key.empty()) {
+        ds->m_registryKey = key;
+        s_registry[key]   = ds;
+    }
+    return ds;
+}
+
+std::vector<SplatDataset::Info> SplatDataset::liveDatasets() {
+    std::vector<std::shared_ptr<SplatDataset>> live;
+    {
+        std::lock_guard<std::mutex> lock(s_registryMutex);
+        for (const auto& entry : s_registry)
+            if (auto ds = entry.second.lock()) live.push_back(std::move(ds));
+    }
+    std::vector<Info> out;
+    for (const auto& ds : live) {
+        Info info;
+        info.path    = ds->m_path;
+        info.owners  = ds.use_count() - 1;          // not counting `live`
+        info.splats  = ds->m_readyCount;
+        info.bytes   = ds->isLoading() ? 0 : ds->m_data->memoryBytes();
+        info.loading = ds->isLoading();
+        out.push_back(info);
+    }
+    return out;
+}
+
+// ---------------------------------------------------------------------------
+// Lifetime
+// ---------------------------------------------------------------------------
+SplatDataset::SplatDataset(const std::string& path, const Settings& settings)
+    : m_path(path), m_settings(settings), m_version(nextVersion())
+{
+    m_loadJob = PLYLoadJob::start(path, settings.shDegree);
+    m_data    = m_loadJob->data();
+    MGlobal::displayInfo(MString("[GaussianSplatData] Loading in background: ") + path.c_str());
+}
+
+SplatDataset::~SplatDataset() {
+    // The worker stops at its next checkpoint and drops the data itself
+    if (m_loadJob) m_loadJob->cancel();
+    releaseInputBuffers();
+
+    if (!m_registryKey.empty()) {
+        std::lock_guard<std::mutex> lock(s_registryMutex);
+        auto it = s_registry.find(m_registryKey);
+        // A failed dataset may already have been replaced under its key
+        if (it != s_registry.end() && it->second.expired()) s_registry.erase(it);
+    }
+}
+
+void SplatDataset::bumpVersion() {
+    m_version     = nextVersion();
+    m_inputsDirty = true;
+}
+
+void SplatDataset::resetData() {
+    m_data       = std::make_shared<GaussianData>();
+    m_readyCount = 0;
+    m_capacity   = 0;
+    m_bvh.clear();
+    bumpVersion();
+    releaseInputBuffers();
+}
+
+void SplatDataset::cancel() {
+    if (!m_loadJob) return;
+    m_loadJob->cancel();
+    m_loadJob.reset();
+    m_failed = true;
+    resetData();
+}
+
+// ---------------------------------------------------------------------------
+// Background loading
+// ---------------------------------------------------------------------------
+float SplatDataset::progress() const {
+    return m_loadJob ? m_loadJob->progress() : (m_readyCount > 0 ? 1.f : 0.f);
+}
+
+bool SplatDataset::loadFinished() const {
+    return !m_loadJob || m_loadJob->finished();
+}
+
+size_t SplatDataset::publishedCount() const {
+    return m_loadJob ? m_loadJob->readyCount() : m_readyCount;
+}
+
+// Picks up the rows the job has published since the last call (one acquire
+// load, no copies) and finishes the load once it is done.
+void SplatDataset::poll() {
+    if (!m_loadJob) return;
+
+    // finished() first: once it is true, readyCount() is final.
+    bool   done  = m_loadJob->finished();
+    size_t ready = m_loadJob->readyCount();
+
+    if (done && !m_loadJob->succeeded()) {
+        if (!m_loadJob->cancelled())
+            MGlobal::displayError(MString("[GaussianSplatData] ") + m_loadJob->error().c_str());
+        m_loadJob.reset();
+        m_failed = true;
+        resetData();
+        return;
+    }
+
+    if (ready > m_readyCount) {
+        // Rows stream in as float columns (compaction happens once the
+        // load is done), so the scales are readable here
+        const float* pos   = m_data->positions.data();
+        const float* scale = m_data->scaleWS.data();
+        if (m_readyCount == 0) {
+            // First rows: the arrays are sized now; GPU buffers follow.
+            m_capacity = (uint32_t)m_data->count();
+            bumpVersion();
+            for (int k = 0; k < 3; ++k) m_bboxMin[k] = m_bboxMax[k] = pos[k];
+            m_maxScale = 0.f;
+            m_minScale = 1e30f;
+        }
+        for (size_t i = m_readyCount; i < ready; ++i)
+            for (int k = 0; k < 3; ++k) {
+                m_bboxMin[k] = std::min(m_bboxMin[k], pos[i * 3 + k]);
+                m_bboxMax[k] = std::max(m_bboxMax[k], pos[i * 3 + k]);
+                m_maxScale   = std::max(m_maxScale, scale[i * 3 + k]);
+                m_minScale   = std::min(m_minScale, scale[i * 3 + k]);
+            }
+        m_readyCount = (uint32_t)ready;
+    }
+
+    if (!done) return;
+
+    MGlobal::displayInfo(MString("[GaussianSplatData] Loaded ") + m_readyCount +
+                         " splats in " + (int)m_loadJob->elapsedMs() + " ms.");
+    m_loadJob.reset();
+
+    // Scale statistics are logged by the loader; the rows streamed through
+    // the bbox loop above are enough to catch the all-1.0 case
+    if (m_readyCount > 0 && m_minScale > 0.999f && m_maxScale < 1.001f)
+        MGlobal::displayWarning("[GaussianSplatData] All scales are 1.0 after exp -- PLY likely missing scale_0/1/2!");
+
+    // Reorder first: compact chunks and BVH leaves then cover small boxes.
+    // The BVH reads the float columns, before they are packed.
+    if (m_settings.order != SplatOrder::File) reorderData();
+    buildBVH();
+    if (m_settings.compact) compactData();
+}
+
+// Chunk hierarchy over the final row order, for culling inside an instance
+// (GaussianRenderManager). Compaction keeps the rows where they are.
+void SplatDataset::buildBVH() {
+    auto t0 = std::chrono::steady_clock::now();
+    m_bvh.build(*m_data, m_readyCount);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    MGlobal::displayInfo(MString("[GaussianSplatData] Chunk BVH: ") + (unsigned)m_bvh.nodeCount() +
+                         " nodes over " + (unsigned)m_bvh.rowCount() + " splats in " + (int)ms + " ms" +
+                         (m_settings.order == SplatOrder::File ? " (file order: set splatOrder to cull chunks)." : "."));
+}
+
+// Replaces the finished dataset with a copy whose rows follow a space-filling
+// curve; a copy for the same reason as compactData().
+void SplatDataset::reorderData() {
+    if (m_data->compact() || m_data->count() < 2) return;
+    auto t0 = std::chrono::steady_clock::now();
+    m_data = std::make_shared<GaussianData>(SplatReorder::reorder(*m_data, m_settings.order));
+    bumpVersion();
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    MGlobal::displayInfo(MString("[GaussianSplatData] Reordered ") + (unsigned)m_data->count() +
+                         " splats along a " + SplatReorder::name(m_settings.order) + " curve in " +
+                         (int)ms + " ms.");
+}
+
+// Replaces the finished float dataset with its packed form. The job's worker
+// may still be writing the sidecar cache from the old data, so this builds a
+// new dataset instead of converting in place.
+void SplatDataset::compactData() {
+    if (m_data->compact() || m_data->empty()) return;
+    size_t before = m_data->memoryBytes();
+    m_data = std::make_shared<GaussianData>(SplatCompact::encode(*m_data));
+    bumpVersion();
+    MGlobal::displayInfo(MString("[GaussianSplatData] Compact storage: ") +
+                         (unsigned)(before >> 20) + " MB -> " +
+                         (unsigned)(m_data->memoryBytes() >> 20) + " MB.");
+}
+
+// ---------------------------------------------------------------------------
+// GPU buffers
+// ---------------------------------------------------------------------------
+void SplatDataset::releaseInputBuffers() {
+    for (PagedBuffer* b : { &m_gpuPositionWS, &m_gpuOpacity, &m_gpuSHCoeffs, &m_gpuCovDiag,
+                            &m_gpuCovOffDiag, &m_gpuScale, &m_gpuRotation, &m_gpuChunks })
+        b->release();
+    m_inputsReady   = false;
+    m_uploadedCount = 0;
+}
+
+bool SplatDataset::uploadIfNeeded(ID3D11Device* device) {
+    if (m_readyCount == 0) return m_inputsReady;
+    if (!m_inputsDirty && m_uploadedCount == m_readyCount) return m_inputsReady;
+
+    // Buffers are allocated once for the whole file; streamed rows are
+    // appended below as they arrive. Compact datasets are only created once
+    // loading has finished, so they are uploaded in one go. Columns past one
+    // buffer's limits are split into pages (PageLayout).
+    const GaussianData& d = *m_data;
+    const bool compact = d.compact();
+    const uint32_t shHalfs = (uint32_t)compactSHHalfs(d.shDegree);
+    const uint32_t shPer   = compact ? shHalfs / 2 : (uint32_t)d.shStride();   // SH elements per splat
+
+    ID3D11DeviceContext* ctx = nullptr;
+    device->GetImmediateContext(&ctx);
+    if (!ctx) return false;
+
+    if (m_inputsDirty) {
+        releaseInputBuffers();
+        uint64_t cap = m_capacity;
+        MGlobal::displayInfo(MString("[GaussianSplatData] Allocating ") + (compact ? "compact " : "") +
+                             "GPU buffers for " + (unsigned)cap + " splats...");
+
+        using PL = PageLayout;
+        m_gpuPositionWS.init(PL(compact ? sizeof(uint16_t)*4 : sizeof(float)*3, PL::kMaxRowPages),
+                             compact ? "positionQ" : "positionWS");
+        m_gpuOpacity.init(PL(sizeof(float), PL::kMaxRowPages), "opacity");
+        m_gpuSHCoeffs.init(PL(compact ? sizeof(uint32_t) : sizeof(float)*3, PL::kMaxSHPages),
+                           compact ? "shH" : "shCoeffs");
+        m_gpuCovDiag.init(PL(sizeof(float)*3, PL::kMaxRowPages), "covDiag");
+        m_gpuCovOffDiag.init(PL(sizeof(float)*3, PL::kMaxRowPages), "covOffDiag");
+        m_gpuScale.init(PL(sizeof(uint16_t)*4, PL::kMaxRowPages), "scaleH");
+        m_gpuRotation.init(PL(sizeof(uint32_t), PL::kMaxRowPages), "rotationQ");
+        m_gpuChunks.init(PL(sizeof(CompactChunk), 1), "chunks");
+
+        bool ok = m_gpuPositionWS.resize(device, ctx, cap) &&
+                  m_gpuOpacity.resize(device, ctx, cap) &&
+                  m_gpuSHCoeffs.resize(device, ctx, cap * shPer);
+        if (ok && compact)
+            ok = m_gpuScale.resize(device, ctx, cap) && m_gpuRotation.resize(device, ctx, cap);
+        else if (ok)
+            ok = m_gpuCovDiag.resize(device, ctx, cap) && m_gpuCovOffDiag.resize(device, ctx, cap);
+        if (ok && compact) {
+            const std::vector<CompactChunk>& chunks = d.packed.chunks;
+            ok = m_gpuChunks.resize(device, ctx, chunks.size());
+            if (ok) m_gpuChunks.update(ctx, 0, chunks.size(), chunks.data());
+        }
+        if (!ok) {
+            releaseInputBuffers();
+            ctx->Release();
+            return false;
+        }
+
+        m_uploadedCount = 0;
+        m_inputsDirty   = false;
+    }
+
+    uint64_t first = m_uploadedCount;
+    uint64_t count = m_readyCount - first;
+    if (compact) {
+        const CompactColumns& p = d.packed;
+        m_gpuPositionWS.update(ctx, first, count, &p.positionQ[first * 4]);
+        m_gpuScale.update(ctx,      first, count, &p.scaleH[first * 4]);
+        m_gpuRotation.update(ctx,   first, count, &p.rotationQ[first]);
+        m_gpuSHCoeffs.update(ctx,   first * shPer, count * shPer, &p.shH[first * shHalfs]);
+    } else {
+        m_gpuPositionWS.update(ctx, first, count, &d.positions[first * 3]);
+        m_gpuSHCoeffs.update(ctx,   first * shPer, count * shPer, &d.shCoeffs[first * d.shFloats()]);
+        // Covariance of the new rows, a batch at a time to bound the scratch
+        const uint64_t kBatch = 1u << 20;
+        std::vector<float> diag, offDiag;
+        for (uint64_t b = first; b < first + count; b += kBatch) {
+            uint64_t n = std::min(kBatch, first + count - b);
+            diag.resize(n * 3);
+            offDiag.resize(n * 3);
+            gs::Covariance3D(&d.scaleWS[b * 3], &d.rotationWS[b * 4], n, diag.data(), offDiag.data());
+            m_gpuCovDiag.update(ctx,    b, n, diag.data());
+            m_gpuCovOffDiag.update(ctx, b, n, offDiag.data());
+        }
+    }
+    m_gpuOpacity.update(ctx, first, count, &d.opacityRaw[first]);
+    ctx->Release();
+
+    m_uploadedCount = m_readyCount;
+    m_inputsReady   = true;
+    return true;
+}
@@ -0,0 +1,158 @@
+#pragma once
+#include <d3d11.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "GaussianData.h"
+#include "PagedBuffer.h"
+#include "SplatBVH.h"
+#include "SplatOrder.h"
+
+class PLYLoadJob;
+
+// ===========================================================================
+// SplatDataset  --  one loaded splat file, shared by every gaussianSplat node
+// that shows it with the same load settings.
+//
+// acquire() keys datasets by the canonical path, size and modification time
+// (SplatCache::statSource; no content is read on the main thread) and the
+// settings that change the stored rows (SH degree, compactStorage,
+// splatOrder). Nodes that
+// reference the same file share one background load, one set of CPU columns
+// and one set of GPU input buffers; each node keeps only its own selection
+// mask. The process-wide registry holds weak references, so a dataset (its
+// load, columns and buffers) is released with the last node using it.
+//
+// Main thread only, except that the load job's worker fills the data while
+// isLoading() (see PLYLoadJob for what may be read meanwhile).
+// ===========================================================================
+class SplatDataset {
+public:
+    struct Settings {
+        int        shDegree = kMaxSHDegree;
+        bool       compact  = false;
+        SplatOrder order    = SplatOrder::File;
+    };
+
+    // The live dataset for `path` and `settings`, or a new one that starts
+    // loading in the background. A file that cannot be stat'ed (e.g. it
+    // does not exist) gets a private dataset, which reports the error.
+    static std::shared_ptr<SplatDataset> acquire(const std::string& path, const Settings& settings);
+
+    // Live datasets and how many nodes hold each (gsDatasetStats)
+    struct Info {
+        std::string path;
+        long        owners  = 0;
+        size_t      splats  = 0;
+        size_t      bytes   = 0;       // CPU columns
+        bool        loading = false;
+    };
+    static std::vector<Info> liveDatasets();
+
+    // Process-wide unique data version; see version()
+    static uint64_t nextVersion();
+
+    SplatDataset(const SplatDataset&)            = delete;
+    SplatDataset& operator=(const SplatDataset&) = delete;
+    ~SplatDataset();
+
+    const std::string& path()     const { return m_path; }
+    const Settings&    settings() const { return m_settings; }
+
+    // Picks up the rows the job has published since the last call and
+    // finishes the load once it is done (reorder, compact). Any owner may
+    // call it; the work happens once.
+    void poll();
+    // Stops the load for every owner; the dataset is then failed() and empty.
+    void cancel();
+
+    bool   isLoading()      const { return m_loadJob != nullptr; }
+    bool   failed()         const { return m_failed; }
+    float  progress()       const;
+    // The job has finished, whether or not poll() has seen it yet
+    bool   loadFinished()   const;
+    // Rows the job has published, whether or not poll() has seen them yet
+    size_t publishedCount() const;
+
+    // While loading, only the first readyCount() rows are valid; the arrays
+    // are already sized for capacity() rows.
+    const GaussianData& data()       const { return *m_data; }
+    uint32_t            readyCount() const { return m_readyCount; }
+    uint32_t            capacity()   const { return m_capacity; }
+    const float*        bboxMin()    const { return m_bboxMin; }   // of rows [0, readyCount())
+    const float*        bboxMax()    const { return m_bboxMax; }
+    // Largest scale (after exp) of rows [0, readyCount()): how far a
+    // splat's 1-sigma ellipsoid reaches past the bbox, in object space
+    float               maxScale()   const { return m_maxScale; }
+    // Chunk hierarchy over the rows (SplatBVH), built once the load has
+    // finished and the rows are in their final order; empty while loading
+    const SplatBVH&     bvh()        const { return m_bvh; }
+    // Changes whenever the rows are replaced (first rows, reorder, compact,
+    // cancel); unique across datasets, so owners can compare it directly.
+    uint64_t            version()    const { return m_version; }
+
+    // --- GPU input buffers (lazy upload, sized for capacity()) ---
+    bool uploadIfNeeded(ID3D11Device* device);
+    bool inputsReady() const { return m_inputsReady; }
+
+    // Paged per PageLayout; rows [0, uploadedCount()) are on the GPU and
+    // belong to the current version() (0 until uploadIfNeeded() has caught
+    // up). The render manager copies from them into its pool; the debug
+    // path reads them directly.
+    const PagedBuffer& gpuPositionWS() const { return m_gpuPositionWS; }
+    const PagedBuffer& gpuOpacity()    const { return m_gpuOpacity; }
+    const PagedBuffer& gpuSHCoeffs()   const { return m_gpuSHCoeffs; }
+    // Float datasets: the object-space covariance (gs::Covariance3D),
+    // computed once per row as it is uploaded, so the preprocess kernel
+    // does not rebuild it from the scale and quaternion every frame
+    const PagedBuffer& gpuCovDiag()    const { return m_gpuCovDiag; }      // float3 xx, yy, zz
+    const PagedBuffer& gpuCovOffDiag() const { return m_gpuCovOffDiag; }   // float3 xy, xz, yz
+    // Compact datasets only: packed scale and quaternion, and a
+    // CompactChunk per kCompactChunkSplats splats
+    const PagedBuffer& gpuScale()      const { return m_gpuScale; }
+    const PagedBuffer& gpuRotation()   const { return m_gpuRotation; }
+    const PagedBuffer& gpuChunks()     const { return m_gpuChunks; }
+    uint32_t uploadedCount() const { return m_inputsReady && !m_inputsDirty ? m_uploadedCount : 0; }
+
+private:
+    SplatDataset(const std::string& path, const Settings& settings);
+
+    void bumpVersion();
+    void resetData();
+    void reorderData();
+    void buildBVH();
+    void compactData();
+    void releaseInputBuffers();
+
+    std::string m_path;
+    Settings    m_settings;
+    std::string m_registryKey;          // empty: not in the registry
+
+    // Shared with the load job while streaming. Never touched before the
+    // job has published its first rows (the worker is still sizing it).
+    std::shared_ptr<const GaussianData> m_data = std::make_shared<GaussianData>();
+    std::shared_ptr<PLYLoadJob>         m_loadJob;
+    bool         m_failed      = false;
+    uint32_t     m_readyCount  = 0;
+    uint32_t     m_capacity    = 0;
+    float        m_bboxMin[3]  = { 0.f, 0.f, 0.f };
+    float        m_bboxMax[3]  = { 0.f, 0.f, 0.f };
+    float        m_maxScale    = 0.f;
+    float        m_minScale    = 0.f;      // only for the missing-scale warning
+    SplatBVH     m_bvh;
+    uint64_t     m_version     = 0;
+
+    PagedBuffer  m_gpuPositionWS;
+    PagedBuffer  m_gpuOpacity;
+    PagedBuffer  m_gpuSHCoeffs;
+    PagedBuffer  m_gpuCovDiag;
+    PagedBuffer  m_gpuCovOffDiag;
+    PagedBuffer  m_gpuScale;
+    PagedBuffer  m_gpuRotation;
+    PagedBuffer  m_gpuChunks;
+
+    bool     m_inputsReady   = false;
+    bool     m_inputsDirty   = true;    // (re)allocate GPU buffers at m_capacity
+    uint32_t m_uploadedCount = 0;       // rows already copied to the GPU buffers
+};
@@ -0,0 +1,184 @@
+#include "SplatKernels.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define GS_KERNELS_X86 1
+#elif defined(__x86_64__) || defined(__i386__)
+#define GS_KERNELS_X86 1
+#endif
+
+namespace gs {
+
+// SplatKernelsAVX2.cpp: each handles the leading multiple of eight rows and
+// returns how many rows it processed.
+size_t FinalizeRowsAVX2(const float* positions, float* scales, float* rotations, size_t n,
+                        float bmin[3], float bmax[3]);
+size_t DisplayColorsAVX2(const float* sh, size_t shFloats, const float* opacity, size_t n,
+                         float* rgba);
+size_t Covariance3DAVX2(const float* scales, const float* rotations, size_t n,
+                        float* diag, float* offDiag);
+
+// ===========================================================================
+// Dispatch
+// ===========================================================================
+static SimdLevel detect() {
+#if defined(GS_KERNELS_X86) && defined(_MSC_VER)
+    int r[4];
+    __cpuid(r, 0);
+    if (r[0] < 7) return SimdLevel::Scalar;
+    __cpuid(r, 1);
+    bool osxsave = (r[2] & (1 << 27)) != 0, avx = (r[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx) return SimdLevel::Scalar;
+    if ((_xgetbv(0) & 0x6) != 0x6) return SimdLevel::Scalar;    // OS saves XMM + YMM state
+    __cpuidex(r, 7, 0);
+    return (r[1] & (1 << 5)) ? SimdLevel::AVX2 : SimdLevel::Scalar;
+#elif defined(GS_KERNELS_X86)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? SimdLevel::AVX2 : SimdLevel::Scalar;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+SimdLevel DetectedSimd() {
+    static const SimdLevel level = detect();
+    return level;
+}
+
+static std::atomic<int> s_active { -1 };     // -1: not set, use DetectedSimd()
+
+SimdLevel ActiveSimd() {
+    int v = s_active.load(std::memory_order_relaxed);
+    return v < 0 ? DetectedSimd() : (SimdLevel)v;
+}
+
+void SetActiveSimd(SimdLevel level) {
+    if ((int)level > (int)DetectedSimd()) level = DetectedSimd();
+    s_active.store((int)level, std::memory_order_relaxed);
+}
+
+const char* SimdName(SimdLevel level) {
+    return level == SimdLevel::AVX2 ? "AVX2" : "scalar";
+}
+
+// ===========================================================================
+// Scalar kernels. SplatKernelsAVX2.cpp mirrors every expression here
+// operation for operation; keep the two in step.
+// ===========================================================================
+static constexpr float kLog2e  = 1.44269504088896341f;
+static constexpr float kLn2Hi  = 0.693359375f;           // ln 2 = kLn2Hi + kLn2Lo
+static constexpr float kLn2Lo  = -2.12194440e-4f;
+static constexpr float kSH_C0  = 0.28209479177387814f;   // 1 / (2*sqrt(pi))
+static constexpr float kExpP[6] = { 1.9875691500e-4f, 1.3981999507e-3f, 8.3334519073e-3f,
+                                    4.1665795894e-2f, 1.6666665459e-1f, 5.0000001201e-1f };
+
+float ExpApprox(float x) {
+    x = std::min(std::max(x, kExpMin), kExpMax);
+    // x = n ln2 + r, |r| <= ln2 / 2
+    float fx = std::floor(x * kLog2e + 0.5f);
+    x = x - fx * kLn2Hi;
+    x = x - fx * kLn2Lo;
+    float z = x * x;
+    float y = kExpP[0];
+    for (int k = 1; k < 6; ++k) y = y * x + kExpP[k];
+    y = y * z + x + 1.f;
+    // * 2^n, n in [-126, 127]
+    int   bits = ((int)fx + 127) << 23;
+    float pow2n;
+    std::memcpy(&pow2n, &bits, 4);
+    return y * pow2n;
+}
+
+float SigmoidApprox(float x) {
+    return 1.f / (1.f + ExpApprox(-x));
+}
+
+static void finalizeScalar(const float* positions, float* scales, float* rotations,
+                           size_t begin, size_t end, float bmin[3], float bmax[3]) {
+    for (size_t i = begin; i < end; ++i) {
+        const float* pos = &positions[i * 3];
+        for (int k = 0; k < 3; ++k) {
+            if (pos[k] < bmin[k]) bmin[k] = pos[k];
+            if (pos[k] > bmax[k]) bmax[k] = pos[k];
+        }
+
+        float* sc = &scales[i * 3];
+        for (int k = 0; k < 3; ++k) sc[k] = ExpApprox(sc[k]);
+
+        float* q = &rotations[i * 4];
+        float len = std::sqrt((q[0]*q[0] + q[1]*q[1]) + (q[2]*q[2] + q[3]*q[3]));
+        if (len < 1e-6f) len = 1.f;
+        for (int k = 0; k < 4; ++k) q[k] /= len;
+    }
+}
+
+static void colorsScalar(const float* sh, size_t shFloats, const float* opacity,
+                         size_t begin, size_t end, float* rgba) {
+    for (size_t i = begin; i < end; ++i) {
+        const float* dc = &sh[i * shFloats];
+        float* out = &rgba[i * 4];
+        for (int k = 0; k < 3; ++k)
+            out[k] = std::min(std::max(0.5f + kSH_C0 * dc[k], 0.f), 1.f);
+        out[3] = SigmoidApprox(opacity[i]);
+    }
+}
+
+static void covarianceScalar(const float* scales, const float* rotations,
+                             size_t begin, size_t end, float* diag, float* offDiag) {
+    for (size_t i = begin; i < end; ++i) {
+        const float* s = &scales[i * 3];
+        const float* q = &rotations[i * 4];
+        float r = q[0], x = q[1], y = q[2], z = q[3];
+        float R[3][3] = {
+            { 1.f - 2.f * (y*y + z*z), 2.f * (x*y - r*z),       2.f * (x*z + r*y)       },
+            { 2.f * (x*y + r*z),       1.f - 2.f * (x*x + z*z), 2.f * (y*z - r*x)       },
+            { 2.f * (x*z - r*y),       2.f * (y*z + r*x),       1.f - 2.f * (x*x + y*y) },
+        };
+        // M = R diag(s^2); cov[a][b] = M[a] . R[b]
+        float M[3][3];
+        for (int a = 0; a < 3; ++a)
+            for (int k = 0; k < 3; ++k) M[a][k] = R[a][k] * (s[k] * s[k]);
+        float* d = &diag[i * 3];
+        float* o = &offDiag[i * 3];
+        d[0] = M[0][0]*R[0][0] + M[0][1]*R[0][1] + M[0][2]*R[0][2];
+        d[1] = M[1][0]*R[1][0] + M[1][1]*R[1][1] + M[1][2]*R[1][2];
+        d[2] = M[2][0]*R[2][0] + M[2][1]*R[2][1] + M[2][2]*R[2][2];
+        o[0] = M[0][0]*R[1][0] + M[0][1]*R[1][1] + M[0][2]*R[1][2];
+        o[1] = M[0][0]*R[2][0] + M[0][1]*R[2][1] + M[0][2]*R[2][2];
+        o[2] = M[1][0]*R[2][0] + M[1][1]*R[2][1] + M[1][2]*R[2][2];
+    }
+}
+
+// ===========================================================================
+// Entry points
+// ===========================================================================
+void FinalizeRows(const float* positions, float* scales, float* rotations, size_t n,
+                  float bmin[3], float bmax[3], SimdLevel level) {
+    size_t done = 0;
+    if (level == SimdLevel::AVX2 && DetectedSimd() == SimdLevel::AVX2)
+        done = FinalizeRowsAVX2(positions, scales, rotations, n, bmin, bmax);
+    finalizeScalar(positions, scales, rotations, done, n, bmin, bmax);
+}
+
+void DisplayColors(const float* sh, size_t shFloats, const float* opacity, size_t n,
+                   float* rgba, SimdLevel level) {
+    size_t done = 0;
+    if (level == SimdLevel::AVX2 && DetectedSimd() == SimdLevel::AVX2)
+        done = DisplayColorsAVX2(sh, shFloats, opacity, n, rgba);
+    colorsScalar(sh, shFloats, opacity, done, n, rgba);
+}
+
+void Covariance3D(const float* scales, const float* rotations, size_t n,
+                  float* diag, float* offDiag, SimdLevel level) {
+    size_t done = 0;
+    if (level == SimdLevel::AVX2 && DetectedSimd() == SimdLevel::AVX2)
+        done = Covariance3DAVX2(scales, rotations, n, diag, offDiag);
+    covarianceScalar(scales, rotations, done, n, diag, offDiag);
+}
+
+} // namespace gs
@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+
+// ===========================================================================
+// SplatKernels  --  batch per-splat transforms with runtime SIMD dispatch.
+//
+// Each kernel has a scalar version and an AVX2 version (SplatKernelsAVX2.cpp,
+// the only file built with AVX2 code generation) that handles eight splats
+// per iteration; rows past the last multiple of eight go through the scalar
+// version. Both evaluate the same operations in the same order without FMA,
+// so they produce bit-identical results and the output does not depend on
+// the CPU or on how a range was split across workers.
+//
+// exp is a Cephes-style approximation: range reduction by ln 2 and a
+// polynomial, relative error below kExpMaxRelError (2^-23) against the exact
+// exp for x in [kExpMin, kExpMax] (8.1e-8 worst over a sweep of every 7th
+// float in that range). Inputs are clamped to the range, so it never returns
+// 0, a subnormal or inf. sigmoid adds an add and a divide on top:
+// kSigmoidMaxRelError for -x in [kExpMin, kExpMax] (2.1e-7 worst seen).
+// ===========================================================================
+namespace gs {
+
+enum class SimdLevel { Scalar = 0, AVX2 = 1 };
+
+static constexpr float kExpMin             = -87.3365447f;   // exp = 2^-126 (FLT_MIN)
+static constexpr float kExpMax             =  88.3762589f;
+static constexpr float kExpMaxRelError     = 1.1920929e-7f;   // 2^-23
+static constexpr float kSigmoidMaxRelError = 2.5e-7f;
+
+// Best level this CPU and OS support (cpuid, checked once)
+SimdLevel DetectedSimd();
+// Level the kernels use by default; starts at DetectedSimd(). Setting a level
+// the CPU lacks selects DetectedSimd() instead.
+SimdLevel ActiveSimd();
+void      SetActiveSimd(SimdLevel level);
+const char* SimdName(SimdLevel level);
+
+float ExpApprox(float x);
+float SigmoidApprox(float x);           // 1 / (1 + ExpApprox(-x))
+
+// GaussianData::finalizeRange for n rows: exp the log-scales in place,
+// normalise the quaternions in place (zero-length ones are left as they
+// are) and grow bmin/bmax by the positions.
+void FinalizeRows(const float* positions, float* scales, float* rotations, size_t n,
+                  float bmin[3], float bmax[3], SimdLevel level = ActiveSimd());
+
+// Object-space covariance R diag(s^2) R^T of n rows: the symmetric 3x3 as
+// float3 (xx, yy, zz) into diag and float3 (xy, xz, yz) into offDiag.
+// scales are the exp'd scales (float3), rotations normalised quaternions
+// (w, x, y, z). The float preprocess pool stores it (see SplatDataset);
+// compact pools build the same matrix in the kernel (Get3DCovariance in
+// shaders/merged_preprocess.hlsl).
+void Covariance3D(const float* scales, const float* rotations, size_t n,
+                  float* diag, float* offDiag, SimdLevel level = ActiveSimd());
+
+// Debug display colours for n rows: rgb = clamp(0.5 + C0 * SH DC, 0, 1),
+// a = sigmoid(opacity). sh points at row 0's SH block, shFloats apart.
+void DisplayColors(const float* sh, size_t shFloats, const float* opacity, size_t n,
+                   float* rgba, SimdLevel level = ActiveSimd());
+
+} // namespace gs
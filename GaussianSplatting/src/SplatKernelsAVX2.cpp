@@ -0,0 +1,189 @@
+// AVX2 versions of the SplatKernels.cpp scalar kernels. This is the only
+// file built with AVX2 code generation, and it is only entered after
+// DetectedSimd() reports AVX2. It includes no standard headers with inline
+// functions, so no AVX2-encoded copy of them can be picked by the linker for
+// the rest of the plugin.
+//
+// Operand order in min/max and every arithmetic step follows the scalar code
+// so both produce identical bits (see SplatKernels.h).
+#include "SplatKernels.h"
+
+#include <immintrin.h>
+
+namespace gs {
+
+static inline __m256 expAVX2(__m256 x) {
+    x = _mm256_min_ps(_mm256_set1_ps(kExpMax), _mm256_max_ps(_mm256_set1_ps(kExpMin), x));
+    __m256 fx = _mm256_floor_ps(_mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(1.44269504088896341f)),
+                                              _mm256_set1_ps(0.5f)));
+    x = _mm256_sub_ps(x, _mm256_mul_ps(fx, _mm256_set1_ps(0.693359375f)));
+    x = _mm256_sub_ps(x, _mm256_mul_ps(fx, _mm256_set1_ps(-2.12194440e-4f)));
+    __m256 z = _mm256_mul_ps(x, x);
+    __m256 y = _mm256_set1_ps(1.9875691500e-4f);
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(1.3981999507e-3f));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(8.3334519073e-3f));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(4.1665795894e-2f));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(1.6666665459e-1f));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(5.0000001201e-1f));
+    y = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(y, z), x), _mm256_set1_ps(1.f));
+    __m256i n = _mm256_add_epi32(_mm256_cvttps_epi32(fx), _mm256_set1_epi32(127));
+    return _mm256_mul_ps(y, _mm256_castsi256_ps(_mm256_slli_epi32(n, 23)));
+}
+
+// ===========================================================================
+// FinalizeRows: 8 rows = 24 position floats, 24 scale floats, 32 quaternion
+// floats per iteration.
+// ===========================================================================
+size_t FinalizeRowsAVX2(const float* positions, float* scales, float* rotations, size_t n,
+                        float bmin[3], float bmax[3]) {
+    const size_t n8 = n & ~(size_t)7;
+    if (n8 == 0) return 0;
+
+    // Three running min/max vectors. Since 24 floats is a whole number of
+    // rows, lane j of vector v always holds component (8v + j) % 3.
+    __m256 lo[3], hi[3];
+    for (int v = 0; v < 3; ++v) {
+        lo[v] = _mm256_set1_ps( 1e30f);
+        hi[v] = _mm256_set1_ps(-1e30f);
+    }
+    const __m256 eps = _mm256_set1_ps(1e-6f);
+    const __m256 one = _mm256_set1_ps(1.f);
+
+    for (size_t i = 0; i < n8; i += 8) {
+        const float* p = positions + i * 3;
+        float*       s = scales    + i * 3;
+        float*       q = rotations + i * 4;
+        for (int v = 0; v < 3; ++v) {
+            __m256 pv = _mm256_loadu_ps(p + v * 8);
+            lo[v] = _mm256_min_ps(pv, lo[v]);
+            hi[v] = _mm256_max_ps(pv, hi[v]);
+            _mm256_storeu_ps(s + v * 8, expAVX2(_mm256_loadu_ps(s + v * 8)));
+        }
+        // Two quaternions per vector; (q0^2 + q1^2) + (q2^2 + q3^2) ends up
+        // in all four lanes of each.
+        for (int v = 0; v < 4; ++v) {
+            __m256 qv  = _mm256_loadu_ps(q + v * 8);
+            __m256 sq  = _mm256_mul_ps(qv, qv);
+            __m256 s2  = _mm256_add_ps(sq, _mm256_permute_ps(sq, _MM_SHUFFLE(2, 3, 0, 1)));
+            __m256 s4  = _mm256_add_ps(s2, _mm256_permute_ps(s2, _MM_SHUFFLE(1, 0, 3, 2)));
+            __m256 len = _mm256_sqrt_ps(s4);
+            len = _mm256_blendv_ps(len, one, _mm256_cmp_ps(len, eps, _CMP_LT_OQ));
+            _mm256_storeu_ps(q + v * 8, _mm256_div_ps(qv, len));
+        }
+    }
+
+    alignas(32) float l[24], h[24];
+    for (int v = 0; v < 3; ++v) {
+        _mm256_store_ps(l + v * 8, lo[v]);
+        _mm256_store_ps(h + v * 8, hi[v]);
+    }
+    for (int j = 0; j < 24; ++j) {
+        int k = j % 3;
+        if (l[j] < bmin[k]) bmin[k] = l[j];
+        if (h[j] > bmax[k]) bmax[k] = h[j];
+    }
+    return n8;
+}
+
+// ===========================================================================
+// DisplayColors: gathers the SH DC of 8 rows, writes 8 interleaved RGBA.
+// ===========================================================================
+size_t DisplayColorsAVX2(const float* sh, size_t shFloats, const float* opacity, size_t n,
+                         float* rgba) {
+    const size_t n8 = n & ~(size_t)7;
+    const __m256i lane = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                            _mm256_set1_epi32((int)shFloats));
+    const __m256 c0   = _mm256_set1_ps(0.28209479177387814f);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one  = _mm256_set1_ps(1.f);
+    const __m256 sign = _mm256_set1_ps(-0.f);
+
+    for (size_t i = 0; i < n8; i += 8) {
+        const float* dc = sh + i * shFloats;     // offsets stay small: 7 * shFloats + 2
+        __m256 c[3];
+        for (int k = 0; k < 3; ++k) {
+            __m256 v = _mm256_i32gather_ps(dc + k, lane, 4);
+            c[k] = _mm256_min_ps(one, _mm256_max_ps(zero, _mm256_add_ps(half, _mm256_mul_ps(c0, v))));
+        }
+        __m256 e = expAVX2(_mm256_xor_ps(_mm256_loadu_ps(opacity + i), sign));
+        __m256 a = _mm256_div_ps(one, _mm256_add_ps(one, e));
+
+        // r/g/b/a planes -> 8 interleaved rgba
+        __m256 t0 = _mm256_unpacklo_ps(c[0], c[1]);
+        __m256 t1 = _mm256_unpackhi_ps(c[0], c[1]);
+        __m256 t2 = _mm256_unpacklo_ps(c[2], a);
+        __m256 t3 = _mm256_unpackhi_ps(c[2], a);
+        __m256 u0 = _mm256_shuffle_ps(t0, t2, 0x44);
+        __m256 u1 = _mm256_shuffle_ps(t0, t2, 0xEE);
+        __m256 u2 = _mm256_shuffle_ps(t1, t3, 0x44);
+        __m256 u3 = _mm256_shuffle_ps(t1, t3, 0xEE);
+        float* out = rgba + i * 4;
+        _mm256_storeu_ps(out +  0, _mm256_permute2f128_ps(u0, u1, 0x20));
+        _mm256_storeu_ps(out +  8, _mm256_permute2f128_ps(u2, u3, 0x20));
+        _mm256_storeu_ps(out + 16, _mm256_permute2f128_ps(u0, u1, 0x31));
+        _mm256_storeu_ps(out + 24, _mm256_permute2f128_ps(u2, u3, 0x31));
+    }
+    return n8;
+}
+
+// ===========================================================================
+// Covariance3D: gathers the scales and quaternions of 8 rows, writes the
+// diagonal and off-diagonal float3s of 8 rows.
+// ===========================================================================
+size_t Covariance3DAVX2(const float* scales, const float* rotations, size_t n,
+                        float* diag, float* offDiag) {
+    const size_t n8 = n & ~(size_t)7;
+    const __m256i lane3 = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+    const __m256i lane4 = _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28);
+    const __m256 one = _mm256_set1_ps(1.f);
+    const __m256 two = _mm256_set1_ps(2.f);
+    auto mul = [](__m256 a, __m256 b) { return _mm256_mul_ps(a, b); };
+    auto add = [](__m256 a, __m256 b) { return _mm256_add_ps(a, b); };
+    auto sub = [](__m256 a, __m256 b) { return _mm256_sub_ps(a, b); };
+
+    alignas(32) float c[6][8];
+    for (size_t i = 0; i < n8; i += 8) {
+        const float* s = scales    + i * 3;
+        const float* q = rotations + i * 4;
+        __m256 r = _mm256_i32gather_ps(q,     lane4, 4);
+        __m256 x = _mm256_i32gather_ps(q + 1, lane4, 4);
+        __m256 y = _mm256_i32gather_ps(q + 2, lane4, 4);
+        __m256 z = _mm256_i32gather_ps(q + 3, lane4, 4);
+        __m256 R[3][3] = {
+            { sub(one, mul(two, add(mul(y, y), mul(z, z)))), mul(two, sub(mul(x, y), mul(r, z))),
+              mul(two, add(mul(x, z), mul(r, y))) },
+            { mul(two, add(mul(x, y), mul(r, z))), sub(one, mul(two, add(mul(x, x), mul(z, z)))),
+              mul(two, sub(mul(y, z), mul(r, x))) },
+            { mul(two, sub(mul(x, z), mul(r, y))), mul(two, add(mul(y, z), mul(r, x))),
+              sub(one, mul(two, add(mul(x, x), mul(y, y)))) },
+        };
+        __m256 s2[3];
+        for (int k = 0; k < 3; ++k) {
+            __m256 sk = _mm256_i32gather_ps(s + k, lane3, 4);
+            s2[k] = mul(sk, sk);
+        }
+        __m256 M[3][3];
+        for (int a = 0; a < 3; ++a)
+            for (int k = 0; k < 3; ++k) M[a][k] = mul(R[a][k], s2[k]);
+        auto dot = [&](int a, int b) {
+            return add(add(mul(M[a][0], R[b][0]), mul(M[a][1], R[b][1])), mul(M[a][2], R[b][2]));
+        };
+        _mm256_store_ps(c[0], dot(0, 0));
+        _mm256_store_ps(c[1], dot(1, 1));
+        _mm256_store_ps(c[2], dot(2, 2));
+        _mm256_store_ps(c[3], dot(0, 1));
+        _mm256_store_ps(c[4], dot(0, 2));
+        _mm256_store_ps(c[5], dot(1, 2));
+        float* d = diag    + i * 3;
+        float* o = offDiag + i * 3;
+        for (int j = 0; j < 8; ++j)
+            for (int k = 0; k < 3; ++k) {
+                d[j * 3 + k] = c[k][j];
+                o[j * 3 + k] = c[3 + k][j];
+            }
+    }
+    return n8;
+}
+
+} // namespace gs
@@ -0,0 +1,150 @@
+#include "SplatOrder.h"
+#include "ParallelFor.h"
+#include "RadixSort.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+static constexpr size_t   kKeyChunkRows  = 16384;     // rows per worker task (keys, gather)
+static constexpr size_t   kSortBlockRows = 65536;     // rows per radix histogram block
+static constexpr int      kRadixBits     = 10;        // 3 passes over a 30-bit key
+
+// ===========================================================================
+// Curve keys
+// ===========================================================================
+// Spreads the low 10 bits of x to every third bit (bit i -> bit 3i)
+static inline uint32_t spreadBits3(uint32_t x) {
+    x &= 0x3ffu;
+    x = (x | (x << 16)) & 0x030000ffu;
+    x = (x | (x <<  8)) & 0x0300f00fu;
+    x = (x | (x <<  4)) & 0x030c30c3u;
+    x = (x | (x <<  2)) & 0x09249249u;
+    return x;
+}
+
+static inline uint32_t mortonKey(uint32_t x, uint32_t y, uint32_t z) {
+    return spreadBits3(x) | (spreadBits3(y) << 1) | (spreadBits3(z) << 2);
+}
+
+// Hilbert index via Skilling's transform ("Programming the Hilbert curve",
+// 2004): turn the coordinates into the transposed Hilbert index in place,
+// then interleave it like a Morton key (X[0] most significant).
+static inline uint32_t hilbertKey(uint32_t x, uint32_t y, uint32_t z) {
+    uint32_t X[3] = { x, y, z };
+    const uint32_t M = 1u << (SplatReorder::kBitsPerAxis - 1);
+    for (uint32_t Q = M; Q > 1; Q >>= 1) {
+        uint32_t P = Q - 1;
+        for (int i = 0; i < 3; ++i) {
+            // Bit set: invert the low bits of X[0]; clear: exchange them
+            // with X[i]. Branch-free, since the bits are random per splat.
+            uint32_t set = 0u - ((X[i] & Q) != 0);
+            X[0] ^= P & set;
+            uint32_t t = (X[0] ^ X[i]) & P & ~set;
+            X[0] ^= t;
+            X[i] ^= t;
+        }
+    }
+    X[1] ^= X[0];                                       // Gray encode
+    X[2] ^= X[1];
+    uint32_t t = 0;
+    for (uint32_t Q = M; Q > 1; Q >>= 1)
+        if (X[2] & Q) t ^= Q - 1;
+    for (int i = 0; i < 3; ++i) X[i] ^= t;
+    return (spreadBits3(X[0]) << 2) | (spreadBits3(X[1]) << 1) | spreadBits3(X[2]);
+}
+
+void SplatReorder::computeKeys(const GaussianData& d, SplatOrder order, std::vector<uint32_t>& keys) {
+    const size_t N = d.count();
+    keys.resize(N);
+    if (N == 0) return;
+
+    // Bbox of the rows themselves: a dataset straight from a cache or a
+    // stream may not have finalize()'s bbox yet.
+    struct alignas(64) Box { float lo[3] = { 1e30f, 1e30f, 1e30f }, hi[3] = { -1e30f, -1e30f, -1e30f }; };
+    std::vector<Box> parts(gs::WorkerCount());
+    const float* pos = d.positions.data();
+    gs::ParallelFor(N, kKeyChunkRows, [&](size_t begin, size_t end, unsigned worker) {
+        Box& b = parts[worker];
+        for (size_t i = begin; i < end; ++i)
+            for (int k = 0; k < 3; ++k) {
+                b.lo[k] = std::min(b.lo[k], pos[i * 3 + k]);
+                b.hi[k] = std::max(b.hi[k], pos[i * 3 + k]);
+            }
+    });
+    float lo[3], scale[3];
+    const float cells = (float)((1u << kBitsPerAxis) - 1);
+    for (int k = 0; k < 3; ++k) {
+        float hi = -1e30f;
+        lo[k] = 1e30f;
+        for (const Box& b : parts) { lo[k] = std::min(lo[k], b.lo[k]); hi = std::max(hi, b.hi[k]); }
+        scale[k] = hi > lo[k] ? cells / (hi - lo[k]) : 0.f;
+    }
+
+    const bool hilbert = order == SplatOrder::Hilbert;
+    gs::ParallelFor(N, kKeyChunkRows, [&](size_t begin, size_t end, unsigned) {
+        for (size_t i = begin; i < end; ++i) {
+            uint32_t q[3];
+            for (int k = 0; k < 3; ++k) {
+                float t = (pos[i * 3 + k] - lo[k]) * scale[k] + 0.5f;
+                q[k] = (uint32_t)std::min(t > 0.f ? t : 0.f, cells);   // NaN -> 0
+            }
+            keys[i] = hilbert ? hilbertKey(q[0], q[1], q[2]) : mortonKey(q[0], q[1], q[2]);
+        }
+    });
+}
+
+// ===========================================================================
+// Radix sort (gs::RadixSortPairs) of the keys with their row indices
+// ===========================================================================
+std::vector<uint32_t> SplatReorder::sortPermutation(const std::vector<uint32_t>& keys) {
+    std::vector<uint32_t> perm(keys.size());
+    std::iota(perm.begin(), perm.end(), 0u);
+    std::vector<uint32_t> sorted = keys;
+    gs::RadixSortPairs<kRadixBits>(sorted, perm, (kKeyBits + kRadixBits - 1) / kRadixBits,
+                                   kSortBlockRows);
+    return perm;
+}
+
+// ===========================================================================
+// Gather
+// ===========================================================================
+GaussianData SplatReorder::permute(const GaussianData& src, const std::vector<uint32_t>& perm) {
+    GaussianData out;
+    out.shDegree       = src.shDegree;
+    out.sourceSHDegree = src.sourceSHDegree;
+    std::memcpy(out.bboxMin, src.bboxMin, sizeof(out.bboxMin));
+    std::memcpy(out.bboxMax, src.bboxMax, sizeof(out.bboxMax));
+
+    const size_t N   = src.count();
+    const size_t shF = src.shFloats();
+    out.resize(N);
+    out.sourceIndex.resize(N);
+    gs::ParallelFor(N, kKeyChunkRows, [&](size_t begin, size_t end, unsigned) {
+        for (size_t i = begin; i < end; ++i) {
+            size_t s = perm[i];
+            std::memcpy(&out.positions[i * 3],  &src.positions[s * 3],  3 * sizeof(float));
+            std::memcpy(&out.scaleWS[i * 3],    &src.scaleWS[s * 3],    3 * sizeof(float));
+            std::memcpy(&out.rotationWS[i * 4], &src.rotationWS[s * 4], 4 * sizeof(float));
+            out.opacityRaw[i] = src.opacityRaw[s];
+            std::memcpy(&out.shCoeffs[i * shF], &src.shCoeffs[s * shF], shF * sizeof(float));
+            out.sourceIndex[i] = (uint32_t)src.fileRow(s);
+        }
+    });
+    return out;
+}
+
+GaussianData SplatReorder::reorder(const GaussianData& src, SplatOrder order) {
+    if (order == SplatOrder::File || src.count() < 2) return src;
+    std::vector<uint32_t> keys;
+    computeKeys(src, order, keys);
+    return permute(src, sortPermutation(keys));
+}
+
+const char* SplatReorder::name(SplatOrder order) {
+    switch (order) {
+    case SplatOrder::Morton:  return "Morton";
+    case SplatOrder::Hilbert: return "Hilbert";
+    default:                  return "file";
+    }
+}
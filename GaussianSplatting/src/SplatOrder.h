@@ -0,0 +1,44 @@
+#pragma once
+#include "GaussianData.h"
+
+#include <cstdint>
+#include <vector>
+
+// Row order of a loaded dataset (gaussianSplat.splatOrder)
+enum class SplatOrder { File = 0, Morton = 1, Hilbert = 2 };
+
+// ===========================================================================
+// SplatReorder  --  spatially coherent row order for a loaded dataset.
+//
+// Trainers write splats in an order that is effectively random in space, so
+// neighbouring rows land far apart on screen. Reordering the rows along a
+// Morton (Z-order) or Hilbert curve through the bbox puts nearby splats in
+// nearby rows: GPU waves in the preprocess pass see similar culling
+// outcomes, CPU passes such as rect selection get long predictable runs, and
+// compact storage chunks (SplatCompact) cover small boxes.
+//
+// Positions are quantised to kBitsPerAxis per axis inside the bbox, giving a
+// 30-bit curve key per row; rows are sorted by key with a stable, parallel
+// LSD radix sort, and every column is gathered by the resulting permutation.
+// GaussianData::sourceIndex keeps the file row of each new row, so
+// gsSavePLY can write either order.
+// ===========================================================================
+class SplatReorder {
+public:
+    static constexpr int kBitsPerAxis = 10;
+    static constexpr int kKeyBits     = 3 * kBitsPerAxis;
+
+    // Returns a copy of the float dataset `src` with its rows in `order`
+    // (File returns the rows unchanged). sourceIndex is composed with any
+    // order src already had, so it always refers to the file.
+    static GaussianData reorder(const GaussianData& src, SplatOrder order);
+
+    // Curve key of every row of a float dataset.
+    static void computeKeys(const GaussianData& d, SplatOrder order, std::vector<uint32_t>& keys);
+    // Permutation that sorts `keys` (kKeyBits wide) stably: new row i is old row perm[i].
+    static std::vector<uint32_t> sortPermutation(const std::vector<uint32_t>& keys);
+    // `src` with new row i = src row perm[i].
+    static GaussianData permute(const GaussianData& src, const std::vector<uint32_t>& perm);
+
+    static const char* name(SplatOrder order);
+};
@@ -0,0 +1,300 @@
+#include "SplatPreprocess.h"
+#include "ParallelFor.h"
+#include "SplatCompact.h"
+#include "SplatKernels.h"
+
+#include <algorithm>
+#include <cmath>
+
+PreprocessInstance::PreprocessInstance(const float worldMat[16], const float viewMat[16]) {
+    for (int i = 0; i < 16; i++) world[i] = worldMat[i];
+    for (int r = 0; r < 4; r++)
+        for (int c = 0; c < 4; c++)
+            worldView[r * 4 + c] = worldMat[r * 4] * viewMat[c] + worldMat[r * 4 + 1] * viewMat[4 + c] +
+                                   worldMat[r * 4 + 2] * viewMat[8 + c] + worldMat[r * 4 + 3] * viewMat[12 + c];
+}
+
+void PreprocessOutputs::resize(size_t n) {
+    positionSS.assign(n * 2, 0.f);
+    depth.assign(n, 0.f);
+    radius.assign(n, 0.f);
+    color.assign(n * 3, 0.f);
+    cov2D.assign(n * 4, 0.f);
+}
+
+namespace {
+
+// Rows per block: compact datasets are decoded a block at a time
+constexpr size_t kBlockRows = 256;
+
+// SH basis constants, as in ComputeSphericalHarmonics
+constexpr double kSH0 = 0.282095;
+constexpr double kSH1 = 0.488603;
+constexpr double kSH2[5] = { 1.092548, -1.092548, 0.315392, -1.092548, 0.546274 };
+constexpr double kSH3[7] = { -0.590044, 2.890611, -0.457046, 0.373176, -0.457046, 1.445305, -0.590044 };
+
+// Frame and instance constants in the working precision. `hoisted` follows
+// the kernel: object-space cov3D from gs::Covariance3D and world * view
+// from PreprocessInstance, both in float. Otherwise every splat goes
+// through the world and view matrices and builds R S S^T R^T itself, the
+// unfactored formulation the hoisted one must agree with.
+template <typename T>
+struct Frame {
+    T world[16], view[16], worldView[16], proj[16], cam[3];
+    T focalX, focalY, limX, limY, filmW, filmH;
+    T fixedRadius;
+    bool hoisted;
+
+    Frame(const float worldMat[16], const PreprocessCamera& c, bool hoist) : hoisted(hoist) {
+        PreprocessInstance inst(worldMat, c.viewMat);
+        for (int k = 0; k < 16; k++) {
+            world[k]     = (T)worldMat[k];
+            view[k]      = (T)c.viewMat[k];
+            worldView[k] = (T)inst.worldView[k];
+            proj[k]      = (T)c.projMat[k];
+        }
+        for (int k = 0; k < 3; k++) cam[k] = (T)c.cameraPos[k];
+        filmW  = (T)c.filmWidth;
+        filmH  = (T)c.filmHeight;
+        focalX = T(0.5) * filmW / (T)c.tanHalfFov[0];
+        focalY = T(0.5) * filmH / (T)c.tanHalfFov[1];
+        limX   = T(1.3) * (T)c.tanHalfFov[0];
+        limY   = T(1.3) * (T)c.tanHalfFov[1];
+        fixedRadius = (T)c.debugFixedRadius;
+    }
+};
+
+// Rows [0, n) of one block. Inputs point at the block's first row in the
+// float column layout (covDiag/covOffDiag: gs::Covariance3D of the block,
+// hoisted frames only); outputs at its first output row.
+template <typename T>
+void preprocessBlock(const Frame<T>& f, size_t n, const float* positions, const float* scales,
+                     const float* rotations, const float* covDiag, const float* covOffDiag,
+                     const float* opacity, const float* sh, size_t shFloats, int shStride,
+                     const uint32_t* mask, float* outPos, float* outDepth, float* outRadius,
+                     float* outColor, float* outCov)
+{
+    for (size_t i = 0; i < n; i++) {
+        const float* p = positions + i * 3;
+
+        // posWS = float4(posOS, 1) * world; posVS = posWS * view, or
+        // float4(posOS, 1) * worldView when hoisted; posCS = posVS * proj
+        T ws[3], vs[4], cs[4];
+        for (int j = 0; j < 3; j++)
+            ws[j] = (T)p[0] * f.world[j] + (T)p[1] * f.world[4 + j] + (T)p[2] * f.world[8 + j] + f.world[12 + j];
+        if (f.hoisted) {
+            for (int j = 0; j < 4; j++)
+                vs[j] = (T)p[0] * f.worldView[j] + (T)p[1] * f.worldView[4 + j] +
+                        (T)p[2] * f.worldView[8 + j] + f.worldView[12 + j];
+        } else {
+            for (int j = 0; j < 4; j++)
+                vs[j] = ws[0] * f.view[j] + ws[1] * f.view[4 + j] + ws[2] * f.view[8 + j] + f.view[12 + j];
+        }
+        for (int j = 0; j < 4; j++)
+            cs[j] = vs[0] * f.proj[j] + vs[1] * f.proj[4 + j] + vs[2] * f.proj[8 + j] + vs[3] * f.proj[12 + j];
+        T ssx = (cs[0] / cs[3] * T(0.5) + T(0.5)) * f.filmW;
+        T ssy = (cs[1] / cs[3] * T(0.5) + T(0.5)) * f.filmH;
+
+        // cov3D and the 3x3 that takes it to view space: the object-space
+        // covariance and worldView when hoisted; otherwise the world cov3D,
+        // W^T (R diag(s^2) R^T) W with W the world 3x3, and the view matrix
+        T cov3[3][3];
+        const T* toView;
+        if (f.hoisted) {
+            const float* d = covDiag + i * 3;
+            const float* o = covOffDiag + i * 3;
+            T c[3][3] = { { d[0], o[0], o[1] }, { o[0], d[1], o[2] }, { o[1], o[2], d[2] } };
+            for (int a = 0; a < 3; a++)
+                for (int b = 0; b < 3; b++) cov3[a][b] = c[a][b];
+            toView = f.worldView;
+        } else {
+            // Quaternion (r, x, y, z)
+            const float* q = rotations + i * 4;
+            T r = q[0], x = q[1], y = q[2], z = q[3];
+            T R[3][3] = {
+                { 1 - 2*(y*y + z*z), 2*(x*y - r*z),     2*(x*z + r*y)     },
+                { 2*(x*y + r*z),     1 - 2*(x*x + z*z), 2*(y*z - r*x)     },
+                { 2*(x*z - r*y),     2*(y*z + r*x),     1 - 2*(x*x + y*y) },
+            };
+            const float* s = scales + i * 3;
+            T s2[3] = { (T)s[0] * (T)s[0], (T)s[1] * (T)s[1], (T)s[2] * (T)s[2] };
+            T obj[3][3], m[3][3];
+            for (int a = 0; a < 3; a++)
+                for (int b = 0; b < 3; b++)
+                    obj[a][b] = R[a][0] * s2[0] * R[b][0] + R[a][1] * s2[1] * R[b][1] + R[a][2] * s2[2] * R[b][2];
+            for (int a = 0; a < 3; a++)
+                for (int b = 0; b < 3; b++)
+                    m[a][b] = obj[a][0] * f.world[b] + obj[a][1] * f.world[4 + b] + obj[a][2] * f.world[8 + b];
+            for (int a = 0; a < 3; a++)
+                for (int b = 0; b < 3; b++)
+                    cov3[a][b] = f.world[a] * m[0][b] + f.world[4 + a] * m[1][b] + f.world[8 + a] * m[2][b];
+            toView = f.view;
+        }
+
+        // cov2D = T cov3D T^T, T = J * transpose(toView 3x3), mean clamped to 1.3 x the FOV
+        T mz = vs[2];
+        T mx = std::clamp(vs[0] / mz, -f.limX, f.limX) * mz;
+        T my = std::clamp(vs[1] / mz, -f.limY, f.limY) * mz;
+        T J[2][3] = {
+            { f.focalX / mz, 0, -f.focalX * mx / (mz * mz) },
+            { 0, f.focalY / mz, -f.focalY * my / (mz * mz) },
+        };
+        T Tm[2][3];
+        for (int a = 0; a < 2; a++)
+            for (int b = 0; b < 3; b++)
+                Tm[a][b] = J[a][0] * toView[b * 4] + J[a][1] * toView[b * 4 + 1] + J[a][2] * toView[b * 4 + 2];
+        T tc[2][3];
+        for (int a = 0; a < 2; a++)
+            for (int b = 0; b < 3; b++)
+                tc[a][b] = Tm[a][0] * cov3[0][b] + Tm[a][1] * cov3[1][b] + Tm[a][2] * cov3[2][b];
+        T ca = tc[0][0] * Tm[0][0] + tc[0][1] * Tm[0][1] + tc[0][2] * Tm[0][2] + T(0.3);
+        T cb = tc[0][0] * Tm[1][0] + tc[0][1] * Tm[1][1] + tc[0][2] * Tm[1][2];
+        T cc = tc[1][0] * Tm[1][0] + tc[1][1] * Tm[1][1] + tc[1][2] * Tm[1][2] + T(0.3);
+
+        T det    = ca * cc - cb * cb;
+        T mid    = T(0.5) * (ca + cc);
+        T lambda = mid + std::sqrt(std::max(T(0.01), mid * mid - det));
+        T radius = std::ceil(T(3) * std::sqrt(lambda));
+
+        // The kernel's early-outs, in its order, as one predicate
+        bool culled = (mask && (mask[i] & 2u)) || !(vs[2] < T(-0.2)) || !(det > 0) ||
+                      radius > T(1024) ||
+                      ssx + radius < 0 || ssx - radius > f.filmW ||
+                      ssy + radius < 0 || ssy - radius > f.filmH;
+
+        // SH colour, view direction from the camera to the world position
+        T dx = ws[0] - f.cam[0], dy = ws[1] - f.cam[1], dz = ws[2] - f.cam[2];
+        T inv = T(1) / std::sqrt(dx * dx + dy * dy + dz * dz);
+        dx *= inv; dy *= inv; dz *= inv;
+        const float* c = sh + i * shFloats;
+        T col[3];
+        for (int k = 0; k < 3; k++) {
+            auto g = [&](int idx) { return (T)c[idx * 3 + k]; };
+            T v = g(0) * T(kSH0);
+            if (shStride >= 4)
+                v += g(1) * T(-kSH1) * dy + g(2) * T(kSH1) * dz + g(3) * T(-kSH1) * dx;
+            if (shStride >= 9)
+                v += g(4) * T(kSH2[0]) * dx * dy + g(5) * T(kSH2[1]) * dy * dz +
+                     g(6) * T(kSH2[2]) * (T(3) * dz * dz - T(1)) + g(7) * T(kSH2[3]) * dx * dz +
+                     g(8) * T(kSH2[4]) * (dx * dx - dy * dy);
+            if (shStride >= 16)
+                v += g(9)  * T(kSH3[0]) * dy * (T(3) * dx * dx - dy * dy) +
+                     g(10) * T(kSH3[1]) * dx * dy * dz +
+                     g(11) * T(kSH3[2]) * dy * (T(5) * dz * dz - T(1)) +
+                     g(12) * T(kSH3[3]) * (T(5) * dz * dz * dz - T(3) * dz) +
+                     g(13) * T(kSH3[4]) * dx * (T(5) * dz * dz - T(1)) +
+                     g(14) * T(kSH3[5]) * dz * (dx * dx - dy * dy) +
+                     g(15) * T(kSH3[6]) * dx * (dx * dx - T(3) * dy * dy);
+            col[k] = std::max(v + T(0.5), T(0));
+        }
+
+        T cov[4] = { cc / det, -cb / det, ca / det, (T)opacity[i] };
+        if (f.fixedRadius > 0) {
+            T invR2 = T(1) / (f.fixedRadius * f.fixedRadius * T(0.1111));
+            radius  = f.fixedRadius;
+            cov[0]  = invR2;
+            cov[1]  = 0;
+            cov[2]  = invR2;
+        }
+
+        T keep = culled ? T(0) : T(1);
+        outPos[i * 2]     = (float)(ssx * keep);
+        outPos[i * 2 + 1] = (float)(ssy * keep);
+        outDepth[i]       = culled ? 0.f : (float)(cs[2] / cs[3]);
+        outRadius[i]      = (float)(radius * keep);
+        for (int k = 0; k < 3; k++) outColor[i * 3 + k] = (float)(col[k] * keep);
+        for (int k = 0; k < 4; k++) outCov[i * 4 + k]   = culled ? 0.f : (float)cov[k];
+    }
+}
+
+template <typename T>
+void runRows(const GaussianData& gd, size_t count, const Frame<T>& f, const uint32_t* mask,
+             PreprocessOutputs& out) {
+    const size_t shFloats = gd.shFloats();
+    const int    shStride = gd.shStride();
+    gs::ParallelFor(count, 16384, [&](size_t begin, size_t end, unsigned) {
+        std::vector<float> pos, scale, rot, sh, covDiag, covOffDiag;
+        if (gd.compact()) {
+            pos.resize(kBlockRows * 3);
+            scale.resize(kBlockRows * 3);
+            rot.resize(kBlockRows * 4);
+            sh.resize(kBlockRows * shFloats);
+        }
+        if (f.hoisted) {
+            covDiag.resize(kBlockRows * 3);
+            covOffDiag.resize(kBlockRows * 3);
+        }
+        for (size_t b = begin; b < end; b += kBlockRows) {
+            size_t n = std::min(kBlockRows, end - b);
+            const float *p, *s, *r, *c;
+            if (gd.compact()) {
+                SplatCompact::decodeRows(gd, b, b + n, pos.data(), scale.data(), rot.data(), sh.data());
+                p = pos.data(); s = scale.data(); r = rot.data(); c = sh.data();
+            } else {
+                p = &gd.positions[b * 3];
+                s = &gd.scaleWS[b * 3];
+                r = &gd.rotationWS[b * 4];
+                c = &gd.shCoeffs[b * shFloats];
+            }
+            if (f.hoisted)
+                gs::Covariance3D(s, r, n, covDiag.data(), covOffDiag.data());
+            preprocessBlock<T>(f, n, p, s, r, covDiag.data(), covOffDiag.data(), &gd.opacityRaw[b], c,
+                               shFloats, shStride, mask ? mask + b : nullptr,
+                               &out.positionSS[b * 2], &out.depth[b], &out.radius[b],
+                               &out.color[b * 3], &out.cov2D[b * 4]);
+        }
+    });
+}
+
+} // namespace
+
+void SplatPreprocess::run(const GaussianData& gd, size_t count, const float worldMat[16],
+                          const PreprocessCamera& camera, const uint32_t* mask,
+                          PreprocessOutputs& out, Precision precision) {
+    count = std::min(count, gd.count());
+    out.resize(count);
+    if (precision == Precision::Double)
+        runRows<double>(gd, count, Frame<double>(worldMat, camera, false), mask, out);
+    else
+        runRows<float>(gd, count, Frame<float>(worldMat, camera, true), mask, out);
+}
+
+PreprocessComparison SplatPreprocess::compare(const PreprocessOutputs& ref,
+                                              const PreprocessOutputs& test,
+                                              size_t count, const PreprocessTolerance& tol) {
+    PreprocessComparison c;
+    count = std::min({ count, ref.count(), test.count() });
+
+    // Records an error against its tolerance; NaN counts as a violation
+    auto track = [&](float err, float bound, float& maxErr) {
+        maxErr = std::max(maxErr, err);
+        c.worstRatio = std::max(c.worstRatio, bound > 0.f ? err / bound : (err > 0.f ? INFINITY : 0.f));
+        return err <= bound;
+    };
+
+    for (size_t i = 0; i < count; i++) {
+        bool drawnRef = ref.radius[i] > 0.f, drawnTest = test.radius[i] > 0.f;
+        if (!drawnRef && !drawnTest) { c.culledBoth++; continue; }
+        if (drawnRef != drawnTest)   { c.cullMismatch++; continue; }
+        c.compared++;
+
+        bool ok = true;
+        for (int k = 0; k < 2; k++)
+            ok &= track(std::fabs(ref.positionSS[i * 2 + k] - test.positionSS[i * 2 + k]),
+                        tol.positionPx, c.positionPx);
+        ok &= track(std::fabs(ref.depth[i] - test.depth[i]), tol.depth, c.depth);
+        ok &= track(std::fabs(ref.radius[i] - test.radius[i]), tol.radius, c.radius);
+        for (int k = 0; k < 3; k++)
+            ok &= track(std::fabs(ref.color[i * 3 + k] - test.color[i * 3 + k]), tol.color, c.color);
+        const float* rc = &ref.cov2D[i * 4];
+        const float* tc = &test.cov2D[i * 4];
+        float scale = std::max(std::fabs(rc[0]), std::fabs(rc[2]));
+        for (int k = 0; k < 3; k++)
+            ok &= track(scale > 0.f ? std::fabs(rc[k] - tc[k]) / scale : std::fabs(tc[k]), tol.cov2D, c.cov2D);
+        ok &= rc[3] == tc[3];       // opacity is passed through unchanged
+        if (!ok) c.violations++;
+    }
+
+    c.passed = c.violations == 0 && (double)c.cullMismatch <= tol.cullMismatch * (double)count;
+    return c;
+}
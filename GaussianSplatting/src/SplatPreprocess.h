@@ -0,0 +1,109 @@
+#pragma once
+#include "GaussianData.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ===========================================================================
+// SplatPreprocess  --  CPU reference of PreprocessKernel
+// (shaders/merged_preprocess.hlsl) for one instance: world transform,
+// view/projection, cov3D, cov2D with the 0.3 dilation, radius, the same
+// culls and the SH colour, producing the same per-splat outputs.
+//
+// Needs no GPU, Maya or D3D, so it can render or regression-test a frame
+// anywhere. Rows are independent and read the SoA columns in order; run()
+// splits them across all cores and evaluates each row without per-row
+// branches (culls become a select at the end, the SH degree is the same for
+// every row), so the loop stays vectorisable. Compact datasets are decoded a
+// block at a time with SplatCompact::decodeRows, which matches the
+// GS_COMPACT kernel's loads.
+//
+// Float runs are what the GPU computes, up to the driver's exp/sqrt/divide
+// and fused multiply-adds, including its camera-independent precomputation
+// (object-space cov3D from gs::Covariance3D, world * view per instance).
+// Double runs the unfactored per-splat formulation (world, then view;
+// R S S^T R^T, then W^T cov W) in double as a ground truth, so comparing
+// the two also checks the precomputation. compare() checks two runs against
+// a PreprocessTolerance; gsPreprocessCheck uses it for float against double
+// and for the GPU outputs of a drawn node against the float run.
+// ===========================================================================
+
+// Frame constants, as GaussianRenderManager::setFrameData takes them
+struct PreprocessCamera {
+    float    viewMat[16]   = {};   // row-major, row vectors (p' = p * M)
+    float    projMat[16]   = {};
+    float    cameraPos[3]  = {};
+    float    tanHalfFov[2] = {};
+    int      filmWidth     = 0;
+    int      filmHeight    = 0;
+    uint32_t debugFixedRadius = 0; // renderMode 3: fixed radius, no cov2D
+};
+
+// Per-instance matrices, as GaussianRenderManager's instance table holds
+// them (recomputed only when the transform or the camera changes): the
+// world matrix, for the SH view direction, and world * view, which takes a
+// position straight to view space and whose upper 3x3 takes the
+// object-space covariance there.
+struct PreprocessInstance {
+    float world[16];
+    float worldView[16];
+
+    PreprocessInstance() = default;
+    PreprocessInstance(const float worldMat[16], const float viewMat[16]);
+};
+
+// Per-splat outputs, laid out like the GPU output buffers. Culled rows
+// (radius 0) are zero throughout; the GPU only writes their radius.
+struct PreprocessOutputs {
+    std::vector<float> positionSS;  // float2: pixels
+    std::vector<float> depth;       // NDC z
+    std::vector<float> radius;      // pixels, 0 = culled
+    std::vector<float> color;       // float3: SH colour
+    std::vector<float> cov2D;       // float4: inverse cov2D (xx, xy, yy), raw opacity
+
+    size_t count() const { return radius.size(); }
+    void   resize(size_t n);
+};
+
+// Largest differences two runs may show. Position and radius are in
+// pixels; ceil() may land on either side of an integer, hence 1 for the
+// radius. cov2D is relative to the larger diagonal term. Rows near a cull
+// boundary (z = -0.2, det = 0, radius = 1024, screen edge) may be drawn
+// by one run only: up to cullMismatch of the rows.
+struct PreprocessTolerance {
+    float positionPx   = 1e-2f;
+    float depth        = 1e-5f;
+    float radius       = 1.f;
+    float color        = 1e-3f;
+    float cov2D        = 1e-3f;
+    float cullMismatch = 1e-4f;
+};
+
+struct PreprocessComparison {
+    size_t compared     = 0;   // rows drawn by both
+    size_t culledBoth   = 0;
+    size_t cullMismatch = 0;   // rows drawn by one only
+    size_t violations   = 0;   // values outside the tolerance in rows drawn by both
+    // Largest difference per output, and largest difference / tolerance
+    float  positionPx = 0.f, depth = 0.f, radius = 0.f, color = 0.f, cov2D = 0.f;
+    float  worstRatio = 0.f;
+    bool   passed = false;     // no violations, cull mismatches within the tolerance
+};
+
+class SplatPreprocess {
+public:
+    enum class Precision { Float, Double };
+
+    // Rows [0, count) of `gd` under `worldMat` (row-major) into `out`
+    // (resized to count). `mask`, when given, holds one uint per row;
+    // rows with bit 1 (deleted) are culled. Runs on all cores.
+    static void run(const GaussianData& gd, size_t count, const float worldMat[16],
+                    const PreprocessCamera& camera, const uint32_t* mask,
+                    PreprocessOutputs& out, Precision precision = Precision::Float);
+
+    // Compares rows [0, count) of two runs (or a run and a GPU readback)
+    static PreprocessComparison compare(const PreprocessOutputs& reference,
+                                        const PreprocessOutputs& test, size_t count,
+                                        const PreprocessTolerance& tolerance = PreprocessTolerance());
+};
@@ -0,0 +1,179 @@
+#include "SplatSort.h"
+#include "ParallelFor.h"
+#include "RadixSort.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+static constexpr size_t   kCompactChunkRows = 65536;   // rows per worker task, a multiple of kGroupSize
+static constexpr size_t   kSortBlockRows    = 65536;   // rows per radix histogram block
+static constexpr int      kRadixBits        = 8;       // 4 passes over a 32-bit key
+static constexpr uint32_t kRadix            = 1u << kRadixBits;
+// Lookback status per tile and digit, as gTileState in radix_sort.hlsl
+static constexpr uint32_t kFlagAggregate    = 1u << 30;  // the tile's own count
+static constexpr uint32_t kFlagInclusive    = 2u << 30;  // count of all tiles up to it
+static constexpr uint32_t kValueMask        = kFlagAggregate - 1;
+static_assert(kCompactChunkRows % SplatSort::kGroupSize == 0, "");
+
+// ===========================================================================
+// Keys
+// ===========================================================================
+uint32_t SplatSort::depthKey(float depth) {
+    // FloatToSortKey (order-preserving for every float), inverted
+    uint32_t bits;
+    std::memcpy(&bits, &depth, sizeof(bits));
+    uint32_t mask = (0u - (bits >> 31)) | 0x80000000u;
+    return ~(bits ^ mask);
+}
+
+float SplatSort::keyDepth(uint32_t key) {
+    uint32_t sortKey = ~key;
+    uint32_t bits = (sortKey & 0x80000000u) ? (sortKey ^ 0x80000000u) : ~sortKey;
+    float depth;
+    std::memcpy(&depth, &bits, sizeof(depth));
+    return depth;
+}
+
+int SplatSort::keyBits(int requested) {
+    if (requested > kMaxQuantizedBits) return kFullKeyBits;
+    return std::max(requested, kMinKeyBits);
+}
+
+// ===========================================================================
+// Quantisation: as GlobalHistKernel. View z from NDC depth inverts the
+// projection's z/w (monotonic in front of the camera), so the steps are
+// even in view depth rather than in the hyperbolic NDC depth.
+// ===========================================================================
+void SplatSort::quantizeKeys(std::vector<uint32_t>& keys, int bits, const float proj[16]) {
+    if (keys.empty() || bits >= kFullKeyBits) return;
+    auto viewZ = [&](float ndc) {
+        return (proj[14] - ndc * proj[15]) / (ndc * proj[11] - proj[10]);
+    };
+    auto range = std::minmax_element(keys.begin(), keys.end());
+    const float zNear = viewZ(keyDepth(*range.second));   // largest key: nearest
+    const float zFar  = viewZ(keyDepth(*range.first));
+    const float scale = zFar != zNear ? 1.f / (zFar - zNear) : 0.f;
+    const float steps = (float)(1u << bits);
+    const uint32_t maxKey = (1u << bits) - 1;
+
+    gs::ParallelFor(keys.size(), kCompactChunkRows, [&](size_t begin, size_t end, unsigned) {
+        for (size_t i = begin; i < end; ++i) {
+            float t = std::clamp((viewZ(keyDepth(keys[i])) - zNear) * scale, 0.f, 1.f);
+            keys[i] = std::min((uint32_t)((1.f - t) * steps), maxKey);
+        }
+    });
+}
+
+// ===========================================================================
+// Compaction: every chunk counts its kept rows in parallel, an exclusive
+// scan over the chunks gives each its first output entry, and the chunks
+// write in parallel. Chunks are whole KeyGenKernel groups, so the counts
+// per group the GPU reserves add up to the same entries.
+// ===========================================================================
+size_t SplatSort::compact(const float* radius, const float* depth, size_t count,
+                          std::vector<uint32_t>& keys, std::vector<uint32_t>& slots) {
+    const size_t numChunks = (count + kCompactChunkRows - 1) / kCompactChunkRows;
+    std::vector<size_t> offsets(numChunks + 1, 0);
+    gs::ParallelFor(count, kCompactChunkRows, [&](size_t begin, size_t end, unsigned) {
+        size_t kept = 0;
+        for (size_t i = begin; i < end; ++i) kept += radius[i] > 0.f;
+        offsets[begin / kCompactChunkRows + 1] = kept;
+    });
+    for (size_t c = 0; c < numChunks; ++c) offsets[c + 1] += offsets[c];
+
+    const size_t total = offsets[numChunks];
+    keys.resize(total);
+    slots.resize(total);
+    gs::ParallelFor(count, kCompactChunkRows, [&](size_t begin, size_t end, unsigned) {
+        size_t dst = offsets[begin / kCompactChunkRows];
+        for (size_t i = begin; i < end; ++i) {
+            if (!(radius[i] > 0.f)) continue;
+            keys[dst]  = depthKey(depth[i]);
+            slots[dst] = (uint32_t)i;
+            dst++;
+        }
+    });
+    return total;
+}
+
+// ===========================================================================
+// Radix sort: gs::RadixSortPairs over 8-bit digits
+// ===========================================================================
+void SplatSort::radixSort(std::vector<uint32_t>& keys, std::vector<uint32_t>& values, int passes) {
+    gs::RadixSortPairs<kRadixBits>(keys, values, passes, kSortBlockRows);
+}
+
+// ===========================================================================
+// Onesweep: the digit histograms of all passes in one read (per worker, then
+// reduced), then per pass every tile of kSortBlockRows keys counts its
+// digits, publishes them as aggregates and walks back over the earlier
+// tiles until an inclusive count, which gives its first output entry per
+// digit. ParallelFor hands tiles out in order, so every tile waited on is
+// already being worked on and the lookback always ends.
+// ===========================================================================
+void SplatSort::onesweep(std::vector<uint32_t>& keys, std::vector<uint32_t>& values, int passes) {
+    const size_t N = keys.size();
+    if (N < 2) return;
+
+    const unsigned numWorkers = gs::WorkerCount();
+    std::vector<uint32_t> hist(size_t(numWorkers) * passes * kRadix, 0);
+    gs::ParallelFor(N, kSortBlockRows, [&](size_t begin, size_t end, unsigned worker) {
+        uint32_t* count = &hist[size_t(worker) * passes * kRadix];
+        for (size_t i = begin; i < end; ++i)
+            for (int pass = 0; pass < passes; ++pass)
+                count[pass * kRadix + ((keys[i] >> (pass * kRadixBits)) & (kRadix - 1))]++;
+    });
+    std::vector<uint32_t> first(passes * kRadix);
+    for (int pass = 0; pass < passes; ++pass) {
+        uint32_t sum = 0;
+        for (uint32_t digit = 0; digit < kRadix; ++digit) {
+            first[pass * kRadix + digit] = sum;
+            for (unsigned w = 0; w < numWorkers; ++w) sum += hist[(size_t(w) * passes + pass) * kRadix + digit];
+        }
+    }
+
+    std::vector<uint32_t> keyB(N), valB(N);
+    const size_t numTiles = (N + kSortBlockRows - 1) / kSortBlockRows;
+    std::vector<std::atomic<uint32_t>> state(numTiles * kRadix);
+
+    for (int pass = 0; pass < passes; ++pass) {
+        const int shift = pass * kRadixBits;
+        for (auto& s : state) s.store(0, std::memory_order_relaxed);
+
+        gs::ParallelFor(N, kSortBlockRows, [&](size_t begin, size_t end, unsigned) {
+            const size_t tile = begin / kSortBlockRows;
+            uint32_t count[kRadix] = {};
+            for (size_t i = begin; i < end; ++i) count[(keys[i] >> shift) & (kRadix - 1)]++;
+
+            std::atomic<uint32_t>* own = &state[tile * kRadix];
+            for (uint32_t digit = 0; digit < kRadix; ++digit)
+                own[digit].store((tile == 0 ? kFlagInclusive : kFlagAggregate) | count[digit],
+                                 std::memory_order_release);
+
+            uint32_t next[kRadix];
+            for (uint32_t digit = 0; digit < kRadix; ++digit) {
+                uint32_t prefix = 0;
+                for (size_t t = tile; t-- > 0;) {
+                    uint32_t s;
+                    while ((s = state[t * kRadix + digit].load(std::memory_order_acquire)) == 0)
+                        std::this_thread::yield();
+                    prefix += s & kValueMask;
+                    if (s & kFlagInclusive) break;
+                }
+                if (tile != 0)
+                    own[digit].store(kFlagInclusive | (prefix + count[digit]), std::memory_order_release);
+                next[digit] = first[pass * kRadix + digit] + prefix;
+            }
+
+            for (size_t i = begin; i < end; ++i) {
+                uint32_t dst = next[(keys[i] >> shift) & (kRadix - 1)]++;
+                keyB[dst] = keys[i];
+                valB[dst] = values[i];
+            }
+        });
+        keys.swap(keyB);
+        values.swap(valB);
+    }
+}
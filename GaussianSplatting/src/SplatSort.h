@@ -0,0 +1,78 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ===========================================================================
+// SplatSort  --  CPU reference of the GPU sort stage (shaders/radix_sort.hlsl).
+//
+// After preprocess, KeyGenKernel keeps only the drawn slots (radius > 0):
+// each group of kGroupSize slots counts its survivors, finds where they go
+// in a dense list by a decoupled lookback over the groups before it, and
+// writes a depth key and the slot there. The list is therefore in slot
+// order, and the radix sort and the instanced draw run over its count,
+// read from the GPU through indirect arguments, so slots culled by
+// preprocess cost nothing past key generation.
+//
+// The GPU sort is Onesweep: one histogram pass counts the digits of all
+// four 8-bit passes up front, then each pass is a single dispatch whose
+// tiles rank their keys stably and take their output offset per digit by
+// decoupled lookback over the earlier tiles. Being stable end to end, equal
+// depths keep slot order and the draw order does not flicker.
+//
+// compact() produces the same list as KeyGen (a prefix sum over the groups
+// in place of the lookback), onesweep() sorts it as the GPU does, with
+// tiles claimed in order and published through the same flags, and
+// radixSort() is the plain multi-pass sort it replaced, kept as a
+// baseline. All run on all cores and give identical results.
+//
+// With a key precision below 32 bits (keyBits()), the sort runs only the
+// passes those bits need: after KeyGen, GlobalHistKernel replaces each
+// full key by the splat's view depth quantised between the nearest and the
+// farthest kept splat of the frame, as quantizeKeys() does. Splats falling
+// in one step keep slot order, which may draw a nearer one first where
+// their footprints overlap (gsSortPrecision measures how often).
+// ===========================================================================
+class SplatSort {
+public:
+    static constexpr uint32_t kGroupSize = 256;   // KeyGenKernel threads per group
+
+    static constexpr int kFullKeyBits = 32;            // float keys, four passes
+    static constexpr int kMinKeyBits  = 8;
+    static constexpr int kMaxQuantizedBits = 24;       // float step of [0, 1]
+
+    // Sort key of an NDC depth: ascending keys put the farthest splat
+    // first, for back-to-front blending
+    static uint32_t depthKey(float depth);
+    // NDC depth of a depthKey()
+    static float keyDepth(uint32_t key);
+
+    // Key bits used for a requested precision: kMinKeyBits..kMaxQuantizedBits
+    // quantise, anything above keeps the full float key (kFullKeyBits)
+    static int keyBits(int requested);
+    // 8-bit sort passes keys of `bits` need
+    static int passCount(int bits) { return (bits + 7) / 8; }
+
+    // Replaces full keys (depthKey) by `bits` (< kFullKeyBits, from
+    // keyBits()) of view depth, normalised between the nearest and the
+    // farthest of them: 0 for the farthest, ascending towards the camera.
+    // `proj` is the row-major projection the depths came through.
+    static void quantizeKeys(std::vector<uint32_t>& keys, int bits, const float proj[16]);
+
+    // Keys and slots of rows [0, count) with radius > 0, in slot order, into
+    // `keys` and `slots` (resized). Returns the number kept.
+    static size_t compact(const float* radius, const float* depth, size_t count,
+                          std::vector<uint32_t>& keys, std::vector<uint32_t>& slots);
+
+    // Sorts `keys` ascending, moving `values` with them: `passes` stable
+    // LSD passes of 8 bits (keys must fit in 8 * passes bits), each counting
+    // per block, scanning, then scattering
+    static void radixSort(std::vector<uint32_t>& keys, std::vector<uint32_t>& values,
+                          int passes = 4);
+
+    // Same result as radixSort(), the way the GPU runs it: one histogram of
+    // all digits up front, then one single-pass scatter per digit with
+    // decoupled lookback between tiles
+    static void onesweep(std::vector<uint32_t>& keys, std::vector<uint32_t>& values,
+                         int passes = 4);
+};
@@ -2,9 +2,13 @@
 #include <maya/MGlobal.h>
 #include <maya/MDrawRegistry.h>
 #include "GaussianNode.h"
+#include "GaussianDataNode.h"
 #include "GaussianDrawOverride.h"
 #include "GaussianRenderManager.h"
 #include "GaussianSelection.h"
+#include "GaussianCommands.h"
+#include "GaussianCheckCommands.h"
+#include "PLYLoadJob.h"
 #include "ShaderLoader.h"
 
 #define EXPORT __declspec(dllexport)
@@ -27,6 +31,14 @@ global proc gaussianSplat_buildMenu()
              -annotation "Create an empty gaussianSplat node (set filePath in AE)"
              -command "gaussianSplat_createNode";
 
+    menuItem -label "Instance Selected Splat"
+             -annotation "Add a gaussianSplat that shares the selected one's data under a new transform"
+             -command "gaussianSplat_instance";
+
+    menuItem -label "Cancel Loading"
+             -annotation "Stop all PLY files that are still loading in the background"
+             -command "gsCancelLoad";
+
     menuItem -divider true -dividerLabel "Selection / Editing";
 
     menuItem -label "Marquee Select Tool"
@@ -75,11 +87,16 @@ global proc AEgaussianSplatTemplate(string $nodeName)
 
         editorTemplate -beginLayout "Point Cloud Data" -collapse 0;
             editorTemplate -addControl "filePath";
+            editorTemplate -addControl "shDegree";
+            editorTemplate -addControl "compactStorage";
+            editorTemplate -addControl "splatOrder";
+            editorTemplate -addControl "loadProgress";
         editorTemplate -endLayout;
 
         editorTemplate -beginLayout "Display" -collapse 0;
             editorTemplate -addControl "pointSize";
             editorTemplate -addControl "renderMode";
+            editorTemplate -addControl "sortKeyBits";
         editorTemplate -endLayout;
 
         editorTemplate -beginLayout "Selection / Editing" -collapse 0;
@@ -191,6 +208,56 @@ global proc gaussianSplat_createNode()
     select -r $transform;
     print ("// Created: " + $node + " -- set filePath in the Attribute Editor\n");
 }
+
+// Instancing: the selected gaussianSplat is moved onto a gaussianSplatData
+// node (created from its filePath and load settings unless it already has
+// one), and a new gaussianSplat under a new transform is connected to it.
+// Every shape connected to the data node shares one copy of the splats.
+global proc gaussianSplat_instance()
+{
+    string $shapes[] = `ls -selection -dag -type gaussianSplat`;
+    if (size($shapes) == 0) { warning "Select a gaussianSplat to instance."; return; }
+    string $src = $shapes[0];
+
+    string $data[] = `listConnections -source true -destination false -type gaussianSplatData ($src + ".inData")`;
+    string $dataNode = "";
+    if (size($data) > 0) {
+        $dataNode = $data[0];
+    } else {
+        $dataNode = `createNode gaussianSplatData -name "gaussianSplatData1"`;
+        setAttr -type "string" ($dataNode + ".filePath") `getAttr ($src + ".filePath")`;
+        setAttr ($dataNode + ".shDegree")       `getAttr ($src + ".shDegree")`;
+        setAttr ($dataNode + ".compactStorage") `getAttr ($src + ".compactStorage")`;
+        setAttr ($dataNode + ".splatOrder")     `getAttr ($src + ".splatOrder")`;
+        connectAttr ($dataNode + ".outData") ($src + ".inData");
+    }
+
+    string $transform = `createNode transform -name "gaussianSplatInstance1"`;
+    string $node      = `createNode gaussianSplat -parent $transform`;
+    connectAttr ($dataNode + ".outData") ($node + ".inData");
+    setAttr ($node + ".pointSize")  `getAttr ($src + ".pointSize")`;
+    setAttr ($node + ".renderMode") `getAttr ($src + ".renderMode")`;
+    setAttr ($node + ".sortKeyBits") `getAttr ($src + ".sortKeyBits")`;
+
+    select -r $transform;
+    print ("// Created: " + $node + " (instance of " + $dataNode + ")\n");
+}
+
+global proc AEgaussianSplatDataTemplate(string $nodeName)
+{
+    editorTemplate -beginScrollLayout;
+        editorTemplate -beginLayout "Point Cloud Data" -collapse 0;
+            editorTemplate -addControl "filePath";
+            editorTemplate -addControl "shDegree";
+            editorTemplate -addControl "compactStorage";
+            editorTemplate -addControl "splatOrder";
+            editorTemplate -addControl "loadProgress";
+        editorTemplate -endLayout;
+        editorTemplate -addExtraControls;
+    editorTemplate -endScrollLayout;
+
+    editorTemplate -suppress "outData";
+}
 )MEL";
 
 // ---------------------------------------------------------------------------
@@ -216,6 +283,20 @@ EXPORT MStatus initializePlugin(MObject obj) {
         return status;
     }
 
+    // Register the gaussianSplatData node (one dataset drawn by several shapes)
+    status = plugin.registerNode(
+        GaussianDataNode::typeName,
+        GaussianDataNode::typeId,
+        GaussianDataNode::creator,
+        GaussianDataNode::initialize);
+
+    if (!status) {
+        MGlobal::displayError(
+            "[GaussianSplat] registerNode(gaussianSplatData) failed: " + status.errorString());
+        plugin.deregisterNode(GaussianNode::typeId);
+        return status;
+    }
+
     // Register the draw override
     status = MHWRender::MDrawRegistry::registerDrawOverrideCreator(
         GaussianNode::drawDbClassification,
@@ -225,6 +306,7 @@ EXPORT MStatus initializePlugin(MObject obj) {
     if (!status) {
         MGlobal::displayError(
             "[GaussianSplat] registerDrawOverrideCreator failed: " + status.errorString());
+        plugin.deregisterNode(GaussianDataNode::typeId);
         plugin.deregisterNode(GaussianNode::typeId);
         return status;
     }
@@ -246,6 +328,53 @@ EXPORT MStatus initializePlugin(MObject obj) {
     plugin.registerContextCommand(GSMarqueeContextCmd::commandName,
                                    GSMarqueeContextCmd::creator);
 
+    // --- Loader / diagnostics commands ---
+    plugin.registerCommand(GSBenchPLYCmd::commandName,
+                           GSBenchPLYCmd::creator,
+                           GSBenchPLYCmd::newSyntax);
+    plugin.registerCommand(GSCancelLoadCmd::commandName,
+                           GSCancelLoadCmd::creator,
+                           GSCancelLoadCmd::newSyntax);
+    plugin.registerCommand(GSCacheStatsCmd::commandName,
+                           GSCacheStatsCmd::creator,
+                           GSCacheStatsCmd::newSyntax);
+    plugin.registerCommand(GSDatasetStatsCmd::commandName,
+                           GSDatasetStatsCmd::creator,
+                           GSDatasetStatsCmd::newSyntax);
+    plugin.registerCommand(GSCompactCheckCmd::commandName,
+                           GSCompactCheckCmd::creator,
+                           GSCompactCheckCmd::newSyntax);
+    plugin.registerCommand(GSBenchKernelsCmd::commandName,
+                           GSBenchKernelsCmd::creator,
+                           GSBenchKernelsCmd::newSyntax);
+    plugin.registerCommand(GSBenchOrderCmd::commandName,
+                           GSBenchOrderCmd::creator,
+                           GSBenchOrderCmd::newSyntax);
+    plugin.registerCommand(GSPoolCheckCmd::commandName,
+                           GSPoolCheckCmd::creator,
+                           GSPoolCheckCmd::newSyntax);
+    plugin.registerCommand(GSPageCheckCmd::commandName,
+                           GSPageCheckCmd::creator,
+                           GSPageCheckCmd::newSyntax);
+    plugin.registerCommand(GSPreprocessCheckCmd::commandName,
+                           GSPreprocessCheckCmd::creator,
+                           GSPreprocessCheckCmd::newSyntax);
+    plugin.registerCommand(GSCullCheckCmd::commandName,
+                           GSCullCheckCmd::creator,
+                           GSCullCheckCmd::newSyntax);
+    plugin.registerCommand(GSSortCheckCmd::commandName,
+                           GSSortCheckCmd::creator,
+                           GSSortCheckCmd::newSyntax);
+    plugin.registerCommand(GSBenchSortCmd::commandName,
+                           GSBenchSortCmd::creator,
+                           GSBenchSortCmd::newSyntax);
+    plugin.registerCommand(GSSortPrecisionCmd::commandName,
+                           GSSortPrecisionCmd::creator,
+                           GSSortPrecisionCmd::newSyntax);
+    plugin.registerCommand(GSCoherenceCheckCmd::commandName,
+                           GSCoherenceCheckCmd::creator,
+                           GSCoherenceCheckCmd::newSyntax);
+
     // Build menu via MEL
     MGlobal::executeCommand(kBuildMenuMel);
     MGlobal::executeCommand("gaussianSplat_buildMenu");
@@ -258,12 +387,31 @@ EXPORT MStatus initializePlugin(MObject obj) {
 EXPORT MStatus uninitializePlugin(MObject obj) {
     MFnPlugin plugin(obj);
 
+    // Background loads and cache writes run plugin code: stop and join them
+    // before anything is deregistered or the DLL goes away
+    PLYLoadJob::stopAll();
+
     // Remove menu
     MGlobal::executeCommand("gaussianSplat_removeMenu");
 
     // Release merged render manager resources before deregistering nodes
     GaussianRenderManager::instance().releaseAll();
 
+    plugin.deregisterCommand(GSCoherenceCheckCmd::commandName);
+    plugin.deregisterCommand(GSSortPrecisionCmd::commandName);
+    plugin.deregisterCommand(GSBenchSortCmd::commandName);
+    plugin.deregisterCommand(GSSortCheckCmd::commandName);
+    plugin.deregisterCommand(GSCullCheckCmd::commandName);
+    plugin.deregisterCommand(GSPreprocessCheckCmd::commandName);
+    plugin.deregisterCommand(GSPageCheckCmd::commandName);
+    plugin.deregisterCommand(GSPoolCheckCmd::commandName);
+    plugin.deregisterCommand(GSBenchKernelsCmd::commandName);
+    plugin.deregisterCommand(GSBenchOrderCmd::commandName);
+    plugin.deregisterCommand(GSCompactCheckCmd::commandName);
+    plugin.deregisterCommand(GSCacheStatsCmd::commandName);
+    plugin.deregisterCommand(GSDatasetStatsCmd::commandName);
+    plugin.deregisterCommand(GSCancelLoadCmd::commandName);
+    plugin.deregisterCommand(GSBenchPLYCmd::commandName);
     plugin.deregisterContextCommand(GSMarqueeContextCmd::commandName);
     plugin.deregisterCommand(GSSavePLYCmd::commandName);
     plugin.deregisterCommand(GSRestoreAllCmd::commandName);
@@ -275,6 +423,7 @@ EXPORT MStatus uninitializePlugin(MObject obj) {
         GaussianNode::drawDbClassification,
         GaussianNode::drawRegistrantId);
 
+    plugin.deregisterNode(GaussianDataNode::typeId);
     plugin.deregisterNode(GaussianNode::typeId);
 
     MGlobal::displayInfo("[GaussianSplat] Plugin unloaded.");
@@ -0,0 +1,17 @@
+#pragma once
+#include "CheckFixtures.h"
+
+#include <cstdio>
+
+// ---------------------------------------------------------------------------
+// Shared by the headless check tools: prints a CheckFixtures report the way
+// the gs* command shows it and turns it into the exit code (0 passed, 1 a
+// check failed). 2 is left for bad arguments and unreadable input.
+// ---------------------------------------------------------------------------
+inline int finishCheck(const char* cmd, const CheckFixtures::CheckReport& report) {
+    for (const std::string& line : report.lines)
+        printf("[%s] %s\n", cmd, line.c_str());
+    if (report.passed()) return 0;
+    fprintf(stderr, "%s: %s\n", cmd, report.error.c_str());
+    return 1;
+}
@@ -0,0 +1,34 @@
+// gsAsciiCheck  --  PLYReader's segmented ASCII parser against the stream
+// reader and the same rows in binary, on LF and CRLF files with and without
+// a final newline, and both readers timed. Exits 0 when every read matches,
+// 1 when one does not, 2 on bad arguments.
+//
+//   gsAsciiCheck [-count <n>] [-iterations <n>]
+#include "CheckTool.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static int usage() {
+    fprintf(stderr, "usage: gsAsciiCheck [-count <n>] [-iterations <n>]\n");
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    long count      = 20000;
+    int  iterations = 1;
+    for (int i = 1; i < argc; i++) {
+        const char* flag = argv[i];
+        if (i + 1 >= argc) return usage();
+        const char* value = argv[++i];
+        if (!std::strcmp(flag, "-c") || !std::strcmp(flag, "-count"))
+            count = std::strtol(value, nullptr, 10);
+        else if (!std::strcmp(flag, "-it") || !std::strcmp(flag, "-iterations"))
+            iterations = std::atoi(value);
+        else
+            return usage();
+    }
+    if (count <= 0) return usage();
+    return finishCheck("gsAsciiCheck", CheckFixtures::asciiCheck((unsigned)count, iterations));
+}
@@ -0,0 +1,35 @@
+// gsBenchKernels  --  the scalar / SIMD parity and exp / sigmoid error
+// bound checks and timings of the gsBenchKernels command, without Maya.
+// Exits 0 when both kernel levels give identical bits within the bounds,
+// 1 when they do not, 2 on bad arguments. The default count keeps the
+// check quick; -count 1000000 or 10000000 gives the timings.
+//
+//   gsBenchKernels [-count <n>] [-iterations <n>]
+#include "CheckTool.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static int usage() {
+    fprintf(stderr, "usage: gsBenchKernels [-count <n>] [-iterations <n>]\n");
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    long count      = 100000;
+    int  iterations = 3;
+    for (int i = 1; i < argc; i++) {
+        const char* flag = argv[i];
+        if (i + 1 >= argc) return usage();
+        const char* value = argv[++i];
+        if (!std::strcmp(flag, "-c") || !std::strcmp(flag, "-count"))
+            count = std::strtol(value, nullptr, 10);
+        else if (!std::strcmp(flag, "-it") || !std::strcmp(flag, "-iterations"))
+            iterations = std::atoi(value);
+        else
+            return usage();
+    }
+    if (count <= 0) return usage();
+    return finishCheck("gsBenchKernels", CheckFixtures::benchKernels((size_t)count, iterations));
+}
@@ -0,0 +1,49 @@
+// gsBenchPLY  --  the reader timings and decoder comparisons of the
+// gsBenchPLY command, without Maya. Exits 0 when the generic and
+// fixed-layout decoders agree and the stream reader is within tolerance,
+// 1 when not, 2 on bad arguments or an unwritable synthetic file.
+//
+//   gsBenchPLY (-file <path> | -synthetic <count>) [-iterations <n>]
+#include "CheckTool.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+static int usage() {
+    fprintf(stderr, "usage: gsBenchPLY (-file <path> | -synthetic <count>) [-iterations <n>]\n");
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    std::string file;
+    long synthetic  = 0;
+    int  iterations = 3;
+    for (int i = 1; i < argc; i++) {
+        const char* flag = argv[i];
+        if (i + 1 >= argc) return usage();
+        const char* value = argv[++i];
+        if (!std::strcmp(flag, "-f") || !std::strcmp(flag, "-file"))
+            file = value;
+        else if (!std::strcmp(flag, "-s") || !std::strcmp(flag, "-synthetic"))
+            synthetic = std::strtol(value, nullptr, 10);
+        else if (!std::strcmp(flag, "-it") || !std::strcmp(flag, "-iterations"))
+            iterations = std::max(1, std::atoi(value));
+        else
+            return usage();
+    }
+    if (file.empty() == (synthetic <= 0)) return usage();
+
+    CheckFixtures::TempPLY temp;
+    if (file.empty()) {
+        std::string err;
+        if (!temp.write("gsBenchPLY", (unsigned)synthetic, err)) {
+            fprintf(stderr, "gsBenchPLY: %s\n", err.c_str());
+            return 2;
+        }
+        file = temp.path();
+    }
+    return finishCheck("gsBenchPLY", CheckFixtures::benchPLY(file, iterations));
+}
@@ -0,0 +1,34 @@
+// gsBenchSort  --  the sort order and stability checks and timings of the
+// gsBenchSort command, without Maya or a GPU. Exits 0 when both radix
+// sorts match std::stable_sort on every distribution, 1 when one does not,
+// 2 on bad arguments.
+//
+//   gsBenchSort [-count <n>] [-iterations <n>]
+#include "CheckTool.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static int usage() {
+    fprintf(stderr, "usage: gsBenchSort [-count <n>] [-iterations <n>]\n");
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    long count      = 1 << 22;
+    int  iterations = 3;
+    for (int i = 1; i < argc; i++) {
+        const char* flag = argv[i];
+        if (i + 1 >= argc) return usage();
+        const char* value = argv[++i];
+        if (!std::strcmp(flag, "-c") || !std::strcmp(flag, "-count"))
+            count = std::strtol(value, nullptr, 10);
+        else if (!std::strcmp(flag, "-it") || !std::strcmp(flag, "-iterations"))
+            iterations = std::atoi(value);
+        else
+            return usage();
+    }
+    if (count <= 0) return usage();
+    return finishCheck("gsBenchSort", CheckFixtures::benchSort((size_t)count, iterations));
+}
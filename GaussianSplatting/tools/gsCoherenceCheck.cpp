@@ -0,0 +1,49 @@
+// gsCoherenceCheck  --  the incremental and reused sort checks of the
+// gsCoherenceCheck command, without Maya or a GPU. Exits 0 when every
+// frame's draw list matches a full sort, 1 when one does not, 2 on bad
+// arguments or an unreadable file.
+//
+//   gsCoherenceCheck (-file <path> | -synthetic <count>) [-frames <n>] [-keyBits <b>]
+#include "CheckTool.h"
+#include "GaussianData.h"
+#include "SplatSort.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+static int usage() {
+    fprintf(stderr, "usage: gsCoherenceCheck (-file <path> | -synthetic <count>) [-frames <n>] [-keyBits <b>]\n");
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    std::string file;
+    long synthetic = 0;
+    int  frames    = 8, keyBits = SplatSort::kFullKeyBits;
+    for (int i = 1; i < argc; i++) {
+        const char* flag = argv[i];
+        if (i + 1 >= argc) return usage();
+        const char* value = argv[++i];
+        if (!std::strcmp(flag, "-f") || !std::strcmp(flag, "-file"))
+            file = value;
+        else if (!std::strcmp(flag, "-s") || !std::strcmp(flag, "-synthetic"))
+            synthetic = std::strtol(value, nullptr, 10);
+        else if (!std::strcmp(flag, "-fr") || !std::strcmp(flag, "-frames"))
+            frames = std::atoi(value);
+        else if (!std::strcmp(flag, "-kb") || !std::strcmp(flag, "-keyBits"))
+            keyBits = std::atoi(value);
+        else
+            return usage();
+    }
+    if (file.empty() == (synthetic <= 0)) return usage();
+
+    GaussianData data;
+    std::string  err;
+    if (!CheckFixtures::readInput(file, (unsigned)synthetic, "gsCoherenceCheck", data, err)) {
+        fprintf(stderr, "gsCoherenceCheck: %s\n", err.c_str());
+        return 2;
+    }
+    return finishCheck("gsCoherenceCheck", CheckFixtures::coherenceCheck(data, frames, keyBits));
+}
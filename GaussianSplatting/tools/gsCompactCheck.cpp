@@ -0,0 +1,51 @@
+// gsCompactCheck  --  the compact storage error bounds of the
+// gsCompactCheck command, without Maya. Exits 0 when every element is
+// within its bound, 1 when one is not, 2 on bad arguments or an unreadable
+// file.
+//
+//   gsCompactCheck (-file <path> | -synthetic <count>) [-shDegree <n>] [-iterations <n>]
+#include "CheckTool.h"
+#include "GaussianData.h"
+#include "PLYReader.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+static int usage() {
+    fprintf(stderr, "usage: gsCompactCheck (-file <path> | -synthetic <count>) [-shDegree <n>] [-iterations <n>]\n");
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    std::string file;
+    long synthetic  = 0;
+    int  iterations = 3;
+    PLYReadControl control;
+    for (int i = 1; i < argc; i++) {
+        const char* flag = argv[i];
+        if (i + 1 >= argc) return usage();
+        const char* value = argv[++i];
+        if (!std::strcmp(flag, "-f") || !std::strcmp(flag, "-file"))
+            file = value;
+        else if (!std::strcmp(flag, "-s") || !std::strcmp(flag, "-synthetic"))
+            synthetic = std::strtol(value, nullptr, 10);
+        else if (!std::strcmp(flag, "-sh") || !std::strcmp(flag, "-shDegree"))
+            control.shDegree = std::clamp(std::atoi(value), 0, kMaxSHDegree);
+        else if (!std::strcmp(flag, "-it") || !std::strcmp(flag, "-iterations"))
+            iterations = std::max(1, std::atoi(value));
+        else
+            return usage();
+    }
+    if (file.empty() == (synthetic <= 0)) return usage();
+
+    GaussianData data;
+    std::string  err;
+    if (!CheckFixtures::readInput(file, (unsigned)synthetic, "gsCompactCheck", data, err, &control)) {
+        fprintf(stderr, "gsCompactCheck: %s\n", err.c_str());
+        return 2;
+    }
+    return finishCheck("gsCompactCheck", CheckFixtures::compactCheck(data, iterations));
+}
@@ -0,0 +1,50 @@
+// gsCullCheck  --  the SplatBVH culling checks of the gsCullCheck command,
+// without Maya or a GPU. Exits 0 when no splat the float preprocess draws
+// is culled, 1 when one is, 2 on bad arguments or an unreadable file.
+//
+//   gsCullCheck (-file <path> | -synthetic <count>) [-order <1|2>] [-iterations <n>]
+#include "CheckTool.h"
+#include "GaussianData.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+static int usage() {
+    fprintf(stderr, "usage: gsCullCheck (-file <path> | -synthetic <count>) [-order <1|2>] [-iterations <n>]\n");
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    std::string file;
+    long synthetic  = 0;
+    int  order      = (int)SplatOrder::Hilbert;
+    int  iterations = 20;
+    for (int i = 1; i < argc; i++) {
+        const char* flag = argv[i];
+        if (i + 1 >= argc) return usage();
+        const char* value = argv[++i];
+        if (!std::strcmp(flag, "-f") || !std::strcmp(flag, "-file"))
+            file = value;
+        else if (!std::strcmp(flag, "-s") || !std::strcmp(flag, "-synthetic"))
+            synthetic = std::strtol(value, nullptr, 10);
+        else if (!std::strcmp(flag, "-o") || !std::strcmp(flag, "-order"))
+            order = std::atoi(value);
+        else if (!std::strcmp(flag, "-it") || !std::strcmp(flag, "-iterations"))
+            iterations = std::max(1, std::atoi(value));
+        else
+            return usage();
+    }
+    if (file.empty() == (synthetic <= 0)) return usage();
+    if (order != (int)SplatOrder::Morton && order != (int)SplatOrder::Hilbert) return usage();
+
+    GaussianData data;
+    std::string  err;
+    if (!CheckFixtures::readInput(file, (unsigned)synthetic, "gsCullCheck", data, err)) {
+        fprintf(stderr, "gsCullCheck: %s\n", err.c_str());
+        return 2;
+    }
+    return finishCheck("gsCullCheck", CheckFixtures::cullCheck(data, (SplatOrder)order, iterations));
+}
@@ -0,0 +1,31 @@
+// gsPageCheck  --  the PageLayout and paged CopyPlan checks of the gsPageCheck
+// command, without Maya or a GPU. Exits 0 when every range checks out, 1
+// when one fails, 2 on bad arguments.
+//
+//   gsPageCheck [-iterations <n>] [-seed <n>]
+#include "CheckTool.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static int usage() {
+    fprintf(stderr, "usage: gsPageCheck [-iterations <n>] [-seed <n>]\n");
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    int iterations = 20000, seed = 1;
+    for (int i = 1; i < argc; i++) {
+        const char* flag = argv[i];
+        if (i + 1 >= argc) return usage();
+        const char* value = argv[++i];
+        if (!std::strcmp(flag, "-it") || !std::strcmp(flag, "-iterations"))
+            iterations = std::atoi(value);
+        else if (!std::strcmp(flag, "-sd") || !std::strcmp(flag, "-seed"))
+            seed = std::atoi(value);
+        else
+            return usage();
+    }
+    return finishCheck("gsPageCheck", CheckFixtures::pageCheck(iterations, (unsigned)seed));
+}
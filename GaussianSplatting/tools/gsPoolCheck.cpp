@@ -0,0 +1,31 @@
+// gsPoolCheck  --  the RangeAllocator and CopyPlan checks of the gsPoolCheck
+// command, without Maya or a GPU. Exits 0 when every step checks out, 1
+// when one fails, 2 on bad arguments.
+//
+//   gsPoolCheck [-operations <n>] [-seed <n>]
+#include "CheckTool.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static int usage() {
+    fprintf(stderr, "usage: gsPoolCheck [-operations <n>] [-seed <n>]\n");
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    int operations = 200000, seed = 1;
+    for (int i = 1; i < argc; i++) {
+        const char* flag = argv[i];
+        if (i + 1 >= argc) return usage();
+        const char* value = argv[++i];
+        if (!std::strcmp(flag, "-op") || !std::strcmp(flag, "-operations"))
+            operations = std::atoi(value);
+        else if (!std::strcmp(flag, "-sd") || !std::strcmp(flag, "-seed"))
+            seed = std::atoi(value);
+        else
+            return usage();
+    }
+    return finishCheck("gsPoolCheck", CheckFixtures::poolCheck(operations, (unsigned)seed));
+}
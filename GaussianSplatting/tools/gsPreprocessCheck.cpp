@@ -0,0 +1,78 @@
+// gsPreprocessCheck  --  the float-against-double preprocess check of the
+// gsPreprocessCheck command, without Maya, for machines that have no
+// devkit (build farm). Exits 0 when both layouts pass, 1 when a check
+// fails, 2 on bad arguments or an unreadable file.
+//
+//   gsPreprocessCheck (-file <path> | -synthetic <count>) [-iterations <n>]
+#include "CheckFixtures.h"
+#include "GaussianData.h"
+#include "PLYReader.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+static int usage() {
+    fprintf(stderr, "usage: gsPreprocessCheck (-file <path> | -synthetic <count>) [-iterations <n>]\n");
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    std::string file;
+    long synthetic  = 0;
+    int  iterations = 3;
+    for (int i = 1; i < argc; i++) {
+        const char* flag = argv[i];
+        if (i + 1 >= argc) return usage();
+        const char* value = argv[++i];
+        if (!std::strcmp(flag, "-f") || !std::strcmp(flag, "-file"))
+            file = value;
+        else if (!std::strcmp(flag, "-s") || !std::strcmp(flag, "-synthetic"))
+            synthetic = std::strtol(value, nullptr, 10);
+        else if (!std::strcmp(flag, "-it") || !std::strcmp(flag, "-iterations"))
+            iterations = std::max(1, std::atoi(value));
+        else
+            return usage();
+    }
+    if (file.empty() == (synthetic <= 0)) return usage();
+
+    CheckFixtures::TempPLY temp;
+    std::string err;
+    if (file.empty()) {
+        if (!temp.write("gsPreprocessCheck", (unsigned)synthetic, err)) {
+            fprintf(stderr, "gsPreprocessCheck: %s\n", err.c_str());
+            return 2;
+        }
+        file = temp.path();
+    }
+
+    GaussianData data;
+    bool ok = PLYReader::read(file, data, err);
+    if (!ok || data.empty()) {
+        fprintf(stderr, "gsPreprocessCheck: read failed (%s): %s\n", file.c_str(),
+                ok ? "no splats" : err.c_str());
+        return 2;
+    }
+
+    CheckFixtures::PreprocessLayoutResult results[2];
+    CheckFixtures::preprocessCheck(data, iterations, results);
+
+    const size_t n = data.count();
+    bool passed = true;
+    for (const CheckFixtures::PreprocessLayoutResult& r : results) {
+        const PreprocessComparison& c = r.comparison;
+        printf("[gsPreprocessCheck] %s layout, %zu splats: float run best of %d %.3f ms "
+               "(%.2f M splats/s); float against double: %s\n",
+               r.compact ? "compact" : "float", n, iterations, r.bestMs,
+               (n / 1000.0) / std::max(r.bestMs, 1e-3), CheckFixtures::describe(c).c_str());
+        if (!c.passed) {
+            fprintf(stderr, "gsPreprocessCheck: %s layout: %zu values outside the tolerance, "
+                    "%zu splats culled by one run only.\n",
+                    r.compact ? "compact" : "float", c.violations, c.cullMismatch);
+            passed = false;
+        }
+    }
+    return passed ? 0 : 1;
+}
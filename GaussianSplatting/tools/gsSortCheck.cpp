@@ -0,0 +1,47 @@
+// gsSortCheck  --  the CPU reference checks of the gsSortCheck command
+// (-file / -synthetic; -viewport needs Maya), without Maya or a GPU. Exits
+// 0 when compaction and both sorts match the reference, 1 when one does
+// not, 2 on bad arguments or an unreadable file.
+//
+//   gsSortCheck (-file <path> | -synthetic <count>) [-iterations <n>]
+#include "CheckTool.h"
+#include "GaussianData.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+static int usage() {
+    fprintf(stderr, "usage: gsSortCheck (-file <path> | -synthetic <count>) [-iterations <n>]\n");
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    std::string file;
+    long synthetic  = 0;
+    int  iterations = 3;
+    for (int i = 1; i < argc; i++) {
+        const char* flag = argv[i];
+        if (i + 1 >= argc) return usage();
+        const char* value = argv[++i];
+        if (!std::strcmp(flag, "-f") || !std::strcmp(flag, "-file"))
+            file = value;
+        else if (!std::strcmp(flag, "-s") || !std::strcmp(flag, "-synthetic"))
+            synthetic = std::strtol(value, nullptr, 10);
+        else if (!std::strcmp(flag, "-it") || !std::strcmp(flag, "-iterations"))
+            iterations = std::max(1, std::atoi(value));
+        else
+            return usage();
+    }
+    if (file.empty() == (synthetic <= 0)) return usage();
+
+    GaussianData data;
+    std::string  err;
+    if (!CheckFixtures::readInput(file, (unsigned)synthetic, "gsSortCheck", data, err)) {
+        fprintf(stderr, "gsSortCheck: %s\n", err.c_str());
+        return 2;
+    }
+    return finishCheck("gsSortCheck", CheckFixtures::sortCheck(data, iterations));
+}
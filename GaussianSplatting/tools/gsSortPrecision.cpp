@@ -0,0 +1,52 @@
+// gsSortPrecision  --  the ordering error of reduced-precision sort keys
+// across test scenes, as the gsSortPrecision command measures it, without
+// Maya or a GPU. Exits 0 when full 32-bit keys have no inversions, 1 when
+// they do, 2 on bad arguments or an unreadable file.
+//
+//   gsSortPrecision (-file <path> [-file <path> ...] | -synthetic <count>) [-views <n>]
+#include "CheckTool.h"
+#include "GaussianData.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static int usage() {
+    fprintf(stderr, "usage: gsSortPrecision (-file <path> [-file <path> ...] | -synthetic <count>) [-views <n>]\n");
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> files;
+    long synthetic = 0;
+    int  views     = 8;
+    for (int i = 1; i < argc; i++) {
+        const char* flag = argv[i];
+        if (i + 1 >= argc) return usage();
+        const char* value = argv[++i];
+        if (!std::strcmp(flag, "-f") || !std::strcmp(flag, "-file"))
+            files.push_back(value);
+        else if (!std::strcmp(flag, "-s") || !std::strcmp(flag, "-synthetic"))
+            synthetic = std::strtol(value, nullptr, 10);
+        else if (!std::strcmp(flag, "-vw") || !std::strcmp(flag, "-views"))
+            views = std::atoi(value);
+        else
+            return usage();
+    }
+    if (files.empty() == (synthetic <= 0)) return usage();
+    if (files.empty()) files.push_back("");         // the synthetic scene
+
+    CheckFixtures::SortPrecision precision(views);
+    for (const std::string& file : files) {
+        GaussianData data;
+        std::string  err;
+        if (!CheckFixtures::readInput(file, (unsigned)synthetic, "gsSortPrecision", data, err)) {
+            fprintf(stderr, "gsSortPrecision: %s\n", err.c_str());
+            return 2;
+        }
+        precision.addScene(file.empty() ? "synthetic" : file, data);
+    }
+    return finishCheck("gsSortPrecision", precision.finish());
+}